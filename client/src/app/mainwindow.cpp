@@ -43,6 +43,8 @@
 #include "resourceconfigdialog.h"
 
 #include "kdcrmdata/enumdefinitionattribute.h"
+#include "kdcrmdata/sugaraccount.h"
+#include "kdcrmdata/sugaropportunity.h"
 
 #include <Akonadi/AgentFilterProxyModel>
 #include <Akonadi/AgentInstance>
@@ -53,6 +55,8 @@
 #include <Akonadi/ServerManager>
 using namespace Akonadi;
 
+#include <KABC/Addressee>
+
 #include <kdeversion.h>
 
 #include <QCheckBox>
@@ -197,6 +201,8 @@ void MainWindow::initialize(bool displayOverlay)
             this, SLOT(slotEmailsLoaded(int)));
     connect(mLinkedItemsRepository, SIGNAL(documentsLoaded(int)),
             this, SLOT(slotDocumentsLoaded(int)));
+    connect(mLinkedItemsRepository, SIGNAL(loadingProgress(QString,int,int)),
+            this, SLOT(slotLoadingProgress(QString,int,int)));
 }
 
 void MainWindow::createActions()
@@ -245,6 +251,8 @@ void MainWindow::setupActions()
                 this, SLOT(slotShowMessage(QString)));
         connect(page, SIGNAL(modelLoaded(DetailsType)),
                 this, SLOT(slotModelLoaded(DetailsType)));
+        connect(page, SIGNAL(loadingProgress(QString,int,int)),
+                this, SLOT(slotLoadingProgress(QString,int,int)));
         connect(page, SIGNAL(synchronizeCollection(Akonadi::Collection)),
                 this, SLOT(slotSynchronizeCollection(Akonadi::Collection)));
         connect(page, SIGNAL(openObject(DetailsType,QString)),
@@ -258,6 +266,8 @@ void MainWindow::slotResourceSelectionChanged(int index)
         mLoadingOverlay->show();
         mLoadingOverlay->setMessage(i18n("Loading..."));
     }
+    mLoadingOverlay->clearProgress();
+    mPendingCollections.clear();
     AgentInstance agent = mResourceSelector->itemData(index, AgentInstanceModel::InstanceRole).value<AgentInstance>();
     if (agent.isValid()) {
         const QByteArray identifier = agent.identifier().toLatin1();
@@ -272,7 +282,7 @@ void MainWindow::slotResourceSelectionChanged(int index)
         AccountRepository::instance()->clear();
         mLinkedItemsRepository->clear();
         mCollectionManager->setResource(identifier);
-        slotShowMessage(i18n("(0/5) Listing folders..."));
+        slotShowMessage(i18n("Listing folders..."));
     } else {
         mUi.actionSynchronize->setEnabled(false);
         mUi.actionFullReload->setEnabled(false);
@@ -354,47 +364,67 @@ void MainWindow::slotShowMessage(const QString &message)
 
 void MainWindow::slotModelLoaded(DetailsType type)
 {
-    // We load Opps, Accounts, Contacts, Notes and Emails in this order (see CollectionManager)
     //qDebug() << typeToString(type) << "loaded";
-    switch (type)
-    {
-    case Account:
-        slotShowMessage(i18n("(2/6) Loading opportunities..."));
-        break;
-    case Opportunity:
-        slotShowMessage(i18n("(3/6) Loading contacts..."));
-        break;
-    case Contact:
-        slotShowMessage(i18n("(4/6) Loading notes..."));
-        ReferencedData::emitInitialLoadingDoneForAll(); // fill combos
-        slotHideOverlay();
-        mLinkedItemsRepository->loadNotes();
-        break;
-    case Lead:
-    case Campaign:
-        // currently unused
-        break;
+    const Page *page = pageForType(type);
+    if (page) {
+        collectionLoaded(page->mimeType());
     }
 }
 
 void MainWindow::slotNotesLoaded(int count)
 {
     Q_UNUSED(count);
-    slotShowMessage(i18n("(5/6) Loading emails..."));
-    mLinkedItemsRepository->loadEmails();
+    collectionLoaded(SugarNote::mimeType());
 }
 
 void MainWindow::slotEmailsLoaded(int count)
 {
     Q_UNUSED(count);
-    slotShowMessage(i18n("(6/6) Loading documents..."));
-    mLinkedItemsRepository->loadDocuments();
+    collectionLoaded(SugarEmail::mimeType());
 }
 
 void MainWindow::slotDocumentsLoaded(int count)
 {
     Q_UNUSED(count);
-    initialLoadingDone();
+    collectionLoaded(SugarDocument::mimeType());
+}
+
+void MainWindow::slotLoadingProgress(const QString &collectionName, int loaded, int total)
+{
+    mLoadingOverlay->setProgress(collectionName, loaded, total);
+}
+
+// All collections are loaded at the same time (see slotCollectionResult), this is called
+// as each one of them is done. Only the steps which really need several collections wait here.
+void MainWindow::collectionLoaded(const QString &mimeType)
+{
+    if (!mPendingCollections.remove(mimeType))
+        return;
+
+    // The opportunities show the name and country of their account: only remove the overlay
+    // once both are available, to avoid the columns filling up in front of the user
+    if (mimeType == SugarAccount::mimeType() || mimeType == SugarOpportunity::mimeType()) {
+        if (!mPendingCollections.contains(SugarAccount::mimeType()) &&
+                !mPendingCollections.contains(SugarOpportunity::mimeType())) {
+            slotHideOverlay();
+        }
+    }
+
+    // The combos are filled from accounts, opportunities and contacts
+    if (mimeType == SugarAccount::mimeType() || mimeType == SugarOpportunity::mimeType() ||
+            mimeType == KABC::Addressee::mimeType()) {
+        if (!mPendingCollections.contains(SugarAccount::mimeType()) &&
+                !mPendingCollections.contains(SugarOpportunity::mimeType()) &&
+                !mPendingCollections.contains(KABC::Addressee::mimeType())) {
+            ReferencedData::emitInitialLoadingDoneForAll(); // fill combos
+        }
+    }
+
+    if (mPendingCollections.isEmpty()) {
+        initialLoadingDone();
+    } else {
+        slotShowMessage(i18np("Loading... (1 folder left)", "Loading... (%1 folders left)", mPendingCollections.count()));
+    }
 }
 
 void MainWindow::initialLoadingDone()
@@ -585,20 +615,32 @@ void MainWindow::slotPrintReport()
 void MainWindow::slotCollectionResult(const QString &mimeType, const Collection &collection)
 {
     if (mimeType == SugarAccount::mimeType()) {
-        slotShowMessage(i18n("(1/6) Loading accounts..."));
+        slotShowMessage(i18n("Loading..."));
     }
     foreach(Page *page, mPages) {
         if (page->mimeType() == mimeType) {
+            const DetailsType type = page->detailsType();
+            // Leads and campaigns aren't needed for the initial loading
+            if (type == Account || type == Opportunity || type == Contact) {
+                mPendingCollections.insert(mimeType);
+            }
             page->setCollection(collection);
             return;
         }
     }
+    // Notes, emails and documents don't depend on anything else, load them right away
     if (mimeType == SugarNote::mimeType()) {
         mLinkedItemsRepository->setNotesCollection(collection);
+        mPendingCollections.insert(mimeType);
+        mLinkedItemsRepository->loadNotes();
     } else if (mimeType == SugarEmail::mimeType()) {
         mLinkedItemsRepository->setEmailsCollection(collection);
+        mPendingCollections.insert(mimeType);
+        mLinkedItemsRepository->loadEmails();
     } else if (mimeType == SugarDocument::mimeType()) {
         mLinkedItemsRepository->setDocumentsCollection(collection);
+        mPendingCollections.insert(mimeType);
+        mLinkedItemsRepository->loadDocuments();
     }
 }
 
@@ -28,6 +28,7 @@
 #include "enums.h"
 
 #include <QMainWindow>
+#include <QSet>
 
 class ItemsTreeModel;
 class KJob;
@@ -83,6 +84,7 @@ private Q_SLOTS:
     void slotNotesLoaded(int count);
     void slotEmailsLoaded(int count);
     void slotDocumentsLoaded(int count);
+    void slotLoadingProgress(const QString &collectionName, int loaded, int total);
     void slotConfigureResources();
     void slotResourceError(const Akonadi::AgentInstance &resource, const QString &message);
     void slotResourceOnline(const Akonadi::AgentInstance &resource, bool online);
@@ -112,6 +114,7 @@ private:
     void setupResourcesCombo();
     Akonadi::AgentInstance currentResource() const;
     void initialResourceSelection();
+    void collectionLoaded(const QString &mimeType);
     void initialLoadingDone();
     void processPendingImports();
     void showResourceDialog();
@@ -139,6 +142,8 @@ private:
     QAction *mResourceSelectorAction;
     QList<KJob *> mClearTimestampJobs;
 
+    // The collections which are being loaded on startup, by mimetype
+    QSet<QString> mPendingCollections;
     bool mInitialLoadingDone;
     bool mDisplayOverlay;
     QStringList mPendingImportPaths;
@@ -108,21 +108,12 @@ void AccountDetails::slotShippingAddressCountryEditingFinished()
 void AccountDetails::on_viewNotesButton_clicked()
 {
     const QString accountId = id();
-    const QVector<SugarNote> notes = mLinkedItemsRepository->notesForAccount(accountId);
-    kDebug() << notes.count() << "notes found for account" << accountId;
-    const QVector<SugarEmail> emails = mLinkedItemsRepository->emailsForAccount(accountId);
-    kDebug() << emails.count() << "emails found for account" << accountId;
     NotesWindow *dlg = new NotesWindow(nullptr);
     dlg->setResourceIdentifier(resourceIdentifier());
     dlg->setLinkedItemsRepository(mLinkedItemsRepository);
     dlg->setLinkedTo(accountId, type());
     dlg->setWindowTitle(i18n("Notes for account %1", name()));
-    foreach(const SugarNote &note, notes) {
-        dlg->addNote(note);
-    }
-    foreach(const SugarEmail &email, emails) {
-        dlg->addEmail(email);
-    }
+    dlg->loadNotes();
     dlg->setAttribute(Qt::WA_DeleteOnClose);
     dlg->show();
 }
@@ -384,21 +384,12 @@ void ContactDetails::on_buttonOpenAccount_clicked()
 void ContactDetails::on_viewNotesButton_clicked()
 {
     const QString contactId = id();
-    const QVector<SugarNote> notes = mLinkedItemsRepository->notesForContact(contactId);
-    kDebug() << notes.count() << "notes found for contact" << contactId;
-    const QVector<SugarEmail> emails = mLinkedItemsRepository->emailsForContact(contactId);
-    kDebug() << emails.count() << "emails found for contact" << contactId;
     NotesWindow *dlg = new NotesWindow(nullptr);
     dlg->setResourceIdentifier(resourceIdentifier());
     dlg->setLinkedItemsRepository(mLinkedItemsRepository);
     dlg->setLinkedTo(contactId, type());
     dlg->setWindowTitle(i18n("Notes for contact %1", name()));
-    foreach(const SugarNote &note, notes) {
-        dlg->addNote(note);
-    }
-    foreach(const SugarEmail &email, emails) {
-        dlg->addEmail(email);
-    }
+    dlg->loadNotes();
     dlg->setAttribute(Qt::WA_DeleteOnClose);
     dlg->show();
 }
@@ -43,6 +43,7 @@
 #include <QPlainTextEdit>
 #include <QSpinBox>
 #include <QTextEdit>
+#include <QtAlgorithms>
 
 using namespace Akonadi;
 
@@ -71,8 +72,123 @@ static QStringList storedProperties()
     return props;
 }
 
+QString Details::FieldBinding::value() const
+{
+    switch (kind) {
+    case LineEdit:
+        return static_cast<QLineEdit *>(widget)->text();
+    case ComboBox: {
+        const QComboBox *cb = static_cast<QComboBox *>(widget);
+        return cb->itemData(cb->currentIndex()).toString();
+    }
+    case CheckBox:
+        return static_cast<QCheckBox *>(widget)->isChecked() ? "1" : "0";
+    case TextEdit:
+        return static_cast<QTextEdit *>(widget)->toPlainText();
+    case PlainTextEdit:
+        return static_cast<QPlainTextEdit *>(widget)->toPlainText();
+    case SpinBox:
+        return QString::number(static_cast<QSpinBox *>(widget)->value());
+    case DoubleSpinBox:
+        return QString::number(static_cast<QDoubleSpinBox *>(widget)->value());
+    case DateEdit:
+        return KDCRMUtils::dateToString(static_cast<QDateEditEx *>(widget)->date());
+    }
+    return QString();
+}
+
+void Details::FieldBinding::setValue(const QString &value) const
+{
+    switch (kind) {
+    case LineEdit: {
+        QLineEdit *w = static_cast<QLineEdit *>(widget);
+        if (w->text() != value)
+            w->setText(value);
+        break;
+    }
+    case ComboBox: {
+        QComboBox *cb = static_cast<QComboBox *>(widget);
+        const int idx = cb->findData(value);
+        if (idx == -1 && cb->count() > 1) {
+            kDebug() << "Didn't find" << value << "in combo" << key;
+        }
+        if (cb->currentIndex() != idx)
+            cb->setCurrentIndex(idx);
+        break;
+    }
+    case CheckBox: {
+        QCheckBox *w = static_cast<QCheckBox *>(widget);
+        const bool checked = value == QLatin1String("1");
+        if (w->isChecked() != checked)
+            w->setChecked(checked);
+        break;
+    }
+    case TextEdit: {
+        QTextEdit *w = static_cast<QTextEdit *>(widget);
+        if (w->toPlainText() != value)
+            w->setPlainText(value);
+        break;
+    }
+    case PlainTextEdit: {
+        QPlainTextEdit *w = static_cast<QPlainTextEdit *>(widget);
+        if (w->toPlainText() != value)
+            w->setPlainText(value);
+        break;
+    }
+    case SpinBox: {
+        QSpinBox *w = static_cast<QSpinBox *>(widget);
+        const int number = value.toInt();
+        if (w->value() != number)
+            w->setValue(number);
+        break;
+    }
+    case DoubleSpinBox: {
+        QDoubleSpinBox *w = static_cast<QDoubleSpinBox *>(widget);
+        const double number = QLocale::c().toDouble(value);
+        if (w->value() != number)
+            w->setValue(number);
+        break;
+    }
+    case DateEdit: {
+        QDateEditEx *w = static_cast<QDateEditEx *>(widget);
+        const QDate date = KDCRMUtils::dateFromString(value);
+        if (w->date() != date)
+            w->setDate(date);
+        break;
+    }
+    }
+}
+
+void Details::FieldBinding::clear() const
+{
+    switch (kind) {
+    case LineEdit:
+        static_cast<QLineEdit *>(widget)->clear();
+        break;
+    case ComboBox:
+        static_cast<QComboBox *>(widget)->setCurrentIndex(0);
+        break;
+    case CheckBox:
+        static_cast<QCheckBox *>(widget)->setChecked(false);
+        break;
+    case TextEdit:
+        static_cast<QTextEdit *>(widget)->clear();
+        break;
+    case PlainTextEdit:
+        static_cast<QPlainTextEdit *>(widget)->clear();
+        break;
+    case SpinBox:
+    case DoubleSpinBox:
+        static_cast<QAbstractSpinBox *>(widget)->clear();
+        break;
+    case DateEdit:
+        static_cast<QDateEditEx *>(widget)->setDate(QDate());
+        break;
+    }
+}
+
 Details::Details(DetailsType type, QWidget *parent)
-    : QWidget(parent), mItemsTreeModel(nullptr), mType(type)
+    : QWidget(parent), mItemsTreeModel(nullptr), mType(type), mUnsupportedFieldsHidden(false)
 {
     // delayed init, wait for subclasses to create GUI
     QMetaObject::invokeMethod(this, "doConnects", Qt::QueuedConnection);
@@ -85,24 +201,108 @@ Details::~Details()
 void Details::doConnects()
 {
     // connect to changed signals
-    Q_FOREACH (QLineEdit *le, findChildren<QLineEdit *>()) {
-        if (!qobject_cast<QAbstractSpinBox *>(le->parentWidget()))
-            connect(le, SIGNAL(textChanged(QString)), this, SIGNAL(modified()));
-    }
-    Q_FOREACH (QComboBox *cb, findChildren<QComboBox *>())
-        connect(cb, SIGNAL(currentIndexChanged(int)), this, SIGNAL(modified()));
-    Q_FOREACH (QCheckBox *cb, findChildren<QCheckBox *>())
-        connect(cb, SIGNAL(toggled(bool)), this, SIGNAL(modified()));
-    Q_FOREACH (QTextEdit *te, findChildren<QTextEdit *>())
-        connect(te, SIGNAL(textChanged()), this, SIGNAL(modified()));
-    Q_FOREACH (QPlainTextEdit *te, findChildren<QPlainTextEdit *>())
-        connect(te, SIGNAL(textChanged()), this, SIGNAL(modified()));
-    Q_FOREACH (QSpinBox *w, findChildren<QSpinBox *>())
-        connect(w, SIGNAL(valueChanged(int)), this, SIGNAL(modified()));
-    Q_FOREACH (QDoubleSpinBox *w, findChildren<QDoubleSpinBox *>())
-        connect(w, SIGNAL(valueChanged(double)), this, SIGNAL(modified()));
-    Q_FOREACH (QDateEditEx *w, findChildren<QDateEditEx *>())
-        connect(w, SIGNAL(dateChanged(QDate)), this, SIGNAL(modified()));
+    Q_FOREACH (const FieldBinding &binding, fieldBindings()) {
+        QWidget *w = binding.widget;
+        switch (binding.kind) {
+        case FieldBinding::LineEdit:
+            connect(w, SIGNAL(textChanged(QString)), this, SIGNAL(modified()));
+            break;
+        case FieldBinding::ComboBox:
+            connect(w, SIGNAL(currentIndexChanged(int)), this, SIGNAL(modified()));
+            break;
+        case FieldBinding::CheckBox:
+            connect(w, SIGNAL(toggled(bool)), this, SIGNAL(modified()));
+            break;
+        case FieldBinding::TextEdit:
+        case FieldBinding::PlainTextEdit:
+            connect(w, SIGNAL(textChanged()), this, SIGNAL(modified()));
+            break;
+        case FieldBinding::SpinBox:
+            connect(w, SIGNAL(valueChanged(int)), this, SIGNAL(modified()));
+            break;
+        case FieldBinding::DoubleSpinBox:
+            connect(w, SIGNAL(valueChanged(double)), this, SIGNAL(modified()));
+            break;
+        case FieldBinding::DateEdit:
+            connect(w, SIGNAL(dateChanged(QDate)), this, SIGNAL(modified()));
+            break;
+        }
+    }
+}
+
+// The widgets are found once, rather than with findChildren() on every call of setData/getData.
+// Internal widgets (e.g. the line edit of a spinbox, the spinboxes of a calendar) are skipped.
+// They are sorted by kind, so that the widgets are still updated type by type, in the same
+// order as when each type was looked up separately (line edits first, etc.): changing a widget
+// can trigger slots which update other fields.
+const QVector<Details::FieldBinding> &Details::fieldBindings() const
+{
+    if (mFieldBindings.isEmpty()) {
+        Q_FOREACH (QWidget *w, findChildren<QWidget *>()) {
+            const QString key = w->objectName();
+            if (key.isEmpty() || key.startsWith(QLatin1String("qt_"))) {
+                continue;
+            }
+            FieldBinding binding;
+            if (qobject_cast<QLineEdit *>(w)) {
+                if (qobject_cast<QAbstractSpinBox *>(w->parentWidget()))
+                    continue;
+                binding.kind = FieldBinding::LineEdit;
+            } else if (qobject_cast<QComboBox *>(w)) {
+                binding.kind = FieldBinding::ComboBox;
+            } else if (qobject_cast<QCheckBox *>(w)) {
+                binding.kind = FieldBinding::CheckBox;
+            } else if (qobject_cast<QTextEdit *>(w)) {
+                binding.kind = FieldBinding::TextEdit;
+            } else if (qobject_cast<QPlainTextEdit *>(w)) {
+                binding.kind = FieldBinding::PlainTextEdit;
+            } else if (qobject_cast<QSpinBox *>(w)) {
+                binding.kind = FieldBinding::SpinBox;
+            } else if (qobject_cast<QDoubleSpinBox *>(w)) {
+                binding.kind = FieldBinding::DoubleSpinBox;
+            } else if (qobject_cast<QDateEditEx *>(w)) {
+                binding.kind = FieldBinding::DateEdit;
+            } else {
+                continue;
+            }
+            binding.key = key;
+            binding.widget = w;
+            binding.supported = mKeys.contains(key);
+            mFieldBindings.append(binding);
+        }
+        qStableSort(mFieldBindings.begin(), mFieldBindings.end(),
+                    [](const FieldBinding &left, const FieldBinding &right) { return left.kind < right.kind; });
+        for (int i = 0; i < mFieldBindings.count(); ++i) {
+            mFieldBindingIndex.insert(mFieldBindings.at(i).key, i);
+        }
+    }
+    return mFieldBindings;
+}
+
+const Details::FieldBinding *Details::fieldBinding(const QString &key) const
+{
+    fieldBindings();
+    const QHash<QString, int>::const_iterator it = mFieldBindingIndex.constFind(key);
+    return it == mFieldBindingIndex.constEnd() ? nullptr : &mFieldBindings.at(*it);
+}
+
+void Details::hideUnsupportedFields()
+{
+    Q_FOREACH (const FieldBinding &binding, fieldBindings()) {
+        if (!binding.supported) {
+            hideIfUnsupported(binding.widget);
+        }
+    }
+    mUnsupportedFieldsHidden = true;
+}
+
+void Details::setKeys(const QStringList &keys)
+{
+    mKeys = keys;
+    for (QVector<FieldBinding>::iterator it = mFieldBindings.begin(); it != mFieldBindings.end(); ++it) {
+        it->supported = mKeys.contains(it->key);
+    }
+    mUnsupportedFieldsHidden = false;
 }
 
 void Details::hideIfUnsupported(QWidget *widget)
@@ -143,33 +343,10 @@ void Details::fillComboBox(QComboBox *combo, const QString &objectName) const
  */
 void Details::clear()
 {
-    Q_FOREACH (QLineEdit *le, findChildren<QLineEdit *>()) {
-        le->clear();
-    }
-    Q_FOREACH (QComboBox *cb, findChildren<QComboBox *>()) {
-        cb->setCurrentIndex(0);
-    }
-    Q_FOREACH (QCheckBox *cb, findChildren<QCheckBox *>()) {
-        cb->setChecked(false);
-    }
-    Q_FOREACH (QTextEdit *te, findChildren<QTextEdit *>()) {
-        te->clear();
-    }
-    Q_FOREACH (QPlainTextEdit *te, findChildren<QPlainTextEdit *>()) {
-        te->clear();
-    }
-    Q_FOREACH (QSpinBox *w, findChildren<QSpinBox *>()) {
-        w->clear();
-    }
-    Q_FOREACH (QDoubleSpinBox *w, findChildren<QDoubleSpinBox *>()) {
-        w->clear();
-    }
-    Q_FOREACH (QDateEditEx *w, findChildren<QDateEditEx *>()) {
-        w->setDate(QDate());
-    }
-    Q_FOREACH (const QString &prop, storedProperties()) {
-        setProperty(prop.toLatin1(), QVariant());
+    Q_FOREACH (const FieldBinding &binding, fieldBindings()) {
+        binding.clear();
     }
+    mStoredData.clear();
 }
 
 void Details::setResourceIdentifier(const QByteArray &ident, const QString &baseUrl)
@@ -180,7 +357,7 @@ void Details::setResourceIdentifier(const QByteArray &ident, const QString &base
 
 void Details::setSupportedFields(const QStringList &fields)
 {
-    mKeys = fields;
+    setKeys(fields);
     Q_ASSERT(mKeys.contains("id"));
 }
 
@@ -207,96 +384,35 @@ void Details::setData(const QMap<QString, QString> &data,
 {
     Q_FOREACH (const QString &prop, storedProperties()) {
         if (data.contains(prop)) {
-            setProperty(prop.toLatin1(), data.value(prop));
+            mStoredData.insert(prop, data.value(prop));
         }
     }
-    setProperty("name", data.value("name")); // displayed in lineedit, but useful for subclasses (e.g. NotesDialog title)
+    mName = data.value("name"); // displayed in lineedit, but useful for subclasses (e.g. NotesDialog title)
 
     if (mKeys.isEmpty()) {
-        mKeys = data.keys(); // remember what are the expected keys, so getData can skip internal widgets
+        setKeys(data.keys()); // remember what are the expected keys, so getData can skip internal widgets
         Q_ASSERT(mKeys.contains("id"));
     }
+    if (!mUnsupportedFieldsHidden) {
+        hideUnsupportedFields();
+    }
 
     // Ensure comboboxes are filled
     setDataInternal(data);
 
-    QString key;
-
-    QList<QLineEdit *> lineEdits = findChildren<QLineEdit *>();
-    Q_FOREACH (QLineEdit *w, lineEdits) {
-        key = w->objectName();
-        if (key.startsWith(QLatin1String("qt_"))) {
-            continue; // skip internal lineedits (e.g. in spinbox)
-        }
-        hideIfUnsupported(w);
-        w->setText(data.value(key));
-    }
-    QList<QComboBox *> comboBoxes = findChildren<QComboBox *>();
-    Q_FOREACH (QComboBox *cb, comboBoxes) {
-        key = cb->objectName();
-        if (key.startsWith(QLatin1String("qt_"))) {
-            continue; // skip internal combos (e.g. in QDateEditEx)
+    Q_FOREACH (const FieldBinding &binding, fieldBindings()) {
+        binding.setValue(data.value(binding.key));
+        if (binding.kind == FieldBinding::DoubleSpinBox && binding.key == KDCRMFields::amount()) {
+            QDoubleSpinBox *w = static_cast<QDoubleSpinBox *>(binding.widget);
+            const QString suffix = data.value(KDCRMFields::currencySymbol());
+            if (w->suffix() != suffix)
+                w->setSuffix(suffix);
         }
-        hideIfUnsupported(cb);
-        const int idx = cb->findData(data.value(key));
-        if (idx == -1 && cb->count() > 1) {
-            kDebug() << "Didn't find" << data.value(key) << "in combo" << key;
-            //for (int row = 0; row < cb->count(); ++row) {
-            //    kDebug() << "  " << cb->itemData(row);
-            //}
-        }
-        cb->setCurrentIndex(idx);
-    }
-
-    QList<QCheckBox *> checkBoxes = findChildren<QCheckBox *>();
-    Q_FOREACH (QCheckBox *w, checkBoxes) {
-        key = w->objectName();
-        hideIfUnsupported(w);
-        w->setChecked(data.value(key) == QLatin1String("1"));
-    }
-
-    QList<QTextEdit *> textEdits = findChildren<QTextEdit *>();
-    Q_FOREACH (QTextEdit *w, textEdits) {
-        key = w->objectName();
-        hideIfUnsupported(w);
-        w->setPlainText(data.value(key));
-    }
-
-    QList<QPlainTextEdit *> plainTextEdits = findChildren<QPlainTextEdit *>();
-    Q_FOREACH (QPlainTextEdit *w, plainTextEdits) {
-        key = w->objectName();
-        hideIfUnsupported(w);
-        w->setPlainText(data.value(key));
-    }
-
-    Q_FOREACH (QSpinBox *w, findChildren<QSpinBox *>()) {
-        key = w->objectName();
-        if (key.startsWith(QLatin1String("qt_"))) {
-            continue; // skip internal widgets (e.g. in QCalendarWidget)
-        }
-        hideIfUnsupported(w);
-        w->setValue(data.value(key).toInt());
-    }
-
-    Q_FOREACH (QDoubleSpinBox *w, findChildren<QDoubleSpinBox *>()) {
-        key = w->objectName();
-        hideIfUnsupported(w);
-        //kDebug() << data.value(key);
-        w->setValue(QLocale::c().toDouble(data.value(key)));
-        if (key == KDCRMFields::amount())
-            w->setSuffix(data.value(KDCRMFields::currencySymbol()));
-    }
-
-    Q_FOREACH (QDateEditEx *w, findChildren<QDateEditEx *>()) {
-        key = w->objectName();
-        hideIfUnsupported(w);
-        //kDebug() << w << "setDate" << key << data.value(key) << KDCRMUtils::dateFromString(data.value(key));
-        w->setDate(KDCRMUtils::dateFromString(data.value(key)));
     }
 
     QList<QLabel *> labels = createdModifiedContainer->findChildren<QLabel *>();
     Q_FOREACH (QLabel *lb, labels) {
-        key = lb->objectName();
+        const QString key = lb->objectName();
         if (key == KDCRMFields::modifiedByName()) {
             lb->setText(data.value(KDCRMFields::modifiedByName()));
         } else if (key == KDCRMFields::dateEntered()) {
@@ -316,66 +432,14 @@ const QMap<QString, QString> Details::getData() const
     Q_ASSERT(mKeys.contains("id"));
 
     QMap<QString, QString> currentData;
-    QString key;
-    QList<QLineEdit *> lineEdits = findChildren<QLineEdit *>();
-    Q_FOREACH (QLineEdit *le, lineEdits) {
-        key = le->objectName();
-        if (!mKeys.contains(key)) continue;
-        if (qobject_cast<QAbstractSpinBox *>(le->parent())) continue;
-        currentData[key] = le->text();
-    }
-
-    QList<QComboBox *> comboBoxes = findChildren<QComboBox *>();
-    Q_FOREACH (QComboBox *cb, comboBoxes) {
-        key = cb->objectName();
-        if (!mKeys.contains(key)) { kDebug() << "skipping" << key; continue; }
-        currentData[key] = cb->itemData(cb->currentIndex()).toString();
-    }
-
-    QList<QCheckBox *> checkBoxes = findChildren<QCheckBox *>();
-    Q_FOREACH (QCheckBox *cb, checkBoxes) {
-        key = cb->objectName();
-        if (!mKeys.contains(key)) continue;
-        currentData[key] = cb->isChecked() ? "1" : "0";
-    }
-
-    QList<QTextEdit *> textEdits = findChildren<QTextEdit *>();
-    Q_FOREACH (QTextEdit *w, textEdits) {
-        key = w->objectName();
-        if (!mKeys.contains(key)) continue;
-        currentData[key] = w->toPlainText();
-    }
-
-    QList<QPlainTextEdit *> plainTextEdits = findChildren<QPlainTextEdit *>();
-    Q_FOREACH (QPlainTextEdit *w, plainTextEdits) {
-        key = w->objectName();
-        if (!mKeys.contains(key)) continue;
-        currentData.insert(key, w->toPlainText());
-    }
-
-    Q_FOREACH (QSpinBox *w, findChildren<QSpinBox *>()) {
-        key = w->objectName();
-        if (!mKeys.contains(key)) continue;
-        currentData[key] = QString::number(w->value());
-    }
-
-    Q_FOREACH (QDoubleSpinBox *w, findChildren<QDoubleSpinBox *>()) {
-        key = w->objectName();
-        if (!mKeys.contains(key)) continue;
-        currentData[key] = QString::number(w->value());
-    }
-
-    Q_FOREACH (QDateEditEx *w, findChildren<QDateEditEx *>()) {
-        key = w->objectName();
-        if (!mKeys.contains(key)) continue;
-        currentData.insert(key, KDCRMUtils::dateToString(w->date()));
+    Q_FOREACH (const FieldBinding &binding, fieldBindings()) {
+        if (binding.supported) {
+            currentData.insert(binding.key, binding.value());
+        }
     }
 
-    Q_FOREACH (const QString &prop, storedProperties()) {
-        QVariant val = property(prop.toLatin1());
-        if (val.isValid()) {
-            currentData.insert(prop, val.toString());
-        }
+    for (QMap<QString, QString>::const_iterator it = mStoredData.constBegin(); it != mStoredData.constEnd(); ++it) {
+        currentData.insert(it.key(), it.value());
     }
 
     // Fill assignee username from assignee userid so it shows up in the model.
@@ -411,12 +475,11 @@ QString Details::currentAccountId() const
     // Account has KDCRMFields::parentId()
     // Contact, Leads, Opportunity have KDCRMFields::accountId()
     if (mType != Campaign) {
-        const QList<QComboBox *> comboBoxes = findChildren<QComboBox *>();
-        Q_FOREACH (QComboBox *cb, comboBoxes) {
-            const QString key = cb->objectName();
-            if (key == KDCRMFields::parentId() || key == KDCRMFields::accountId()) {
-                return cb->itemData(cb->currentIndex()).toString();
-            }
+        const FieldBinding *binding = fieldBinding(KDCRMFields::parentId());
+        if (!binding || binding->kind != FieldBinding::ComboBox)
+            binding = fieldBinding(KDCRMFields::accountId());
+        if (binding && binding->kind == FieldBinding::ComboBox) {
+            return binding->value();
         }
     }
     return QString();
@@ -427,14 +490,12 @@ void Details::assignToMe()
     const QString fullUserName = ClientSettings::self()->fullUserName();
     if (fullUserName.isEmpty())
         return;
-    const QList<QComboBox *> comboBoxes = findChildren<QComboBox *>();
-    Q_FOREACH (QComboBox *cb, comboBoxes) {
-        const QString key = cb->objectName();
-        if (key == KDCRMFields::assignedUserId()) {
-            const int idx = cb->findText(fullUserName);
-            if (idx >= 0) {
-                cb->setCurrentIndex(idx);
-            }
+    const FieldBinding *binding = fieldBinding(KDCRMFields::assignedUserId());
+    if (binding && binding->kind == FieldBinding::ComboBox) {
+        QComboBox *cb = static_cast<QComboBox *>(binding->widget);
+        const int idx = cb->findText(fullUserName);
+        if (idx >= 0) {
+            cb->setCurrentIndex(idx);
         }
     }
 }
@@ -444,12 +505,12 @@ QString Details::name() const
     if (mType == Contact) {
         return findChild<QLineEdit *>(KDCRMFields::firstName())->text() + ' ' + findChild<QLineEdit *>(KDCRMFields::lastName())->text();
     }
-    return property("name").toString();
+    return mName;
 }
 
 QString Details::id() const
 {
-    return property("id").toString();
+    return mStoredData.value(KDCRMFields::id());
 }
 
 QCompleter *Details::createCountriesCompleter()
@@ -29,6 +29,8 @@
 
 #include <Akonadi/Item>
 
+#include <QHash>
+#include <QVector>
 #include <QWidget>
 
 class CollectionManager;
@@ -90,6 +92,34 @@ private Q_SLOTS:
     void doConnects();
 
 private:
+    // Binds a field (the objectName of the widget) to the widget showing it
+    struct FieldBinding {
+        enum Kind {
+            LineEdit,
+            ComboBox,
+            CheckBox,
+            TextEdit,
+            PlainTextEdit,
+            SpinBox,
+            DoubleSpinBox,
+            DateEdit
+        };
+
+        QString value() const;
+        // Only touches the widget if the value is different
+        void setValue(const QString &value) const;
+        void clear() const;
+
+        Kind kind;
+        QString key;
+        QWidget *widget;
+        bool supported; // see mKeys
+    };
+
+    const QVector<FieldBinding> &fieldBindings() const;
+    const FieldBinding *fieldBinding(const QString &key) const;
+    void setKeys(const QStringList &keys);
+    void hideUnsupportedFields();
     void hideIfUnsupported(QWidget *widget);
 
     const DetailsType mType;
@@ -97,5 +127,13 @@ private:
     QString mResourceBaseUrl;
     QStringList mKeys;
     EnumDefinitions mEnumDefinitions;
+
+    // Built from the child widgets on first use, they don't change afterwards
+    mutable QVector<FieldBinding> mFieldBindings;
+    mutable QHash<QString, int> mFieldBindingIndex; // key -> position in mFieldBindings
+    bool mUnsupportedFieldsHidden;
+
+    QMap<QString, QString> mStoredData; // see storedProperties()
+    QString mName;
 };
 #endif /* DETAILS_H */
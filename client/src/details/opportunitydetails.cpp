@@ -212,21 +212,12 @@ void OpportunityDetails::updateCloseDateLabel(bool closed)
 void OpportunityDetails::on_viewNotesButton_clicked()
 {
     const QString oppId = id();
-    const QVector<SugarNote> notes = mLinkedItemsRepository->notesForOpportunity(oppId);
-    kDebug() << notes.count() << "notes found for opp" << oppId;
-    const QVector<SugarEmail> emails = mLinkedItemsRepository->emailsForOpportunity(oppId);
-    kDebug() << emails.count() << "emails found for opp" << oppId;
     NotesWindow *dlg = new NotesWindow(nullptr);
     dlg->setResourceIdentifier(resourceIdentifier());
     dlg->setLinkedItemsRepository(mLinkedItemsRepository);
     dlg->setLinkedTo(oppId, type());
     dlg->setWindowTitle(i18n("Notes for opportunity %1", name()));
-    foreach(const SugarNote &note, notes) {
-        dlg->addNote(note);
-    }
-    foreach(const SugarEmail &email, emails) {
-        dlg->addEmail(email);
-    }
+    dlg->loadNotes();
     dlg->setAttribute(Qt::WA_DeleteOnClose);
     dlg->show();
 }
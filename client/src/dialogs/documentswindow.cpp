@@ -28,23 +28,29 @@
 #include "sugarresourceitemtransfer.h"
 
 #include <Akonadi/ItemDeleteJob>
+#include <Akonadi/ItemFetchJob>
 #include <Akonadi/ItemModifyJob>
 #include <KMimeType>
 #include <KRun>
 
 #include <QComboBox>
+#include <QDBusPendingCallWatcher>
 #include <QFileDialog>
 #include <QLabel>
 #include <QMessageBox>
 #include <QPlainTextEdit>
+#include <QProgressBar>
 #include <QScrollBar>
 
+#include <climits>
+
 DocumentWidget::DocumentWidget(EnumDefinitions *definitions, QWidget *parent)
     : QWidget(parent),
       mEnumDefinitions(definitions)
 {
     mNameLabel = new QLabel(this);
     mStatusBox = new QComboBox(this);
+    mProgressBar = new QProgressBar(this);
     mDeleteButton = new QPushButton(this);
     mDescriptionEdit = new QPlainTextEdit(this);
     QFrame *horizontalLine = new QFrame(this);
@@ -60,6 +66,8 @@ DocumentWidget::DocumentWidget(EnumDefinitions *definitions, QWidget *parent)
         }
     }
 
+    mProgressBar->setRange(0, 100);
+    mProgressBar->hide();
     mDeleteButton->setText(i18n("Delete"));
     horizontalLine->setFrameShape(QFrame::HLine);
 
@@ -71,6 +79,7 @@ DocumentWidget::DocumentWidget(EnumDefinitions *definitions, QWidget *parent)
     QHBoxLayout *firstRow = new QHBoxLayout;
     firstRow->addWidget(mNameLabel);
     firstRow->addWidget(mStatusBox);
+    firstRow->addWidget(mProgressBar);
     firstRow->addStretch();
     firstRow->addWidget(mDeleteButton);
 
@@ -127,10 +136,17 @@ bool DocumentWidget::isModified() const
     return false;
 }
 
+void DocumentWidget::setTransferProgress(int percent)
+{
+    mProgressBar->setValue(qMax(percent, 0));
+    mProgressBar->setVisible(percent != -1);
+}
+
 
 DocumentsWindow::DocumentsWindow(QWidget *parent)
     : QWidget(parent),
       ui(new Ui::DocumentsWindow),
+      mTransferInterface(nullptr),
       mLinkedItemsRepository(nullptr),
       mIsNotModifiedOverride(false),
       mLinkedItemType(Account),
@@ -151,6 +167,12 @@ DocumentsWindow::~DocumentsWindow()
 void DocumentsWindow::setResourceIdentifier(const QString &identifier)
 {
     mResourceIdentifier = identifier;
+
+    delete mTransferInterface;
+    mTransferInterface = new ComKdabSugarCRMItemTransferInterface(QLatin1String("org.freedesktop.Akonadi.Resource.") + mResourceIdentifier, QLatin1String("/ItemTransfer"), QDBusConnection::sessionBus(), this);
+    // The resource replies once the transfer is done, which can take a while for big documents
+    mTransferInterface->setTimeout(INT_MAX);
+    connect(mTransferInterface, SIGNAL(transferProgress(QString,int)), this, SLOT(slotTransferProgress(QString,int)));
 }
 
 void DocumentsWindow::setLinkedItemsRepository(LinkedItemsRepository *repository)
@@ -179,9 +201,33 @@ void DocumentsWindow::loadDocumentsFor(const QString &id, LinkedItemType itemTyp
         break;
     }
 
+    // The repository only has what's needed to list them, fetch the documents for editing
+    QStringList ids;
+    ids.reserve(documents.count());
     foreach (const SugarDocument &document, documents) {
-        addDocument(document);
+        ids.append(document.id());
     }
+    if (ids.isEmpty())
+        return;
+
+    Akonadi::ItemFetchJob *job = mLinkedItemsRepository->fetchFullItems(ids, this);
+    connect(job, SIGNAL(itemsReceived(Akonadi::Item::List)), this, SLOT(slotItemsReceived(Akonadi::Item::List)));
+    connect(job, SIGNAL(result(KJob*)), this, SLOT(slotFetchResult(KJob*)));
+}
+
+void DocumentsWindow::slotItemsReceived(const Akonadi::Item::List &items)
+{
+    foreach (const Akonadi::Item &item, items) {
+        if (item.hasPayload<SugarDocument>()) {
+            addDocument(item.payload<SugarDocument>());
+        }
+    }
+}
+
+void DocumentsWindow::slotFetchResult(KJob *job)
+{
+    if (job->error())
+        qWarning() << "Unable to fetch the documents:" << job->errorString();
 }
 
 void DocumentsWindow::closeEvent(QCloseEvent *event)
@@ -227,11 +273,20 @@ void DocumentsWindow::urlClicked(const QString &url)
 {
     const QString documentRevisionId = QUrl(url).path().mid(1); // strip leading '/' from path
 
-    ComKdabSugarCRMItemTransferInterface transferInterface(QLatin1String("org.freedesktop.Akonadi.Resource.") + mResourceIdentifier, QLatin1String("/ItemTransfer"), QDBusConnection::sessionBus());
+    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(mTransferInterface->downloadDocumentRevision(documentRevisionId), this);
+    watcher->setProperty("documentRevisionId", documentRevisionId);
+    connect(watcher, SIGNAL(finished(QDBusPendingCallWatcher*)), this, SLOT(slotDownloadFinished(QDBusPendingCallWatcher*)));
+}
 
-    QDBusPendingReply<QString> reply = transferInterface.downloadDocumentRevision(documentRevisionId);
-    reply.waitForFinished();
+void DocumentsWindow::slotDownloadFinished(QDBusPendingCallWatcher *watcher)
+{
+    watcher->deleteLater();
+
+    DocumentWidget *widget = widgetForTransfer(watcher->property("documentRevisionId").toString());
+    if (widget)
+        widget->setTransferProgress(-1);
 
+    const QDBusPendingReply<QString> reply = *watcher;
     if (reply.isValid()) {
 
         const QString filePath = reply.value();
@@ -239,7 +294,7 @@ void DocumentsWindow::urlClicked(const QString &url)
             const QUrl localFile = QUrl::fromLocalFile(filePath);
             const KMimeType::Ptr mimeType = KMimeType::findByUrl(localFile);
 
-            KRun::runUrl(localFile, mimeType ? mimeType->name() : QString(), this, true, false);
+            KRun::runUrl(localFile, mimeType ? mimeType->name() : QString(), this, false, false);
 
             return;
         }
@@ -248,6 +303,23 @@ void DocumentsWindow::urlClicked(const QString &url)
     QMessageBox::warning(this, i18n("Unable to download Document"), i18n("Could not download the document, make sure the resource is online."));
 }
 
+void DocumentsWindow::slotTransferProgress(const QString &transfer, int percent)
+{
+    DocumentWidget *widget = widgetForTransfer(transfer);
+    if (widget)
+        widget->setTransferProgress(percent);
+}
+
+DocumentWidget *DocumentsWindow::widgetForTransfer(const QString &transfer) const
+{
+    // downloads are identified by revision id, uploads by file path
+    foreach (DocumentWidget *widget, mDocumentWidgets) {
+        if (widget->document().documentRevisionId() == transfer || widget->newDocumentFilePath() == transfer)
+            return widget;
+    }
+    return nullptr;
+}
+
 void DocumentsWindow::deleteDocument()
 {
     DocumentWidget *widget = qobject_cast<DocumentWidget*>(sender());
@@ -295,6 +367,46 @@ void DocumentsWindow::slotJobResult(KJob *job)
     if (job->error())
         qWarning() << job->errorString();
 
+    pendingJobDone();
+}
+
+void DocumentsWindow::slotUploadFinished(QDBusPendingCallWatcher *watcher)
+{
+    watcher->deleteLater();
+
+    const QDBusPendingReply<QString> uploadReply = *watcher;
+    const QString documentId = uploadReply.isValid() ? uploadReply.value() : QString();
+    if (documentId.isEmpty()) {
+        qWarning() << "Unable to upload new document";
+        pendingJobDone();
+        return;
+    }
+
+    // link created instance to currently loaded Account/Opportunity
+    const QString linkedItemModuleName = (mLinkedItemType == Account ? "Accounts" : "Opportunities");
+
+    QDBusPendingCallWatcher *linkWatcher = new QDBusPendingCallWatcher(mTransferInterface->linkItem(documentId, "Documents", mLinkedItemId, linkedItemModuleName), this);
+    linkWatcher->setProperty("documentId", documentId);
+    connect(linkWatcher, SIGNAL(finished(QDBusPendingCallWatcher*)), this, SLOT(slotLinkFinished(QDBusPendingCallWatcher*)));
+}
+
+void DocumentsWindow::slotLinkFinished(QDBusPendingCallWatcher *watcher)
+{
+    watcher->deleteLater();
+
+    const QString documentId = watcher->property("documentId").toString();
+    const QDBusPendingReply<bool> linkReply = *watcher;
+    if (linkReply.isError()) {
+        qWarning() << "Unable to link document" << documentId << ":" << linkReply.error().message();
+    } else if (!linkReply.value()) {
+        qWarning() << "Unable to link document" << documentId << ", see resource logs for details";
+    }
+
+    pendingJobDone();
+}
+
+void DocumentsWindow::pendingJobDone()
+{
     --mPendingJobCount;
 
     if (mPendingJobCount == 0) {
@@ -361,35 +473,12 @@ void DocumentsWindow::saveChanges()
             const SugarDocument document = widget->document();
             const SugarDocument modifiedDocument = widget->modifiedDocument();
             if (document.id().startsWith(QLatin1String("__temp"))) {
-                ComKdabSugarCRMItemTransferInterface transferInterface(QLatin1String("org.freedesktop.Akonadi.Resource.") + mResourceIdentifier, QLatin1String("/ItemTransfer"), QDBusConnection::sessionBus());
-
-                // create new document instance
-                QDBusPendingReply<QString> uploadReply = transferInterface.uploadDocument(modifiedDocument.documentName(), modifiedDocument.statusId(),
-                                                                                          modifiedDocument.description(), widget->newDocumentFilePath());
-                uploadReply.waitForFinished();
-
-                const QString documentId = uploadReply.value();
-                if (documentId.isEmpty()) {
-                    qWarning() << "Unable to upload new document";
-                    continue;
-                }
-
-                // link created instance to currently loaded Account/Opportunity
-                const QString linkedItemModuleName = (mLinkedItemType == Account ? "Accounts" : "Opportunities");
-
-                QDBusPendingReply<bool> linkReply = transferInterface.linkItem(documentId, "Documents", mLinkedItemId, linkedItemModuleName);
-                linkReply.waitForFinished();
-                if (linkReply.isError()) {
-                    qWarning() << "Unable to link document" << documentId << ":" << linkReply.error().message();
-                    continue;
-                }
-
-                const bool ok = linkReply.value();
-                if (!ok) {
-                    qWarning() << "Unable to link document" << documentId << ", see resource logs for details";
-                    continue;
-                }
+                // create new document instance, then link it, see slotUploadFinished
+                QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(mTransferInterface->uploadDocument(modifiedDocument.documentName(), modifiedDocument.statusId(),
+                                                                                                              modifiedDocument.description(), widget->newDocumentFilePath()), this);
+                connect(watcher, SIGNAL(finished(QDBusPendingCallWatcher*)), this, SLOT(slotUploadFinished(QDBusPendingCallWatcher*)));
 
+                ++mPendingJobCount;
             } else {
                 Akonadi::Item item = mLinkedItemsRepository->documentItem(document.id());
                 if (item.isValid()) {
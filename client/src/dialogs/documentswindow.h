@@ -24,17 +24,22 @@
 #include "kdcrmdata/enumdefinitions.h"
 #include "kdcrmdata/sugardocument.h"
 
+#include <Akonadi/Item>
+
 #include <QWidget>
 
 namespace Ui {
 class DocumentsWindow;
 }
 
+class ComKdabSugarCRMItemTransferInterface;
 class KJob;
 class LinkedItemsRepository;
 class QComboBox;
+class QDBusPendingCallWatcher;
 class QLabel;
 class QPlainTextEdit;
+class QProgressBar;
 class QPushButton;
 class QUrl;
 
@@ -55,6 +60,9 @@ public:
 
     bool isModified() const;
 
+    // Shows the progress of a download or upload, hidden if percent is -1
+    void setTransferProgress(int percent);
+
 signals:
     void urlClicked(const QString &url);
     void deleteDocument();
@@ -62,6 +70,7 @@ signals:
 private:
     QLabel *mNameLabel;
     QComboBox *mStatusBox;
+    QProgressBar *mProgressBar;
     QPlainTextEdit *mDescriptionEdit;
     QPushButton *mDeleteButton;
 
@@ -102,12 +111,21 @@ private slots:
     void attachDocument();
 
     void slotJobResult(KJob *job);
+    void slotDownloadFinished(QDBusPendingCallWatcher *watcher);
+    void slotUploadFinished(QDBusPendingCallWatcher *watcher);
+    void slotLinkFinished(QDBusPendingCallWatcher *watcher);
+    void slotTransferProgress(const QString &transfer, int percent);
+    void slotItemsReceived(const Akonadi::Item::List &items);
+    void slotFetchResult(KJob *job);
 
 private:
     DocumentWidget* addDocument(const SugarDocument &document);
 
+    DocumentWidget *widgetForTransfer(const QString &transfer) const;
+
     bool isModified() const;
     void saveChanges();
+    void pendingJobDone();
 
 private:
     QVector<SugarDocument> mDocuments;
@@ -115,6 +133,7 @@ private:
 
     Ui::DocumentsWindow *ui;
     QString mResourceIdentifier;
+    ComKdabSugarCRMItemTransferInterface *mTransferInterface;
     LinkedItemsRepository *mLinkedItemsRepository;
     EnumDefinitions mEnumDefinitions;
     bool mIsNotModifiedOverride;
@@ -46,6 +46,8 @@ public:
     virtual Akonadi::Item item() const = 0;
     virtual QString title() const = 0;
     virtual QString detailsName() const = 0;
+    // Called when the item was modified elsewhere, e.g. by a sync
+    virtual void updateItem(const Akonadi::Item &item) = 0;
 
 Q_SIGNALS:
     void itemSaved();
@@ -33,6 +33,9 @@
 
 #include <Akonadi/Item>
 #include <Akonadi/ItemCreateJob>
+#include <Akonadi/ItemFetchJob>
+
+#include <KDebug>
 
 NotesWindow::NotesWindow(QWidget *parent) :
     QWidget(parent),
@@ -68,6 +71,47 @@ void NotesWindow::setLinkedTo(const QString &id, DetailsType itemType)
     mLinkedItemType = itemType;
 }
 
+void NotesWindow::loadNotes()
+{
+    Q_ASSERT(mLinkedItemsRepository);
+
+    QVector<SugarNote> notes;
+    QVector<SugarEmail> emails;
+    switch (mLinkedItemType) {
+    case Account:
+        notes = mLinkedItemsRepository->notesForAccount(mLinkedItemId);
+        emails = mLinkedItemsRepository->emailsForAccount(mLinkedItemId);
+        break;
+    case Contact:
+        notes = mLinkedItemsRepository->notesForContact(mLinkedItemId);
+        emails = mLinkedItemsRepository->emailsForContact(mLinkedItemId);
+        break;
+    case Opportunity:
+        notes = mLinkedItemsRepository->notesForOpportunity(mLinkedItemId);
+        emails = mLinkedItemsRepository->emailsForOpportunity(mLinkedItemId);
+        break;
+    default:
+        break;
+    }
+    kDebug() << notes.count() << "notes and" << emails.count() << "emails found for" << typeToString(mLinkedItemType) << mLinkedItemId;
+
+    // The repository only has the subjects, fetch the text
+    QStringList ids;
+    ids.reserve(notes.count() + emails.count());
+    foreach (const SugarNote &note, notes) {
+        ids.append(note.id());
+    }
+    foreach (const SugarEmail &email, emails) {
+        ids.append(email.id());
+    }
+    if (ids.isEmpty())
+        return;
+
+    Akonadi::ItemFetchJob *job = mLinkedItemsRepository->fetchFullItems(ids, this);
+    connect(job, SIGNAL(itemsReceived(Akonadi::Item::List)), this, SLOT(slotItemsReceived(Akonadi::Item::List)));
+    connect(job, SIGNAL(result(KJob*)), this, SLOT(slotFetchResult(KJob*)));
+}
+
 void NotesWindow::addNote(const SugarNote &note)
 {
     const QDateTime modified = KDCRMUtils::dateTimeFromString(note.dateModified());
@@ -97,6 +141,13 @@ void NotesWindow::addEmail(const SugarEmail &email)
 }
 
 void NotesWindow::setVisible(bool visible)
+{
+    fillTextEdit();
+    QWidget::setVisible(visible);
+    ui->textEdit->verticalScrollBar()->setValue(0);
+}
+
+void NotesWindow::fillTextEdit()
 {
     if (ui->textEdit->document()->isEmpty()) {
         qSort(m_notes);
@@ -116,8 +167,6 @@ void NotesWindow::setVisible(bool visible)
                 cursor.insertText(note.text());
         }
     }
-    QWidget::setVisible(visible);
-    ui->textEdit->verticalScrollBar()->setValue(0);
 }
 
 void NotesWindow::closeEvent(QCloseEvent *event)
@@ -197,3 +246,23 @@ void NotesWindow::slotJobResult(KJob *job)
     mIsNotModifiedOverride = true;
     QWidget::close();
 }
+
+void NotesWindow::slotItemsReceived(const Akonadi::Item::List &items)
+{
+    foreach (const Akonadi::Item &item, items) {
+        if (item.hasPayload<SugarNote>()) {
+            addNote(item.payload<SugarNote>());
+        } else if (item.hasPayload<SugarEmail>()) {
+            addEmail(item.payload<SugarEmail>());
+        }
+    }
+}
+
+void NotesWindow::slotFetchResult(KJob *job)
+{
+    if (job->error())
+        qWarning() << job->errorString();
+
+    fillTextEdit();
+    ui->textEdit->verticalScrollBar()->setValue(0);
+}
@@ -25,6 +25,8 @@
 #include <QDateTime>
 #include "enums.h"
 
+#include <Akonadi/Item>
+
 namespace Ui {
 class NotesWindow;
 }
@@ -69,6 +71,8 @@ public:
     void setLinkedItemsRepository(LinkedItemsRepository *repository);
 
     void setLinkedTo(const QString &id, DetailsType itemType);
+    // Fetches the full notes and emails linked to the item given to setLinkedTo, and shows them
+    void loadNotes();
 
     void addNote(const SugarNote &note);
     void addEmail(const SugarEmail &email);
@@ -84,10 +88,13 @@ private slots:
     void on_buttonBox_accepted();
 
     void slotJobResult(KJob *job);
+    void slotItemsReceived(const Akonadi::Item::List &items);
+    void slotFetchResult(KJob *job);
 
 private:
     bool isModified() const;
     void saveChanges();
+    void fillTextEdit();
 
     QVector<NoteText> m_notes;
     Ui::NotesWindow *ui;
@@ -55,7 +55,7 @@ public:
 
 public Q_SLOTS:
     void setItem(const Akonadi::Item &item);
-    void updateItem(const Akonadi::Item &item);
+    void updateItem(const Akonadi::Item &item) override;
     void setOnline(bool online);
     void accept() override;
 
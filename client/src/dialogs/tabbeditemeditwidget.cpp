@@ -104,6 +104,11 @@ QString TabbedItemEditWidget::detailsName() const
     return mItemEditWidget->detailsName();
 }
 
+void TabbedItemEditWidget::updateItem(const Akonadi::Item &item)
+{
+    mItemEditWidget->updateItem(item);
+}
+
 void TabbedItemEditWidget::initialize()
 {
     if (mType == Opportunity) {
@@ -47,6 +47,7 @@ public:
     bool isModified() const override;
     QString title() const override;
     QString detailsName() const override;
+    void updateItem(const Akonadi::Item &item) override;
 
 private Q_SLOTS:
     void openWidget(const QString &itemKey);
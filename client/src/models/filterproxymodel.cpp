@@ -23,6 +23,7 @@
 #include "filterproxymodel.h"
 #include "itemstreemodel.h"
 
+#include "kdcrmdata/kdcrmsearchpattern.h"
 #include "kdcrmdata/sugaraccount.h"
 #include "kdcrmdata/sugarcampaign.h"
 #include "kdcrmdata/sugarlead.h"
@@ -34,14 +35,13 @@
 
 #include <KLocalizedString>
 
-static bool accountMatchesFilter(const SugarAccount &account,
-                                 const QString &filterString);
-static bool campaignMatchesFilter(const SugarCampaign &campaign,
-                                  const QString &filterString);
-static bool contactMatchesFilter(const KABC::Addressee &addressee,
-                                 const QString &filterString);
-static bool leadMatchesFilter(const SugarLead &lead,
-                              const QString &filterString);
+#include <QHash>
+#include <QSet>
+
+static QString accountSearchText(const SugarAccount &account);
+static QString campaignSearchText(const SugarCampaign &campaign);
+static QString contactSearchText(const KABC::Addressee &addressee);
+static QString leadSearchText(const SugarLead &lead);
 
 using namespace Akonadi;
 
@@ -53,6 +53,18 @@ public:
     {}
     DetailsType mType;
     QString mFilter;
+    KDCRMSearchPattern mPattern;
+    // case-folded searchText() of each item, built on first use
+    mutable QHash<Item::Id, QString> mSearchIndex;
+    // items which don't contain mFilter; they can't contain a longer filter either,
+    // so when the user types one more character, only the other items are searched again
+    mutable QSet<Item::Id> mRejectedIds;
+
+    void forgetItem(Item::Id id)
+    {
+        mSearchIndex.remove(id);
+        mRejectedIds.remove(id);
+    }
 };
 
 FilterProxyModel::FilterProxyModel(DetailsType type, QObject *parent)
@@ -80,9 +92,39 @@ QString FilterProxyModel::filterDescription() const
     return QString();
 }
 
+void FilterProxyModel::setSourceModel(QAbstractItemModel *model)
+{
+    if (sourceModel()) {
+        disconnect(sourceModel(), SIGNAL(dataChanged(QModelIndex,QModelIndex)),
+                   this, SLOT(slotSourceDataChanged(QModelIndex,QModelIndex)));
+        disconnect(sourceModel(), SIGNAL(rowsAboutToBeRemoved(QModelIndex,int,int)),
+                   this, SLOT(slotSourceRowsAboutToBeRemoved(QModelIndex,int,int)));
+        disconnect(sourceModel(), SIGNAL(modelAboutToBeReset()),
+                   this, SLOT(slotSourceModelAboutToBeReset()));
+    }
+    d->mSearchIndex.clear();
+    d->mRejectedIds.clear();
+    // Connected before QSortFilterProxyModel's own connections, so that the index
+    // is up to date when changed rows are filtered again
+    if (model) {
+        connect(model, SIGNAL(dataChanged(QModelIndex,QModelIndex)),
+                this, SLOT(slotSourceDataChanged(QModelIndex,QModelIndex)));
+        connect(model, SIGNAL(rowsAboutToBeRemoved(QModelIndex,int,int)),
+                this, SLOT(slotSourceRowsAboutToBeRemoved(QModelIndex,int,int)));
+        connect(model, SIGNAL(modelAboutToBeReset()),
+                this, SLOT(slotSourceModelAboutToBeReset()));
+    }
+    QSortFilterProxyModel::setSourceModel(model);
+}
+
 void FilterProxyModel::setFilterString(const QString &filter)
 {
+    const KDCRMSearchPattern pattern(filter);
+    if (!pattern.foldedPattern().contains(d->mPattern.foldedPattern())) {
+        d->mRejectedIds.clear();
+    }
     d->mFilter = filter;
+    d->mPattern = pattern;
     invalidateFilter();
 }
 
@@ -91,131 +133,139 @@ bool FilterProxyModel::filterAcceptsRow(int row, const QModelIndex &parent) cons
     if (d->mFilter.isEmpty()) {
         return true;
     }
-    const QModelIndex index = sourceModel()->index(row, 0, parent);
-    const Akonadi::Item item =
-        index.data(Akonadi::EntityTreeModel::ItemRole).value<Akonadi::Item>();
-
-    switch (d->mType) {
-    case Account: {
-        Q_ASSERT(item.hasPayload<SugarAccount>());
-        const SugarAccount account = item.payload<SugarAccount>();
-        return accountMatchesFilter(account, d->mFilter);
-    }
-    case Campaign: {
-        Q_ASSERT(item.hasPayload<SugarCampaign>());
-        const SugarCampaign campaign = item.payload<SugarCampaign>();
-        return campaignMatchesFilter(campaign, d->mFilter);
-    }
-    case Contact: {
-        Q_ASSERT(item.hasPayload<KABC::Addressee>());
-        const KABC::Addressee contact = item.payload<KABC::Addressee>();
-        return contactMatchesFilter(contact, d->mFilter);
-    }
-    case Lead: {
-        Q_ASSERT(item.hasPayload<SugarLead>());
-        const SugarLead lead = item.payload<SugarLead>();
-        return leadMatchesFilter(lead, d->mFilter);
-    }
-    case Opportunity: // notreached, handled by subclass
+    if (d->mType == Opportunity) { // notreached, handled by subclass
         return false;
     }
-    return true;
+    return matchesFilterString(row, parent);
 }
 
-static bool accountMatchesFilter(const SugarAccount &account, const QString &filter)
+bool FilterProxyModel::matchesFilterString(int row, const QModelIndex &parent) const
 {
-    if (account.name().contains(filter, Qt::CaseInsensitive)) {
-        return true;
-    }
-    if (account.billingAddressCity().contains(filter, Qt::CaseInsensitive) ||
-            account.shippingAddressCity().contains(filter, Qt::CaseInsensitive) ||
-            account.billingAddressStreet().contains(filter, Qt::CaseInsensitive) ||
-            account.shippingAddressStreet().contains(filter, Qt::CaseInsensitive)) {
+    if (d->mFilter.isEmpty()) {
         return true;
     }
-    if (account.email1().contains(filter, Qt::CaseInsensitive)) {
-        return true;
+    const QModelIndex index = sourceModel()->index(row, 0, parent);
+    const Item::Id id = index.data(EntityTreeModel::ItemIdRole).toLongLong();
+    if (d->mRejectedIds.contains(id)) {
+        return false;
     }
-    if (account.billingAddressCountry().contains(filter, Qt::CaseInsensitive)) {
-        return true;
+    QHash<Item::Id, QString>::const_iterator it = d->mSearchIndex.constFind(id);
+    if (it == d->mSearchIndex.constEnd()) {
+        const Item item = index.data(EntityTreeModel::ItemRole).value<Item>();
+        it = d->mSearchIndex.insert(id, searchText(item).toCaseFolded());
     }
-    if (account.phoneOffice().contains(filter, Qt::CaseInsensitive)) {
+    if (d->mPattern.matchesFolded(*it)) {
         return true;
     }
-
+    d->mRejectedIds.insert(id);
     return false;
 }
 
-static bool campaignMatchesFilter(const SugarCampaign &campaign, const QString &filter)
+QString FilterProxyModel::searchText(const Item &item) const
 {
-    if (campaign.name().contains(filter, Qt::CaseInsensitive)) {
-        return true;
-    }
-    if (campaign.status().contains(filter, Qt::CaseInsensitive)) {
-        return true;
-    }
-    if (campaign.campaignType().contains(filter, Qt::CaseInsensitive)) {
-        return true;
-    }
-    if (campaign.endDate().contains(filter, Qt::CaseInsensitive)) {
-        return true;
-    }
-    if (campaign.assignedUserName().contains(filter, Qt::CaseInsensitive)) {
-        return true;
+    switch (d->mType) {
+    case Account:
+        Q_ASSERT(item.hasPayload<SugarAccount>());
+        return accountSearchText(item.payload<SugarAccount>());
+    case Campaign:
+        Q_ASSERT(item.hasPayload<SugarCampaign>());
+        return campaignSearchText(item.payload<SugarCampaign>());
+    case Contact:
+        Q_ASSERT(item.hasPayload<KABC::Addressee>());
+        return contactSearchText(item.payload<KABC::Addressee>());
+    case Lead:
+        Q_ASSERT(item.hasPayload<SugarLead>());
+        return leadSearchText(item.payload<SugarLead>());
+    case Opportunity: // notreached, handled by subclass
+        break;
     }
+    return QString();
+}
 
-    return false;
+void FilterProxyModel::forgetSearchText(qint64 itemId)
+{
+    d->forgetItem(itemId);
 }
 
-static bool contactMatchesFilter(const KABC::Addressee& contact, const QString &filter)
+void FilterProxyModel::slotSourceDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight)
 {
-    if (contact.assembledName().contains(filter, Qt::CaseInsensitive)) {
-        return true;
-    }
-    if (contact.organization().contains(filter, Qt::CaseInsensitive)) {
-        return true;
-    }
-    if (contact.preferredEmail().contains(filter, Qt::CaseInsensitive)) {
-        return true;
-    }
-    if (contact.phoneNumber(KABC::PhoneNumber::Work).number().contains(filter, Qt::CaseInsensitive)) {
-        return true;
-    }
-    if (contact.phoneNumber(KABC::PhoneNumber::Cell).number().contains(filter, Qt::CaseInsensitive)) {
-        return true;
+    if (d->mSearchIndex.isEmpty() && d->mRejectedIds.isEmpty())
+        return;
+    const QModelIndex parent = topLeft.parent();
+    if (topLeft.row() == 0 && bottomRight.row() == sourceModel()->rowCount(parent) - 1) {
+        // e.g. all account names changed, cheaper to start over
+        d->mSearchIndex.clear();
+        d->mRejectedIds.clear();
+        return;
     }
-    if (contact.givenName().contains(filter, Qt::CaseInsensitive)) {
-        return true;
+    for (int row = topLeft.row(); row <= bottomRight.row(); ++row) {
+        d->forgetItem(sourceModel()->index(row, 0, parent).data(EntityTreeModel::ItemIdRole).toLongLong());
     }
-    if (ItemsTreeModel::countryForContact(contact).contains(filter, Qt::CaseInsensitive)) {
-        return true;
+}
+
+void FilterProxyModel::slotSourceRowsAboutToBeRemoved(const QModelIndex &parent, int start, int end)
+{
+    if (d->mSearchIndex.isEmpty() && d->mRejectedIds.isEmpty())
+        return;
+    for (int row = start; row <= end; ++row) {
+        d->forgetItem(sourceModel()->index(row, 0, parent).data(EntityTreeModel::ItemIdRole).toLongLong());
     }
+}
 
-    return false;
+void FilterProxyModel::slotSourceModelAboutToBeReset()
+{
+    d->mSearchIndex.clear();
+    d->mRejectedIds.clear();
 }
 
-static bool leadMatchesFilter(const SugarLead &lead, const QString &filter)
+static QString accountSearchText(const SugarAccount &account)
 {
-    if (lead.firstName().contains(filter, Qt::CaseInsensitive)) {
-        return true;
-    }
-    if (lead.lastName().contains(filter, Qt::CaseInsensitive)) {
-        return true;
-    }
-    if (lead.status().contains(filter, Qt::CaseInsensitive)) {
-        return true;
-    }
-    if (lead.accountName().contains(filter, Qt::CaseInsensitive)) {
-        return true;
-    }
-    if (lead.email1().contains(filter, Qt::CaseInsensitive)) {
-        return true;
-    }
-    if (lead.assignedUserName().contains(filter, Qt::CaseInsensitive)) {
-        return true;
-    }
+    return (QStringList()
+            << account.name()
+            << account.billingAddressCity()
+            << account.shippingAddressCity()
+            << account.billingAddressStreet()
+            << account.shippingAddressStreet()
+            << account.email1()
+            << account.billingAddressCountry()
+            << account.phoneOffice()
+            ).join(QLatin1String("\n"));
+}
 
-    return false;
+static QString campaignSearchText(const SugarCampaign &campaign)
+{
+    return (QStringList()
+            << campaign.name()
+            << campaign.status()
+            << campaign.campaignType()
+            << campaign.endDate()
+            << campaign.assignedUserName()
+            ).join(QLatin1String("\n"));
+}
+
+static QString contactSearchText(const KABC::Addressee &contact)
+{
+    return (QStringList()
+            << contact.assembledName()
+            << contact.organization()
+            << contact.preferredEmail()
+            << contact.phoneNumber(KABC::PhoneNumber::Work).number()
+            << contact.phoneNumber(KABC::PhoneNumber::Cell).number()
+            << contact.givenName()
+            << ItemsTreeModel::countryForContact(contact)
+            ).join(QLatin1String("\n"));
+}
+
+static QString leadSearchText(const SugarLead &lead)
+{
+    return (QStringList()
+            << lead.firstName()
+            << lead.lastName()
+            << lead.status()
+            << lead.accountName()
+            << lead.email1()
+            << lead.assignedUserName()
+            ).join(QLatin1String("\n"));
 }
 
 #include "filterproxymodel.moc"
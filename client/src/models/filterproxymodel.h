@@ -26,6 +26,11 @@
 #include <QtGui/QSortFilterProxyModel>
 #include "enums.h"
 
+namespace Akonadi
+{
+class Item;
+}
+
 /**
  * A proxy model for sugar tree models.
  *
@@ -60,6 +65,8 @@ public:
      */
     virtual QString filterDescription() const;
 
+    void setSourceModel(QAbstractItemModel *sourceModel) override;
+
 public Q_SLOTS:
     /**
      * Sets the filter that is used to filter for matching items
@@ -69,6 +76,29 @@ public Q_SLOTS:
 protected:
     virtual bool filterAcceptsRow(int row, const QModelIndex &parent) const;
 
+    /**
+     * Returns whether the item at @p row contains the filter string.
+     * The searchable text of each item is computed once and cached until the item changes.
+     */
+    bool matchesFilterString(int row, const QModelIndex &parent) const;
+
+    /**
+     * Returns the text searched by the filter string for the given item,
+     * one line per searchable field.
+     */
+    virtual QString searchText(const Akonadi::Item &item) const;
+
+    /**
+     * Drops the cached searchable text of the given item, e.g. when it includes
+     * data from another item which changed. Call invalidateFilter() afterwards.
+     */
+    void forgetSearchText(qint64 itemId);
+
+private Q_SLOTS:
+    void slotSourceDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight);
+    void slotSourceRowsAboutToBeRemoved(const QModelIndex &parent, int start, int end);
+    void slotSourceModelAboutToBeReset();
+
 private:
     class Private;
     Private *const d;
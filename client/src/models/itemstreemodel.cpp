@@ -37,22 +37,52 @@
 #include <KIcon>
 #include <KIconLoader>
 #include <KLocale>
+#include <QHash>
 #include <QMetaEnum>
 #include <QFont>
+#include <QSet>
+
+#include <algorithm>
 
 using namespace Akonadi;
 
+// What the views and proxies ask for an item, all computed from a single payload extraction
+// on first use, and dropped when the item changes
+struct ItemsTreeModel::CachedRow
+{
+    CachedRow() : hasToolTip(false) {}
+    QVector<QVariant> values; // two per column: DisplayRole, EditRole. Empty until computed.
+    QVariant font;
+    QVariant toolTip; // only computed on request
+    bool hasToolTip;
+};
+
 class ItemsTreeModel::Private
 {
 public:
     Private()
         : mColumns(),
-          mIconSize(KIconLoader::global()->currentSize(KIconLoader::Small))
+          mIconSize(KIconLoader::global()->currentSize(KIconLoader::Small)),
+          mAccountRowIndexDirty(false),
+          mEmittingAccountChanges(false)
     {
     }
 
     ItemsTreeModel::ColumnTypes mColumns;
     const int mIconSize;
+    QHash<Akonadi::Item::Id, CachedRow> mRowCache;
+
+    // The account of each row, and the reverse index used to find the rows showing an account.
+    // Rows are appended during loading; removals shift rows, so the reverse index is then
+    // rebuilt on next use rather than updated row by row.
+    QVector<QString> mAccountIdByRow;
+    QHash<QString, QVector<int> > mRowsByAccountId;
+    bool mAccountRowIndexDirty;
+
+    // Account changes not yet notified, emitted once per event loop iteration
+    QSet<QString> mChangedAccountIds;
+    QVector<int> mChangedAccountColumns;
+    bool mEmittingAccountChanges;
 };
 
 ItemsTreeModel::ItemsTreeModel(DetailsType type, ChangeRecorder *monitor, QObject *parent)
@@ -60,7 +90,17 @@ ItemsTreeModel::ItemsTreeModel(DetailsType type, ChangeRecorder *monitor, QObjec
 {
     d->mColumns = columnTypes(mType);
 
-    if (mType == Opportunity) {
+    // Connected first, so that the cache is up to date before the views and proxies are notified
+    connect(this, SIGNAL(dataChanged(QModelIndex,QModelIndex)),
+            this, SLOT(slotDataChanged(QModelIndex,QModelIndex)));
+    connect(this, SIGNAL(rowsInserted(QModelIndex,int,int)),
+            this, SLOT(slotRowsInserted(QModelIndex,int,int)));
+    connect(this, SIGNAL(rowsAboutToBeRemoved(QModelIndex,int,int)),
+            this, SLOT(slotRowsAboutToBeRemoved(QModelIndex,int,int)));
+    connect(this, SIGNAL(modelAboutToBeReset()),
+            this, SLOT(slotModelAboutToBeReset()));
+
+    if (mType == Opportunity || mType == Contact) {
         // Update accountName and country columns once all accounts are loaded
         connect(AccountRepository::instance(), SIGNAL(initialLoadingDone()),
                 this, SLOT(slotAccountsLoaded()));
@@ -89,36 +129,107 @@ ItemsTreeModel::ColumnTypes ItemsTreeModel::columnTypes() const
  */
 QVariant ItemsTreeModel::entityData(const Item &item, int column, int role) const
 {
-    // avoid calling item.payload() for all other roles
-    if (role == Qt::DisplayRole || role == Qt::EditRole || role == Qt::DecorationRole) {
-
-        if (mType == Account) {
-            return accountData(item, column, role);
-        } else if (mType == Campaign) {
-            return campaignData(item, column, role);
-        } else if (mType == Contact) {
-            return contactData(item, column, role);
-        } else if (mType == Lead) {
-            return leadData(item, column, role);
-        } else if (mType == Opportunity) {
-            return opportunityData(item, column, role);
+    // Sorting calls this O(n log n) times and painting once per cell and role, and the values can be
+    // costly to compute (payload extraction, date parsing, account lookups), so cache them
+    switch (role) {
+    case Qt::DisplayRole:
+    case Qt::EditRole: {
+        if (column < 0 || column >= d->mColumns.count())
+            break;
+        const CachedRow &row = cachedRow(item);
+        return row.values.at(column * 2 + (role == Qt::EditRole ? 1 : 0));
+    }
+    case Qt::DecorationRole:
+        return QVariant(); // no icons, avoid the payload extraction in EntityTreeModel
+    case Qt::FontRole:
+        if (mType == Opportunity) {
+            return cachedRow(item).font;
         }
-    } else if (role == Qt::ToolTipRole) {
-        if (ClientSettings::self()->showToolTips()) {
-            if (mType == Account) {
-                return accountToolTip(item);
-            } else if (mType == Opportunity) {
-                return opportunityToolTip(item);
-            }
+        break;
+    case Qt::ToolTipRole: {
+        if (!ClientSettings::self()->showToolTips() || (mType != Account && mType != Opportunity))
+            return QVariant();
+        CachedRow &row = d->mRowCache[item.id()];
+        if (!row.hasToolTip) {
+            row.toolTip = mType == Account ? accountToolTip(item) : opportunityToolTip(item);
+            row.hasToolTip = true;
         }
-        return QVariant();
-    } else if (mType == Opportunity && role == Qt::FontRole) {
-        return opportunityData(item, column, role);
+        return row.toolTip;
+    }
+    default:
+        break;
     }
-
     return EntityTreeModel::entityData(item, column, role);
 }
 
+ItemsTreeModel::CachedRow &ItemsTreeModel::cachedRow(const Item &item) const
+{
+    CachedRow &row = d->mRowCache[item.id()];
+    if (row.values.isEmpty()) {
+        fillRow(item, row);
+    }
+    return row;
+}
+
+template <typename T>
+void ItemsTreeModel::fillRowValues(const T &payload, QVariant (ItemsTreeModel::*data)(const T &, int, int) const,
+                                   QVector<QVariant> &values) const
+{
+    const int columns = d->mColumns.count();
+    values.resize(columns * 2);
+    for (int column = 0; column < columns; ++column) {
+        values[column * 2] = (this->*data)(payload, column, Qt::DisplayRole);
+        values[column * 2 + 1] = (this->*data)(payload, column, Qt::EditRole);
+    }
+}
+
+void ItemsTreeModel::fillRow(const Item &item, CachedRow &row) const
+{
+    switch (mType) {
+    case Account:
+        if (item.hasPayload<SugarAccount>()) {
+            fillRowValues(item.payload<SugarAccount>(), &ItemsTreeModel::accountData, row.values);
+            return;
+        }
+        break;
+    case Campaign:
+        if (item.hasPayload<SugarCampaign>()) {
+            fillRowValues(item.payload<SugarCampaign>(), &ItemsTreeModel::campaignData, row.values);
+            return;
+        }
+        break;
+    case Contact:
+        if (item.hasPayload<KABC::Addressee>()) {
+            fillRowValues(item.payload<KABC::Addressee>(), &ItemsTreeModel::contactData, row.values);
+            return;
+        }
+        break;
+    case Lead:
+        if (item.hasPayload<SugarLead>()) {
+            fillRowValues(item.payload<SugarLead>(), &ItemsTreeModel::leadData, row.values);
+            return;
+        }
+        break;
+    case Opportunity:
+        if (item.hasPayload<SugarOpportunity>()) {
+            const SugarOpportunity opportunity = item.payload<SugarOpportunity>();
+            fillRowValues(opportunity, &ItemsTreeModel::opportunityData, row.values);
+            row.font = opportunityFont(opportunity);
+            return;
+        }
+        break;
+    default:
+        break;
+    }
+
+    // Pass modeltest
+    const int columns = d->mColumns.count();
+    row.values.resize(columns * 2);
+    for (int column = 0; column < columns; ++column) {
+        row.values[column * 2] = item.remoteId();
+    }
+}
+
 /**
  * Reimp
  */
@@ -163,26 +274,62 @@ QString ItemsTreeModel::countryForContact(const KABC::Addressee &addressee)
 
 void ItemsTreeModel::slotAccountModified(const QString &accountId, const QVector<AccountRepository::Field> &changedFields)
 {
-    Q_UNUSED(accountId);
-    if (mType == Opportunity) {
-        // We could iterate over all opps to find those which use that account.... but maybe this is just faster:
-        const int rows = rowCount();
-        if (rows == 0)
-            return;
-        QVector<int> columns;
-        if (changedFields.contains(AccountRepository::Country)) {
-            columns.append(d->mColumns.indexOf(Country));
-        }
-        if (changedFields.contains(AccountRepository::Name)) {
-            columns.append(d->mColumns.indexOf(OpportunityAccountName));
+    QVector<int> columns;
+    if (changedFields.contains(AccountRepository::Country)) {
+        columns.append(d->mColumns.indexOf(Country));
+    }
+    if (changedFields.contains(AccountRepository::Name)) {
+        columns.append(d->mColumns.indexOf(OpportunityAccountName));
+        columns.append(d->mColumns.indexOf(Organization));
+    }
+    if (changedFields.contains(AccountRepository::Address) && mType == Opportunity) {
+        columns.append(d->mColumns.indexOf(PostalCode));
+        columns.append(d->mColumns.indexOf(City));
+    }
+    columns.removeAll(-1); // not a column of this type
+    if (columns.isEmpty())
+        return;
+    // An incremental sync modifies many accounts in a row, notify the rows using them all at once
+    if (d->mChangedAccountIds.isEmpty()) {
+        QMetaObject::invokeMethod(this, "slotEmitAccountChanges", Qt::QueuedConnection);
+    }
+    d->mChangedAccountIds.insert(accountId);
+    d->mChangedAccountColumns += columns;
+}
+
+void ItemsTreeModel::slotEmitAccountChanges()
+{
+    const QSet<QString> accountIds = d->mChangedAccountIds;
+    const QVector<int> columns = d->mChangedAccountColumns;
+    d->mChangedAccountIds.clear();
+    d->mChangedAccountColumns.clear();
+    if (columns.isEmpty())
+        return;
+
+    if (d->mAccountRowIndexDirty)
+        rebuildAccountRowIndex();
+    QVector<int> rows;
+    foreach (const QString &accountId, accountIds) {
+        rows += d->mRowsByAccountId.value(accountId);
+    }
+    if (rows.isEmpty())
+        return;
+    std::sort(rows.begin(), rows.end());
+
+    const int firstColumn = *std::min_element(columns.constBegin(), columns.constEnd());
+    const int lastColumn = *std::max_element(columns.constBegin(), columns.constEnd());
+    // One dataChanged per range of adjacent rows
+    d->mEmittingAccountChanges = true;
+    int i = 0;
+    while (i < rows.count()) {
+        const int firstRow = rows.at(i);
+        int lastRow = firstRow;
+        while (++i < rows.count() && rows.at(i) <= lastRow + 1) {
+            lastRow = rows.at(i);
         }
-        if (columns.isEmpty())
-            return;
-        const int firstColumn = *std::min_element(columns.constBegin(), columns.constEnd());
-        const int lastColumn = *std::max_element(columns.constBegin(), columns.constEnd());
-        kDebug() << "emit dataChanged" << 0 << firstColumn << rows-1 << lastColumn;
-        emit dataChanged(index(0, firstColumn), index(rows - 1, lastColumn));
+        emit dataChanged(index(firstRow, firstColumn), index(lastRow, lastColumn));
     }
+    d->mEmittingAccountChanges = false;
 }
 
 // Called when the accounts have just been loaded
@@ -190,15 +337,126 @@ void ItemsTreeModel::slotAccountModified(const QString &accountId, const QVector
 // (i.e. due to queued jobs in the resource)
 void ItemsTreeModel::slotAccountsLoaded()
 {
+    emitColumnsChanged(QVector<int>() << d->mColumns.indexOf(Country) << d->mColumns.indexOf(OpportunityAccountName)
+                       << d->mColumns.indexOf(Organization));
+}
+
+void ItemsTreeModel::emitColumnsChanged(QVector<int> columns)
+{
+    columns.removeAll(-1); // not a column of this type
     const int rows = rowCount();
-    if (rows > 0) {
-        const int columnCountry = d->mColumns.indexOf(Country);
-        const int columnAccountName = d->mColumns.indexOf(OpportunityAccountName);
-        const int firstColumn = qMin(columnCountry, columnAccountName);
-        const int lastColumn = qMax(columnCountry, columnAccountName);
-        kDebug() << "emit dataChanged" << 0 << firstColumn << rows-1 << lastColumn;
-        emit dataChanged(index(0, firstColumn), index(rows - 1, lastColumn));
+    if (rows == 0 || columns.isEmpty())
+        return;
+    const int firstColumn = *std::min_element(columns.constBegin(), columns.constEnd());
+    const int lastColumn = *std::max_element(columns.constBegin(), columns.constEnd());
+    kDebug() << "emit dataChanged" << 0 << firstColumn << rows-1 << lastColumn;
+    d->mEmittingAccountChanges = true;
+    emit dataChanged(index(0, firstColumn), index(rows - 1, lastColumn));
+    d->mEmittingAccountChanges = false;
+}
+
+bool ItemsTreeModel::hasAccountRowIndex() const
+{
+    return mType == Opportunity || mType == Contact;
+}
+
+QString ItemsTreeModel::accountIdForRow(int row) const
+{
+    const Item item = index(row, 0).data(EntityTreeModel::ItemRole).value<Item>();
+    if (mType == Opportunity && item.hasPayload<SugarOpportunity>()) {
+        return item.payload<SugarOpportunity>().accountId();
+    } else if (mType == Contact && item.hasPayload<KABC::Addressee>()) {
+        return item.payload<KABC::Addressee>().custom("FATCRM", "X-AccountId");
     }
+    return QString();
+}
+
+// An item was modified, it might now be linked to another account
+void ItemsTreeModel::updateAccountIds(int start, int end)
+{
+    end = qMin(end, d->mAccountIdByRow.count() - 1);
+    for (int row = start; row <= end; ++row) {
+        const QString accountId = accountIdForRow(row);
+        QString &oldAccountId = d->mAccountIdByRow[row];
+        if (accountId == oldAccountId)
+            continue;
+        if (!d->mAccountRowIndexDirty) {
+            QHash<QString, QVector<int> >::iterator it = d->mRowsByAccountId.find(oldAccountId);
+            if (it != d->mRowsByAccountId.end()) {
+                it->remove(it->indexOf(row));
+                if (it->isEmpty())
+                    d->mRowsByAccountId.erase(it);
+            }
+            if (!accountId.isEmpty())
+                d->mRowsByAccountId[accountId].append(row);
+        }
+        oldAccountId = accountId;
+    }
+}
+
+void ItemsTreeModel::rebuildAccountRowIndex()
+{
+    d->mRowsByAccountId.clear();
+    for (int row = 0; row < d->mAccountIdByRow.count(); ++row) {
+        const QString &accountId = d->mAccountIdByRow.at(row);
+        if (!accountId.isEmpty())
+            d->mRowsByAccountId[accountId].append(row);
+    }
+    d->mAccountRowIndexDirty = false;
+}
+
+void ItemsTreeModel::slotDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight)
+{
+    if (hasAccountRowIndex() && !d->mEmittingAccountChanges && !topLeft.parent().isValid()) {
+        updateAccountIds(topLeft.row(), bottomRight.row());
+    }
+    if (d->mRowCache.isEmpty())
+        return;
+    const QModelIndex parent = topLeft.parent();
+    if (topLeft.row() == 0 && bottomRight.row() == rowCount(parent) - 1) {
+        d->mRowCache.clear();
+        return;
+    }
+    for (int row = topLeft.row(); row <= bottomRight.row(); ++row) {
+        d->mRowCache.remove(index(row, 0, parent).data(EntityTreeModel::ItemIdRole).toLongLong());
+    }
+}
+
+void ItemsTreeModel::slotRowsInserted(const QModelIndex &parent, int start, int end)
+{
+    if (!hasAccountRowIndex() || parent.isValid() || start > d->mAccountIdByRow.count())
+        return;
+    const bool appended = start == d->mAccountIdByRow.count();
+    d->mAccountIdByRow.insert(start, end - start + 1, QString());
+    for (int row = start; row <= end; ++row) {
+        const QString accountId = accountIdForRow(row);
+        d->mAccountIdByRow[row] = accountId;
+        if (appended && !d->mAccountRowIndexDirty && !accountId.isEmpty())
+            d->mRowsByAccountId[accountId].append(row);
+    }
+    if (!appended)
+        d->mAccountRowIndexDirty = true; // the following rows moved
+}
+
+void ItemsTreeModel::slotRowsAboutToBeRemoved(const QModelIndex &parent, int start, int end)
+{
+    if (hasAccountRowIndex() && !parent.isValid() && end < d->mAccountIdByRow.count()) {
+        d->mAccountIdByRow.remove(start, end - start + 1);
+        d->mAccountRowIndexDirty = true;
+    }
+    if (d->mRowCache.isEmpty())
+        return;
+    for (int row = start; row <= end; ++row) {
+        d->mRowCache.remove(index(row, 0, parent).data(EntityTreeModel::ItemIdRole).toLongLong());
+    }
+}
+
+void ItemsTreeModel::slotModelAboutToBeReset()
+{
+    d->mRowCache.clear();
+    d->mAccountIdByRow.clear();
+    d->mRowsByAccountId.clear();
+    d->mAccountRowIndexDirty = false;
 }
 
 /**
@@ -234,20 +492,10 @@ QVariant ItemsTreeModel::entityHeaderData(int section, Qt::Orientation orientati
 /**
  * Return the data. SugarAccount type
  */
-QVariant ItemsTreeModel::accountData(const Item &item, int column, int role) const
+QVariant ItemsTreeModel::accountData(const SugarAccount &account, int column, int role) const
 {
-    if (!item.hasPayload<SugarAccount>()) {
-        // Pass modeltest
-        if (role == Qt::DisplayRole) {
-            return item.remoteId();
-        }
-
-        return QVariant();
-    }
-    const SugarAccount account = item.payload<SugarAccount>();
-
     if ((role == Qt::DisplayRole) || (role == Qt::EditRole)) {
-        switch (columnTypes().at(column)) {
+        switch (d->mColumns.at(column)) {
         case Name:
             return account.name();
         case City:
@@ -272,22 +520,10 @@ QVariant ItemsTreeModel::accountData(const Item &item, int column, int role) con
 /**
  * Return the data. SugarCampaign type
  */
-QVariant ItemsTreeModel::campaignData(const Item &item, int column, int role) const
+QVariant ItemsTreeModel::campaignData(const SugarCampaign &campaign, int column, int role) const
 {
-    if (!item.hasPayload<SugarCampaign>()) {
-
-        // Pass modeltest
-        if (role == Qt::DisplayRole) {
-            return item.remoteId();
-        }
-
-        return QVariant();
-    }
-
-    const SugarCampaign campaign = item.payload<SugarCampaign>();
-
     if ((role == Qt::DisplayRole) || (role == Qt::EditRole)) {
-        switch (columnTypes().at(column)) {
+        switch (d->mColumns.at(column)) {
         case CampaignName:
             return campaign.name();
         case Status:
@@ -308,22 +544,10 @@ QVariant ItemsTreeModel::campaignData(const Item &item, int column, int role) co
 /**
  * Return the data. KABC::Addressee type - ref: Contacts
  */
-QVariant ItemsTreeModel::contactData(const Item &item, int column, int role) const
+QVariant ItemsTreeModel::contactData(const KABC::Addressee &addressee, int column, int role) const
 {
-    if (!item.hasPayload<KABC::Addressee>()) {
-
-        // Pass modeltest
-        if (role == Qt::DisplayRole) {
-            return item.remoteId();
-        }
-
-        return QVariant();
-    }
-
-    const KABC::Addressee addressee = item.payload<KABC::Addressee>();
-
     if ((role == Qt::DisplayRole) || (role == Qt::EditRole)) {
-        switch (columnTypes().at(column)) {
+        switch (d->mColumns.at(column)) {
         case FullName:
             return addressee.assembledName();
         case Title:
@@ -358,22 +582,10 @@ QVariant ItemsTreeModel::contactData(const Item &item, int column, int role) con
 /**
  * Return the data. SugarLead type
  */
-QVariant ItemsTreeModel::leadData(const Item &item, int column, int role) const
+QVariant ItemsTreeModel::leadData(const SugarLead &lead, int column, int role) const
 {
-    if (!item.hasPayload<SugarLead>()) {
-
-        // Pass modeltest
-        if (role == Qt::DisplayRole) {
-            return item.remoteId();
-        }
-
-        return QVariant();
-    }
-
-    const SugarLead lead = item.payload<SugarLead>();
-
     if ((role == Qt::DisplayRole) || (role == Qt::EditRole)) {
-        switch (columnTypes().at(column)) {
+        switch (d->mColumns.at(column)) {
         case LeadName:
             return lead.lastName();
         case LeadStatus:
@@ -394,22 +606,10 @@ QVariant ItemsTreeModel::leadData(const Item &item, int column, int role) const
 /**
  * Return the data. SugarOpportunity type
  */
-QVariant ItemsTreeModel::opportunityData(const Item &item, int column, int role) const
+QVariant ItemsTreeModel::opportunityData(const SugarOpportunity &opportunity, int column, int role) const
 {
-    if (!item.hasPayload<SugarOpportunity>()) {
-
-        // Pass modeltest
-        if (role == Qt::DisplayRole) {
-            return item.remoteId();
-        }
-
-        return QVariant();
-    }
-
-    const SugarOpportunity opportunity = item.payload<SugarOpportunity>();
-
     if ((role == Qt::DisplayRole) || (role == Qt::EditRole)) {
-        switch (columnTypes().at(column)) {
+        switch (d->mColumns.at(column)) {
         case OpportunityName:
             return opportunity.name();
         case OpportunityAccountName:
@@ -463,12 +663,15 @@ QVariant ItemsTreeModel::opportunityData(const Item &item, int column, int role)
             return QVariant();
         }
     }
-    if (role == Qt::FontRole) {
-        if (opportunity.customFields().value("urgent") == "1") {
-            QFont boldFont;
-            boldFont.setBold(true);
-            return boldFont;
-        }
+    return QVariant();
+}
+
+QVariant ItemsTreeModel::opportunityFont(const SugarOpportunity &opportunity) const
+{
+    if (opportunity.customFields().value("urgent") == "1") {
+        QFont boldFont;
+        boldFont.setBold(true);
+        return boldFont;
     }
     return QVariant();
 }
@@ -29,6 +29,9 @@
 #include <Akonadi/EntityTreeModel>
 
 namespace KABC { class Addressee; }
+class SugarCampaign;
+class SugarLead;
+class SugarOpportunity;
 
 /**
  * A model for sugar items.
@@ -119,13 +122,30 @@ public:
 private Q_SLOTS:
     void slotAccountModified(const QString &accountId, const QVector<AccountRepository::Field> &changedFields);
     void slotAccountsLoaded();
+    void slotEmitAccountChanges();
+    void slotDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight);
+    void slotRowsInserted(const QModelIndex &parent, int start, int end);
+    void slotRowsAboutToBeRemoved(const QModelIndex &parent, int start, int end);
+    void slotModelAboutToBeReset();
 
 private:
-    QVariant accountData(const Akonadi::Item &item, int column, int role) const;
-    QVariant campaignData(const Akonadi::Item &item, int column, int role) const;
-    QVariant contactData(const Akonadi::Item &item, int column, int role) const;
-    QVariant leadData(const Akonadi::Item &item, int column, int role) const;
-    QVariant opportunityData(const Akonadi::Item &item, int column, int role) const;
+    struct CachedRow;
+    CachedRow &cachedRow(const Akonadi::Item &item) const;
+    void fillRow(const Akonadi::Item &item, CachedRow &row) const;
+    template <typename T>
+    void fillRowValues(const T &payload, QVariant (ItemsTreeModel::*data)(const T &, int, int) const,
+                       QVector<QVariant> &values) const;
+    void emitColumnsChanged(QVector<int> columns);
+    bool hasAccountRowIndex() const;
+    QString accountIdForRow(int row) const;
+    void updateAccountIds(int start, int end);
+    void rebuildAccountRowIndex();
+    QVariant accountData(const SugarAccount &account, int column, int role) const;
+    QVariant campaignData(const SugarCampaign &campaign, int column, int role) const;
+    QVariant contactData(const KABC::Addressee &addressee, int column, int role) const;
+    QVariant leadData(const SugarLead &lead, int column, int role) const;
+    QVariant opportunityData(const SugarOpportunity &opportunity, int column, int role) const;
+    QVariant opportunityFont(const SugarOpportunity &opportunity) const;
     QVariant accountToolTip(const Akonadi::Item &item) const;
     QVariant opportunityToolTip(const Akonadi::Item &item) const;
     QString columnTitle(ColumnType col) const;
@@ -33,22 +33,126 @@
 #include <Akonadi/EntityTreeModel>
 
 #include <QDate>
+#include <QHash>
+#include <QSet>
 
 using namespace Akonadi;
 
+// OpportunityFilterSettings, compiled into what filterAcceptsRow() needs
+struct CompiledFilter
+{
+    CompiledFilter()
+        : filterCountries(false), otherCountries(false), showOpen(true), showClosed(false),
+          priorityFilter(AnyPriority)
+    {}
+
+    enum PriorityFilter {
+        AnyPriority,
+        NoPriority,
+        GivenPriority
+    };
+
+    QSet<QString> assignees; // no filtering if empty
+    bool filterCountries;
+    bool otherCountries; // only show countries which are in none of the groups
+    QSet<QString> countries; // case-folded; the countries of all groups if otherCountries is set
+    bool showOpen;
+    bool showClosed;
+    QDate maxDate;
+    QDate modifiedAfter;
+    QDate modifiedBefore;
+    PriorityFilter priorityFilter;
+    QString priority; // compared to the upper-cased priority of the opportunity
+};
+
+static CompiledFilter compileFilter(const OpportunityFilterSettings &settings)
+{
+    CompiledFilter filter;
+    filter.assignees = settings.assignees().toSet();
+
+    const QStringList countries = settings.countries();
+    filter.filterCountries = !countries.isEmpty();
+    filter.otherCountries = countries.contains(OpportunityFilterSettings::otherCountriesSpecialValue());
+    if (filter.otherCountries) {
+        // Special case: filtering for a country not in any of the defined groups
+        foreach (const ClientSettings::GroupFilters::Group &group, ClientSettings::self()->countryFilters().groups()) {
+            foreach (const QString &country, group.entries) {
+                filter.countries.insert(country.toCaseFolded());
+            }
+        }
+    } else {
+        // Standard filtering using a country group
+        foreach (const QString &country, countries) {
+            filter.countries.insert(country.toCaseFolded());
+        }
+    }
+
+    filter.showOpen = settings.showOpen();
+    filter.showClosed = settings.showClosed();
+    filter.maxDate = settings.maxDate();
+    filter.modifiedAfter = settings.modifiedAfter();
+    filter.modifiedBefore = settings.modifiedBefore();
+
+    const QString shownPriority = settings.shownPriority();
+    if (shownPriority == "-") {
+        filter.priorityFilter = CompiledFilter::AnyPriority;
+    } else if (shownPriority.isEmpty() || shownPriority == "Not set") { // "Not set" is much clearer to me than just a blank space (like the WebUI has)
+        filter.priorityFilter = CompiledFilter::NoPriority;
+    } else {
+        filter.priorityFilter = CompiledFilter::GivenPriority;
+        filter.priority = shownPriority;
+    }
+    return filter;
+}
+
 class OpportunityFilterProxyModel::Private
 {
 public:
     Private()
-    {}
+        : filter(compileFilter(settings))
+    {
+        const ItemsTreeModel::ColumnTypes columns = ItemsTreeModel::columnTypes(Opportunity);
+        nextStepDateColumn = columns.indexOf(ItemsTreeModel::NextStepDate);
+        lastModifiedDateColumn = columns.indexOf(ItemsTreeModel::LastModifiedDate);
+    }
+
+    bool countryAccepted(const QString &accountId) const
+    {
+        QHash<QString, bool>::const_iterator it = countryAcceptedCache.constFind(accountId);
+        if (it != countryAcceptedCache.constEnd()) {
+            return *it;
+        }
+        const QString country = AccountRepository::instance()->accountById(accountId).countryForGui().toCaseFolded();
+        const bool accepted = filter.otherCountries ? !filter.countries.contains(country)
+                                                    : filter.countries.contains(country);
+        countryAcceptedCache.insert(accountId, accepted);
+        return accepted;
+    }
 
     OpportunityFilterSettings settings;
+    CompiledFilter filter;
+    // whether the country of an account passes the country filter, by account id
+    mutable QHash<QString, bool> countryAcceptedCache;
+    // the opportunities whose cached search text includes the name of an account, by account id
+    mutable QMultiHash<QString, Item::Id> searchTextIdsByAccountId;
+    // accounts added or renamed since the last slotForgetAccountSearchTexts()
+    QSet<QString> renamedAccountIds;
+    // resolved once, lessThan() is called O(n log n) times per sort
+    int nextStepDateColumn;
+    int lastModifiedDateColumn;
 
 };
 
 OpportunityFilterProxyModel::OpportunityFilterProxyModel(QObject *parent)
     : FilterProxyModel(Opportunity, parent), d(new Private())
 {
+    AccountRepository *accountRepository = AccountRepository::instance();
+    connect(accountRepository, SIGNAL(accountAdded(QString,Akonadi::Item::Id)),
+            this, SLOT(slotAccountAdded(QString)));
+    connect(accountRepository, SIGNAL(accountModified(QString,QVector<AccountRepository::Field>)),
+            this, SLOT(slotAccountModified(QString,QVector<AccountRepository::Field>)));
+    connect(ClientSettings::self(), SIGNAL(countryFiltersChanged()),
+            this, SLOT(slotCountryFiltersChanged()));
 }
 
 OpportunityFilterProxyModel::~OpportunityFilterProxyModel()
@@ -59,50 +163,80 @@ OpportunityFilterProxyModel::~OpportunityFilterProxyModel()
 void OpportunityFilterProxyModel::setFilter(const OpportunityFilterSettings &settings)
 {
     d->settings = settings;
+    d->filter = compileFilter(settings);
+    d->countryAcceptedCache.clear();
     invalidate();
 }
 
-QString OpportunityFilterProxyModel::filterDescription() const
+void OpportunityFilterProxyModel::slotAccountAdded(const QString &accountId)
 {
-    QString txt = d->settings.filterDescription();
-
-    if (!filterString().isEmpty()) {
-        txt = i18n("%1, containing \"%2\"", txt, filterString());
-    }
-
-    return txt;
+    // e.g. the account wasn't loaded yet when the opportunity was filtered
+    d->countryAcceptedCache.remove(accountId);
+    accountNameChanged(accountId);
 }
 
-static bool opportunityMatchesFilter(const SugarOpportunity &opportunity, const QString &filter)
+void OpportunityFilterProxyModel::slotAccountModified(const QString &accountId, const QVector<AccountRepository::Field> &changedFields)
 {
-    if (opportunity.name().contains(filter, Qt::CaseInsensitive)) {
-        return true;
+    if (changedFields.contains(AccountRepository::Country)) {
+        d->countryAcceptedCache.remove(accountId);
+        if (d->filter.filterCountries) {
+            invalidateFilter();
+        }
     }
-    const QString accountName = ReferencedData::instance(AccountRef)->referencedData(opportunity.accountId());
-    if (accountName.contains(filter, Qt::CaseInsensitive)) {
-        return true;
+    if (changedFields.contains(AccountRepository::Name)) {
+        accountNameChanged(accountId);
     }
-    if (opportunity.salesStage().contains(filter, Qt::CaseInsensitive)) {
-        return true;
+}
+
+void OpportunityFilterProxyModel::accountNameChanged(const QString &accountId)
+{
+    if (!d->searchTextIdsByAccountId.contains(accountId))
+        return;
+    // Delayed, ReferencedData only gets the new name after AccountRepository
+    if (d->renamedAccountIds.isEmpty()) {
+        QMetaObject::invokeMethod(this, "slotForgetAccountSearchTexts", Qt::QueuedConnection);
     }
-    if (opportunity.amount().contains(filter, Qt::CaseInsensitive)) {
-        return true;
+    d->renamedAccountIds.insert(accountId);
+}
+
+void OpportunityFilterProxyModel::slotForgetAccountSearchTexts()
+{
+    Q_FOREACH (const QString &accountId, d->renamedAccountIds) {
+        Q_FOREACH (Item::Id id, d->searchTextIdsByAccountId.values(accountId)) {
+            forgetSearchText(id);
+        }
+        d->searchTextIdsByAccountId.remove(accountId);
     }
-    if (opportunity.dateClosed().contains(filter, Qt::CaseInsensitive)) {
-        return true;
+    d->renamedAccountIds.clear();
+    if (!filterString().isEmpty()) {
+        invalidateFilter();
     }
-    if (opportunity.assignedUserName().contains(filter, Qt::CaseInsensitive)) {
-        return true;
+}
+
+void OpportunityFilterProxyModel::slotCountryFiltersChanged()
+{
+    if (d->filter.otherCountries) {
+        setFilter(d->settings);
     }
-    if (opportunity.opportunitySize().contains(filter, Qt::CaseInsensitive)) {
-        return true;
+}
+
+QString OpportunityFilterProxyModel::filterDescription() const
+{
+    QString txt = d->settings.filterDescription();
+
+    if (!filterString().isEmpty()) {
+        txt = i18n("%1, containing \"%2\"", txt, filterString());
     }
 
-    return false;
+    return txt;
 }
 
 bool OpportunityFilterProxyModel::filterAcceptsRow(int row, const QModelIndex &parent) const
 {
+    // Cheapest check first, it doesn't need a copy of the payload
+    if (!matchesFilterString(row, parent))
+        return false;
+
     const QModelIndex index = sourceModel()->index(row, 0, parent);
     const Akonadi::Item item =
         index.data(Akonadi::EntityTreeModel::ItemRole).value<Akonadi::Item>();
@@ -110,60 +244,63 @@ bool OpportunityFilterProxyModel::filterAcceptsRow(int row, const QModelIndex &p
     Q_ASSERT(item.hasPayload<SugarOpportunity>());
     const SugarOpportunity opportunity = item.payload<SugarOpportunity>();
 
-    const QStringList assignees = d->settings.assignees();
-    if (!assignees.isEmpty() && !assignees.contains(opportunity.assignedUserName()))
+    const CompiledFilter &filter = d->filter;
+    if (!filter.assignees.isEmpty() && !filter.assignees.contains(opportunity.assignedUserName()))
         return false;
 
-    const QStringList countries = d->settings.countries();
-    if (!countries.isEmpty()) {
-        const QString country = AccountRepository::instance()->accountById(opportunity.accountId()).countryForGui();
-        if (countries.contains(OpportunityFilterSettings::otherCountriesSpecialValue())) {
-            // Special case: filtering for a country not in any of the defined groups
-            QVector<ClientSettings::GroupFilters::Group> groups = ClientSettings::self()->countryFilters().groups();
-            const auto it = std::find_if(groups.constBegin(), groups.constEnd(),
-                                         [&country](const ClientSettings::GroupFilters::Group &group){
-                return group.entries.contains(country, Qt::CaseInsensitive); });
-            if (it != groups.constEnd())
-                return false;
-        } else {
-            // Standard filtering using a country group
-            if (!countries.contains(country, Qt::CaseInsensitive))
-                return false;
-        }
-    }
+    if (filter.filterCountries && !d->countryAccepted(opportunity.accountId()))
+        return false;
 
     const bool isClosed = opportunity.salesStage().contains("Closed");
-    if (!d->settings.showClosed() && isClosed)
+    if (!filter.showClosed && isClosed)
         return false;
-    if (!d->settings.showOpen() && !isClosed)
+    if (!filter.showOpen && !isClosed)
         return false;
-    if (d->settings.maxDate().isValid() && (!opportunity.nextCallDate().isValid()
-                                 || opportunity.nextCallDate() > d->settings.maxDate()))
+    if (filter.maxDate.isValid() && (!opportunity.nextCallDate().isValid()
+                                 || opportunity.nextCallDate() > filter.maxDate))
         return false;
-    if (d->settings.modifiedAfter().isValid() && opportunity.dateModified().date() < d->settings.modifiedAfter())
+    if (filter.modifiedAfter.isValid() && opportunity.dateModified().date() < filter.modifiedAfter)
         return false;
-    if (d->settings.modifiedBefore().isValid() && opportunity.dateModified().date() > d->settings.modifiedBefore())
+    if (filter.modifiedBefore.isValid() && opportunity.dateModified().date() > filter.modifiedBefore)
         return false;
 
-    QString shownPriority = d->settings.shownPriority();
-    if (shownPriority == "Not set") // "Not set" is much clearer to me than just a blank space (like the WebUI has)
-        shownPriority = "";
-    if (shownPriority != "-" && opportunity.opportunityPriority().toUpper() != shownPriority)
-        return false;
-
-    const QString filterStr = filterString();
-    if (filterStr.isEmpty()) {
-        return true;
+    switch (filter.priorityFilter) {
+    case CompiledFilter::AnyPriority:
+        break;
+    case CompiledFilter::NoPriority:
+        if (!opportunity.opportunityPriority().isEmpty())
+            return false;
+        break;
+    case CompiledFilter::GivenPriority:
+        if (opportunity.opportunityPriority().toUpper() != filter.priority)
+            return false;
+        break;
     }
 
-    return opportunityMatchesFilter(opportunity, filterStr);
+    return true;
+}
+
+QString OpportunityFilterProxyModel::searchText(const Akonadi::Item &item) const
+{
+    Q_ASSERT(item.hasPayload<SugarOpportunity>());
+    const SugarOpportunity opportunity = item.payload<SugarOpportunity>();
+    if (!d->searchTextIdsByAccountId.contains(opportunity.accountId(), item.id())) {
+        d->searchTextIdsByAccountId.insert(opportunity.accountId(), item.id());
+    }
+    return (QStringList()
+            << opportunity.name()
+            << ReferencedData::instance(AccountRef)->referencedData(opportunity.accountId())
+            << opportunity.salesStage()
+            << opportunity.amount()
+            << opportunity.dateClosed()
+            << opportunity.assignedUserName()
+            << opportunity.opportunitySize()
+            ).join(QLatin1String("\n"));
 }
 
 bool OpportunityFilterProxyModel::lessThan(const QModelIndex &left, const QModelIndex &right) const
 {
-    const ItemsTreeModel::ColumnTypes columns = ItemsTreeModel::columnTypes(Opportunity);
-    const int nextStepDateColumn = columns.indexOf(ItemsTreeModel::NextStepDate);
-    if (sortColumn() == nextStepDateColumn) {
+    if (sortColumn() == d->nextStepDateColumn) {
         QVariant l = (left.model() ? left.model()->data(left, sortRole()) : QVariant());
         QVariant r = (right.model() ? right.model()->data(right, sortRole()) : QVariant());
         if (l.userType() == QVariant::Date) {
@@ -171,9 +308,8 @@ bool OpportunityFilterProxyModel::lessThan(const QModelIndex &left, const QModel
             QDate rightDt = r.toDate();
             if (leftDt == rightDt) {
                 // compare last modified dates
-                const int lastModifiedDateColumn = columns.indexOf(ItemsTreeModel::LastModifiedDate);
-                leftDt = left.sibling(left.row(), lastModifiedDateColumn).data(sortRole()).toDate();
-                rightDt = right.sibling(right.row(), lastModifiedDateColumn).data(sortRole()).toDate();
+                leftDt = left.sibling(left.row(), d->lastModifiedDateColumn).data(sortRole()).toDate();
+                rightDt = right.sibling(right.row(), d->lastModifiedDateColumn).data(sortRole()).toDate();
             }
             return leftDt < rightDt;
         }
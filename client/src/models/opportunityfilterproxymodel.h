@@ -24,6 +24,7 @@
 #define OPPORTUNITYFILTERPROXYMODEL_H
 
 #include "filterproxymodel.h"
+#include "accountrepository.h"
 class OpportunityFilterSettings;
 
 /**
@@ -59,8 +60,17 @@ public:
 protected:
     virtual bool filterAcceptsRow(int row, const QModelIndex &parent) const override;
     virtual bool lessThan(const QModelIndex &left, const QModelIndex &right) const override;
+    virtual QString searchText(const Akonadi::Item &item) const override;
+
+private Q_SLOTS:
+    void slotAccountAdded(const QString &accountId);
+    void slotAccountModified(const QString &accountId, const QVector<AccountRepository::Field> &changedFields);
+    void slotCountryFiltersChanged();
+    void slotForgetAccountSearchTexts();
 
 private:
+    void accountNameChanged(const QString &accountId);
+
     class Private;
     Private *const d;
 };
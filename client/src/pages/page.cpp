@@ -111,21 +111,38 @@ Page::~Page()
 }
 
 void Page::openWidget(const QString &id)
+{
+    const Item::Id itemId = mItemIdsBySugarId.value(id, -1);
+    if (itemId != -1) {
+        const QModelIndexList indexes = EntityTreeModel::modelIndexesForItem(mItemsTreeModel, Item(itemId));
+        if (!indexes.isEmpty()) {
+            const Item item = indexes.first().data(EntityTreeModel::ItemRole).value<Item>();
+            openWidgetForItem(item, mType);
+            return;
+        }
+    }
+    kWarning() << this << "(" << typeToString(mType) << ") Object not found:" << id << "among" << mItemsTreeModel->rowCount() << "rows";
+}
+
+void Page::updateSugarIds(int start, int end, bool remove)
 {
     ItemDataExtractor *dataExtractor = itemDataExtractor();
     if (!dataExtractor) {
         return;
     }
-    const int count = mItemsTreeModel->rowCount();
-    for (int i = 0; i < count; ++i) {
-        const QModelIndex index = mItemsTreeModel->index(i, 0);
-        const Item item = mItemsTreeModel->data(index, EntityTreeModel::ItemRole).value<Item>();
-        if (dataExtractor->idForItem(item) == id) {
-            openWidgetForItem(item, mType);
-            return;
+    for (int row = start; row <= end; ++row) {
+        const QModelIndex index = mItemsTreeModel->index(row, 0);
+        const Item item = index.data(EntityTreeModel::ItemRole).value<Item>();
+        const QString id = dataExtractor->idForItem(item);
+        if (id.isEmpty()) { // not saved to the server yet
+            continue;
+        }
+        if (remove) {
+            mItemIdsBySugarId.remove(id);
+        } else {
+            mItemIdsBySugarId.insert(id, item.id());
         }
     }
-    kWarning() << this << "(" << typeToString(mType) << ") Object not found:" << id << "among" << count << "rows";
 }
 
 void Page::openWidgetForItem(const Item &item, DetailsType itemType)
@@ -169,6 +186,7 @@ void Page::slotResourceSelectionChanged(const QByteArray &identifier)
 
     delete mItemsTreeModel;
     mItemsTreeModel = nullptr;
+    mItemIdsBySugarId.clear();
 
     retrieveResourceUrl();
     mUi.reloadPB->setEnabled(false);
@@ -344,10 +362,13 @@ void Page::slotRowsInserted(const QModelIndex &, int start, int end)
     //kDebug() << typeToString(mType) << ": rows inserted from" << start << "to" << end;
     const bool emitChanges = mInitialLoadingDone;
 
+    updateSugarIds(start, end, false);
     handleNewRows(start, end, emitChanges);
 
-    if (!mInitialLoadingDone)
+    if (!mInitialLoadingDone) {
+        emit loadingProgress(typeToTranslatedString(mType), mItemsTreeModel->rowCount(), mCollection.statistics().count());
         slotCheckCollectionPopulated(mCollection.id());
+    }
 }
 
 void Page::slotCheckCollectionPopulated(Akonadi::Collection::Id id)
@@ -377,6 +398,7 @@ void Page::slotCheckCollectionPopulated(Akonadi::Collection::Id id)
 
 void Page::slotRowsAboutToBeRemoved(const QModelIndex &, int start, int end)
 {
+    updateSugarIds(start, end, true);
     handleRemovedRows(start, end, mInitialLoadingDone);
 }
 
@@ -524,7 +546,14 @@ void Page::slotDataChanged(const QModelIndex &topLeft, const QModelIndex &bottom
         }
         const Item item = index.data(EntityTreeModel::ItemRole).value<Item>();
         Q_ASSERT(item.isValid());
-        emit modelItemChanged(item); // update details dialog
+        OpenedWidgetsRepository::instance()->itemChanged(item); // update details dialog
+        if (ItemDataExtractor *dataExtractor = itemDataExtractor()) {
+            // a newly created item gets its id once saved to the server
+            const QString id = dataExtractor->idForItem(item);
+            if (!id.isEmpty()) {
+                mItemIdsBySugarId.insert(id, item.id());
+            }
+        }
     }
 }
 
@@ -615,9 +644,7 @@ ItemEditWidgetBase *Page::createItemEditWidget(const Akonadi::Item &item, Detail
     if (item.isValid()) // no need to call setItem for "New <Item>" widget
         widget->setItem(item);
 
-    // in case of changes while the widget is up
-    connect(this, SIGNAL(modelItemChanged(Akonadi::Item)),
-            widget, SLOT(updateItem(Akonadi::Item)));
+    // changes while the widget is up are delivered by OpenedWidgetsRepository::itemChanged
     connect(this, SIGNAL(onlineStatusChanged(bool)),
             widget, SLOT(setOnline(bool)));
     connect(widget, SIGNAL(itemSaved()),
@@ -653,13 +680,7 @@ ItemEditWidgetBase *Page::createItemEditWidget(const Akonadi::Item &item, Detail
 
 ItemEditWidgetBase *Page::openedWidgetForItem(const Item &item)
 {
-    QSet<ItemEditWidgetBase*> itemEditWidgets = OpenedWidgetsRepository::instance()->openedWidgets();
-    auto it = std::find_if(itemEditWidgets.constBegin(), itemEditWidgets.constEnd(),
-                           [&](ItemEditWidgetBase *widget) { return item.id() == widget->item().id(); });
-    if (it == itemEditWidgets.constEnd()) {
-        return nullptr;
-    }
-    return *it;
+    return OpenedWidgetsRepository::instance()->widgetForItem(item.id());
 }
 
 void Page::slotUnregisterItemEditWidget()
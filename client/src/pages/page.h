@@ -33,6 +33,7 @@
 #include <Akonadi/Collection>
 #include <Akonadi/Item>
 
+#include <QHash>
 #include <QWidget>
 
 namespace Akonadi
@@ -71,7 +72,7 @@ Q_SIGNALS:
     void modelCreated(ItemsTreeModel *model);
     void statusMessage(const QString &);
     void modelLoaded(DetailsType type);
-    void modelItemChanged(const Akonadi::Item &item);
+    void loadingProgress(const QString &collectionName, int loaded, int total);
     void synchronizeCollection(const Akonadi::Collection &collection);
     void openObject(DetailsType type, const QString &id);
     void onlineStatusChanged(bool online);
@@ -131,6 +132,7 @@ private:
     enum ItemEditWidgetType { Simple, TabWidget };
     ItemEditWidgetBase *createItemEditWidget(const Akonadi::Item &item, DetailsType itemType, bool forceSimpleWidget = false);
     ItemEditWidgetBase *openedWidgetForItem(const Akonadi::Item &item);
+    void updateSugarIds(int start, int end, bool remove);
 
 private:
     QString mMimeType;
@@ -152,6 +154,9 @@ private:
 
     QStringList mSelectedEmails;
 
+    // Sugar id -> Akonadi item id of the rows of mItemsTreeModel, for openWidget()
+    QHash<QString, Akonadi::Item::Id> mItemIdsBySugarId;
+
     KJobProgressTracker *mJobProgressTracker;
 };
 
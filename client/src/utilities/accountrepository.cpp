@@ -38,15 +38,61 @@ AccountRepository::~AccountRepository()
 
 void AccountRepository::clear()
 {
-    mIdMap.clear();
-    mKeyMap.clear();
-    mNameMap.clear();
-    mCountries.clear();
+    mAccounts.clear();
+    mFreeSlots.clear();
+    mIdIndex.clear();
+    mKeyIndex.clear();
+    mNameIndex.clear();
+    mCountryIndex.clear();
 }
 
 QStringList AccountRepository::countries() const
 {
-    return mCountries.toList();
+    return mCountryIndex.uniqueKeys();
+}
+
+void AccountRepository::indexSlot(int pos)
+{
+    Slot &slot = mAccounts[pos];
+    const SugarAccount &account = slot.account;
+    slot.key = account.key();
+    slot.cleanName = account.cleanAccountName();
+    slot.countries.clear();
+    if (!account.billingAddressCountry().isEmpty()) {
+        slot.countries.append(account.billingAddressCountry());
+    }
+    if (!account.shippingAddressCountry().isEmpty() && !slot.countries.contains(account.shippingAddressCountry())) {
+        slot.countries.append(account.shippingAddressCountry());
+    }
+
+    mIdIndex.insert(account.id(), pos);
+    mKeyIndex.insert(slot.key, pos);
+    mNameIndex.insert(slot.cleanName, pos);
+    foreach (const QString &country, slot.countries) {
+        mCountryIndex.insert(country, pos);
+    }
+}
+
+void AccountRepository::unindexSlot(int pos)
+{
+    const Slot &slot = mAccounts.at(pos);
+    mIdIndex.remove(slot.account.id());
+    // only this slot, there can be several accounts with the same key or name
+    mKeyIndex.remove(slot.key, pos);
+    mNameIndex.remove(slot.cleanName, pos);
+    foreach (const QString &country, slot.countries) {
+        mCountryIndex.remove(country, pos);
+    }
+}
+
+QList<SugarAccount> AccountRepository::accountsAt(const QList<int> &positions) const
+{
+    QList<SugarAccount> accounts;
+    accounts.reserve(positions.count());
+    foreach (int pos, positions) {
+        accounts.append(mAccounts.at(pos).account);
+    }
+    return accounts;
 }
 
 void AccountRepository::addAccount(const SugarAccount &account, Akonadi::Item::Id akonadiId)
@@ -54,18 +100,21 @@ void AccountRepository::addAccount(const SugarAccount &account, Akonadi::Item::I
     const QString accountId = account.id();
 
     Q_ASSERT(!accountId.isEmpty());
-    if (mIdMap.contains(accountId)) // can this happen?
-        qWarning() << "AccountRepository: already have" << accountId << mIdMap.value(accountId).name() << account.name();
-    mIdMap.insert(accountId, account);
-    // ## This does not handle the case of renaming accounts later on
-    mKeyMap.insertMulti(account.key(), account);
-    mNameMap.insertMulti(account.cleanAccountName(), account);
-    if (!account.billingAddressCountry().isEmpty()) {
-        mCountries.insert(account.billingAddressCountry());
-    }
-    if (!account.shippingAddressCountry().isEmpty()) {
-        mCountries.insert(account.shippingAddressCountry());
+    QHash<QString, int>::const_iterator existing = mIdIndex.constFind(accountId);
+    int pos;
+    if (existing != mIdIndex.constEnd()) { // can this happen?
+        pos = *existing;
+        qWarning() << "AccountRepository: already have" << accountId << mAccounts.at(pos).account.name() << account.name();
+        unindexSlot(pos);
+    } else if (!mFreeSlots.isEmpty()) {
+        pos = mFreeSlots.last();
+        mFreeSlots.removeLast();
+    } else {
+        pos = mAccounts.count();
+        mAccounts.resize(pos + 1);
     }
+    mAccounts[pos].account = account;
+    indexSlot(pos);
     emit accountAdded(accountId, akonadiId);
 }
 
@@ -74,10 +123,11 @@ QVector<AccountRepository::Field> AccountRepository::modifyAccount(const SugarAc
     QVector<Field> changedFields;
     const QString accountId = account.id();
     Q_ASSERT(!accountId.isEmpty());
-    Map::iterator it = mIdMap.find(accountId);
-    if (it != mIdMap.end()) {
+    QHash<QString, int>::const_iterator it = mIdIndex.constFind(accountId);
+    if (it != mIdIndex.constEnd()) {
         // Existing account modified
-        const SugarAccount &oldAccount = *it;
+        const int pos = *it;
+        const SugarAccount &oldAccount = mAccounts.at(pos).account;
         if (oldAccount.name() != account.name()) {
             qDebug() << "account renamed from" << oldAccount.name() << "to" << account.name();
             changedFields.append(Name);
@@ -86,13 +136,17 @@ QVector<AccountRepository::Field> AccountRepository::modifyAccount(const SugarAc
             qDebug() << account.name() << ": country modified";
             changedFields.append(Country);
         }
+        if (oldAccount.postalCodeForGui() != account.postalCodeForGui() || oldAccount.cityForGui() != account.cityForGui()) {
+            changedFields.append(Address);
+        }
 
-        *it = account;
+        // Reindex, the key, the clean name and the countries might have changed
+        unindexSlot(pos);
+        mAccounts[pos].account = account;
+        indexSlot(pos);
         if (!changedFields.isEmpty()) {
             emit accountModified(accountId, changedFields);
         }
-        // We don't handle changes in mKeyMap and mNameMap, hoping that this doesn't matter
-        // since they are only used by the import dialog.
     } else {
         qWarning() << "Account not found " << accountId << "name=" << account.name();
     }
@@ -103,50 +157,37 @@ void AccountRepository::removeAccount(const SugarAccount &account)
 {
     const QString id = account.id();
     Q_ASSERT(!id.isEmpty());
-    const QString key = account.key();
-    const QString cleanAccountName = account.cleanAccountName();
-
-    mIdMap.remove(id);
-
-    // Be careful not to remove the wrong one if there are duplicates...
-
-    Map::iterator i = mKeyMap.find(key);
-    while (i != mKeyMap.end() && i.key() == key) {
-        if (i.value().id() == id) {
-            mKeyMap.erase(i);
-            break;
-        }
-        ++i;
-    }
-
-    i = mNameMap.find(cleanAccountName);
-    while (i != mNameMap.end() && i.key() == cleanAccountName) {
-        if (i.value().id() == id) {
-            mNameMap.erase(i);
-            break;
-        }
-        ++i;
-    }
+    QHash<QString, int>::const_iterator it = mIdIndex.constFind(id);
+    if (it == mIdIndex.constEnd())
+        return;
+    const int pos = *it;
+    // Using the indexed values rather than those of the given account, in case of a rename
+    unindexSlot(pos);
+    mAccounts[pos] = Slot();
+    mFreeSlots.append(pos);
 }
 
 SugarAccount AccountRepository::accountById(const QString &id) const
 {
-    return mIdMap.value(id);
+    QHash<QString, int>::const_iterator it = mIdIndex.constFind(id);
+    if (it == mIdIndex.constEnd())
+        return SugarAccount();
+    return mAccounts.at(*it).account;
 }
 
 bool AccountRepository::hasId(const QString &id) const
 {
-    return mIdMap.contains(id);
+    return mIdIndex.contains(id);
 }
 
 QList<SugarAccount> AccountRepository::similarAccounts(const SugarAccount &account) const
 {
-    return mNameMap.values(account.cleanAccountName());
+    return accountsAt(mNameIndex.values(account.cleanAccountName()));
 }
 
 QList<SugarAccount> AccountRepository::accountsByKey(const QString &key) const
 {
-    return mKeyMap.values(key);
+    return accountsAt(mKeyIndex.values(key));
 }
 
 void AccountRepository::emitInitialLoadingDone()
@@ -27,7 +27,8 @@
 
 #include <Akonadi/Item>
 
-#include <QMap>
+#include <QHash>
+#include <QStringList>
 #include <QVector>
 
 class AccountRepository : public QObject
@@ -41,7 +42,8 @@ public:
     enum Field
     {
         Name,
-        Country
+        Country,
+        Address // postal code or city, as shown in the GUI
     };
 
     void clear();
@@ -72,11 +74,26 @@ signals:
 private:
     AccountRepository();
 
-    typedef QMap<QString, SugarAccount> Map;
-    Map mIdMap;
-    Map mKeyMap;
-    Map mNameMap;
-    QSet<QString> mCountries;
+    // The accounts are stored once, in mAccounts; the indexes refer to them by position.
+    // The indexed values are kept in the slot, to remove them after a rename.
+    struct Slot
+    {
+        SugarAccount account;
+        QString key;
+        QString cleanName;
+        QStringList countries;
+    };
+
+    void indexSlot(int pos);
+    void unindexSlot(int pos);
+    QList<SugarAccount> accountsAt(const QList<int> &positions) const;
+
+    QVector<Slot> mAccounts;
+    QVector<int> mFreeSlots;
+    QHash<QString, int> mIdIndex;
+    QMultiHash<QString, int> mKeyIndex;
+    QMultiHash<QString, int> mNameIndex;
+    QMultiHash<QString, int> mCountryIndex;
 };
 
 Q_DECLARE_METATYPE(QVector<AccountRepository::Field>)
@@ -30,132 +30,135 @@
 
 #include <QFile>
 #include <QDebug>
+#include <QStringList>
 #include <QTextCodec>
 
+#include <algorithm>
+
 static const int COLUMN_COUNTRY = 10;
 
 ContactsImporter::ContactsImporter()
 {
+    mAccountColumns.insert(5, KDCRMFields::name());
+    mAccountColumns.insert(6, KDCRMFields::billingAddressStreet());
+    mAccountColumns.insert(7, KDCRMFields::billingAddressCity());
+    mAccountColumns.insert(8, KDCRMFields::billingAddressPostalcode());
+    mAccountColumns.insert(9, KDCRMFields::billingAddressState());
+    mAccountColumns.insert(COLUMN_COUNTRY, KDCRMFields::billingAddressCountry());
+    mAccountColumns.insert(11, KDCRMFields::vatNo());
+    mAccountColumns.insert(12, KDCRMFields::website());
+    mAccountColumns.insert(13, KDCRMFields::description());
 }
 
 bool ContactsImporter::importFile(const QString &fileName)
 {
     mContacts.clear();
+    mContactsByAccountName.clear();
 
     QFile file(fileName);
     if (!file.open(QIODevice::ReadOnly))
         return false;
 
-    QCsvStandardBuilder builder;
+    QCsvRowBuilder builder([this](const QStringList &row) { importRow(row); });
     QCsvReader reader(&builder);
     reader.setDelimiter(QLatin1Char(','));
     reader.setTextCodec(QTextCodec::codecForName("utf-8"));
-    if (!reader.read(&file))
-        return false;
+    reader.setStartRow(1); // skip title row
+    return reader.read(&file);
+}
 
-    QMap<int, QString> accountColumns;
-    accountColumns.insert(5, KDCRMFields::name());
-    accountColumns.insert(6, KDCRMFields::billingAddressStreet());
-    accountColumns.insert(7, KDCRMFields::billingAddressCity());
-    accountColumns.insert(8, KDCRMFields::billingAddressPostalcode());
-    accountColumns.insert(9, KDCRMFields::billingAddressState());
-    accountColumns.insert(COLUMN_COUNTRY, KDCRMFields::billingAddressCountry());
-    accountColumns.insert(11, KDCRMFields::vatNo());
-    accountColumns.insert(12, KDCRMFields::website());
-    accountColumns.insert(13, KDCRMFields::description());
-
-    const int rows = builder.rowCount();
-    mContacts.reserve(rows);
-    for (int row = 1; row < rows; ++row) { // skip title row
-        QMap<QString, QString> accountData;
-        QMap<int, QString>::const_iterator it = accountColumns.constBegin();
-        for ( ; it != accountColumns.end() ; ++it) {
-            QString value = builder.data(row, it.key());
-            //qDebug() << it.key() << value << "->" << it.value();
-            if (it.key() == COLUMN_COUNTRY) {
-                value = KDCRMUtils::canonicalCountryName(value);
-            }
-            if (!value.isEmpty()) {
-                accountData.insert(it.value(), value);
-            }
+void ContactsImporter::importRow(const QStringList &row)
+{
+    QMap<QString, QString> accountData;
+    QMap<int, QString>::const_iterator it = mAccountColumns.constBegin();
+    for ( ; it != mAccountColumns.constEnd() ; ++it) {
+        QString value = row.value(it.key());
+        //qDebug() << it.key() << value << "->" << it.value();
+        if (it.key() == COLUMN_COUNTRY) {
+            value = KDCRMUtils::canonicalCountryName(value);
+        }
+        if (!value.isEmpty()) {
+            accountData.insert(it.value(), value);
         }
+    }
 
-        KABC::Addressee addressee;
-        const QString givenName = builder.data(row, 0).trimmed();
-        if (!givenName.isEmpty())
-            addressee.setGivenName(givenName);
+    KABC::Addressee addressee;
+    const QString givenName = row.value(0).trimmed();
+    if (!givenName.isEmpty())
+        addressee.setGivenName(givenName);
 
-        const QString familyName = builder.data(row, 1).trimmed();
-        if (!familyName.isEmpty())
-            addressee.setFamilyName(familyName);
+    const QString familyName = row.value(1).trimmed();
+    if (!familyName.isEmpty())
+        addressee.setFamilyName(familyName);
 
-        const QString prefix = builder.data(row, 2).trimmed();
-        if (!prefix.isEmpty())
-            addressee.insertCustom(QLatin1String("FATCRM"), QLatin1String("X-Salutation"), prefix);
+    const QString prefix = row.value(2).trimmed();
+    if (!prefix.isEmpty())
+        addressee.insertCustom(QLatin1String("FATCRM"), QLatin1String("X-Salutation"), prefix);
 
-        const QString phoneNumber = builder.data(row, 3).trimmed();
-        if (!phoneNumber.isEmpty())
-            addressee.insertPhoneNumber(KABC::PhoneNumber(phoneNumber, KABC::PhoneNumber::Work));
+    const QString phoneNumber = row.value(3).trimmed();
+    if (!phoneNumber.isEmpty())
+        addressee.insertPhoneNumber(KABC::PhoneNumber(phoneNumber, KABC::PhoneNumber::Work));
 
-        const QString emailAddress = builder.data(row, 4).trimmed();
-        if (!emailAddress.isEmpty())
-            addressee.insertEmail(emailAddress, true);
+    const QString emailAddress = row.value(4).trimmed();
+    if (!emailAddress.isEmpty())
+        addressee.insertEmail(emailAddress, true);
 
-        const QString companyName = builder.data(row, 5).trimmed();
-        if (!companyName.isEmpty())
-            addressee.setOrganization(companyName);
+    const QString companyName = row.value(5).trimmed();
+    if (!companyName.isEmpty())
+        addressee.setOrganization(companyName);
 
-        KABC::Address workAddress(KABC::Address::Work|KABC::Address::Pref);
-        const QString workStreet = builder.data(row, 6).trimmed();
-        if (!workStreet.isEmpty())
-            workAddress.setStreet(workStreet);
+    KABC::Address workAddress(KABC::Address::Work|KABC::Address::Pref);
+    const QString workStreet = row.value(6).trimmed();
+    if (!workStreet.isEmpty())
+        workAddress.setStreet(workStreet);
 
-        const QString workCity = builder.data(row, 7).trimmed();
-        if (!workCity.isEmpty())
-            workAddress.setLocality(workCity);
+    const QString workCity = row.value(7).trimmed();
+    if (!workCity.isEmpty())
+        workAddress.setLocality(workCity);
 
-        const QString workZipCode = builder.data(row, 8).trimmed();
-        if (!workZipCode.isEmpty())
-            workAddress.setPostalCode(workZipCode);
+    const QString workZipCode = row.value(8).trimmed();
+    if (!workZipCode.isEmpty())
+        workAddress.setPostalCode(workZipCode);
 
-        const QString workState = builder.data(row, 9).trimmed();
-        if (!workState.isEmpty())
-            workAddress.setRegion(workState);
+    const QString workState = row.value(9).trimmed();
+    if (!workState.isEmpty())
+        workAddress.setRegion(workState);
 
-        const QString workCountry = builder.data(row, 10).trimmed();
-        if (!workCountry.isEmpty())
-            workAddress.setCountry(workCountry);
+    const QString workCountry = row.value(10).trimmed();
+    if (!workCountry.isEmpty())
+        workAddress.setCountry(workCountry);
 
-        if (!workAddress.isEmpty())
-            addressee.insertAddress(workAddress);
+    if (!workAddress.isEmpty())
+        addressee.insertAddress(workAddress);
 
-        const QString jobTitle = builder.data(row, 14).trimmed();
-        if (!jobTitle.isEmpty())
-            addressee.setTitle(jobTitle);
+    const QString jobTitle = row.value(14).trimmed();
+    if (!jobTitle.isEmpty())
+        addressee.setTitle(jobTitle);
 
-        if (accountData.value(KDCRMFields::name()).trimmed().isEmpty()) {
-            const QString identifier = ((!givenName.isEmpty() || !familyName.isEmpty()) ? QString::fromLatin1("%1 %2").arg(givenName, familyName).trimmed() : emailAddress);
-            accountData.insert(KDCRMFields::name(), QString::fromLatin1("%1 (individual)").arg(identifier));
-        }
+    if (accountData.value(KDCRMFields::name()).trimmed().isEmpty()) {
+        const QString identifier = ((!givenName.isEmpty() || !familyName.isEmpty()) ? QString::fromLatin1("%1 %2").arg(givenName, familyName).trimmed() : emailAddress);
+        accountData.insert(KDCRMFields::name(), QString::fromLatin1("%1 (individual)").arg(identifier));
+    }
 
-        SugarAccount newAccount;
-        newAccount.setData(accountData);
+    SugarAccount newAccount;
+    newAccount.setData(accountData);
 
-        auto existingSet = std::find_if(mContacts.begin(), mContacts.end(),
-                                        [&newAccount](const ContactsSet &contactSet) { return contactSet.account.isSameAccount(newAccount); });
+    // isSameAccount() requires the same clean name, so only accounts with that name are candidates.
+    // The indexes are in increasing order, so this finds the same set as a search through all of mContacts.
+    QVector<int> &candidates = mContactsByAccountName[newAccount.cleanAccountName()];
+    auto existingIndex = std::find_if(candidates.constBegin(), candidates.constEnd(),
+                                      [this, &newAccount](int index) { return mContacts.at(index).account.isSameAccount(newAccount); });
 
-        if (existingSet != mContacts.end()) {
-            (*existingSet).addressees.append(addressee);
-        } else {
-            ContactsSet contactsSet;
-            contactsSet.account = newAccount;
-            contactsSet.addressees.append(addressee);
+    if (existingIndex != candidates.constEnd()) {
+        mContacts[*existingIndex].addressees.append(addressee);
+    } else {
+        ContactsSet contactsSet;
+        contactsSet.account = newAccount;
+        contactsSet.addressees.append(addressee);
 
-            mContacts.append(contactsSet);
-        }
+        candidates.append(mContacts.count());
+        mContacts.append(contactsSet);
     }
-
-    return true;
 }
 
 QVector<ContactsSet> ContactsImporter::contacts() const
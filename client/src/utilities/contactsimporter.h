@@ -26,20 +26,30 @@
 #include "contactsset.h"
 #include "kdcrmdata/sugaraccount.h"
 
+#include <QHash>
+#include <QMap>
 #include <QVector>
 
+class QStringList;
+
 class ContactsImporter
 {
 public:
     ContactsImporter();
 
+    // The contacts sets are built while the file is being parsed,
+    // rather than after reading the whole file into memory
     bool importFile(const QString &fileName);
 
     QVector<ContactsSet> contacts() const;
 
 private:
-    QVector<ContactsSet> mContacts;
+    void importRow(const QStringList &row);
 
+    QMap<int, QString> mAccountColumns;
+    QVector<ContactsSet> mContacts;
+    // Indexes in mContacts, by SugarAccount::cleanAccountName(), to find the matching account quickly
+    QHash<QString, QVector<int> > mContactsByAccountName;
 };
 
 #endif // CONTACTSIMPORTER_H
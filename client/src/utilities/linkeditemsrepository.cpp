@@ -23,14 +23,20 @@
 #include "linkeditemsrepository.h"
 #include "collectionmanager.h"
 
+#include "kdcrmdata/kdcrmfieldstream.h"
+
 #include <Akonadi/Collection>
 #include <Akonadi/CollectionStatistics>
 #include <Akonadi/ItemFetchJob>
 #include <Akonadi/ItemFetchScope>
 #include <Akonadi/Monitor>
 
+#include <KLocalizedString>
+
 #include <QStringList>
 
+static const char s_fullPayloadFetchProperty[] = "fullPayloadFetch";
+
 LinkedItemsRepository::LinkedItemsRepository(CollectionManager *collectionManager, QObject *parent) :
     QObject(parent),
     mMonitor(nullptr),
@@ -54,6 +60,8 @@ void LinkedItemsRepository::clear()
     mOpportunityEmailsHash.clear();
     mAccountDocumentsHash.clear();
     mOpportunityDocumentsHash.clear();
+    mDocumentItems.clear();
+    mItemIds.clear();
     delete mMonitor;
     mMonitor = nullptr;
 }
@@ -70,8 +78,13 @@ void LinkedItemsRepository::loadNotes()
     // load notes
     Akonadi::ItemFetchJob *job = new Akonadi::ItemFetchJob(mNotesCollection, this);
     configureItemFetchScope(job->fetchScope());
+    // Don't make the resource retrieve items which don't have the header part yet, see fetchFullPayloads
+    job->fetchScope().setCacheOnly(true);
     connect(job, SIGNAL(itemsReceived(Akonadi::Item::List)),
             this, SLOT(slotNotesReceived(Akonadi::Item::List)));
+    // Nothing will be received for an empty folder, don't let the caller wait forever
+    if (mNotesCollection.statistics().count() == 0)
+        QMetaObject::invokeMethod(this, "notesLoaded", Qt::QueuedConnection, Q_ARG(int, 0));
 }
 
 QVector<SugarNote> LinkedItemsRepository::notesForAccount(const QString &id) const
@@ -91,11 +104,18 @@ QVector<SugarNote> LinkedItemsRepository::notesForOpportunity(const QString &id)
 
 void LinkedItemsRepository::slotNotesReceived(const Akonadi::Item::List &items)
 {
-    mNotesLoaded += items.count();
+    Akonadi::Item::List withoutHeader;
     foreach(const Akonadi::Item &item, items) {
-        storeNote(item, false);
+        if (needsFullPayloadFetch(item.hasPayload<SugarNote>())) {
+            withoutHeader.append(item);
+        } else {
+            storeNote(item, false);
+            ++mNotesLoaded;
+        }
     }
+    fetchFullPayloads(withoutHeader, SLOT(slotNotesReceived(Akonadi::Item::List)));
     //kDebug() << "loaded" << mNotesLoaded << "notes";
+    emit loadingProgress(i18n("notes"), mNotesLoaded, mNotesCollection.statistics().count());
     if (mNotesLoaded == mNotesCollection.statistics().count())
         emit notesLoaded(mNotesLoaded);
 }
@@ -111,6 +131,7 @@ void LinkedItemsRepository::storeNote(const Akonadi::Item &item, bool emitSignal
             return;
         }
         removeNote(id); // handle change of parent
+        mItemIds.insert(id, item.id());
         const QString parentId = note.parentId();
         if (note.parentType() == QLatin1String("Accounts")) {
             if (!parentId.isEmpty()) {
@@ -155,6 +176,8 @@ void LinkedItemsRepository::removeNote(const QString &id)
 {
     Q_ASSERT(!id.isEmpty());
 
+    mItemIds.remove(id);
+
     const QString oldAccountId = mNotesAccountIdHash.value(id);
     if (!oldAccountId.isEmpty()) {
         //kDebug() << "note" << id << "oldAccountId" << oldAccountId;
@@ -209,8 +232,13 @@ void LinkedItemsRepository::loadEmails()
     // load emails
     Akonadi::ItemFetchJob *job = new Akonadi::ItemFetchJob(mEmailsCollection, this);
     configureItemFetchScope(job->fetchScope());
+    // Don't make the resource retrieve items which don't have the header part yet, see fetchFullPayloads
+    job->fetchScope().setCacheOnly(true);
     connect(job, SIGNAL(itemsReceived(Akonadi::Item::List)),
             this, SLOT(slotEmailsReceived(Akonadi::Item::List)));
+    // Nothing will be received for an empty folder, don't let the caller wait forever
+    if (mEmailsCollection.statistics().count() == 0)
+        QMetaObject::invokeMethod(this, "emailsLoaded", Qt::QueuedConnection, Q_ARG(int, 0));
 }
 
 void LinkedItemsRepository::monitorChanges()
@@ -247,11 +275,18 @@ QVector<SugarEmail> LinkedItemsRepository::emailsForOpportunity(const QString &i
 
 void LinkedItemsRepository::slotEmailsReceived(const Akonadi::Item::List &items)
 {
-    mEmailsLoaded += items.count();
+    Akonadi::Item::List withoutHeader;
     foreach(const Akonadi::Item &item, items) {
-        storeEmail(item, false);
+        if (needsFullPayloadFetch(item.hasPayload<SugarEmail>())) {
+            withoutHeader.append(item);
+        } else {
+            storeEmail(item, false);
+            ++mEmailsLoaded;
+        }
     }
+    fetchFullPayloads(withoutHeader, SLOT(slotEmailsReceived(Akonadi::Item::List)));
     //kDebug() << "loaded" << mEmailsLoaded << "emails";
+    emit loadingProgress(i18n("emails"), mEmailsLoaded, mEmailsCollection.statistics().count());
     if (mEmailsLoaded == mEmailsCollection.statistics().count()) {
         emit emailsLoaded(mEmailsLoaded);
     }
@@ -264,6 +299,7 @@ void LinkedItemsRepository::storeEmail(const Akonadi::Item &item, bool emitSigna
         const QString id = email.id();
         Q_ASSERT(!id.isEmpty());
         removeEmail(id); // handle change of parent
+        mItemIds.insert(id, item.id());
         const QString parentId = email.parentId();
         if (email.parentType() == QLatin1String("Accounts")) {
             if (!parentId.isEmpty()) {
@@ -309,6 +345,8 @@ void LinkedItemsRepository::removeEmail(const QString &id)
 {
     Q_ASSERT(!id.isEmpty());
 
+    mItemIds.remove(id);
+
     const QString oldAccountId = mEmailsAccountIdHash.value(id);
     if (!oldAccountId.isEmpty()) {
         //kDebug() << "email" << id << "oldAccountId" << oldAccountId;
@@ -368,8 +406,13 @@ void LinkedItemsRepository::loadDocuments()
     // load documents
     Akonadi::ItemFetchJob *job = new Akonadi::ItemFetchJob(mDocumentsCollection, this);
     configureItemFetchScope(job->fetchScope());
+    // Don't make the resource retrieve items which don't have the header part yet, see fetchFullPayloads
+    job->fetchScope().setCacheOnly(true);
     connect(job, SIGNAL(itemsReceived(Akonadi::Item::List)),
             this, SLOT(slotDocumentsReceived(Akonadi::Item::List)));
+    // Nothing will be received for an empty folder, don't let the caller wait forever
+    if (mDocumentsCollection.statistics().count() == 0)
+        QMetaObject::invokeMethod(this, "documentsLoaded", Qt::QueuedConnection, Q_ARG(int, 0));
 }
 
 QVector<SugarDocument> LinkedItemsRepository::documentsForOpportunity(const QString &id) const
@@ -389,11 +432,18 @@ Akonadi::Item LinkedItemsRepository::documentItem(const QString &id) const
 
 void LinkedItemsRepository::slotDocumentsReceived(const Akonadi::Item::List &items)
 {
-    mDocumentsLoaded += items.count();
+    Akonadi::Item::List withoutHeader;
     foreach(const Akonadi::Item &item, items) {
-        storeDocument(item, false);
+        if (needsFullPayloadFetch(item.hasPayload<SugarDocument>())) {
+            withoutHeader.append(item);
+        } else {
+            storeDocument(item, false);
+            ++mDocumentsLoaded;
+        }
     }
+    fetchFullPayloads(withoutHeader, SLOT(slotDocumentsReceived(Akonadi::Item::List)));
 
+    emit loadingProgress(i18n("documents"), mDocumentsLoaded, mDocumentsCollection.statistics().count());
     if (mDocumentsLoaded == mDocumentsCollection.statistics().count())
         emit documentsLoaded(mDocumentsLoaded);
 }
@@ -463,7 +513,54 @@ void LinkedItemsRepository::configureItemFetchScope(Akonadi::ItemFetchScope &sco
 {
     scope.setFetchRemoteIdentification(false);
     scope.setIgnoreRetrievalErrors(true);
-    scope.fetchFullPayload(true);
+    // Only what's needed to sort the items by parent, the rest is fetched by fetchFullItems
+    scope.fetchPayloadPart(KDCRMHeaderPayloadPart);
+}
+
+// Items stored before KDCRMHeaderPayloadPart existed only have the full payload.
+// Returns true if this item is one of them, unless we already fetched its full payload.
+bool LinkedItemsRepository::needsFullPayloadFetch(bool hasPayload) const
+{
+    if (hasPayload) {
+        return false;
+    }
+    // Don't loop if even the full payload is missing, the store method will warn about it
+    const QObject *job = sender();
+    return !job || !job->property(s_fullPayloadFetchProperty).toBool();
+}
+
+void LinkedItemsRepository::fetchFullPayloads(const Akonadi::Item::List &items, const char *slot)
+{
+    if (items.isEmpty())
+        return;
+
+    kDebug() << "Fetching the full payload of" << items.count() << "items without a header part";
+    Akonadi::ItemFetchJob *job = new Akonadi::ItemFetchJob(items, this);
+    job->fetchScope().setFetchRemoteIdentification(false);
+    job->fetchScope().setIgnoreRetrievalErrors(true);
+    job->fetchScope().fetchFullPayload(true);
+    job->setProperty(s_fullPayloadFetchProperty, true);
+    connect(job, SIGNAL(itemsReceived(Akonadi::Item::List)), this, slot);
+}
+
+Akonadi::ItemFetchJob *LinkedItemsRepository::fetchFullItems(const QStringList &ids, QObject *parent) const
+{
+    Akonadi::Item::List items;
+    items.reserve(ids.count());
+    foreach (const QString &id, ids) {
+        const Akonadi::Item::Id itemId = mItemIds.contains(id) ? mItemIds.value(id) : mDocumentItems.value(id).id();
+        if (itemId != -1) {
+            items.append(Akonadi::Item(itemId));
+        } else {
+            kWarning() << "No item for" << id;
+        }
+    }
+
+    Akonadi::ItemFetchJob *job = new Akonadi::ItemFetchJob(items, parent);
+    job->fetchScope().setFetchRemoteIdentification(false);
+    job->fetchScope().setIgnoreRetrievalErrors(true);
+    job->fetchScope().fetchFullPayload(true);
+    return job;
 }
 
 void LinkedItemsRepository::updateItem(const Akonadi::Item &item, const Akonadi::Collection &collection)
@@ -37,6 +37,7 @@ class CollectionManager;
 namespace Akonadi
 {
     class Monitor;
+    class ItemFetchJob;
     class ItemFetchScope;
 }
 
@@ -77,11 +78,19 @@ public:
 
     Akonadi::Item documentItem(const QString &id) const;
 
+    // The repository only keeps the fields needed to list the notes, emails and documents
+    // (see KDCRMHeaderPayloadPart). This returns a job fetching the full payload of the given ones
+    // (by Sugar id), e.g. to show the text of the notes.
+    Akonadi::ItemFetchJob *fetchFullItems(const QStringList &ids, QObject *parent) const;
+
 signals:
     void notesLoaded(int count);
     void emailsLoaded(int count);
     void documentsLoaded(int count);
 
+    // Emitted while loading notes, emails or documents, for progress reporting
+    void loadingProgress(const QString &collectionName, int loaded, int total);
+
     // Emitted when notes, emails or documents for this account have been modified.
     void accountModified(const QString &accountId);
     // Emitted when notes, emails or documents for this opportunity have been modified.
@@ -106,6 +115,8 @@ private:
     void storeDocument(const Akonadi::Item &item, bool emitSignals);
     void removeDocument(const QString &id);
     void configureItemFetchScope(Akonadi::ItemFetchScope &scope);
+    bool needsFullPayloadFetch(bool hasPayload) const;
+    void fetchFullPayloads(const Akonadi::Item::List &items, const char *slot);
     void updateItem(const Akonadi::Item &item, const Akonadi::Collection &collection);
 
     Akonadi::Collection mNotesCollection;
@@ -138,6 +149,8 @@ private:
     QHash<QString, Akonadi::Item> mDocumentItems;
     int mDocumentsLoaded;
 
+    QHash<QString, Akonadi::Item::Id> mItemIds; // note or email id -> akonadi item id (to fetch the full payload)
+
     CollectionManager *mCollectionManager;
 };
 
@@ -20,8 +20,11 @@
 
 #include "loadingoverlay.h"
 
+#include <KLocalizedString>
+
 #include <QResizeEvent>
 #include <QPainter>
+#include <QStringList>
 
 LoadingOverlay::LoadingOverlay(QWidget *parent) : QWidget(parent)
 {
@@ -56,6 +59,21 @@ void LoadingOverlay::paintEvent(QPaintEvent *)
     overlayFont.setPointSize(30);
     p.setFont(overlayFont);
     p.drawText(rect(), mMessage, QTextOption(Qt::AlignCenter));
+
+    if (!mProgress.isEmpty()) {
+        QStringList lines;
+        lines.reserve(mProgress.count());
+        foreach (const Progress &progress, mProgress) {
+            lines.append(i18nc("collection name: number of items loaded / total", "%1: %2 / %3",
+                               progress.name, progress.loaded, progress.total));
+        }
+        const QFontMetrics messageMetrics(overlayFont);
+        overlayFont.setPointSize(14);
+        p.setFont(overlayFont);
+        QRect progressRect = rect();
+        progressRect.setTop(rect().center().y() + messageMetrics.height());
+        p.drawText(progressRect, Qt::AlignHCenter | Qt::AlignTop, lines.join(QLatin1String("\n")));
+    }
 }
 
 void LoadingOverlay::setMessage(const QString &message)
@@ -64,4 +82,25 @@ void LoadingOverlay::setMessage(const QString &message)
     update();
 }
 
+void LoadingOverlay::setProgress(const QString &name, int loaded, int total)
+{
+    for (int i = 0; i < mProgress.count(); ++i) {
+        if (mProgress.at(i).name == name) {
+            mProgress[i].loaded = loaded;
+            mProgress[i].total = total;
+            update();
+            return;
+        }
+    }
+    const Progress progress = { name, loaded, total };
+    mProgress.append(progress);
+    update();
+}
+
+void LoadingOverlay::clearProgress()
+{
+    mProgress.clear();
+    update();
+}
+
 
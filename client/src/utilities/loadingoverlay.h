@@ -21,6 +21,7 @@
 #ifndef LOADINGOVERLAY_H
 #define LOADINGOVERLAY_H
 
+#include <QVector>
 #include <QWidget>
 
 class QEvent;
@@ -35,12 +36,24 @@ public:
 
     void setMessage(const QString &message);
 
+    // Shows "name: loaded / total" below the message, one line per collection
+    void setProgress(const QString &name, int loaded, int total);
+    void clearProgress();
+
 protected:
     bool eventFilter(QObject *obj, QEvent *event) override;
     void paintEvent(QPaintEvent *) override;
 
 private:
+    struct Progress
+    {
+        QString name;
+        int loaded;
+        int total;
+    };
+
     QString mMessage;
+    QVector<Progress> mProgress;
 
 };
 
@@ -20,6 +20,8 @@
 
 #include "openedwidgetsrepository.h"
 
+#include <QMetaObject>
+
 OpenedWidgetsRepository *OpenedWidgetsRepository::instance()
 {
     static OpenedWidgetsRepository repo;
@@ -45,6 +47,42 @@ QSet<ItemEditWidgetBase*> OpenedWidgetsRepository::openedWidgets() const
     return mItemEditWidgets;
 }
 
+ItemEditWidgetBase *OpenedWidgetsRepository::widgetForItem(Akonadi::Item::Id id) const
+{
+    foreach (ItemEditWidgetBase *widget, mItemEditWidgets) {
+        if (widget->item().id() == id) {
+            return widget;
+        }
+    }
+    return nullptr;
+}
+
+void OpenedWidgetsRepository::itemChanged(const Akonadi::Item &item)
+{
+    if (mItemEditWidgets.isEmpty()) {
+        return;
+    }
+    if (mChangedItems.isEmpty()) {
+        QMetaObject::invokeMethod(this, "slotDeliverChangedItems", Qt::QueuedConnection);
+    }
+    mChangedItems.insert(item.id(), item);
+}
+
+void OpenedWidgetsRepository::slotDeliverChangedItems()
+{
+    const QHash<Akonadi::Item::Id, Akonadi::Item> changedItems = mChangedItems;
+    mChangedItems.clear();
+    // The widgets are looked up by their current item id,
+    // since a "New <Item>" widget only gets an id once saved.
+    foreach (ItemEditWidgetBase *widget, mItemEditWidgets) {
+        const Akonadi::Item::Id id = widget->item().id();
+        QHash<Akonadi::Item::Id, Akonadi::Item>::const_iterator it = changedItems.constFind(id);
+        if (it != changedItems.constEnd()) {
+            widget->updateItem(it.value());
+        }
+    }
+}
+
 OpenedWidgetsRepository::OpenedWidgetsRepository()
 {
 }
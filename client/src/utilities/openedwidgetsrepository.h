@@ -21,10 +21,13 @@
 #ifndef OPENEDWIDGETSREPOSITORY_H
 #define OPENEDWIDGETSREPOSITORY_H
 
+#include <QHash>
 #include <QObject>
 
 #include "itemeditwidgetbase.h"
 
+#include <Akonadi/Item>
+
 class ItemEditWidgetBase;
 
 class OpenedWidgetsRepository : public QObject
@@ -37,9 +40,21 @@ public:
     void registerWidget(ItemEditWidgetBase *widget);
     void unregisterWidget(ItemEditWidgetBase *widget);
     QSet<ItemEditWidgetBase*> openedWidgets() const;
+    ItemEditWidgetBase *widgetForItem(Akonadi::Item::Id id) const;
+
+    /**
+     * Notifies the widget showing this item, if any, that the item changed.
+     * Changes are delivered once per event loop iteration, only the latest
+     * version of each item is delivered.
+     */
+    void itemChanged(const Akonadi::Item &item);
+
+private Q_SLOTS:
+    void slotDeliverChangedItems();
 
 private:
     QSet<ItemEditWidgetBase*> mItemEditWidgets;
+    QHash<Akonadi::Item::Id, Akonadi::Item> mChangedItems;
 
     OpenedWidgetsRepository();
 };
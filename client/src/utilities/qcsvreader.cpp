@@ -19,16 +19,28 @@
 
 #include "qcsvreader.h"
 
+#include <QScopedPointer>
 #include <QStringList>
 #include <QTextCodec>
-#include <QTextStream>
 
 #include <KLocalizedString>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+// How much is read from the device and decoded at once
+static const int s_blockSize = 64 * 1024;
+
 QCsvBuilderInterface::~QCsvBuilderInterface()
 {
 }
 
+void QCsvBuilderInterface::fieldRef( const QStringRef &data, uint row, uint column )
+{
+    field( data.toString(), row, column );
+}
+
 class QCsvReader::Private
 {
 public:
@@ -43,7 +55,7 @@ public:
 
     void emitBeginLine( uint row );
     void emitEndLine( uint row );
-    void emitField( const QString &data, int row, int column );
+    void emitField( const QStringRef &data, int row, int column );
 
     QCsvBuilderInterface *mBuilder;
     QTextCodec *mCodec;
@@ -68,10 +80,10 @@ void QCsvReader::Private::emitEndLine( uint row )
     }
 }
 
-void QCsvReader::Private::emitField( const QString &data, int row, int column )
+void QCsvReader::Private::emitField( const QStringRef &data, int row, int column )
 {
     if ( ( row - mStartRow ) > 0 ) {
-        mBuilder->field( data, row - mStartRow - 1, column - 1 );
+        mBuilder->fieldRef( data, row - mStartRow - 1, column - 1 );
     }
 }
 
@@ -86,6 +98,103 @@ QCsvReader::~QCsvReader()
     delete d;
 }
 
+/**
+ * The text of the field being parsed. As long as the field is one contiguous run of
+ * characters of the current decoded block, it is only a range in that block, so that
+ * it can be handed to the builder without copying it.
+ */
+class FieldBuffer
+{
+public:
+    FieldBuffer()
+        : mBegin( 0 ), mEnd( 0 )
+    {
+    }
+
+    void append( const QChar *begin, const QChar *end )
+    {
+        if ( begin == mEnd ) {
+            mEnd = end;
+        } else {
+            flush();
+            mBegin = begin;
+            mEnd = end;
+        }
+    }
+
+    bool isEmpty() const
+    {
+        return mText.isEmpty() && mBegin == mEnd;
+    }
+
+    void clear()
+    {
+        mText.clear();
+        mBegin = mEnd = 0;
+    }
+
+    // Copies the pending range, which is needed before the block it points to goes away
+    void flush()
+    {
+        if ( mBegin != mEnd ) {
+            mText.append( mBegin, mEnd - mBegin );
+        }
+        mBegin = mEnd = 0;
+    }
+
+    QStringRef toStringRef( const QString &block )
+    {
+        if ( isEmpty() ) {
+            return QStringRef();
+        }
+        if ( mText.isEmpty() ) {
+            return QStringRef( &block, mBegin - block.constData(), mEnd - mBegin );
+        }
+        flush();
+        return QStringRef( &mText );
+    }
+
+private:
+    QString mText;
+    const QChar *mBegin;
+    const QChar *mEnd;
+};
+
+/**
+ * Returns the first character in [begin, end) which is a delimiter, a quote or a newline,
+ * or end if there is none. This is where the parser spends most of its time.
+ */
+static const QChar *findSpecialChar( const QChar *begin, const QChar *end, QChar delimiter, QChar textQuote )
+{
+    const ushort *it = reinterpret_cast<const ushort *>( begin );
+    const ushort *last = reinterpret_cast<const ushort *>( end );
+    const ushort delim = delimiter.unicode();
+    const ushort quote = textQuote.unicode();
+
+#ifdef __SSE2__
+    const __m128i delims = _mm_set1_epi16( delim );
+    const __m128i quotes = _mm_set1_epi16( quote );
+    const __m128i crs = _mm_set1_epi16( '\r' );
+    const __m128i lfs = _mm_set1_epi16( '\n' );
+    for ( ; last - it >= 8; it += 8 ) {
+        const __m128i chars = _mm_loadu_si128( reinterpret_cast<const __m128i *>( it ) );
+        const __m128i matches = _mm_or_si128( _mm_or_si128( _mm_cmpeq_epi16( chars, delims ), _mm_cmpeq_epi16( chars, quotes ) ),
+                                              _mm_or_si128( _mm_cmpeq_epi16( chars, crs ), _mm_cmpeq_epi16( chars, lfs ) ) );
+        const int mask = _mm_movemask_epi8( matches );
+        if ( mask != 0 ) {
+            return reinterpret_cast<const QChar *>( it + ( __builtin_ctz( mask ) / 2 ) );
+        }
+    }
+#endif
+
+    for ( ; it != last; ++it ) {
+        if ( *it == delim || *it == quote || *it == '\r' || *it == '\n' ) {
+            break;
+        }
+    }
+    return reinterpret_cast<const QChar *>( it );
+}
+
 bool QCsvReader::read( QIODevice *device )
 {
     enum State {
@@ -98,8 +207,7 @@ bool QCsvReader::read( QIODevice *device )
 
     int row, column;
 
-    QString field;
-    QChar input;
+    FieldBuffer field;
     State currentState = StartLine;
 
     row = column = 1;
@@ -114,8 +222,9 @@ bool QCsvReader::read( QIODevice *device )
         return false;
     }
 
-    QTextStream inputStream( device );
-    inputStream.setCodec( d->mCodec );
+    QScopedPointer<QTextDecoder> decoder;
+    QByteArray bytes;
+    QString block;
 
     /**
    * We use the following state machine to parse CSV:
@@ -146,113 +255,136 @@ bool QCsvReader::read( QIODevice *device )
    *   NormalField -> EmptyField [label="Delimiter"]
    *   NormalField -> NormalField [label="Other Char"]
    * }
+   *
+   * The input is read and decoded in large blocks. Within a field, runs of
+   * characters which don't change the state are skipped in one go.
    */
 
-    while ( !inputStream.atEnd() && d->mNotTerminated ) {
-        inputStream >> input;
-
-        switch ( currentState ) {
-        case StartLine:
-            if ( input == QLatin1Char( '\r' ) || input == QLatin1Char( '\n' ) ) {
-                currentState = StartLine;
-            } else if ( input == d->mTextQuote ) {
-                d->emitBeginLine( row );
-                currentState = QuotedField;
-            } else if ( input == d->mDelimiter ) {
-                d->emitBeginLine( row );
-                d->emitField( field, row, column );
-                column++;
-                currentState = EmptyField;
-            } else {
-                d->emitBeginLine( row );
-                field.append( input );
-                currentState = NormalField;
-            }
+    while ( d->mNotTerminated ) {
+        bytes.resize( s_blockSize );
+        const qint64 bytesRead = device->read( bytes.data(), bytes.size() );
+        if ( bytesRead <= 0 ) {
             break;
-        case QuotedField:
-            if ( input == QLatin1Char( '\r' ) || input == QLatin1Char( '\n' ) ) {
-                field.append( input );
-                currentState = QuotedField;
-            } else if ( input == d->mTextQuote ) {
-                currentState = QuotedFieldEnd;
-            } else if ( input == d->mDelimiter ) {
-                field.append( input );
-                currentState = QuotedField;
-            } else {
-                field.append( input );
-                currentState = QuotedField;
-            }
-            break;
-        case QuotedFieldEnd:
-            if ( input == QLatin1Char( '\r' ) || input == QLatin1Char( '\n' ) ) {
-                d->emitField( field, row, column );
-                field.clear();
-                d->emitEndLine( row );
-                column = 1;
-                row++;
-                currentState = StartLine;
-            } else if ( input == d->mTextQuote ) {
-                field.append( input );
-                currentState = QuotedField;
-            } else if ( input == d->mDelimiter ) {
-                d->emitField( field, row, column );
-                field.clear();
-                column++;
-                currentState = EmptyField;
-            } else {
-                d->emitField( field, row, column );
-                field.clear();
-                column++;
-                field.append( input );
-                currentState = EmptyField;
-            }
-            break;
-        case NormalField:
-            if ( input == QLatin1Char( '\r' ) || input == QLatin1Char( '\n' ) ) {
-                d->emitField( field, row, column );
-                field.clear();
-                d->emitEndLine( row );
-                row++;
-                column = 1;
-                currentState = StartLine;
-            } else if ( input == d->mTextQuote ) {
-                field.append( input );
-                currentState = NormalField;
-            } else if ( input == d->mDelimiter ) {
-                d->emitField( field, row, column );
-                field.clear();
-                column++;
-                currentState = EmptyField;
-            } else {
-                field.append( input );
-                currentState = NormalField;
+        }
+        bytes.resize( bytesRead );
+        if ( !decoder ) {
+            // Like QTextStream did: a byte order mark overrides the codec
+            decoder.reset( QTextCodec::codecForUtfText( bytes, d->mCodec )->makeDecoder() );
+        }
+        block = decoder->toUnicode( bytes );
+
+        const QChar *it = block.constData();
+        const QChar *end = it + block.size();
+        while ( it != end && d->mNotTerminated ) {
+            if ( currentState == NormalField || currentState == QuotedField ) {
+                const QChar *special = findSpecialChar( it, end, d->mDelimiter, d->mTextQuote );
+                if ( special != it ) {
+                    field.append( it, special );
+                    it = special;
+                    continue;
+                }
             }
-            break;
-        case EmptyField:
-            if ( input == QLatin1Char( '\r' ) || input == QLatin1Char( '\n' ) ) {
-                d->emitField( QString(), row, column );
-                field.clear();
-                d->emitEndLine( row );
-                column = 1;
-                row++;
-                currentState = StartLine;
-            } else if ( input == d->mTextQuote ) {
-                currentState = QuotedField;
-            } else if ( input == d->mDelimiter ) {
-                d->emitField( QString(), row, column );
-                column++;
-                currentState = EmptyField;
-            } else {
-                field.append( input );
-                currentState = NormalField;
+
+            const QChar input = *it;
+
+            switch ( currentState ) {
+            case StartLine:
+                if ( input == QLatin1Char( '\r' ) || input == QLatin1Char( '\n' ) ) {
+                    currentState = StartLine;
+                } else if ( input == d->mTextQuote ) {
+                    d->emitBeginLine( row );
+                    currentState = QuotedField;
+                } else if ( input == d->mDelimiter ) {
+                    d->emitBeginLine( row );
+                    d->emitField( field.toStringRef( block ), row, column );
+                    column++;
+                    currentState = EmptyField;
+                } else {
+                    d->emitBeginLine( row );
+                    field.append( it, it + 1 );
+                    currentState = NormalField;
+                }
+                break;
+            case QuotedField:
+                if ( input == d->mTextQuote ) {
+                    currentState = QuotedFieldEnd;
+                } else {
+                    field.append( it, it + 1 );
+                    currentState = QuotedField;
+                }
+                break;
+            case QuotedFieldEnd:
+                if ( input == QLatin1Char( '\r' ) || input == QLatin1Char( '\n' ) ) {
+                    d->emitField( field.toStringRef( block ), row, column );
+                    field.clear();
+                    d->emitEndLine( row );
+                    column = 1;
+                    row++;
+                    currentState = StartLine;
+                } else if ( input == d->mTextQuote ) {
+                    field.append( it, it + 1 );
+                    currentState = QuotedField;
+                } else if ( input == d->mDelimiter ) {
+                    d->emitField( field.toStringRef( block ), row, column );
+                    field.clear();
+                    column++;
+                    currentState = EmptyField;
+                } else {
+                    d->emitField( field.toStringRef( block ), row, column );
+                    field.clear();
+                    column++;
+                    field.append( it, it + 1 );
+                    currentState = EmptyField;
+                }
+                break;
+            case NormalField:
+                if ( input == QLatin1Char( '\r' ) || input == QLatin1Char( '\n' ) ) {
+                    d->emitField( field.toStringRef( block ), row, column );
+                    field.clear();
+                    d->emitEndLine( row );
+                    row++;
+                    column = 1;
+                    currentState = StartLine;
+                } else if ( input == d->mDelimiter ) {
+                    d->emitField( field.toStringRef( block ), row, column );
+                    field.clear();
+                    column++;
+                    currentState = EmptyField;
+                } else {
+                    field.append( it, it + 1 );
+                    currentState = NormalField;
+                }
+                break;
+            case EmptyField:
+                if ( input == QLatin1Char( '\r' ) || input == QLatin1Char( '\n' ) ) {
+                    d->emitField( QStringRef(), row, column );
+                    field.clear();
+                    d->emitEndLine( row );
+                    column = 1;
+                    row++;
+                    currentState = StartLine;
+                } else if ( input == d->mTextQuote ) {
+                    currentState = QuotedField;
+                } else if ( input == d->mDelimiter ) {
+                    d->emitField( QStringRef(), row, column );
+                    column++;
+                    currentState = EmptyField;
+                } else {
+                    field.append( it, it + 1 );
+                    currentState = NormalField;
+                }
+                break;
             }
-            break;
+            ++it;
         }
+
+        // The next block will replace this one
+        field.flush();
     }
 
     if ( currentState != StartLine ) {
-        if ( field.length() > 0 ) {
-            d->emitField( field, row, column );
+        if ( !field.isEmpty() ) {
+            d->emitField( field.toStringRef( block ), row, column );
             ++row;
             field.clear();
         }
@@ -381,14 +513,15 @@ void QCsvStandardBuilder::beginLine()
 
 void QCsvStandardBuilder::field( const QString &data, uint row, uint column )
 {
-    const uint size = d->mRows[ row ].size();
-    if ( column >= size ) {
-        for ( uint i = column; i < size + 1; ++i ) {
-            d->mRows[ row ].append( QString() );
+    QStringList &fields = d->mRows[ row ];
+    if ( column == uint( fields.size() ) ) {
+        fields.append( data );
+    } else {
+        while ( uint( fields.size() ) <= column ) {
+            fields.append( QString() );
         }
+        fields[ column ] = data;
     }
-
-    d->mRows[ row ][ column ] = data;
     //qDebug() << "mRows[" << row << "][" << column << "] = " << data;
 
     d->mColumnCount = qMax( d->mColumnCount, column + 1 );
@@ -406,3 +539,74 @@ void QCsvStandardBuilder::error( const QString &errorMsg )
 {
     d->mLastErrorString = errorMsg;
 }
+
+class QCsvRowBuilder::Private
+{
+public:
+    Private( const QCsvRowBuilder::RowCallback &callback )
+        : mCallback( callback ), mInLine( false )
+    {
+    }
+
+    QCsvRowBuilder::RowCallback mCallback;
+    QStringList mRow;
+    QString mLastErrorString;
+    bool mInLine;
+};
+
+QCsvRowBuilder::QCsvRowBuilder( const RowCallback &callback )
+    : d( new Private( callback ) )
+{
+}
+
+QCsvRowBuilder::~QCsvRowBuilder()
+{
+    delete d;
+}
+
+QString QCsvRowBuilder::lastErrorString() const
+{
+    return d->mLastErrorString;
+}
+
+void QCsvRowBuilder::begin()
+{
+    d->mLastErrorString.clear();
+}
+
+void QCsvRowBuilder::beginLine()
+{
+    d->mRow.clear();
+    d->mInLine = true;
+}
+
+void QCsvRowBuilder::field( const QString &data, uint row, uint column )
+{
+    Q_UNUSED( row );
+    while ( uint( d->mRow.size() ) < column ) {
+        d->mRow.append( QString() );
+    }
+    if ( column == uint( d->mRow.size() ) ) {
+        d->mRow.append( data );
+    } else {
+        d->mRow[ column ] = data;
+    }
+}
+
+void QCsvRowBuilder::endLine()
+{
+    // The reader can end the last line without having started it
+    if ( d->mInLine ) {
+        d->mInLine = false;
+        d->mCallback( d->mRow );
+    }
+}
+
+void QCsvRowBuilder::end()
+{
+}
+
+void QCsvRowBuilder::error( const QString &errorMsg )
+{
+    d->mLastErrorString = errorMsg;
+}
@@ -21,6 +21,9 @@
 #define QCSVREADER_H
 
 #include <QObject>
+#include <QStringList>
+
+#include <functional>
 
 class QIODevice;
 
@@ -60,6 +63,19 @@ public:
      */
     virtual void field( const QString &data, uint row, uint column ) = 0;
 
+    /**
+     * This method is called for every parsed field, with the data still in
+     * the reader's buffer. The reference is only valid during the call.
+     *
+     * The default implementation calls field() with a copy of the data;
+     * reimplement it to avoid the copy.
+     *
+     * @param data The data of the field.
+     * @param row The row of the field.
+     * @param column The column of the field.
+     */
+    virtual void fieldRef( const QStringRef &data, uint row, uint column );
+
     /**
      * This method is called whenever a line ends.
      */
@@ -234,4 +250,47 @@ private:
     Q_DISABLE_COPY( QCsvStandardBuilder )
 };
 
+/**
+ * @short A builder which passes each parsed row to a callback.
+ *
+ * Unlike QCsvStandardBuilder, it never holds more than one row,
+ * so files of any size can be processed while they are parsed.
+ */
+class QCsvRowBuilder : public QCsvBuilderInterface
+{
+public:
+    typedef std::function<void( const QStringList &row )> RowCallback;
+
+    /**
+     * Creates a new csv row builder, which calls @p callback for every row.
+     */
+    explicit QCsvRowBuilder( const RowCallback &callback );
+
+    /**
+     * Destroys the csv row builder.
+     */
+    ~QCsvRowBuilder() override;
+
+    /**
+     * Returns the error message of the last error.
+     */
+    QString lastErrorString() const;
+
+    /**
+     * @internal
+     */
+    void begin() override;
+    void beginLine() override;
+    void field( const QString &data, uint row, uint column ) override;
+    void endLine() override;
+    void end() override;
+    void error( const QString &errorMsg ) override;
+
+private:
+    class Private;
+    Private *const d;
+
+    Q_DISABLE_COPY( QCsvRowBuilder )
+};
+
 #endif
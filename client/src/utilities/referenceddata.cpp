@@ -54,13 +54,30 @@ class ReferencedData::Private
 {
 public:
     explicit Private(ReferencedDataType type)
-        : mType(type)
+        : mType(type), mMerging(false), mMergePos(0)
     {
     }
 
+    // While addMap is merging, the current rows are mMerged followed by the rest of mVector
+    int count() const
+    {
+        return mMerging ? mMerged.count() + mVector.count() - mMergePos : mVector.count();
+    }
+    const KeyValue &at(int row) const
+    {
+        if (mMerging) {
+            return row < mMerged.count() ? mMerged.at(row) : mVector.at(mMergePos + row - mMerged.count());
+        }
+        return mVector.at(row);
+    }
+
 public:
     KeyValueVector mVector;
     const ReferencedDataType mType;
+
+    KeyValueVector mMerged;
+    bool mMerging;
+    int mMergePos; // first row of mVector which isn't in mMerged yet
 };
 
 
@@ -138,26 +155,68 @@ void ReferencedData::setReferencedDataInternal(const QString &id, const QString
 
 void ReferencedData::addMap(const QMap<QString, QString> &idDataMap, bool emitChanges)
 {
+    if (idDataMap.isEmpty()) {
+        return;
+    }
+    // Both the map and the vector are sorted, merge them in one go, O(n + m).
+    // Each run of consecutive new rows is announced with a single pair of signals,
+    // count() and data() show the partially merged data in between, like one insertion at a time would.
+    const KeyValueVector &old = d->mVector;
+    d->mMerged.reserve(old.count() + idDataMap.count());
+    d->mMergePos = 0;
+    d->mMerging = true;
+    QVector<int> changedRows;
+
     QMap<QString, QString>::const_iterator it = idDataMap.constBegin();
     const QMap<QString, QString>::const_iterator end = idDataMap.constEnd();
-    if (d->mVector.isEmpty()) {
-        d->mVector.reserve(idDataMap.count());
-        // The vector is currently empty -> fast path
-        // The map is already sorted, we can just copy right away
-        // and emit the signals only once, which is the whole point of this method.
+    while (it != end) {
+        // Copy the existing rows which come before this key
+        const KeyValueVector::const_iterator oldIt = qLowerBound(old.constBegin() + d->mMergePos, old.constEnd(), KeyValue(it.key()));
+        const int oldRow = oldIt - old.constBegin();
+        for (int row = d->mMergePos; row < oldRow; ++row) {
+            d->mMerged.append(old.at(row));
+        }
+        d->mMergePos = oldRow;
+
+        if (oldIt != old.constEnd() && oldIt->key == it.key()) {
+            if (oldIt->value != it.value()) {
+                changedRows.append(d->mMerged.count());
+            }
+            d->mMerged.append(KeyValue(it.key(), it.value()));
+            ++d->mMergePos;
+            ++it;
+            continue;
+        }
+
+        // New keys, up to the next existing one
+        int runLength = 0;
+        QMap<QString, QString>::const_iterator runEnd = it;
+        while (runEnd != end && (oldIt == old.constEnd() || runEnd.key() < oldIt->key)) {
+            ++runEnd;
+            ++runLength;
+        }
+        const int row = d->mMerged.count();
         if (emitChanges) {
-            emit rowsAboutToBeInserted(0, idDataMap.count() - 1);
+            emit rowsAboutToBeInserted(row, row + runLength - 1);
         }
-        for ( ; it != end ; ++it) {
-            d->mVector.append(KeyValue(it.key(), it.value()));
+        for ( ; it != runEnd ; ++it) {
+            d->mMerged.append(KeyValue(it.key(), it.value()));
         }
         if (emitChanges) {
             emit rowsInserted();
         }
-    } else {
-        // Append to existing data -> slower code path
-        for ( ; it != end ; ++it) {
-            setReferencedDataInternal(it.key(), it.value(), emitChanges);
+    }
+    for (int row = d->mMergePos; row < old.count(); ++row) {
+        d->mMerged.append(old.at(row));
+    }
+
+    d->mVector.swap(d->mMerged);
+    d->mMerged.clear();
+    d->mMerging = false;
+
+    if (emitChanges) {
+        foreach (int row, changedRows) {
+            emit dataChanged(row);
         }
     }
 }
@@ -168,6 +227,12 @@ QString ReferencedData::referencedData(const QString &id) const
     if (findIt != d->mVector.constEnd()) {
         return findIt->value;
     }
+    if (d->mMerging) { // called from a slot connected to rowsInserted
+        findIt = d->mMerged.constBinaryFind(id);
+        if (findIt != d->mMerged.constEnd()) {
+            return findIt->value;
+        }
+    }
     return QString();
 }
 
@@ -188,8 +253,8 @@ void ReferencedData::removeReferencedData(const QString &id, bool emitChanges)
 
 QPair<QString, QString> ReferencedData::data(int row) const
 {
-    if (row >= 0 && row < d->mVector.count()) {
-        const KeyValue &it = d->mVector.at(row);
+    if (row >= 0 && row < d->count()) {
+        const KeyValue &it = d->at(row);
         return qMakePair(it.key, it.value);
     }
     return qMakePair(QString(), QString());
@@ -197,7 +262,7 @@ QPair<QString, QString> ReferencedData::data(int row) const
 
 int ReferencedData::count() const
 {
-    return d->mVector.count();
+    return d->count();
 }
 
 ReferencedDataType ReferencedData::dataType() const
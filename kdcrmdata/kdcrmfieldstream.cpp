@@ -0,0 +1,290 @@
+/*
+  This file is part of FatCRM, a desktop application for SugarCRM written by KDAB.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+  Authors: David Faure <david.faure@kdab.com>
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "kdcrmfieldstream.h"
+
+#include "kdcrmfields.h"
+
+#include <QHash>
+#include <QIODevice>
+
+static const quint8 s_formatVersion = 1;
+static const quint16 s_customFieldId = 0;
+static const quint16 s_endOfFieldsId = 0xffff;
+
+typedef QString (*FieldNameFunction)();
+
+// The index (plus one) is stored in payloads: only append to this list,
+// never reorder or remove anything.
+static const FieldNameFunction s_fieldNames[] = {
+    &KDCRMFields::assignedUserName,
+    &KDCRMFields::dateModified,
+    &KDCRMFields::dateEntered,
+    &KDCRMFields::id,
+    &KDCRMFields::name,
+    &KDCRMFields::modifiedUserId,
+    &KDCRMFields::modifiedByName,
+    &KDCRMFields::createdBy,
+    &KDCRMFields::createdByName,
+    &KDCRMFields::assignedUserId,
+    &KDCRMFields::accountName,
+    &KDCRMFields::campaignName,
+    &KDCRMFields::campaignType,
+    &KDCRMFields::campaignId,
+    &KDCRMFields::status,
+    &KDCRMFields::parentName,
+    &KDCRMFields::tickerSymbol,
+    &KDCRMFields::campaign,
+    &KDCRMFields::reportsTo,
+    &KDCRMFields::parentId,
+    &KDCRMFields::accountId,
+    &KDCRMFields::reportsToId,
+    &KDCRMFields::opportunityType,
+    &KDCRMFields::description,
+    &KDCRMFields::descriptionHtml,
+    &KDCRMFields::deleted,
+    &KDCRMFields::content,
+    &KDCRMFields::leadSource,
+    &KDCRMFields::amount,
+    &KDCRMFields::amountUsDollar,
+    &KDCRMFields::contactId,
+    &KDCRMFields::currencyId,
+    &KDCRMFields::currencyName,
+    &KDCRMFields::currencySymbol,
+    &KDCRMFields::dateClosed,
+    &KDCRMFields::nextStep,
+    &KDCRMFields::salesStage,
+    &KDCRMFields::probability,
+    &KDCRMFields::nextCallDate,
+    &KDCRMFields::billingAddressStreet,
+    &KDCRMFields::billingAddressCity,
+    &KDCRMFields::billingAddressState,
+    &KDCRMFields::billingAddressCountry,
+    &KDCRMFields::billingAddressPostalcode,
+    &KDCRMFields::shippingAddressStreet,
+    &KDCRMFields::shippingAddressCity,
+    &KDCRMFields::shippingAddressState,
+    &KDCRMFields::shippingAddressCountry,
+    &KDCRMFields::shippingAddressPostalcode,
+    &KDCRMFields::industry,
+    &KDCRMFields::accountType,
+    &KDCRMFields::opportunityPriority,
+    &KDCRMFields::opportunitySize,
+    &KDCRMFields::primaryAddressStreet,
+    &KDCRMFields::primaryAddressCity,
+    &KDCRMFields::primaryAddressState,
+    &KDCRMFields::primaryAddressPostalcode,
+    &KDCRMFields::primaryAddressCountry,
+    &KDCRMFields::altAddressStreet,
+    &KDCRMFields::altAddressCity,
+    &KDCRMFields::altAddressState,
+    &KDCRMFields::altAddressPostalcode,
+    &KDCRMFields::altAddressCountry,
+    &KDCRMFields::firstName,
+    &KDCRMFields::lastName,
+    &KDCRMFields::title,
+    &KDCRMFields::department,
+    &KDCRMFields::phoneHome,
+    &KDCRMFields::phoneMobile,
+    &KDCRMFields::phoneWork,
+    &KDCRMFields::phoneOther,
+    &KDCRMFields::phoneFax,
+    &KDCRMFields::birthdate,
+    &KDCRMFields::assistant,
+    &KDCRMFields::phoneAssistant,
+    &KDCRMFields::salutation,
+    &KDCRMFields::doNotCall,
+    &KDCRMFields::cAcceptStatusFields,
+    &KDCRMFields::mAcceptStatusFields,
+    &KDCRMFields::opportunityRoleFields,
+    &KDCRMFields::accountDescription,
+    &KDCRMFields::accounting,
+    &KDCRMFields::accountPhoneOther,
+    &KDCRMFields::accountPhoneWork,
+    &KDCRMFields::actualCost,
+    &KDCRMFields::annualRevenue,
+    &KDCRMFields::budget,
+    &KDCRMFields::ccAddrsNames,
+    &KDCRMFields::contactName,
+    &KDCRMFields::converted,
+    &KDCRMFields::dateDue,
+    &KDCRMFields::dateDueFlag,
+    &KDCRMFields::dateSent,
+    &KDCRMFields::dateStart,
+    &KDCRMFields::dateStartFlag,
+    &KDCRMFields::employees,
+    &KDCRMFields::endDate,
+    &KDCRMFields::expectedCost,
+    &KDCRMFields::expectedRevenue,
+    &KDCRMFields::fileMimeType,
+    &KDCRMFields::fileName,
+    &KDCRMFields::frequency,
+    &KDCRMFields::fromAddrName,
+    &KDCRMFields::impressions,
+    &KDCRMFields::leadSourceDescription,
+    &KDCRMFields::messageId,
+    &KDCRMFields::objective,
+    &KDCRMFields::opportunityAmount,
+    &KDCRMFields::opportunityId,
+    &KDCRMFields::opportunityName,
+    &KDCRMFields::ownership,
+    &KDCRMFields::parentType,
+    &KDCRMFields::portalApp,
+    &KDCRMFields::portalName,
+    &KDCRMFields::priority,
+    &KDCRMFields::rating,
+    &KDCRMFields::referedBy,
+    &KDCRMFields::referUrl,
+    &KDCRMFields::sicCode,
+    &KDCRMFields::startDate,
+    &KDCRMFields::statusDescription,
+    &KDCRMFields::trackerCount,
+    &KDCRMFields::trackerKey,
+    &KDCRMFields::trackerText,
+    &KDCRMFields::toAddrsNames,
+    &KDCRMFields::vatNo,
+    &KDCRMFields::vismaId,
+    &KDCRMFields::website,
+    &KDCRMFields::documentName,
+    &KDCRMFields::docId,
+    &KDCRMFields::docType,
+    &KDCRMFields::docUrl,
+    &KDCRMFields::activeDate,
+    &KDCRMFields::expDate,
+    &KDCRMFields::categoryId,
+    &KDCRMFields::subcategoryId,
+    &KDCRMFields::statusId,
+    &KDCRMFields::documentRevisionId,
+    &KDCRMFields::relatedDocId,
+    &KDCRMFields::relatedDocName,
+    &KDCRMFields::relatedDocRevId,
+    &KDCRMFields::isTemplate,
+    &KDCRMFields::templateType,
+    &KDCRMFields::email1,
+    &KDCRMFields::email2,
+};
+
+static const int s_fieldNameCount = sizeof(s_fieldNames) / sizeof(*s_fieldNames);
+
+typedef QHash<QString, quint16> FieldIdHash;
+Q_GLOBAL_STATIC(FieldIdHash, s_fieldIds)
+
+static const FieldIdHash &fieldIds()
+{
+    FieldIdHash &ids = *s_fieldIds();
+    if (ids.isEmpty()) {
+        ids.reserve(s_fieldNameCount);
+        for (int i = 0; i < s_fieldNameCount; ++i) {
+            ids.insert(s_fieldNames[i](), i + 1);
+        }
+    }
+    return ids;
+}
+
+quint16 KDCRMFields::fieldId(const QString &name)
+{
+    return fieldIds().value(name, s_customFieldId);
+}
+
+QString KDCRMFields::fieldName(quint16 fieldId)
+{
+    if (fieldId == s_customFieldId || fieldId > s_fieldNameCount) {
+        return QString();
+    }
+    return s_fieldNames[fieldId - 1]();
+}
+
+KDCRMFieldWriter::KDCRMFieldWriter(QIODevice *device)
+    : mStream(device)
+{
+    mStream.setVersion(QDataStream::Qt_4_8);
+    mStream << s_formatVersion;
+}
+
+void KDCRMFieldWriter::writeField(const QString &name, const QString &value)
+{
+    if (value.isEmpty()) {
+        return;
+    }
+    const quint16 id = KDCRMFields::fieldId(name);
+    mStream << id;
+    if (id == s_customFieldId) {
+        mStream << name.toUtf8();
+    }
+    mStream << value.toUtf8();
+}
+
+bool KDCRMFieldWriter::finish()
+{
+    mStream << s_endOfFieldsId;
+    return mStream.status() == QDataStream::Ok;
+}
+
+KDCRMFieldReader::KDCRMFieldReader(QIODevice *device)
+    : mStream(device),
+      mError(false)
+{
+    mStream.setVersion(QDataStream::Qt_4_8);
+    quint8 formatVersion = 0;
+    mStream >> formatVersion;
+    if (mStream.status() != QDataStream::Ok || formatVersion != s_formatVersion) {
+        mError = true;
+    }
+}
+
+bool KDCRMFieldReader::readField(QString &name, QString &value)
+{
+    while (!mError) {
+        quint16 id = s_endOfFieldsId;
+        mStream >> id;
+        if (mStream.status() != QDataStream::Ok) {
+            mError = true;
+            return false;
+        }
+        if (id == s_endOfFieldsId) {
+            return false;
+        }
+
+        if (id == s_customFieldId) {
+            QByteArray utf8Name;
+            mStream >> utf8Name;
+            name = QString::fromUtf8(utf8Name.constData(), utf8Name.size());
+        } else {
+            name = KDCRMFields::fieldName(id);
+        }
+        QByteArray utf8Value;
+        mStream >> utf8Value;
+        if (mStream.status() != QDataStream::Ok) {
+            mError = true; // truncated data
+            return false;
+        }
+        if (name.isEmpty()) {
+            continue; // a field id from a newer version, skip it
+        }
+        value = QString::fromUtf8(utf8Value.constData(), utf8Value.size());
+        return true;
+    }
+    return false;
+}
+
+bool KDCRMFieldReader::hasError() const
+{
+    return mError;
+}
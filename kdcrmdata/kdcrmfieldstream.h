@@ -0,0 +1,85 @@
+/*
+  This file is part of FatCRM, a desktop application for SugarCRM written by KDAB.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+  Authors: David Faure <david.faure@kdab.com>
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef KDCRMFIELDSTREAM_H
+#define KDCRMFIELDSTREAM_H
+
+#include "kdcrmdata_export.h"
+
+#include <QDataStream>
+#include <QString>
+
+class QIODevice;
+
+// Akonadi payload version of the Sugar* items stored in the binary format below.
+// Payloads with version 0 (the default) are XML, written by the Sugar*IO classes.
+const int KDCRMBinaryPayloadVersion = 1;
+
+// Akonadi payload part which only holds the fields needed to list notes, emails and documents
+// (id, parent, date, subject), so that the client doesn't have to fetch the full payload of all of them.
+// Always in the binary format.
+const char KDCRMHeaderPayloadPart[] = "HEAD";
+
+/**
+ * Writes name/value pairs in a compact binary format, meant for Akonadi payloads.
+ *
+ * Names from KDCRMFields are stored as a 16-bit field id, other names (custom fields)
+ * are stored as text. Empty values are skipped, the reader gets them from the default
+ * constructed object.
+ */
+class KDCRMDATA_EXPORT KDCRMFieldWriter
+{
+public:
+    explicit KDCRMFieldWriter(QIODevice *device);
+
+    void writeField(const QString &name, const QString &value);
+    // Terminates the list of fields. Returns false if writing failed.
+    bool finish();
+
+private:
+    QDataStream mStream;
+};
+
+/**
+ * Reads what KDCRMFieldWriter wrote.
+ */
+class KDCRMDATA_EXPORT KDCRMFieldReader
+{
+public:
+    explicit KDCRMFieldReader(QIODevice *device);
+
+    // Returns false at the end of the fields, or on error
+    bool readField(QString &name, QString &value);
+    bool hasError() const;
+
+private:
+    QDataStream mStream;
+    bool mError;
+};
+
+namespace KDCRMFields
+{
+    // The id of a field name in the binary format, 0 if it doesn't have one
+    KDCRMDATA_EXPORT quint16 fieldId(const QString &name);
+    // The field name for the given id, empty if unknown
+    KDCRMDATA_EXPORT QString fieldName(quint16 fieldId);
+}
+
+#endif // KDCRMFIELDSTREAM_H
@@ -0,0 +1,176 @@
+/*
+  This file is part of FatCRM, a desktop application for SugarCRM written by KDAB.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+  Authors: David Faure <david.faure@kdab.com>
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "kdcrmsearchpattern.h"
+
+#include <string.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+static inline ushort foldedUnit(ushort unit)
+{
+    if (unit < 0x80) {
+        return (unit >= 'A' && unit <= 'Z') ? unit + ('a' - 'A') : unit;
+    }
+    return QChar::toCaseFolded(unit);
+}
+
+#ifdef __SSE2__
+static inline int lowestSetBit(uint mask)
+{
+#if defined(Q_CC_GNU)
+    return __builtin_ctz(mask);
+#else
+    int bit = 0;
+    while (!(mask & 1)) {
+        mask >>= 1;
+        ++bit;
+    }
+    return bit;
+#endif
+}
+#endif
+
+// Exact search, the text and the pattern are both case-folded
+static int indexOfFolded(const ushort *text, int length, const ushort *pattern, int patternLength)
+{
+    const int lastStart = length - patternLength;
+    const ushort first = pattern[0];
+    const size_t restSize = (patternLength - 1) * sizeof(ushort);
+    int i = 0;
+#ifdef __SSE2__
+    const __m128i firstVector = _mm_set1_epi16(first);
+    // only whole blocks of possible start positions, so the loads stay within the text
+    for (; i + 8 <= lastStart + 1; i += 8) {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(text + i));
+        uint mask = _mm_movemask_epi8(_mm_cmpeq_epi16(block, firstVector));
+        while (mask) {
+            const int bit = lowestSetBit(mask);
+            const int pos = i + bit / 2;
+            if (memcmp(text + pos + 1, pattern + 1, restSize) == 0) {
+                return pos;
+            }
+            mask &= ~(3u << bit);
+        }
+    }
+#endif
+    for (; i <= lastStart; ++i) {
+        if (text[i] == first && memcmp(text + i + 1, pattern + 1, restSize) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static inline bool matchesAt(const ushort *text, const ushort *pattern, int patternLength)
+{
+    for (int k = 0; k < patternLength; ++k) {
+        if (foldedUnit(text[k]) != pattern[k]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Case-insensitive search, only the pattern is case-folded
+static bool containsFolding(const ushort *text, int length, const ushort *pattern, int patternLength)
+{
+    const int lastStart = length - patternLength;
+    const ushort first = pattern[0];
+    int i = 0;
+#ifdef __SSE2__
+    // Candidates are the ASCII characters equal to the first character of the pattern
+    // (either case), and any non-ASCII character, which is then checked by the scalar code.
+    // A non-ASCII pattern character can only come from a non-ASCII text character.
+    const bool asciiLetter = first >= 'a' && first <= 'z';
+    const __m128i firstVector = _mm_set1_epi16(first < 0x80 ? first : 0xffff);
+    const __m128i caseBit = _mm_set1_epi16(asciiLetter ? 0x20 : 0);
+    const __m128i nonAsciiBits = _mm_set1_epi16(static_cast<short>(0xff80));
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i allOnes = _mm_cmpeq_epi16(zero, zero);
+    for (; i + 8 <= lastStart + 1; i += 8) {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(text + i));
+        const __m128i sameChar = _mm_cmpeq_epi16(_mm_or_si128(block, caseBit), firstVector);
+        const __m128i ascii = _mm_cmpeq_epi16(_mm_and_si128(block, nonAsciiBits), zero);
+        const __m128i nonAscii = _mm_andnot_si128(ascii, allOnes);
+        uint mask = _mm_movemask_epi8(_mm_or_si128(sameChar, nonAscii));
+        while (mask) {
+            const int bit = lowestSetBit(mask);
+            if (matchesAt(text + i + bit / 2, pattern, patternLength)) {
+                return true;
+            }
+            mask &= ~(3u << bit);
+        }
+    }
+#endif
+    for (; i <= lastStart; ++i) {
+        if (foldedUnit(text[i]) == first && matchesAt(text + i, pattern, patternLength)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+KDCRMSearchPattern::KDCRMSearchPattern()
+{
+}
+
+KDCRMSearchPattern::KDCRMSearchPattern(const QString &pattern)
+    : mFolded(pattern.toCaseFolded())
+{
+}
+
+bool KDCRMSearchPattern::matches(const QString &text) const
+{
+    if (mFolded.isEmpty()) {
+        return true;
+    }
+    return containsFolding(text.utf16(), text.length(), mFolded.utf16(), mFolded.length());
+}
+
+bool KDCRMSearchPattern::matchesAny(const QStringList &texts) const
+{
+    if (mFolded.isEmpty()) {
+        return true;
+    }
+    const ushort *pattern = mFolded.utf16();
+    const int patternLength = mFolded.length();
+    for (QStringList::const_iterator it = texts.constBegin(); it != texts.constEnd(); ++it) {
+        if (containsFolding(it->utf16(), it->length(), pattern, patternLength)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool KDCRMSearchPattern::matchesFolded(const QString &foldedText) const
+{
+    return indexInFolded(foldedText.constData(), foldedText.length()) != -1;
+}
+
+int KDCRMSearchPattern::indexInFolded(const QChar *foldedText, int length) const
+{
+    if (mFolded.isEmpty()) {
+        return 0;
+    }
+    return indexOfFolded(reinterpret_cast<const ushort *>(foldedText), length, mFolded.utf16(), mFolded.length());
+}
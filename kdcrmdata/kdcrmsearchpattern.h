@@ -0,0 +1,62 @@
+/*
+  This file is part of FatCRM, a desktop application for SugarCRM written by KDAB.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+  Authors: David Faure <david.faure@kdab.com>
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef KDCRMSEARCHPATTERN_H
+#define KDCRMSEARCHPATTERN_H
+
+#include "kdcrmdata_export.h"
+
+#include <QString>
+#include <QStringList>
+
+/**
+ * A case-insensitive substring search, as done by the search box of the item lists.
+ *
+ * The pattern is case-folded once, then matched against many strings,
+ * scanning for its first character several characters at a time.
+ * Case folding is done per UTF-16 code unit, like QString::toCaseFolded().
+ */
+class KDCRMDATA_EXPORT KDCRMSearchPattern
+{
+public:
+    KDCRMSearchPattern();
+    explicit KDCRMSearchPattern(const QString &pattern);
+
+    bool isEmpty() const { return mFolded.isEmpty(); }
+
+    // The case-folded pattern
+    QString foldedPattern() const { return mFolded; }
+
+    // Equivalent to text.contains(pattern, Qt::CaseInsensitive)
+    bool matches(const QString &text) const;
+    // Returns true if any of the strings contains the pattern, case-insensitively
+    bool matchesAny(const QStringList &texts) const;
+
+    // Faster, for text which was already case-folded with QString::toCaseFolded()
+    bool matchesFolded(const QString &foldedText) const;
+
+    // Returns the position of the pattern in the given case-folded text, or -1
+    int indexInFolded(const QChar *foldedText, int length) const;
+
+private:
+    QString mFolded;
+};
+
+#endif
@@ -27,6 +27,8 @@
 
 #include <QDateTime>
 
+#include <string.h>
+
 #define TIMESTAMPFORMAT QLatin1String( "yyyy-MM-dd hh:mm:ss" )
 
 QDateTime KDCRMUtils::dateTimeFromString(const QString &serverTimestamp)
@@ -95,26 +97,185 @@ QString KDCRMUtils::formatDateTime(const QDateTime &dt)
 // and we get &amp;gt; for '>', etc.
 // And strangely enough, it uses &#039; instead of &apos;
 
+namespace {
+
+inline int encodedLength(ushort c)
+{
+    switch (c) {
+    case '&':
+        return 5; // &amp;
+    case '<':
+    case '>':
+        return 4; // &lt; &gt;
+    case '\'':
+    case '"':
+        return 6; // &#039; &quot;
+    default:
+        return 1;
+    }
+}
+
+inline void appendLatin1(QChar *&out, const char *str)
+{
+    while (*str) {
+        *out++ = QLatin1Char(*str++);
+    }
+}
+
+inline int digitValue(ushort c, int base)
+{
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (base == 16) {
+        if (c >= 'a' && c <= 'f') {
+            return c - 'a' + 10;
+        }
+        if (c >= 'A' && c <= 'F') {
+            return c - 'A' + 10;
+        }
+    }
+    return -1;
+}
+
+inline bool startsWith(const QChar *in, int length, const char *str, int strLength)
+{
+    if (length < strLength) {
+        return false;
+    }
+    for (int i = 0; i < strLength; ++i) {
+        if (in[i].unicode() != ushort(str[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Decodes the entity at the start of in, which is a '&', into out.
+// Returns the number of characters consumed, or 0 if this isn't an entity.
+// Decoding never produces more characters than it consumes.
+int decodeEntity(const QChar *in, int length, QChar *&out)
+{
+    struct NamedEntity {
+        const char *name;
+        int length;
+        char value;
+    };
+    static const NamedEntity namedEntities[] = {
+        { "&amp;", 5, '&' },
+        { "&lt;", 4, '<' },
+        { "&gt;", 4, '>' },
+        { "&quot;", 6, '"' },
+        { "&apos;", 6, '\'' }
+    };
+    for (const NamedEntity &entity : namedEntities) {
+        if (startsWith(in, length, entity.name, entity.length)) {
+            *out++ = QLatin1Char(entity.value);
+            return entity.length;
+        }
+    }
+
+    // Numeric character references, &#39; or &#x27;
+    if (length < 4 || in[1] != QLatin1Char('#')) {
+        return 0;
+    }
+    int i = 2;
+    int base = 10;
+    if (in[i] == QLatin1Char('x') || in[i] == QLatin1Char('X')) {
+        base = 16;
+        ++i;
+    }
+    const int firstDigit = i;
+    uint code = 0;
+    for (; i < length; ++i) {
+        const int digit = digitValue(in[i].unicode(), base);
+        if (digit < 0) {
+            break;
+        }
+        code = code * base + digit;
+        if (code > 0x10ffff) {
+            return 0;
+        }
+    }
+    if (i == firstDigit || i == length || in[i] != QLatin1Char(';')
+            || code == 0 || (code >= 0xd800 && code <= 0xdfff)) {
+        return 0;
+    }
+    if (QChar::requiresSurrogates(code)) {
+        *out++ = QChar(QChar::highSurrogate(code));
+        *out++ = QChar(QChar::lowSurrogate(code));
+    } else {
+        *out++ = QChar(ushort(code));
+    }
+    return i + 1;
+}
+
+}
+
 QString KDCRMUtils::encodeXML(const QString &str)
 {
-    QString encoded = str;
-    encoded.replace('&', "&amp;");
-    encoded.replace('<', "&lt;");
-    encoded.replace('>', "&gt;");
-    encoded.replace('\'', "&#039;");
-    encoded.replace('"', "&quot;");
+    const QChar *begin = str.constData();
+    const QChar *end = begin + str.size();
+    int encodedSize = 0;
+    for (const QChar *in = begin; in != end; ++in) {
+        encodedSize += encodedLength(in->unicode());
+    }
+    if (encodedSize == str.size()) {
+        return str;
+    }
+
+    QString encoded(encodedSize, Qt::Uninitialized);
+    QChar *out = encoded.data();
+    for (const QChar *in = begin; in != end; ++in) {
+        switch (in->unicode()) {
+        case '&':
+            appendLatin1(out, "&amp;");
+            break;
+        case '<':
+            appendLatin1(out, "&lt;");
+            break;
+        case '>':
+            appendLatin1(out, "&gt;");
+            break;
+        case '\'':
+            appendLatin1(out, "&#039;");
+            break;
+        case '"':
+            appendLatin1(out, "&quot;");
+            break;
+        default:
+            *out++ = *in;
+        }
+    }
     return encoded;
 }
 
 QString KDCRMUtils::decodeXML(const QString &str)
 {
-    QString decoded = str;
-    decoded.replace("&quot;", QChar('"'));
-    decoded.replace("&#039;", QChar('\''));
-    decoded.replace("&gt;", QChar('>'));
-    decoded.replace("&lt;", QChar('<'));
-    decoded.replace("&amp;", QChar('&'));
     // While at it, remove trailing spaces, they can be confusing with e.g. country filtering.
+    const int firstEntity = str.indexOf(QLatin1Char('&'));
+    if (firstEntity == -1) {
+        return str.trimmed();
+    }
+
+    QString decoded(str.size(), Qt::Uninitialized);
+    const QChar *in = str.constData();
+    const QChar *end = in + str.size();
+    QChar *out = decoded.data();
+    memcpy(out, in, firstEntity * sizeof(QChar));
+    in += firstEntity;
+    out += firstEntity;
+    while (in != end) {
+        if (*in == QLatin1Char('&')) {
+            const int consumed = decodeEntity(in, end - in, out);
+            if (consumed > 0) {
+                in += consumed;
+                continue;
+            }
+        }
+        *out++ = *in++;
+    }
+    decoded.resize(out - decoded.constData());
     return decoded.trimmed();
 }
 
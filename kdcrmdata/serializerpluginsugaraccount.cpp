@@ -24,6 +24,7 @@
 
 #include "sugaraccount.h"
 #include "sugaraccountio.h"
+#include "kdcrmfieldstream.h"
 
 #include <Akonadi/Item>
 
@@ -33,15 +34,16 @@ using namespace Akonadi;
 
 bool SerializerPluginSugarAccount::deserialize(Item &item, const QByteArray &label, QIODevice &data, int version)
 {
-    Q_UNUSED(version);
-
     if (label != Item::FullPayload) {
         return false;
     }
 
     SugarAccount sugarAccount;
     SugarAccountIO io;
-    if (!io.readSugarAccount(&data, sugarAccount)) {
+    // Payloads stored before the binary format was introduced are XML
+    const bool ok = version >= KDCRMBinaryPayloadVersion
+            ? io.readSugarAccountBinary(&data, sugarAccount) : io.readSugarAccount(&data, sugarAccount);
+    if (!ok) {
         return false;
     }
 
@@ -52,15 +54,14 @@ bool SerializerPluginSugarAccount::deserialize(Item &item, const QByteArray &lab
 
 void SerializerPluginSugarAccount::serialize(const Item &item, const QByteArray &label, QIODevice &data, int &version)
 {
-    Q_UNUSED(version);
-
     if (label != Item::FullPayload || !item.hasPayload<SugarAccount>()) {
         return;
     }
 
     const SugarAccount sugarAccount = item.payload<SugarAccount>();
     SugarAccountIO io;
-    io.writeSugarAccount(sugarAccount, &data);
+    io.writeSugarAccountBinary(sugarAccount, &data);
+    version = KDCRMBinaryPayloadVersion;
 }
 
 Q_EXPORT_PLUGIN2(akonadi_serializer_sugaraccount, Akonadi::SerializerPluginSugarAccount)
@@ -24,6 +24,7 @@
 
 #include "sugarcampaign.h"
 #include "sugarcampaignio.h"
+#include "kdcrmfieldstream.h"
 
 #include <Akonadi/Item>
 
@@ -33,15 +34,16 @@ using namespace Akonadi;
 
 bool SerializerPluginSugarCampaign::deserialize(Item &item, const QByteArray &label, QIODevice &data, int version)
 {
-    Q_UNUSED(version);
-
     if (label != Item::FullPayload) {
         return false;
     }
 
     SugarCampaign sugarCampaign;
     SugarCampaignIO io;
-    if (!io.readSugarCampaign(&data, sugarCampaign)) {
+    // Payloads stored before the binary format was introduced are XML
+    const bool ok = version >= KDCRMBinaryPayloadVersion
+            ? io.readSugarCampaignBinary(&data, sugarCampaign) : io.readSugarCampaign(&data, sugarCampaign);
+    if (!ok) {
         return false;
     }
 
@@ -52,15 +54,14 @@ bool SerializerPluginSugarCampaign::deserialize(Item &item, const QByteArray &la
 
 void SerializerPluginSugarCampaign::serialize(const Item &item, const QByteArray &label, QIODevice &data, int &version)
 {
-    Q_UNUSED(version);
-
     if (label != Item::FullPayload || !item.hasPayload<SugarCampaign>()) {
         return;
     }
 
     const SugarCampaign sugarCampaign = item.payload<SugarCampaign>();
     SugarCampaignIO io;
-    io.writeSugarCampaign(sugarCampaign, &data);
+    io.writeSugarCampaignBinary(sugarCampaign, &data);
+    version = KDCRMBinaryPayloadVersion;
 }
 
 Q_EXPORT_PLUGIN2(akonadi_serializer_sugarcampaign, Akonadi::SerializerPluginSugarCampaign)
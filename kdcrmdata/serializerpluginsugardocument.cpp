@@ -22,6 +22,7 @@
 
 #include "sugardocument.h"
 #include "sugardocumentio.h"
+#include "kdcrmfieldstream.h"
 
 #include <Akonadi/Item>
 
@@ -31,15 +32,24 @@ using namespace Akonadi;
 
 bool SerializerPluginSugarDocument::deserialize(Item &item, const QByteArray &label, QIODevice &data, int version)
 {
-    Q_UNUSED(version);
-
-    if (label != Item::FullPayload) {
-        return false;
-    }
-
     SugarDocument sugarDocument;
     SugarDocumentIO io;
-    if (!io.readSugarDocument(&data, sugarDocument)) {
+    if (label == KDCRMHeaderPayloadPart) {
+        // Don't replace the full payload with the partial one, if both were fetched
+        if (item.hasPayload<SugarDocument>()) {
+            return true;
+        }
+        if (!io.readSugarDocumentBinary(&data, sugarDocument)) {
+            return false;
+        }
+    } else if (label == Item::FullPayload) {
+        // Payloads stored before the binary format was introduced are XML
+        const bool ok = version >= KDCRMBinaryPayloadVersion
+                ? io.readSugarDocumentBinary(&data, sugarDocument) : io.readSugarDocument(&data, sugarDocument);
+        if (!ok) {
+            return false;
+        }
+    } else {
         return false;
     }
 
@@ -50,15 +60,29 @@ bool SerializerPluginSugarDocument::deserialize(Item &item, const QByteArray &la
 
 void SerializerPluginSugarDocument::serialize(const Item &item, const QByteArray &label, QIODevice &data, int &version)
 {
-    Q_UNUSED(version);
-
-    if (label != Item::FullPayload || !item.hasPayload<SugarDocument>()) {
+    if (!item.hasPayload<SugarDocument>()) {
         return;
     }
 
     const SugarDocument sugarDocument = item.payload<SugarDocument>();
     SugarDocumentIO io;
-    io.writeSugarDocument(sugarDocument, &data);
+    if (label == Item::FullPayload) {
+        io.writeSugarDocumentBinary(sugarDocument, &data);
+    } else if (label == KDCRMHeaderPayloadPart) {
+        io.writeSugarDocumentHeaderBinary(sugarDocument, &data);
+    } else {
+        return;
+    }
+    version = KDCRMBinaryPayloadVersion;
+}
+
+QSet<QByteArray> SerializerPluginSugarDocument::parts(const Item &item) const
+{
+    QSet<QByteArray> partIdentifiers;
+    if (item.hasPayload<SugarDocument>()) {
+        partIdentifiers << Item::FullPayload << QByteArray(KDCRMHeaderPayloadPart);
+    }
+    return partIdentifiers;
 }
 
 Q_EXPORT_PLUGIN2(akonadi_serializer_sugardocument, Akonadi::SerializerPluginSugarDocument)
@@ -24,6 +24,7 @@
 #include <Akonadi/ItemSerializerPlugin>
 
 #include <QObject>
+#include <QSet>
 
 namespace Akonadi
 {
@@ -36,6 +37,7 @@ class SerializerPluginSugarDocument : public QObject, public ItemSerializerPlugi
 public:
     bool deserialize(Item &item, const QByteArray &label, QIODevice &data, int version) override;
     void serialize(const Item &item, const QByteArray &label, QIODevice &data, int &version) override;
+    QSet<QByteArray> parts(const Item &item) const override;
 };
 
 }
@@ -24,6 +24,7 @@
 
 #include "sugaremail.h"
 #include "sugaremailio.h"
+#include "kdcrmfieldstream.h"
 
 #include <Akonadi/Item>
 
@@ -33,15 +34,24 @@ using namespace Akonadi;
 
 bool SerializerPluginSugarEmail::deserialize(Item &item, const QByteArray &label, QIODevice &data, int version)
 {
-    Q_UNUSED(version);
-
-    if (label != Item::FullPayload) {
-        return false;
-    }
-
     SugarEmail sugarEmail;
     SugarEmailIO io;
-    if (!io.readSugarEmail(&data, sugarEmail)) {
+    if (label == KDCRMHeaderPayloadPart) {
+        // Don't replace the full payload with the partial one, if both were fetched
+        if (item.hasPayload<SugarEmail>()) {
+            return true;
+        }
+        if (!io.readSugarEmailBinary(&data, sugarEmail)) {
+            return false;
+        }
+    } else if (label == Item::FullPayload) {
+        // Payloads stored before the binary format was introduced are XML
+        const bool ok = version >= KDCRMBinaryPayloadVersion
+                ? io.readSugarEmailBinary(&data, sugarEmail) : io.readSugarEmail(&data, sugarEmail);
+        if (!ok) {
+            return false;
+        }
+    } else {
         return false;
     }
 
@@ -52,15 +62,29 @@ bool SerializerPluginSugarEmail::deserialize(Item &item, const QByteArray &label
 
 void SerializerPluginSugarEmail::serialize(const Item &item, const QByteArray &label, QIODevice &data, int &version)
 {
-    Q_UNUSED(version);
-
-    if (label != Item::FullPayload || !item.hasPayload<SugarEmail>()) {
+    if (!item.hasPayload<SugarEmail>()) {
         return;
     }
 
     const SugarEmail sugarEmail = item.payload<SugarEmail>();
     SugarEmailIO io;
-    io.writeSugarEmail(sugarEmail, &data);
+    if (label == Item::FullPayload) {
+        io.writeSugarEmailBinary(sugarEmail, &data);
+    } else if (label == KDCRMHeaderPayloadPart) {
+        io.writeSugarEmailHeaderBinary(sugarEmail, &data);
+    } else {
+        return;
+    }
+    version = KDCRMBinaryPayloadVersion;
+}
+
+QSet<QByteArray> SerializerPluginSugarEmail::parts(const Item &item) const
+{
+    QSet<QByteArray> partIdentifiers;
+    if (item.hasPayload<SugarEmail>()) {
+        partIdentifiers << Item::FullPayload << QByteArray(KDCRMHeaderPayloadPart);
+    }
+    return partIdentifiers;
 }
 
 Q_EXPORT_PLUGIN2(akonadi_serializer_sugaremail, Akonadi::SerializerPluginSugarEmail)
@@ -26,6 +26,7 @@
 #include <Akonadi/ItemSerializerPlugin>
 
 #include <QObject>
+#include <QSet>
 
 namespace Akonadi
 {
@@ -38,6 +39,7 @@ class SerializerPluginSugarEmail : public QObject, public ItemSerializerPlugin
 public:
     bool deserialize(Item &item, const QByteArray &label, QIODevice &data, int version);
     void serialize(const Item &item, const QByteArray &label, QIODevice &data, int &version);
+    QSet<QByteArray> parts(const Item &item) const;
 };
 
 }
@@ -24,6 +24,7 @@
 
 #include "sugarlead.h"
 #include "sugarleadio.h"
+#include "kdcrmfieldstream.h"
 
 #include <Akonadi/Item>
 
@@ -33,15 +34,16 @@ using namespace Akonadi;
 
 bool SerializerPluginSugarLead::deserialize(Item &item, const QByteArray &label, QIODevice &data, int version)
 {
-    Q_UNUSED(version);
-
     if (label != Item::FullPayload) {
         return false;
     }
 
     SugarLead sugarLead;
     SugarLeadIO io;
-    if (!io.readSugarLead(&data, sugarLead)) {
+    // Payloads stored before the binary format was introduced are XML
+    const bool ok = version >= KDCRMBinaryPayloadVersion
+            ? io.readSugarLeadBinary(&data, sugarLead) : io.readSugarLead(&data, sugarLead);
+    if (!ok) {
         return false;
     }
 
@@ -52,15 +54,14 @@ bool SerializerPluginSugarLead::deserialize(Item &item, const QByteArray &label,
 
 void SerializerPluginSugarLead::serialize(const Item &item, const QByteArray &label, QIODevice &data, int &version)
 {
-    Q_UNUSED(version);
-
     if (label != Item::FullPayload || !item.hasPayload<SugarLead>()) {
         return;
     }
 
     const SugarLead sugarLead = item.payload<SugarLead>();
     SugarLeadIO io;
-    io.writeSugarLead(sugarLead, &data);
+    io.writeSugarLeadBinary(sugarLead, &data);
+    version = KDCRMBinaryPayloadVersion;
 }
 
 Q_EXPORT_PLUGIN2(akonadi_serializer_sugarlead, Akonadi::SerializerPluginSugarLead)
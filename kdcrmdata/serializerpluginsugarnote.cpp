@@ -24,6 +24,7 @@
 
 #include "sugarnote.h"
 #include "sugarnoteio.h"
+#include "kdcrmfieldstream.h"
 
 #include <Akonadi/Item>
 
@@ -33,15 +34,24 @@ using namespace Akonadi;
 
 bool SerializerPluginSugarNote::deserialize(Item &item, const QByteArray &label, QIODevice &data, int version)
 {
-    Q_UNUSED(version);
-
-    if (label != Item::FullPayload) {
-        return false;
-    }
-
     SugarNote sugarNote;
     SugarNoteIO io;
-    if (!io.readSugarNote(&data, sugarNote)) {
+    if (label == KDCRMHeaderPayloadPart) {
+        // Don't replace the full payload with the partial one, if both were fetched
+        if (item.hasPayload<SugarNote>()) {
+            return true;
+        }
+        if (!io.readSugarNoteBinary(&data, sugarNote)) {
+            return false;
+        }
+    } else if (label == Item::FullPayload) {
+        // Payloads stored before the binary format was introduced are XML
+        const bool ok = version >= KDCRMBinaryPayloadVersion
+                ? io.readSugarNoteBinary(&data, sugarNote) : io.readSugarNote(&data, sugarNote);
+        if (!ok) {
+            return false;
+        }
+    } else {
         return false;
     }
 
@@ -52,15 +62,29 @@ bool SerializerPluginSugarNote::deserialize(Item &item, const QByteArray &label,
 
 void SerializerPluginSugarNote::serialize(const Item &item, const QByteArray &label, QIODevice &data, int &version)
 {
-    Q_UNUSED(version);
-
-    if (label != Item::FullPayload || !item.hasPayload<SugarNote>()) {
+    if (!item.hasPayload<SugarNote>()) {
         return;
     }
 
     const SugarNote sugarNote = item.payload<SugarNote>();
     SugarNoteIO io;
-    io.writeSugarNote(sugarNote, &data);
+    if (label == Item::FullPayload) {
+        io.writeSugarNoteBinary(sugarNote, &data);
+    } else if (label == KDCRMHeaderPayloadPart) {
+        io.writeSugarNoteHeaderBinary(sugarNote, &data);
+    } else {
+        return;
+    }
+    version = KDCRMBinaryPayloadVersion;
+}
+
+QSet<QByteArray> SerializerPluginSugarNote::parts(const Item &item) const
+{
+    QSet<QByteArray> partIdentifiers;
+    if (item.hasPayload<SugarNote>()) {
+        partIdentifiers << Item::FullPayload << QByteArray(KDCRMHeaderPayloadPart);
+    }
+    return partIdentifiers;
 }
 
 Q_EXPORT_PLUGIN2(akonadi_serializer_sugarnote, Akonadi::SerializerPluginSugarNote)
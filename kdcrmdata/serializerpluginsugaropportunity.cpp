@@ -24,6 +24,7 @@
 
 #include "sugaropportunity.h"
 #include "sugaropportunityio.h"
+#include "kdcrmfieldstream.h"
 
 #include <Akonadi/Item>
 
@@ -33,15 +34,16 @@ using namespace Akonadi;
 
 bool SerializerPluginSugarOpportunity::deserialize(Item &item, const QByteArray &label, QIODevice &data, int version)
 {
-    Q_UNUSED(version);
-
     if (label != Item::FullPayload) {
         return false;
     }
 
     SugarOpportunity sugarOpportunity;
     SugarOpportunityIO io;
-    if (!io.readSugarOpportunity(&data, sugarOpportunity)) {
+    // Payloads stored before the binary format was introduced are XML
+    const bool ok = version >= KDCRMBinaryPayloadVersion
+            ? io.readSugarOpportunityBinary(&data, sugarOpportunity) : io.readSugarOpportunity(&data, sugarOpportunity);
+    if (!ok) {
         return false;
     }
 
@@ -52,15 +54,14 @@ bool SerializerPluginSugarOpportunity::deserialize(Item &item, const QByteArray
 
 void SerializerPluginSugarOpportunity::serialize(const Item &item, const QByteArray &label, QIODevice &data, int &version)
 {
-    Q_UNUSED(version);
-
     if (label != Item::FullPayload || !item.hasPayload<SugarOpportunity>()) {
         return;
     }
 
     const SugarOpportunity sugarOpportunity = item.payload<SugarOpportunity>();
     SugarOpportunityIO io;
-    io.writeSugarOpportunity(sugarOpportunity, &data);
+    io.writeSugarOpportunityBinary(sugarOpportunity, &data);
+    version = KDCRMBinaryPayloadVersion;
 }
 
 Q_EXPORT_PLUGIN2(akonadi_serializer_sugaropportunity, Akonadi::SerializerPluginSugarOpportunity)
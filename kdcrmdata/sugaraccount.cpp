@@ -39,96 +39,73 @@ public:
     {
     }
 
-    Private(const Private &other)
-        : QSharedData(other),
-          mEmpty(other.mEmpty),
-          mId(other.mId),
-          mName(other.mName),
-          mDateEntered(other.mDateEntered),
-          mDateModified(other.mDateModified),
-          mModifiedUserId(other.mModifiedUserId),
-          mModifiedByName(other.mModifiedByName),
-          mCreatedBy(other.mCreatedBy),
-          mCreatedByName(other.mCreatedByName),
-          mDescription(other.mDescription),
-          mDeleted(other.mDeleted),
-          mAssignedUserId(other.mAssignedUserId),
-          mAssignedUserName(other.mAssignedUserName),
-          mAccountType(other.mAccountType),
-          mIndustry(other.mIndustry),
-          mAnnualRevenue(other.mAnnualRevenue),
-          mPhoneFax(other.mPhoneFax),
-          mBillingAddressStreet(other.mBillingAddressStreet),
-          mBillingAddressCity(other.mBillingAddressCity),
-          mBillingAddressState(other.mBillingAddressState),
-          mBillingAddressPostalcode(other.mBillingAddressPostalcode),
-          mBillingAddressCountry(other.mBillingAddressCountry),
-          mRating(other.mRating),
-          mPhoneOffice(other.mPhoneOffice),
-          mPhoneAlternate(other.mPhoneAlternate),
-          mWebsite(other.mWebsite),
-          mOwnership(other.mOwnership),
-          mEmployees(other.mEmployees),
-          mTickerSymbol(other.mTickerSymbol),
-          mShippingAddressStreet(other.mShippingAddressStreet),
-          mShippingAddressCity(other.mShippingAddressCity),
-          mShippingAddressState(other.mShippingAddressState),
-          mShippingAddressPostalcode(other.mShippingAddressPostalcode),
-          mShippingAddressCountry(other.mShippingAddressCountry),
-          mEmail1(other.mEmail1),
-          mParentId(other.mParentId),
-          mParentName(other.mParentName),
-          mSicCode(other.mSicCode),
-          mCampaignId(other.mCampaignId),
-          mCampaignName(other.mCampaignName),
-          mCustomFields(other.mCustomFields)
-    {
-    }
-
     bool mEmpty;
 
-    QString mId;
-    QString mName;
-    QString mDateEntered;
-    QString mDateModified;
-    QString mModifiedUserId;
-    QString mModifiedByName;
-    QString mCreatedBy;
-    QString mCreatedByName;
-    QString mDescription;
-    QString mDeleted;
-    QString mAssignedUserId;
-    QString mAssignedUserName;
-    QString mAccountType;
-    QString mIndustry;
-    QString mAnnualRevenue;
-    QString mPhoneFax;
-    QString mBillingAddressStreet;
-    QString mBillingAddressCity;
-    QString mBillingAddressState;
-    QString mBillingAddressPostalcode;
-    QString mBillingAddressCountry;
-    QString mRating;
-    QString mPhoneOffice;
-    QString mPhoneAlternate;
-    QString mWebsite;
-    QString mOwnership;
-    QString mEmployees;
-    QString mTickerSymbol;
-    QString mShippingAddressStreet;
-    QString mShippingAddressCity;
-    QString mShippingAddressState;
-    QString mShippingAddressPostalcode;
-    QString mShippingAddressCountry;
-    QString mEmail1;
-    QString mParentId;
-    QString mParentName;
-    QString mSicCode;
-    QString mCampaignId;
-    QString mCampaignName;
+    QString mValues[SugarAccount::FieldCount];
     QMap<QString, QString> mCustomFields;
 };
 
+typedef QString (*FieldNameFunction)();
+
+// In the order of SugarAccount::Field
+static const FieldNameFunction s_fieldNames[] = {
+    &KDCRMFields::id,
+    &KDCRMFields::name,
+    &KDCRMFields::dateEntered,
+    &KDCRMFields::dateModified,
+    &KDCRMFields::modifiedUserId,
+    &KDCRMFields::modifiedByName,
+    &KDCRMFields::createdBy,
+    &KDCRMFields::createdByName,
+    &KDCRMFields::description,
+    &KDCRMFields::deleted,
+    &KDCRMFields::assignedUserId,
+    &KDCRMFields::assignedUserName,
+    &KDCRMFields::accountType,
+    &KDCRMFields::industry,
+    &KDCRMFields::annualRevenue,
+    &KDCRMFields::phoneFax,
+    &KDCRMFields::billingAddressStreet,
+    &KDCRMFields::billingAddressCity,
+    &KDCRMFields::billingAddressState,
+    &KDCRMFields::billingAddressPostalcode,
+    &KDCRMFields::billingAddressCountry,
+    &KDCRMFields::rating,
+    &KDCRMFields::accountPhoneWork,
+    &KDCRMFields::accountPhoneOther,
+    &KDCRMFields::website,
+    &KDCRMFields::ownership,
+    &KDCRMFields::employees,
+    &KDCRMFields::tickerSymbol,
+    &KDCRMFields::shippingAddressStreet,
+    &KDCRMFields::shippingAddressCity,
+    &KDCRMFields::shippingAddressState,
+    &KDCRMFields::shippingAddressPostalcode,
+    &KDCRMFields::shippingAddressCountry,
+    &KDCRMFields::email1,
+    &KDCRMFields::parentId,
+    &KDCRMFields::parentName,
+    &KDCRMFields::sicCode,
+    &KDCRMFields::campaignId,
+    &KDCRMFields::campaignName,
+};
+static_assert(sizeof(s_fieldNames) / sizeof(*s_fieldNames) == SugarAccount::FieldCount, "one name per field");
+
+struct FieldNames
+{
+    FieldNames()
+    {
+        for (int i = 0; i < SugarAccount::FieldCount; ++i) {
+            names[i] = s_fieldNames[i]();
+            indexes.insert(names[i], i);
+        }
+    }
+
+    QString names[SugarAccount::FieldCount];
+    QHash<QString, int> indexes;
+};
+Q_GLOBAL_STATIC(FieldNames, s_names)
+
 SugarAccount::SugarAccount()
     : d(new Private)
 {
@@ -170,7 +147,7 @@ static const int s_extensionCount = sizeof(s_extensions) / sizeof(*s_extensions)
 // E.g. HP (city: Barcelona) != HP (city: Chicago) != HP (city: London)
 bool SugarAccount::isSameAccount(const SugarAccount &other) const
 {
-    if (!d->mId.isEmpty() && !other.d->mId.isEmpty() && d->mId != other.d->mId) {
+    if (!d->mValues[Id].isEmpty() && !other.d->mValues[Id].isEmpty() && d->mValues[Id] != other.d->mValues[Id]) {
         return false;
     }
 
@@ -178,11 +155,11 @@ bool SugarAccount::isSameAccount(const SugarAccount &other) const
         return false;
     }
 
-    if (QString::compare(d->mBillingAddressCountry, other.d->mBillingAddressCountry, Qt::CaseInsensitive) != 0) {
+    if (QString::compare(d->mValues[BillingAddressCountry], other.d->mValues[BillingAddressCountry], Qt::CaseInsensitive) != 0) {
         return false;
     }
 
-    if (QString::compare(d->mBillingAddressCity, other.d->mBillingAddressCity, Qt::CaseInsensitive) != 0) {
+    if (QString::compare(d->mValues[BillingAddressCity], other.d->mValues[BillingAddressCity], Qt::CaseInsensitive) != 0) {
         return false;
     }
 
@@ -191,12 +168,12 @@ bool SugarAccount::isSameAccount(const SugarAccount &other) const
 
 QString SugarAccount::key() const
 {
-    return cleanAccountName() + '_' + d->mBillingAddressCountry + '_' + d->mBillingAddressCity;
+    return cleanAccountName() + '_' + d->mValues[BillingAddressCountry] + '_' + d->mValues[BillingAddressCity];
 }
 
 QString SugarAccount::cleanAccountName() const
 {
-    QString result = d->mName;
+    QString result = d->mValues[Name];
     for (int i = 0; i < s_extensionCount; ++i) {
         const QString extension = s_extensions[i];
         result.remove(", " + extension + '.', Qt::CaseInsensitive);
@@ -218,22 +195,22 @@ QString SugarAccount::cleanAccountName() const
 
 QString SugarAccount::countryForGui() const
 {
-    const QString billingCountry = d->mBillingAddressCountry;
-    const QString country = billingCountry.isEmpty() ? d->mShippingAddressCountry : billingCountry;
+    const QString billingCountry = d->mValues[BillingAddressCountry];
+    const QString country = billingCountry.isEmpty() ? d->mValues[ShippingAddressCountry] : billingCountry;
     return country.trimmed();
 }
 
 QString SugarAccount::cityForGui() const
 {
-    const QString billingCity = d->mBillingAddressCity;
-    const QString city = billingCity.isEmpty() ? d->mShippingAddressCity : billingCity;
+    const QString billingCity = d->mValues[BillingAddressCity];
+    const QString city = billingCity.isEmpty() ? d->mValues[ShippingAddressCity] : billingCity;
     return city.trimmed();
 }
 
 QString SugarAccount::postalCodeForGui() const
 {
-    const QString billingPostalcode = d->mBillingAddressPostalcode;
-    const QString postalCode = billingPostalcode.isEmpty() ? d->mShippingAddressPostalcode : billingPostalcode;
+    const QString billingPostalcode = d->mValues[BillingAddressPostalcode];
+    const QString postalCode = billingPostalcode.isEmpty() ? d->mValues[ShippingAddressPostalcode] : billingPostalcode;
     return postalCode.trimmed();
 }
 
@@ -247,438 +224,459 @@ void SugarAccount::clear()
     *this = SugarAccount();
 }
 
+QString SugarAccount::value(Field field) const
+{
+    return d->mValues[field];
+}
+
+void SugarAccount::setValue(Field field, const QString &value)
+{
+    d->mEmpty = false;
+    d->mValues[field] = value;
+}
+
+QString SugarAccount::fieldName(Field field)
+{
+    return s_names()->names[field];
+}
+
+int SugarAccount::fieldIndex(const QString &name)
+{
+    return s_names()->indexes.value(name, -1);
+}
+
 void SugarAccount::setId(const QString &id)
 {
     d->mEmpty = false;
-    d->mId = id;
+    d->mValues[Id] = id;
 }
 
 QString SugarAccount::id() const
 {
-    return d->mId;
+    return d->mValues[Id];
 }
 
 void SugarAccount::setName(const QString &name)
 {
     d->mEmpty = false;
-    d->mName = name;
+    d->mValues[Name] = name;
 }
 
 QString SugarAccount::name() const
 {
-    return d->mName;
+    return d->mValues[Name];
 }
 
 void SugarAccount::setDateEntered(const QString &value)
 {
     d->mEmpty = false;
-    d->mDateEntered = value;
+    d->mValues[DateEntered] = value;
 }
 
 QString SugarAccount::dateEntered() const
 {
-    return d->mDateEntered;
+    return d->mValues[DateEntered];
 }
 
 void SugarAccount::setDateModified(const QString &value)
 {
     d->mEmpty = false;
-    d->mDateModified = value;
+    d->mValues[DateModified] = value;
 }
 
 QString SugarAccount::dateModified() const
 {
-    return d->mDateModified;
+    return d->mValues[DateModified];
 }
 
 void SugarAccount::setModifiedUserId(const QString &value)
 {
     d->mEmpty = false;
-    d->mModifiedUserId = value;
+    d->mValues[ModifiedUserId] = value;
 }
 
 QString SugarAccount::modifiedUserId() const
 {
-    return d->mModifiedUserId;
+    return d->mValues[ModifiedUserId];
 }
 
 void SugarAccount::setModifiedByName(const QString &value)
 {
     d->mEmpty = false;
-    d->mModifiedByName = value;
+    d->mValues[ModifiedByName] = value;
 }
 
 QString SugarAccount::modifiedByName() const
 {
-    return d->mModifiedByName;
+    return d->mValues[ModifiedByName];
 }
 
 void SugarAccount::setCreatedBy(const QString &value)
 {
     d->mEmpty = false;
-    d->mCreatedBy = value;
+    d->mValues[CreatedBy] = value;
 }
 
 QString SugarAccount::createdBy() const
 {
-    return d->mCreatedBy;
+    return d->mValues[CreatedBy];
 }
 
 void SugarAccount::setCreatedByName(const QString &value)
 {
     d->mEmpty = false;
-    d->mCreatedByName = value;
+    d->mValues[CreatedByName] = value;
 }
 
 QString SugarAccount::createdByName() const
 {
-    return d->mCreatedByName;
+    return d->mValues[CreatedByName];
 }
 
 void SugarAccount::setDescription(const QString &value)
 {
     d->mEmpty = false;
-    d->mDescription = value;
+    d->mValues[Description] = value;
 }
 
 QString SugarAccount::description() const
 {
-    return d->mDescription;
+    return d->mValues[Description];
 }
 
 QString SugarAccount::limitedDescription(int wantedParagraphs) const
 {
-    return KDCRMUtils::limitString(d->mDescription, wantedParagraphs);
+    return KDCRMUtils::limitString(d->mValues[Description], wantedParagraphs);
 }
 
 void SugarAccount::setDeleted(const QString &value)
 {
     d->mEmpty = false;
-    d->mDeleted = value;
+    d->mValues[Deleted] = value;
 }
 
 QString SugarAccount::deleted() const
 {
-    return d->mDeleted;
+    return d->mValues[Deleted];
 }
 
 void SugarAccount::setAssignedUserId(const QString &value)
 {
     d->mEmpty = false;
-    d->mAssignedUserId = value;
+    d->mValues[AssignedUserId] = value;
 }
 
 QString SugarAccount::assignedUserId() const
 {
-    return d->mAssignedUserId;
+    return d->mValues[AssignedUserId];
 }
 
 void SugarAccount::setAssignedUserName(const QString &value)
 {
     d->mEmpty = false;
-    d->mAssignedUserName = value;
+    d->mValues[AssignedUserName] = value;
 }
 
 QString SugarAccount::assignedUserName() const
 {
-    return d->mAssignedUserName;
+    return d->mValues[AssignedUserName];
 }
 
 void SugarAccount::setAccountType(const QString &value)
 {
     d->mEmpty = false;
-    d->mAccountType = value;
+    d->mValues[AccountType] = value;
 }
 
 QString SugarAccount::accountType() const
 {
-    return d->mAccountType;
+    return d->mValues[AccountType];
 }
 
 void SugarAccount::setIndustry(const QString &value)
 {
     d->mEmpty = false;
-    d->mIndustry = value;
+    d->mValues[Industry] = value;
 }
 
 QString SugarAccount::industry() const
 {
-    return d->mIndustry;
+    return d->mValues[Industry];
 }
 
 void SugarAccount::setAnnualRevenue(const QString &value)
 {
     d->mEmpty = false;
-    d->mAnnualRevenue = value;
+    d->mValues[AnnualRevenue] = value;
 }
 
 QString SugarAccount::annualRevenue() const
 {
-    return d->mAnnualRevenue;
+    return d->mValues[AnnualRevenue];
 }
 
 void SugarAccount::setPhoneFax(const QString &value)
 {
     d->mEmpty = false;
-    d->mPhoneFax = value;
+    d->mValues[PhoneFax] = value;
 }
 
 QString SugarAccount::phoneFax() const
 {
-    return d->mPhoneFax;
+    return d->mValues[PhoneFax];
 }
 
 void SugarAccount::setBillingAddressStreet(const QString &value)
 {
     d->mEmpty = false;
-    d->mBillingAddressStreet = value;
+    d->mValues[BillingAddressStreet] = value;
 }
 
 QString SugarAccount::billingAddressStreet() const
 {
-    return d->mBillingAddressStreet;
+    return d->mValues[BillingAddressStreet];
 }
 
 void SugarAccount::setBillingAddressCity(const QString &value)
 {
     d->mEmpty = false;
-    d->mBillingAddressCity = value;
+    d->mValues[BillingAddressCity] = value;
 }
 
 QString SugarAccount::billingAddressCity() const
 {
-    return d->mBillingAddressCity;
+    return d->mValues[BillingAddressCity];
 }
 
 void SugarAccount::setBillingAddressState(const QString &value)
 {
     d->mEmpty = false;
-    d->mBillingAddressState = value;
+    d->mValues[BillingAddressState] = value;
 }
 
 QString SugarAccount::billingAddressState() const
 {
-    return d->mBillingAddressState;
+    return d->mValues[BillingAddressState];
 }
 
 void SugarAccount::setBillingAddressPostalcode(const QString &value)
 {
     d->mEmpty = false;
-    d->mBillingAddressPostalcode = value;
+    d->mValues[BillingAddressPostalcode] = value;
 }
 
 QString SugarAccount::billingAddressPostalcode() const
 {
-    return d->mBillingAddressPostalcode;
+    return d->mValues[BillingAddressPostalcode];
 }
 
 void SugarAccount::setBillingAddressCountry(const QString &value)
 {
     d->mEmpty = false;
-    d->mBillingAddressCountry = value;
+    d->mValues[BillingAddressCountry] = value;
 }
 
 QString SugarAccount::billingAddressCountry() const
 {
-    return d->mBillingAddressCountry;
+    return d->mValues[BillingAddressCountry];
 }
 
 void SugarAccount::setRating(const QString &value)
 {
     d->mEmpty = false;
-    d->mRating = value;
+    d->mValues[Rating] = value;
 }
 
 QString SugarAccount::rating() const
 {
-    return d->mRating;
+    return d->mValues[Rating];
 }
 
 void SugarAccount::setPhoneOffice(const QString &value)
 {
     d->mEmpty = false;
-    d->mPhoneOffice = value;
+    d->mValues[PhoneOffice] = value;
 }
 
 QString SugarAccount::phoneOffice() const
 {
-    return d->mPhoneOffice;
+    return d->mValues[PhoneOffice];
 }
 
 void SugarAccount::setPhoneAlternate(const QString &value)
 {
     d->mEmpty = false;
-    d->mPhoneAlternate = value;
+    d->mValues[PhoneAlternate] = value;
 }
 
 QString SugarAccount::phoneAlternate() const
 {
-    return d->mPhoneAlternate;
+    return d->mValues[PhoneAlternate];
 }
 
 void SugarAccount::setWebsite(const QString &value)
 {
     d->mEmpty = false;
-    d->mWebsite = value;
+    d->mValues[Website] = value;
 }
 
 QString SugarAccount::website() const
 {
-    return d->mWebsite;
+    return d->mValues[Website];
 }
 
 void SugarAccount::setOwnership(const QString &value)
 {
     d->mEmpty = false;
-    d->mOwnership = value;
+    d->mValues[Ownership] = value;
 }
 
 QString SugarAccount::ownership() const
 {
-    return d->mOwnership;
+    return d->mValues[Ownership];
 }
 
 void SugarAccount::setEmployees(const QString &value)
 {
     d->mEmpty = false;
-    d->mEmployees = value;
+    d->mValues[Employees] = value;
 }
 
 QString SugarAccount::employees() const
 {
-    return d->mEmployees;
+    return d->mValues[Employees];
 }
 
 void SugarAccount::setTickerSymbol(const QString &value)
 {
     d->mEmpty = false;
-    d->mTickerSymbol = value;
+    d->mValues[TickerSymbol] = value;
 }
 
 QString SugarAccount::tickerSymbol() const
 {
-    return d->mTickerSymbol;
+    return d->mValues[TickerSymbol];
 }
 
 void SugarAccount::setShippingAddressStreet(const QString &value)
 {
     d->mEmpty = false;
-    d->mShippingAddressStreet = value;
+    d->mValues[ShippingAddressStreet] = value;
 }
 
 QString SugarAccount::shippingAddressStreet() const
 {
-    return d->mShippingAddressStreet;
+    return d->mValues[ShippingAddressStreet];
 }
 
 void SugarAccount::setShippingAddressCity(const QString &value)
 {
     d->mEmpty = false;
-    d->mShippingAddressCity = value;
+    d->mValues[ShippingAddressCity] = value;
 }
 
 QString SugarAccount::shippingAddressCity() const
 {
-    return d->mShippingAddressCity;
+    return d->mValues[ShippingAddressCity];
 }
 
 void SugarAccount::setShippingAddressState(const QString &value)
 {
     d->mEmpty = false;
-    d->mShippingAddressState = value;
+    d->mValues[ShippingAddressState] = value;
 }
 
 QString SugarAccount::shippingAddressState() const
 {
-    return d->mShippingAddressState;
+    return d->mValues[ShippingAddressState];
 }
 
 void SugarAccount::setShippingAddressPostalcode(const QString &value)
 {
     d->mEmpty = false;
-    d->mShippingAddressPostalcode = value;
+    d->mValues[ShippingAddressPostalcode] = value;
 }
 
 QString SugarAccount::shippingAddressPostalcode() const
 {
-    return d->mShippingAddressPostalcode;
+    return d->mValues[ShippingAddressPostalcode];
 }
 
 void SugarAccount::setShippingAddressCountry(const QString &value)
 {
     d->mEmpty = false;
-    d->mShippingAddressCountry = value;
+    d->mValues[ShippingAddressCountry] = value;
 }
 
 QString SugarAccount::shippingAddressCountry() const
 {
-    return d->mShippingAddressCountry;
+    return d->mValues[ShippingAddressCountry];
 }
 
 void SugarAccount::setEmail1(const QString &value)
 {
     d->mEmpty = false;
-    d->mEmail1 = value;
+    d->mValues[Email1] = value;
 }
 
 QString SugarAccount::email1() const
 {
-    return d->mEmail1;
+    return d->mValues[Email1];
 }
 
 void SugarAccount::setParentId(const QString &value)
 {
     d->mEmpty = false;
-    d->mParentId = value;
+    d->mValues[ParentId] = value;
 }
 
 QString SugarAccount::parentId() const
 {
-    return d->mParentId;
+    return d->mValues[ParentId];
 }
 
 void SugarAccount::setParentName(const QString &value)
 {
     d->mEmpty = false;
-    d->mParentName = value;
+    d->mValues[ParentName] = value;
 }
 
 QString SugarAccount::parentName() const
 {
-    return d->mParentName;
+    return d->mValues[ParentName];
 }
 
 void SugarAccount::setSicCode(const QString &value)
 {
     d->mEmpty = false;
-    d->mSicCode = value;
+    d->mValues[SicCode] = value;
 }
 
 QString SugarAccount::sicCode() const
 {
-    return d->mSicCode;
+    return d->mValues[SicCode];
 }
 
 void SugarAccount::setCampaignId(const QString &value)
 {
     d->mEmpty = false;
-    d->mCampaignId = value;
+    d->mValues[CampaignId] = value;
 }
 
 QString SugarAccount::campaignId() const
 {
-    return d->mCampaignId;
+    return d->mValues[CampaignId];
 }
 
 void SugarAccount::setCampaignName(const QString &value)
 {
     d->mEmpty = false;
-    d->mCampaignName = value;
+    d->mValues[CampaignName] = value;
 }
 
 QString SugarAccount::campaignName() const
 {
-    return d->mCampaignName;
+    return d->mValues[CampaignName];
 }
 
 void SugarAccount::setCustomField(const QString &name, const QString &value)
@@ -699,6 +697,11 @@ void SugarAccount::setData(const QMap<QString, QString>& data)
     const SugarAccount::AccessorHash accessors = SugarAccount::accessorHash();
     QMap<QString, QString>::const_iterator it = data.constBegin();
     for ( ; it != data.constEnd() ; ++it) {
+        const int index = fieldIndex(it.key());
+        if (index >= 0) {
+            d->mValues[index] = it.value();
+            continue;
+        }
         const SugarAccount::AccessorHash::const_iterator accessIt = accessors.constFind(it.key());
         if (accessIt != accessors.constEnd()) {
             (this->*(accessIt.value().setter))(it.value());
@@ -706,30 +709,17 @@ void SugarAccount::setData(const QMap<QString, QString>& data)
             d->mCustomFields.insert(it.key(), it.value());
         }
     }
-
-    // equivalent to this, but fully automated:
-    //d->mId = data.value("id");
-    //d->mName = data.value("name");
-    // ...
 }
 
 QMap<QString, QString> SugarAccount::data() const
 {
     QMap<QString, QString> data;
 
-    const SugarAccount::AccessorHash accessors = SugarAccount::accessorHash();
-    SugarAccount::AccessorHash::const_iterator it    = accessors.constBegin();
-    SugarAccount::AccessorHash::const_iterator endIt = accessors.constEnd();
-    for (; it != endIt; ++it) {
-        const SugarAccount::valueGetter getter = (*it).getter;
-        data.insert(it.key(), (this->*getter)());
+    const FieldNames *fieldNames = s_names();
+    for (int i = 0; i < FieldCount; ++i) {
+        data.insert(fieldNames->names[i], d->mValues[i]);
     }
 
-    // equivalent to this, but fully automated:
-    //data.insert("id", d->mId);
-    //data.insert("name", d->mName);
-    // ...
-
     // plus custom fields
     QMap<QString, QString>::const_iterator cit = d->mCustomFields.constBegin();
     const QMap<QString, QString>::const_iterator end = d->mCustomFields.constEnd();
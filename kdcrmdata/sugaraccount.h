@@ -117,6 +117,70 @@ private:
     bool operator!=(const SugarAccount &) const;
 public:
 
+    /**
+      The fields stored as plain strings, as indexes for value() and setValue().
+     */
+    enum Field {
+        Id = 0,
+        Name,
+        DateEntered,
+        DateModified,
+        ModifiedUserId,
+        ModifiedByName,
+        CreatedBy,
+        CreatedByName,
+        Description,
+        Deleted,
+        AssignedUserId,
+        AssignedUserName,
+        AccountType,
+        Industry,
+        AnnualRevenue,
+        PhoneFax,
+        BillingAddressStreet,
+        BillingAddressCity,
+        BillingAddressState,
+        BillingAddressPostalcode,
+        BillingAddressCountry,
+        Rating,
+        PhoneOffice,
+        PhoneAlternate,
+        Website,
+        Ownership,
+        Employees,
+        TickerSymbol,
+        ShippingAddressStreet,
+        ShippingAddressCity,
+        ShippingAddressState,
+        ShippingAddressPostalcode,
+        ShippingAddressCountry,
+        Email1,
+        ParentId,
+        ParentName,
+        SicCode,
+        CampaignId,
+        CampaignName,
+        FieldCount
+    };
+
+    /**
+      Return the value of the given field.
+     */
+    QString value(Field field) const;
+    /**
+      Set the value of the given field.
+     */
+    void setValue(Field field, const QString &value);
+
+    /**
+      Return the name of the given field, as in KDCRMFields.
+     */
+    static QString fieldName(Field field);
+    /**
+      Return the Field for the given name (from KDCRMFields), or -1 if there's none (e.g. custom fields).
+     */
+    static int fieldIndex(const QString &name);
+
     /**
       Return, if the SugarAccount entry is empty.
      */
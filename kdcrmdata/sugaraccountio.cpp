@@ -22,6 +22,7 @@
 
 #include "sugaraccountio.h"
 #include "sugaraccount.h"
+#include "kdcrmfieldstream.h"
 
 #include <KLocalizedString>
 #include <QDebug>
@@ -30,6 +31,16 @@
 #include <QIODevice>
 #include <QXmlStreamWriter>
 
+static void setAccountField(SugarAccount &account, const QString &key, const QString &value)
+{
+    const int index = SugarAccount::fieldIndex(key);
+    if (index >= 0) {
+        account.setValue(static_cast<SugarAccount::Field>(index), value);
+    } else {
+        account.setCustomField(key, value);
+    }
+}
+
 SugarAccountIO::SugarAccountIO()
 {
 }
@@ -64,18 +75,12 @@ QString SugarAccountIO::errorString() const
 
 void SugarAccountIO::readAccount(SugarAccount &account)
 {
-    const SugarAccount::AccessorHash accessors = SugarAccount::accessorHash();
     Q_ASSERT(xml.isStartElement() && xml.name() == "sugarAccount");
 
     while (xml.readNextStartElement()) {
         const QString key = xml.name().toString();
         const QString value = xml.readElementText();
-        const SugarAccount::AccessorHash::const_iterator accessIt = accessors.constFind(key);
-        if (accessIt != accessors.constEnd()) {
-            (account.*(accessIt.value().setter))(value);
-        } else {
-            account.setCustomField(key, value);
-        }
+        setAccountField(account, key, value);
     }
 }
 
@@ -92,12 +97,9 @@ bool SugarAccountIO::writeSugarAccount(const SugarAccount &account, QIODevice *d
     writer.writeStartElement("sugarAccount");
     writer.writeAttribute("version", "1.0");
 
-    const SugarAccount::AccessorHash accessors = SugarAccount::accessorHash();
-    SugarAccount::AccessorHash::const_iterator it    = accessors.constBegin();
-    SugarAccount::AccessorHash::const_iterator endIt = accessors.constEnd();
-    for (; it != endIt; ++it) {
-        const SugarAccount::valueGetter getter = (*it).getter;
-        writer.writeTextElement(it.key(), (account.*getter)());
+    for (int i = 0; i < SugarAccount::FieldCount; ++i) {
+        const SugarAccount::Field field = static_cast<SugarAccount::Field>(i);
+        writer.writeTextElement(SugarAccount::fieldName(field), account.value(field));
     }
 
     // plus custom fields
@@ -112,3 +114,42 @@ bool SugarAccountIO::writeSugarAccount(const SugarAccount &account, QIODevice *d
 
     return true;
 }
+
+bool SugarAccountIO::readSugarAccountBinary(QIODevice *device, SugarAccount &account)
+{
+    if (device == nullptr || !device->isReadable()) {
+        return false;
+    }
+
+    account = SugarAccount();
+    KDCRMFieldReader reader(device);
+    QString key;
+    QString value;
+    while (reader.readField(key, value)) {
+        setAccountField(account, key, value);
+    }
+    return !reader.hasError();
+}
+
+bool SugarAccountIO::writeSugarAccountBinary(const SugarAccount &account, QIODevice *device)
+{
+    if (device == nullptr || !device->isWritable()) {
+        return false;
+    }
+
+    KDCRMFieldWriter writer(device);
+    for (int i = 0; i < SugarAccount::FieldCount; ++i) {
+        const SugarAccount::Field field = static_cast<SugarAccount::Field>(i);
+        writer.writeField(SugarAccount::fieldName(field), account.value(field));
+    }
+
+    // plus custom fields
+    const QMap<QString, QString> customFields = account.customFields();
+    QMap<QString, QString>::const_iterator cit = customFields.constBegin();
+    const QMap<QString, QString>::const_iterator end = customFields.constEnd();
+    for ( ; cit != end ; ++cit ) {
+        writer.writeField(cit.key(), cit.value());
+    }
+
+    return writer.finish();
+}
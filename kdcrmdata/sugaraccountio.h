@@ -35,6 +35,9 @@ public:
     SugarAccountIO();
     bool readSugarAccount(QIODevice *device, SugarAccount &account);
     bool writeSugarAccount(const SugarAccount &account, QIODevice *device);
+    // Compact binary format (see KDCRMFieldWriter), used for the Akonadi payloads
+    bool readSugarAccountBinary(QIODevice *device, SugarAccount &account);
+    bool writeSugarAccountBinary(const SugarAccount &account, QIODevice *device);
     QString errorString() const;
 
 private:
@@ -22,6 +22,7 @@
 
 #include "sugarcampaignio.h"
 #include "sugarcampaign.h"
+#include "kdcrmfieldstream.h"
 #include "kdcrmfields.h"
 
 #include <KLocalizedString>
@@ -29,6 +30,18 @@
 #include <QIODevice>
 #include <QXmlStreamWriter>
 
+static void setCampaignField(SugarCampaign &campaign, const SugarCampaign::AccessorHash &accessors,
+                             const QString &key, const QString &value)
+{
+    const SugarCampaign::AccessorHash::const_iterator accessIt = accessors.constFind(key);
+    if (accessIt != accessors.constEnd()) {
+        (campaign.*(accessIt.value().setter))(value);
+    } else {
+        //TODO: add custom field support
+        //campaign.setCustomField(key, value);
+    }
+}
+
 SugarCampaignIO::SugarCampaignIO()
 {
 }
@@ -69,13 +82,7 @@ void SugarCampaignIO::readCampaign(SugarCampaign &campaign)
     while (xml.readNextStartElement()) {
         const QString key = xml.name().toString();
         const QString value = xml.readElementText();
-        const SugarCampaign::AccessorHash::const_iterator accessIt = accessors.constFind(key);
-        if (accessIt != accessors.constEnd()) {
-            (campaign.*(accessIt.value().setter))(value);
-        } else {
-            //TODO: add custom field support
-            //campaign.setCustomField(key, value);
-        }
+        setCampaignField(campaign, accessors, key, value);
     }
 }
 
@@ -114,3 +121,38 @@ bool SugarCampaignIO::writeSugarCampaign(const SugarCampaign &campaign, QIODevic
 
     return true;
 }
+
+bool SugarCampaignIO::readSugarCampaignBinary(QIODevice *device, SugarCampaign &campaign)
+{
+    if (device == nullptr || !device->isReadable()) {
+        return false;
+    }
+
+    campaign = SugarCampaign();
+    const SugarCampaign::AccessorHash accessors = SugarCampaign::accessorHash();
+    KDCRMFieldReader reader(device);
+    QString key;
+    QString value;
+    while (reader.readField(key, value)) {
+        setCampaignField(campaign, accessors, key, value);
+    }
+    return !reader.hasError();
+}
+
+bool SugarCampaignIO::writeSugarCampaignBinary(const SugarCampaign &campaign, QIODevice *device)
+{
+    if (device == nullptr || !device->isWritable()) {
+        return false;
+    }
+
+    KDCRMFieldWriter writer(device);
+    const SugarCampaign::AccessorHash accessors = SugarCampaign::accessorHash();
+    SugarCampaign::AccessorHash::const_iterator it = accessors.constBegin();
+    const SugarCampaign::AccessorHash::const_iterator endIt = accessors.constEnd();
+    for (; it != endIt; ++it) {
+        const SugarCampaign::valueGetter getter = (*it).getter;
+        writer.writeField(it.key(), (campaign.*getter)());
+    }
+
+    return writer.finish();
+}
@@ -35,6 +35,9 @@ public:
     SugarCampaignIO();
     bool readSugarCampaign(QIODevice *device, SugarCampaign &campaign);
     bool writeSugarCampaign(const SugarCampaign &campaign, QIODevice *device);
+    // Compact binary format (see KDCRMFieldWriter), used for the Akonadi payloads
+    bool readSugarCampaignBinary(QIODevice *device, SugarCampaign &campaign);
+    bool writeSugarCampaignBinary(const SugarCampaign &campaign, QIODevice *device);
     QString errorString() const;
 
 private:
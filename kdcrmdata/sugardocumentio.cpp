@@ -20,6 +20,8 @@
 
 #include "sugardocumentio.h"
 #include "sugardocument.h"
+#include "kdcrmfieldstream.h"
+#include "kdcrmfields.h"
 
 #include <KLocalizedString>
 #include <QDebug>
@@ -31,6 +33,23 @@
 static const char s_linkedAccountIdsKey[] = "linked_account_ids";
 static const char s_linkedOpportunityIdsKey[] = "linked_opportunity_ids";
 
+static void setDocumentField(SugarDocument &document, const SugarDocument::AccessorHash &accessors,
+                             const QString &key, const QString &value)
+{
+    const SugarDocument::AccessorHash::const_iterator accessIt = accessors.constFind(key);
+    if (accessIt != accessors.constEnd()) {
+        (document.*(accessIt.value().setter))(value);
+    } else if (key == QLatin1String(s_linkedAccountIdsKey)) {
+        const QStringList ids = value.split(QLatin1Char(','));
+        document.setLinkedAccountIds(ids);
+    } else if (key == QLatin1String(s_linkedOpportunityIdsKey)) {
+        const QStringList ids = value.split(QLatin1Char(','));
+        document.setLinkedOpportunityIds(ids);
+    } else {
+        document.setCustomField(key, value);
+    }
+}
+
 SugarDocumentIO::SugarDocumentIO()
 {
 }
@@ -71,20 +90,7 @@ void SugarDocumentIO::readDocument(SugarDocument &document)
     while (xml.readNextStartElement()) {
         const QString key = xml.name().toString();
         const QString value = xml.readElementText();
-        const SugarDocument::AccessorHash::const_iterator accessIt = accessors.constFind(key);
-        if (accessIt != accessors.constEnd()) {
-            (document.*(accessIt.value().setter))(value);
-        } else {
-            if (key == QLatin1String(s_linkedAccountIdsKey)) {
-                const QStringList ids = value.split(QLatin1Char(','));
-                document.setLinkedAccountIds(ids);
-            } else if (key == QLatin1String(s_linkedOpportunityIdsKey)) {
-                const QStringList ids = value.split(QLatin1Char(','));
-                document.setLinkedOpportunityIds(ids);
-            } else {
-                document.setCustomField(key, value);
-            }
-        }
+        setDocumentField(document, accessors, key, value);
     }
 }
 
@@ -127,3 +133,57 @@ bool SugarDocumentIO::writeSugarDocument(const SugarDocument &document, QIODevic
 
     return true;
 }
+
+bool SugarDocumentIO::readSugarDocumentBinary(QIODevice *device, SugarDocument &document)
+{
+    if (device == nullptr || !device->isReadable()) {
+        return false;
+    }
+
+    document = SugarDocument();
+    const SugarDocument::AccessorHash accessors = SugarDocument::accessorHash();
+    KDCRMFieldReader reader(device);
+    QString key;
+    QString value;
+    while (reader.readField(key, value)) {
+        setDocumentField(document, accessors, key, value);
+    }
+    return !reader.hasError();
+}
+
+bool SugarDocumentIO::writeSugarDocumentBinary(const SugarDocument &document, QIODevice *device)
+{
+    if (device == nullptr || !device->isWritable()) {
+        return false;
+    }
+
+    KDCRMFieldWriter writer(device);
+    const SugarDocument::AccessorHash accessors = SugarDocument::accessorHash();
+    SugarDocument::AccessorHash::const_iterator it = accessors.constBegin();
+    const SugarDocument::AccessorHash::const_iterator endIt = accessors.constEnd();
+    for (; it != endIt; ++it) {
+        const SugarDocument::valueGetter getter = (*it).getter;
+        writer.writeField(it.key(), (document.*getter)());
+    }
+
+    writer.writeField(QLatin1String(s_linkedAccountIdsKey), document.linkedAccountIds().join(QLatin1String(",")));
+    writer.writeField(QLatin1String(s_linkedOpportunityIdsKey), document.linkedOpportunityIds().join(QLatin1String(",")));
+
+    return writer.finish();
+}
+
+bool SugarDocumentIO::writeSugarDocumentHeaderBinary(const SugarDocument &document, QIODevice *device)
+{
+    if (device == nullptr || !device->isWritable()) {
+        return false;
+    }
+
+    KDCRMFieldWriter writer(device);
+    writer.writeField(KDCRMFields::id(), document.id());
+    writer.writeField(KDCRMFields::documentName(), document.documentName());
+    writer.writeField(KDCRMFields::dateModified(), document.dateModified());
+    writer.writeField(QLatin1String(s_linkedAccountIdsKey), document.linkedAccountIds().join(QLatin1String(",")));
+    writer.writeField(QLatin1String(s_linkedOpportunityIdsKey), document.linkedOpportunityIds().join(QLatin1String(",")));
+
+    return writer.finish();
+}
@@ -33,6 +33,11 @@ public:
     SugarDocumentIO();
     bool readSugarDocument(QIODevice *device, SugarDocument &document);
     bool writeSugarDocument(const SugarDocument &document, QIODevice *device);
+    // Compact binary format (see KDCRMFieldWriter), used for the Akonadi payloads
+    bool readSugarDocumentBinary(QIODevice *device, SugarDocument &document);
+    bool writeSugarDocumentBinary(const SugarDocument &document, QIODevice *device);
+    // Only the fields needed to list it (KDCRMHeaderPayloadPart), read it back with readSugarDocumentBinary
+    bool writeSugarDocumentHeaderBinary(const SugarDocument &document, QIODevice *device);
     QString errorString() const;
 
 private:
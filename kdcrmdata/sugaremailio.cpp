@@ -22,6 +22,8 @@
 
 #include "sugaremailio.h"
 #include "sugaremail.h"
+#include "kdcrmfieldstream.h"
+#include "kdcrmfields.h"
 
 #include <KLocalizedString>
 
@@ -30,6 +32,17 @@
 #include <QIODevice>
 #include <QXmlStreamWriter>
 
+static void setEmailField(SugarEmail &email, const SugarEmail::AccessorHash &accessors,
+                          const QString &key, const QString &value)
+{
+    const SugarEmail::AccessorHash::const_iterator accessIt = accessors.constFind(key);
+    if (accessIt != accessors.constEnd()) {
+        (email.*(accessIt.value().setter))(value);
+    } else {
+        qDebug() << "Unexpected field in email" << key;
+    }
+}
+
 SugarEmailIO::SugarEmailIO()
 {
 }
@@ -68,14 +81,9 @@ void SugarEmailIO::readEmail(SugarEmail &email)
     Q_ASSERT(xml.isStartElement() && xml.name() == "sugarEmail");
 
     while (xml.readNextStartElement()) {
-
-        const SugarEmail::AccessorHash::const_iterator accessIt = accessors.constFind(xml.name().toString());
-        if (accessIt != accessors.constEnd()) {
-            (email.*(accessIt.value().setter))(xml.readElementText());
-        } else {
-            qDebug() << "Unexpected XML field in email" << xml.name();
-            xml.skipCurrentElement();
-        }
+        const QString key = xml.name().toString();
+        const QString value = xml.readElementText();
+        setEmailField(email, accessors, key, value);
     }
 }
 
@@ -103,3 +111,54 @@ bool SugarEmailIO::writeSugarEmail(const SugarEmail &email, QIODevice *device)
 
     return true;
 }
+
+bool SugarEmailIO::readSugarEmailBinary(QIODevice *device, SugarEmail &email)
+{
+    if (device == nullptr || !device->isReadable()) {
+        return false;
+    }
+
+    email = SugarEmail();
+    const SugarEmail::AccessorHash accessors = SugarEmail::accessorHash();
+    KDCRMFieldReader reader(device);
+    QString key;
+    QString value;
+    while (reader.readField(key, value)) {
+        setEmailField(email, accessors, key, value);
+    }
+    return !reader.hasError();
+}
+
+bool SugarEmailIO::writeSugarEmailBinary(const SugarEmail &email, QIODevice *device)
+{
+    if (device == nullptr || !device->isWritable()) {
+        return false;
+    }
+
+    KDCRMFieldWriter writer(device);
+    const SugarEmail::AccessorHash accessors = SugarEmail::accessorHash();
+    SugarEmail::AccessorHash::const_iterator it = accessors.constBegin();
+    const SugarEmail::AccessorHash::const_iterator endIt = accessors.constEnd();
+    for (; it != endIt; ++it) {
+        const SugarEmail::valueGetter getter = (*it).getter;
+        writer.writeField(it.key(), (email.*getter)());
+    }
+
+    return writer.finish();
+}
+
+bool SugarEmailIO::writeSugarEmailHeaderBinary(const SugarEmail &email, QIODevice *device)
+{
+    if (device == nullptr || !device->isWritable()) {
+        return false;
+    }
+
+    KDCRMFieldWriter writer(device);
+    writer.writeField(KDCRMFields::id(), email.id());
+    writer.writeField(KDCRMFields::name(), email.name());
+    writer.writeField(KDCRMFields::dateSent(), email.dateSent());
+    writer.writeField(KDCRMFields::parentType(), email.parentType());
+    writer.writeField(KDCRMFields::parentId(), email.parentId());
+
+    return writer.finish();
+}
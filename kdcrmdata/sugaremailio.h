@@ -35,6 +35,11 @@ public:
     SugarEmailIO();
     bool readSugarEmail(QIODevice *device, SugarEmail &email);
     bool writeSugarEmail(const SugarEmail &email, QIODevice *device);
+    // Compact binary format (see KDCRMFieldWriter), used for the Akonadi payloads
+    bool readSugarEmailBinary(QIODevice *device, SugarEmail &email);
+    bool writeSugarEmailBinary(const SugarEmail &email, QIODevice *device);
+    // Only the fields needed to list it (KDCRMHeaderPayloadPart), read it back with readSugarEmailBinary
+    bool writeSugarEmailHeaderBinary(const SugarEmail &email, QIODevice *device);
     QString errorString() const;
 
 private:
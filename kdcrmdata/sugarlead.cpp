@@ -40,66 +40,89 @@ public:
 
     bool mEmpty;
 
-    QString mId;
-    QString mDateEntered;
-    QString mDateModified;
-    QString mModifiedUserId;
-    QString mModifiedByName;
-    QString mCreatedBy;
-    QString mCreatedByName;
-    QString mDescription;
-    QString mDeleted;
-    QString mAssignedUserId;
-    QString mAssignedUserName;
-    QString mSalutation;
-    QString mFirstName;
-    QString mLastName;
-    QString mTitle;
-    QString mDepartment;
-    QString mDoNotCall;
-    QString mPhoneHome;
-    QString mPhoneMobile;
-    QString mPhoneWork;
-    QString mPhoneOther;
-    QString mPhoneFax;
-    QString mEmail1;
-    QString mEmail2;
-    QString mPrimaryAddressStreet;
-    QString mPrimaryAddressCity;
-    QString mPrimaryAddressState;
-    QString mPrimaryAddressPostalcode;
-    QString mPrimaryAddressCountry;
-    QString mAltAddressStreet;
-    QString mAltAddressCity;
-    QString mAltAddressState;
-    QString mAltAddressPostalcode;
-    QString mAltAddressCountry;
-    QString mAssistant;
-    QString mAssistantPhone;
-    QString mConverted;
-    QString mReferedBy;
-    QString mLeadSource;
-    QString mLeadSourceDescription;
-    QString mStatus;
-    QString mStatusDescription;
-    QString mReportsToId;
-    QString mReportToName;
-    QString mAccountName;
-    QString mAccountDescription;
-    QString mContactId;
-    QString mAccountId;
-    QString mOpportunityId;
-    QString mOpportunityName;
-    QString mOpportunityAmount;
-    QString mCampaignId;
-    QString mCampaignName;
-    QString mCAcceptStatusFields;
-    QString mMAcceptStatusFields;
-    QString mBirthdate;
-    QString mPortalName;
-    QString mPortalApp;
+    QString mValues[SugarLead::FieldCount];
 };
 
+typedef QString (*FieldNameFunction)();
+
+// In the order of SugarLead::Field
+static const FieldNameFunction s_fieldNames[] = {
+    &KDCRMFields::id,
+    &KDCRMFields::dateEntered,
+    &KDCRMFields::dateModified,
+    &KDCRMFields::modifiedUserId,
+    &KDCRMFields::modifiedByName,
+    &KDCRMFields::createdBy,
+    &KDCRMFields::createdByName,
+    &KDCRMFields::description,
+    &KDCRMFields::deleted,
+    &KDCRMFields::assignedUserId,
+    &KDCRMFields::assignedUserName,
+    &KDCRMFields::salutation,
+    &KDCRMFields::firstName,
+    &KDCRMFields::lastName,
+    &KDCRMFields::title,
+    &KDCRMFields::department,
+    &KDCRMFields::doNotCall,
+    &KDCRMFields::phoneHome,
+    &KDCRMFields::phoneMobile,
+    &KDCRMFields::phoneWork,
+    &KDCRMFields::phoneOther,
+    &KDCRMFields::phoneFax,
+    &KDCRMFields::email1,
+    &KDCRMFields::email2,
+    &KDCRMFields::primaryAddressStreet,
+    &KDCRMFields::primaryAddressCity,
+    &KDCRMFields::primaryAddressState,
+    &KDCRMFields::primaryAddressPostalcode,
+    &KDCRMFields::primaryAddressCountry,
+    &KDCRMFields::altAddressStreet,
+    &KDCRMFields::altAddressCity,
+    &KDCRMFields::altAddressState,
+    &KDCRMFields::altAddressPostalcode,
+    &KDCRMFields::altAddressCountry,
+    &KDCRMFields::assistant,
+    &KDCRMFields::phoneAssistant,
+    &KDCRMFields::converted,
+    &KDCRMFields::referedBy,
+    &KDCRMFields::leadSource,
+    &KDCRMFields::leadSourceDescription,
+    &KDCRMFields::status,
+    &KDCRMFields::statusDescription,
+    &KDCRMFields::reportsToId,
+    &KDCRMFields::reportsTo,
+    &KDCRMFields::accountName,
+    &KDCRMFields::accountDescription,
+    &KDCRMFields::contactId,
+    &KDCRMFields::accountId,
+    &KDCRMFields::opportunityId,
+    &KDCRMFields::opportunityName,
+    &KDCRMFields::opportunityAmount,
+    &KDCRMFields::campaignId,
+    &KDCRMFields::campaignName,
+    &KDCRMFields::cAcceptStatusFields,
+    &KDCRMFields::mAcceptStatusFields,
+    &KDCRMFields::birthdate,
+    &KDCRMFields::portalName,
+    &KDCRMFields::portalApp,
+};
+static_assert(sizeof(s_fieldNames) / sizeof(*s_fieldNames) == SugarLead::FieldCount, "one name per field");
+
+struct FieldNames
+{
+    FieldNames()
+    {
+        for (int i = 0; i < SugarLead::FieldCount; ++i) {
+            names[i] = s_fieldNames[i]();
+            indexes.insert(names[i], i);
+        }
+    }
+
+    QString names[SugarLead::FieldCount];
+    QHash<QString, int> indexes;
+};
+Q_GLOBAL_STATIC(FieldNames, s_names)
+
 SugarLead::SugarLead()
     : d(new Private)
 {
@@ -133,642 +156,663 @@ void SugarLead::clear()
     *this = SugarLead();
 }
 
+QString SugarLead::value(Field field) const
+{
+    return d->mValues[field];
+}
+
+void SugarLead::setValue(Field field, const QString &value)
+{
+    d->mEmpty = false;
+    d->mValues[field] = value;
+}
+
+QString SugarLead::fieldName(Field field)
+{
+    return s_names()->names[field];
+}
+
+int SugarLead::fieldIndex(const QString &name)
+{
+    return s_names()->indexes.value(name, -1);
+}
+
 void SugarLead::setId(const QString &id)
 {
     d->mEmpty = false;
-    d->mId = id;
+    d->mValues[Id] = id;
 }
 
 QString SugarLead::id() const
 {
-    return d->mId;
+    return d->mValues[Id];
 }
 
 void SugarLead::setDateEntered(const QString &value)
 {
     d->mEmpty = false;
-    d->mDateEntered = value;
+    d->mValues[DateEntered] = value;
 }
 
 QString SugarLead::dateEntered() const
 {
-    return d->mDateEntered;
+    return d->mValues[DateEntered];
 }
 
 void SugarLead::setDateModified(const QString &value)
 {
     d->mEmpty = false;
-    d->mDateModified = value;
+    d->mValues[DateModified] = value;
 }
 
 QString SugarLead::dateModified() const
 {
-    return d->mDateModified;
+    return d->mValues[DateModified];
 }
 
 void SugarLead::setModifiedUserId(const QString &value)
 {
     d->mEmpty = false;
-    d->mModifiedUserId = value;
+    d->mValues[ModifiedUserId] = value;
 }
 
 QString SugarLead::modifiedUserId() const
 {
-    return d->mModifiedUserId;
+    return d->mValues[ModifiedUserId];
 }
 
 void SugarLead::setModifiedByName(const QString &value)
 {
     d->mEmpty = false;
-    d->mModifiedByName = value;
+    d->mValues[ModifiedByName] = value;
 }
 
 QString SugarLead::modifiedByName() const
 {
-    return d->mModifiedByName;
+    return d->mValues[ModifiedByName];
 }
 
 void SugarLead::setCreatedBy(const QString &value)
 {
     d->mEmpty = false;
-    d->mCreatedBy = value;
+    d->mValues[CreatedBy] = value;
 }
 
 QString SugarLead::createdBy() const
 {
-    return d->mCreatedBy;
+    return d->mValues[CreatedBy];
 }
 
 void SugarLead::setCreatedByName(const QString &value)
 {
     d->mEmpty = false;
-    d->mCreatedByName = value;
+    d->mValues[CreatedByName] = value;
 }
 
 QString SugarLead::createdByName() const
 {
-    return d->mCreatedByName;
+    return d->mValues[CreatedByName];
 }
 
 void SugarLead::setDescription(const QString &value)
 {
     d->mEmpty = false;
-    d->mDescription = value;
+    d->mValues[Description] = value;
 }
 
 QString SugarLead::description() const
 {
-    return d->mDescription;
+    return d->mValues[Description];
 }
 
 void SugarLead::setDeleted(const QString &value)
 {
     d->mEmpty = false;
-    d->mDeleted = value;
+    d->mValues[Deleted] = value;
 }
 
 QString SugarLead::deleted() const
 {
-    return d->mDeleted;
+    return d->mValues[Deleted];
 }
 
 void SugarLead::setAssignedUserId(const QString &value)
 {
     d->mEmpty = false;
-    d->mAssignedUserId = value;
+    d->mValues[AssignedUserId] = value;
 }
 
 QString SugarLead::assignedUserId() const
 {
-    return d->mAssignedUserId;
+    return d->mValues[AssignedUserId];
 }
 
 void SugarLead::setAssignedUserName(const QString &value)
 {
     d->mEmpty = false;
-    d->mAssignedUserName = value;
+    d->mValues[AssignedUserName] = value;
 }
 
 QString SugarLead::assignedUserName() const
 {
-    return d->mAssignedUserName;
+    return d->mValues[AssignedUserName];
 }
 
 void SugarLead::setSalutation(const QString &value)
 {
     d->mEmpty = false;
-    d->mSalutation = value;
+    d->mValues[Salutation] = value;
 }
 
 QString SugarLead::salutation() const
 {
-    return d->mSalutation;
+    return d->mValues[Salutation];
 }
 
 void SugarLead::setFirstName(const QString &value)
 {
     d->mEmpty = false;
-    d->mFirstName = value;
+    d->mValues[FirstName] = value;
 }
 
 QString SugarLead::firstName() const
 {
-    return d->mFirstName;
+    return d->mValues[FirstName];
 }
 
 void SugarLead::setLastName(const QString &value)
 {
     d->mEmpty = false;
-    d->mLastName = value;
+    d->mValues[LastName] = value;
 }
 
 QString SugarLead::lastName() const
 {
-    return d->mLastName;
+    return d->mValues[LastName];
 }
 
 void SugarLead::setTitle(const QString &value)
 {
     d->mEmpty = false;
-    d->mTitle = value;
+    d->mValues[Title] = value;
 }
 
 QString SugarLead::title() const
 {
-    return d->mTitle;
+    return d->mValues[Title];
 }
 
 void SugarLead::setDepartment(const QString &value)
 {
     d->mEmpty = false;
-    d->mDepartment = value;
+    d->mValues[Department] = value;
 }
 
 QString SugarLead::department() const
 {
-    return d->mDepartment;
+    return d->mValues[Department];
 }
 
 void SugarLead::setDoNotCall(const QString &value)
 {
     d->mEmpty = false;
-    d->mDoNotCall = value;
+    d->mValues[DoNotCall] = value;
 }
 
 QString SugarLead::doNotCall() const
 {
-    return d->mDoNotCall;
+    return d->mValues[DoNotCall];
 }
 
 void SugarLead::setPhoneHome(const QString &value)
 {
     d->mEmpty = false;
-    d->mPhoneHome = value;
+    d->mValues[PhoneHome] = value;
 }
 
 QString SugarLead::phoneHome() const
 {
-    return d->mPhoneHome;
+    return d->mValues[PhoneHome];
 }
 
 void SugarLead::setPhoneMobile(const QString &value)
 {
     d->mEmpty = false;
-    d->mPhoneMobile = value;
+    d->mValues[PhoneMobile] = value;
 }
 
 QString SugarLead::phoneMobile() const
 {
-    return d->mPhoneMobile;
+    return d->mValues[PhoneMobile];
 }
 
 void SugarLead::setPhoneWork(const QString &value)
 {
     d->mEmpty = false;
-    d->mPhoneWork = value;
+    d->mValues[PhoneWork] = value;
 }
 
 QString SugarLead::phoneWork() const
 {
-    return d->mPhoneWork;
+    return d->mValues[PhoneWork];
 }
 
 void SugarLead::setPhoneOther(const QString &value)
 {
     d->mEmpty = false;
-    d->mPhoneOther = value;
+    d->mValues[PhoneOther] = value;
 }
 
 QString SugarLead::phoneOther() const
 {
-    return d->mPhoneOther;
+    return d->mValues[PhoneOther];
 }
 
 void SugarLead::setPhoneFax(const QString &value)
 {
     d->mEmpty = false;
-    d->mPhoneFax = value;
+    d->mValues[PhoneFax] = value;
 }
 
 QString SugarLead::phoneFax() const
 {
-    return d->mPhoneFax;
+    return d->mValues[PhoneFax];
 }
 
 void SugarLead::setEmail1(const QString &value)
 {
     d->mEmpty = false;
-    d->mEmail1 = value;
+    d->mValues[Email1] = value;
 }
 
 QString SugarLead::email1() const
 {
-    return d->mEmail1;
+    return d->mValues[Email1];
 }
 
 void SugarLead::setEmail2(const QString &value)
 {
     d->mEmpty = false;
-    d->mEmail2 = value;
+    d->mValues[Email2] = value;
 }
 
 QString SugarLead::email2() const
 {
-    return d->mEmail2;
+    return d->mValues[Email2];
 }
 
 void SugarLead::setPrimaryAddressStreet(const QString &value)
 {
     d->mEmpty = false;
-    d->mPrimaryAddressStreet = value;
+    d->mValues[PrimaryAddressStreet] = value;
 }
 
 QString SugarLead::primaryAddressStreet() const
 {
-    return d->mPrimaryAddressStreet;
+    return d->mValues[PrimaryAddressStreet];
 }
 
 void SugarLead::setPrimaryAddressCity(const QString &value)
 {
     d->mEmpty = false;
-    d->mPrimaryAddressCity = value;
+    d->mValues[PrimaryAddressCity] = value;
 }
 
 QString SugarLead::primaryAddressCity() const
 {
-    return d->mPrimaryAddressCity;
+    return d->mValues[PrimaryAddressCity];
 }
 
 void SugarLead::setPrimaryAddressState(const QString &value)
 {
     d->mEmpty = false;
-    d->mPrimaryAddressState = value;
+    d->mValues[PrimaryAddressState] = value;
 }
 
 QString SugarLead::primaryAddressState() const
 {
-    return d->mPrimaryAddressState;
+    return d->mValues[PrimaryAddressState];
 }
 
 void SugarLead::setPrimaryAddressPostalcode(const QString &value)
 {
     d->mEmpty = false;
-    d->mPrimaryAddressPostalcode = value;
+    d->mValues[PrimaryAddressPostalcode] = value;
 }
 
 QString SugarLead::primaryAddressPostalcode() const
 {
-    return d->mPrimaryAddressPostalcode;
+    return d->mValues[PrimaryAddressPostalcode];
 }
 
 void SugarLead::setPrimaryAddressCountry(const QString &value)
 {
     d->mEmpty = false;
-    d->mPrimaryAddressCountry = value;
+    d->mValues[PrimaryAddressCountry] = value;
 }
 
 QString SugarLead::primaryAddressCountry() const
 {
-    return d->mPrimaryAddressCountry;
+    return d->mValues[PrimaryAddressCountry];
 }
 
 void SugarLead::setAltAddressStreet(const QString &value)
 {
     d->mEmpty = false;
-    d->mAltAddressStreet = value;
+    d->mValues[AltAddressStreet] = value;
 }
 
 QString SugarLead::altAddressStreet() const
 {
-    return d->mAltAddressStreet;
+    return d->mValues[AltAddressStreet];
 }
 
 void SugarLead::setAltAddressCity(const QString &value)
 {
     d->mEmpty = false;
-    d->mAltAddressCity = value;
+    d->mValues[AltAddressCity] = value;
 }
 
 QString SugarLead::altAddressCity() const
 {
-    return d->mAltAddressCity;
+    return d->mValues[AltAddressCity];
 }
 
 void SugarLead::setAltAddressState(const QString &value)
 {
     d->mEmpty = false;
-    d->mAltAddressState = value;
+    d->mValues[AltAddressState] = value;
 }
 
 QString SugarLead::altAddressState() const
 {
-    return d->mAltAddressState;
+    return d->mValues[AltAddressState];
 }
 
 void SugarLead::setAltAddressPostalcode(const QString &value)
 {
     d->mEmpty = false;
-    d->mAltAddressPostalcode = value;
+    d->mValues[AltAddressPostalcode] = value;
 }
 
 QString SugarLead::altAddressPostalcode() const
 {
-    return d->mAltAddressPostalcode;
+    return d->mValues[AltAddressPostalcode];
 }
 
 void SugarLead::setAltAddressCountry(const QString &value)
 {
     d->mEmpty = false;
-    d->mAltAddressCountry = value;
+    d->mValues[AltAddressCountry] = value;
 }
 
 QString SugarLead::altAddressCountry() const
 {
-    return d->mAltAddressCountry;
+    return d->mValues[AltAddressCountry];
 }
 
 void SugarLead::setAssistant(const QString &value)
 {
     d->mEmpty = false;
-    d->mAssistant = value;
+    d->mValues[Assistant] = value;
 }
 
 QString SugarLead::assistant() const
 {
-    return d->mAssistant;
+    return d->mValues[Assistant];
 }
 
 void SugarLead::setAssistantPhone(const QString &value)
 {
     d->mEmpty = false;
-    d->mAssistantPhone = value;
+    d->mValues[AssistantPhone] = value;
 }
 
 QString SugarLead::assistantPhone() const
 {
-    return d->mAssistantPhone;
+    return d->mValues[AssistantPhone];
 }
 
 void SugarLead::setConverted(const QString &value)
 {
     d->mEmpty = false;
-    d->mConverted = value;
+    d->mValues[Converted] = value;
 }
 
 QString SugarLead::converted() const
 {
-    return d->mConverted;
+    return d->mValues[Converted];
 }
 
 void SugarLead::setReferedBy(const QString &value)
 {
     d->mEmpty = false;
-    d->mReferedBy = value;
+    d->mValues[ReferedBy] = value;
 }
 
 QString SugarLead::referedBy() const
 {
-    return d->mReferedBy;
+    return d->mValues[ReferedBy];
 }
 
 void SugarLead::setLeadSource(const QString &value)
 {
     d->mEmpty = false;
-    d->mLeadSource = value;
+    d->mValues[LeadSource] = value;
 }
 
 QString SugarLead::leadSource() const
 {
-    return d->mLeadSource;
+    return d->mValues[LeadSource];
 }
 
 void SugarLead::setLeadSourceDescription(const QString &value)
 {
     d->mEmpty = false;
-    d->mLeadSourceDescription = value;
+    d->mValues[LeadSourceDescription] = value;
 }
 
 QString SugarLead::leadSourceDescription() const
 {
-    return d->mLeadSourceDescription;
+    return d->mValues[LeadSourceDescription];
 }
 
 void SugarLead::setStatus(const QString &value)
 {
     d->mEmpty = false;
-    d->mStatus = value;
+    d->mValues[Status] = value;
 }
 
 QString SugarLead::status() const
 {
-    return d->mStatus;
+    return d->mValues[Status];
 }
 
 void SugarLead::setStatusDescription(const QString &value)
 {
     d->mEmpty = false;
-    d->mStatusDescription = value;
+    d->mValues[StatusDescription] = value;
 }
 
 QString SugarLead::statusDescription() const
 {
-    return d->mStatusDescription;
+    return d->mValues[StatusDescription];
 }
 
 void SugarLead::setReportsToId(const QString &value)
 {
     d->mEmpty = false;
-    d->mReportsToId = value;
+    d->mValues[ReportsToId] = value;
 }
 
 QString SugarLead::reportsToId() const
 {
-    return d->mReportsToId;
+    return d->mValues[ReportsToId];
 }
 
 void SugarLead::setReportToName(const QString &value)
 {
     d->mEmpty = false;
-    d->mReportToName = value;
+    d->mValues[ReportToName] = value;
 }
 
 QString SugarLead::reportToName() const
 {
-    return d->mReportToName;
+    return d->mValues[ReportToName];
 }
 
 void SugarLead::setAccountName(const QString &value)
 {
     d->mEmpty = false;
-    d->mAccountName = value;
+    d->mValues[AccountName] = value;
 }
 
 QString SugarLead::accountName() const
 {
-    return d->mAccountName;
+    return d->mValues[AccountName];
 }
 
 void SugarLead::setAccountDescription(const QString &value)
 {
     d->mEmpty = false;
-    d->mAccountDescription = value;
+    d->mValues[AccountDescription] = value;
 }
 
 QString SugarLead::accountDescription() const
 {
-    return d->mAccountDescription;
+    return d->mValues[AccountDescription];
 }
 
 void SugarLead::setContactId(const QString &value)
 {
     d->mEmpty = false;
-    d->mContactId = value;
+    d->mValues[ContactId] = value;
 }
 
 QString SugarLead::contactId() const
 {
-    return d->mContactId;
+    return d->mValues[ContactId];
 }
 
 void SugarLead::setAccountId(const QString &value)
 {
     d->mEmpty = false;
-    d->mAccountId = value;
+    d->mValues[AccountId] = value;
 }
 
 QString SugarLead::accountId() const
 {
-    return d->mAccountId;
+    return d->mValues[AccountId];
 }
 
 void SugarLead::setOpportunityId(const QString &value)
 {
     d->mEmpty = false;
-    d->mOpportunityId = value;
+    d->mValues[OpportunityId] = value;
 }
 
 QString SugarLead::opportunityId() const
 {
-    return d->mOpportunityId;
+    return d->mValues[OpportunityId];
 }
 
 void SugarLead::setOpportunityName(const QString &value)
 {
     d->mEmpty = false;
-    d->mOpportunityName = value;
+    d->mValues[OpportunityName] = value;
 }
 
 QString SugarLead::opportunityName() const
 {
-    return d->mOpportunityName;
+    return d->mValues[OpportunityName];
 }
 
 void SugarLead::setOpportunityAmount(const QString &value)
 {
     d->mEmpty = false;
-    d->mOpportunityAmount = value;
+    d->mValues[OpportunityAmount] = value;
 }
 
 QString SugarLead::opportunityAmount() const
 {
-    return d->mOpportunityAmount;
+    return d->mValues[OpportunityAmount];
 }
 
 void SugarLead::setCampaignId(const QString &value)
 {
     d->mEmpty = false;
-    d->mCampaignId = value;
+    d->mValues[CampaignId] = value;
 }
 
 QString SugarLead::campaignId() const
 {
-    return d->mCampaignId;
+    return d->mValues[CampaignId];
 }
 
 void SugarLead::setCampaignName(const QString &value)
 {
     d->mEmpty = false;
-    d->mCampaignName = value;
+    d->mValues[CampaignName] = value;
 }
 
 QString SugarLead::campaignName() const
 {
-    return d->mCampaignName;
+    return d->mValues[CampaignName];
 }
 
 void SugarLead::setCAcceptStatusFields(const QString &value)
 {
     d->mEmpty = false;
-    d->mCAcceptStatusFields = value;
+    d->mValues[CAcceptStatusFields] = value;
 }
 
 QString SugarLead::cAcceptStatusFields() const
 {
-    return d->mCAcceptStatusFields;
+    return d->mValues[CAcceptStatusFields];
 }
 
 void SugarLead::setMAcceptStatusFields(const QString &value)
 {
     d->mEmpty = false;
-    d->mMAcceptStatusFields = value;
+    d->mValues[MAcceptStatusFields] = value;
 }
 
 QString SugarLead::mAcceptStatusFields() const
 {
-    return d->mMAcceptStatusFields;
+    return d->mValues[MAcceptStatusFields];
 }
 
 void SugarLead::setBirthdate(const QString &value)
 {
     d->mEmpty = false;
-    d->mBirthdate = value;
+    d->mValues[Birthdate] = value;
 }
 
 QString SugarLead::birthdate() const
 {
-    return d->mBirthdate;
+    return d->mValues[Birthdate];
 }
 
 void SugarLead::setPortalName(const QString &value)
 {
     d->mEmpty = false;
-    d->mPortalName = value;
+    d->mValues[PortalName] = value;
 }
 
 QString SugarLead::portalName() const
 {
-    return d->mPortalName;
+    return d->mValues[PortalName];
 }
 
 void SugarLead::setPortalApp(const QString &value)
 {
     d->mEmpty = false;
-    d->mPortalApp = value;
+    d->mValues[PortalApp] = value;
 }
 
 QString SugarLead::portalApp() const
 {
-    return d->mPortalApp;
+    return d->mValues[PortalApp];
 }
 
 void SugarLead::setData(const QMap<QString, QString>& data)
@@ -778,12 +822,16 @@ void SugarLead::setData(const QMap<QString, QString>& data)
     const SugarLead::AccessorHash accessors = SugarLead::accessorHash();
     QMap<QString, QString>::const_iterator it = data.constBegin();
     for ( ; it != data.constEnd() ; ++it) {
+        const int index = fieldIndex(it.key());
+        if (index >= 0) {
+            d->mValues[index] = it.value();
+            continue;
+        }
         const SugarLead::AccessorHash::const_iterator accessIt = accessors.constFind(it.key());
         if (accessIt != accessors.constEnd()) {
             (this->*(accessIt.value().setter))(it.value());
         } else {
-            //TODO: add custom field support
-            // d->mCustomFields.insert(it.key(), it.value());
+            d->mCustomFields.insert(it.key(), it.value());
         }
     }
 }
@@ -792,12 +840,9 @@ QMap<QString, QString> SugarLead::data()
 {
     QMap<QString, QString> data;
 
-    const SugarLead::AccessorHash accessors = SugarLead::accessorHash();
-    SugarLead::AccessorHash::const_iterator it    = accessors.constBegin();
-    SugarLead::AccessorHash::const_iterator endIt = accessors.constEnd();
-    for (; it != endIt; ++it) {
-        const SugarLead::valueGetter getter = (*it).getter;
-        data.insert(it.key(), (this->*getter)());
+    const FieldNames *fieldNames = s_names();
+    for (int i = 0; i < FieldCount; ++i) {
+        data.insert(fieldNames->names[i], d->mValues[i]);
     }
 
 /*TODO: add custom field support
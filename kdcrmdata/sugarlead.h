@@ -62,6 +62,89 @@ public:
     */
     SugarLead &operator=(const SugarLead &);
 
+    /**
+      The fields stored as plain strings, as indexes for value() and setValue().
+     */
+    enum Field {
+        Id = 0,
+        DateEntered,
+        DateModified,
+        ModifiedUserId,
+        ModifiedByName,
+        CreatedBy,
+        CreatedByName,
+        Description,
+        Deleted,
+        AssignedUserId,
+        AssignedUserName,
+        Salutation,
+        FirstName,
+        LastName,
+        Title,
+        Department,
+        DoNotCall,
+        PhoneHome,
+        PhoneMobile,
+        PhoneWork,
+        PhoneOther,
+        PhoneFax,
+        Email1,
+        Email2,
+        PrimaryAddressStreet,
+        PrimaryAddressCity,
+        PrimaryAddressState,
+        PrimaryAddressPostalcode,
+        PrimaryAddressCountry,
+        AltAddressStreet,
+        AltAddressCity,
+        AltAddressState,
+        AltAddressPostalcode,
+        AltAddressCountry,
+        Assistant,
+        AssistantPhone,
+        Converted,
+        ReferedBy,
+        LeadSource,
+        LeadSourceDescription,
+        Status,
+        StatusDescription,
+        ReportsToId,
+        ReportToName,
+        AccountName,
+        AccountDescription,
+        ContactId,
+        AccountId,
+        OpportunityId,
+        OpportunityName,
+        OpportunityAmount,
+        CampaignId,
+        CampaignName,
+        CAcceptStatusFields,
+        MAcceptStatusFields,
+        Birthdate,
+        PortalName,
+        PortalApp,
+        FieldCount
+    };
+
+    /**
+      Return the value of the given field.
+     */
+    QString value(Field field) const;
+    /**
+      Set the value of the given field.
+     */
+    void setValue(Field field, const QString &value);
+
+    /**
+      Return the name of the given field, as in KDCRMFields.
+     */
+    static QString fieldName(Field field);
+    /**
+      Return the Field for the given name (from KDCRMFields), or -1 if there's none (e.g. custom fields).
+     */
+    static int fieldIndex(const QString &name);
+
     /**
       Return, if the SugarLead entry is empty.
      */
@@ -22,6 +22,7 @@
 
 #include "sugarleadio.h"
 #include "sugarlead.h"
+#include "kdcrmfieldstream.h"
 #include "kdcrmfields.h"
 
 #include <KLocalizedString>
@@ -29,6 +30,17 @@
 #include <QIODevice>
 #include <QXmlStreamWriter>
 
+static void setLeadField(SugarLead &lead, const QString &key, const QString &value)
+{
+    const int index = SugarLead::fieldIndex(key);
+    if (index >= 0) {
+        lead.setValue(static_cast<SugarLead::Field>(index), value);
+    } else {
+        //TODO: add custom field support
+        //lead.setCustomField(key, value);
+    }
+}
+
 SugarLeadIO::SugarLeadIO()
 {
 }
@@ -63,19 +75,12 @@ QString SugarLeadIO::errorString() const
 
 void SugarLeadIO::readLead(SugarLead &lead)
 {
-    const SugarLead::AccessorHash accessors = SugarLead::accessorHash();
     Q_ASSERT(xml.isStartElement() && xml.name() == "sugarLead");
 
     while (xml.readNextStartElement()) {
         const QString key = xml.name().toString();
         const QString value = xml.readElementText();
-        const SugarLead::AccessorHash::const_iterator accessIt = accessors.constFind(key);
-        if (accessIt != accessors.constEnd()) {
-            (lead.*(accessIt.value().setter))(value);
-        } else {
-            //TODO: add custom field support
-            //lead.setCustomField(key, value);
-        }
+        setLeadField(lead, key, value);
     }
 }
 
@@ -92,12 +97,9 @@ bool SugarLeadIO::writeSugarLead(const SugarLead &lead, QIODevice *device)
     writer.writeStartElement("sugarLead");
     writer.writeAttribute("version", "1.0");
 
-    const SugarLead::AccessorHash accessors = SugarLead::accessorHash();
-    SugarLead::AccessorHash::const_iterator it = accessors.constBegin();
-    const SugarLead::AccessorHash::const_iterator endIt = accessors.constEnd();
-    for (; it != endIt; ++it) {
-        const SugarLead::valueGetter getter = (*it).getter;
-        writer.writeTextElement(it.key(), (lead.*getter)());
+    for (int i = 0; i < SugarLead::FieldCount; ++i) {
+        const SugarLead::Field field = static_cast<SugarLead::Field>(i);
+        writer.writeTextElement(SugarLead::fieldName(field), lead.value(field));
     }
 
 /* TODO: add custom field support
@@ -114,3 +116,34 @@ bool SugarLeadIO::writeSugarLead(const SugarLead &lead, QIODevice *device)
 
     return true;
 }
+
+bool SugarLeadIO::readSugarLeadBinary(QIODevice *device, SugarLead &lead)
+{
+    if (device == nullptr || !device->isReadable()) {
+        return false;
+    }
+
+    lead = SugarLead();
+    KDCRMFieldReader reader(device);
+    QString key;
+    QString value;
+    while (reader.readField(key, value)) {
+        setLeadField(lead, key, value);
+    }
+    return !reader.hasError();
+}
+
+bool SugarLeadIO::writeSugarLeadBinary(const SugarLead &lead, QIODevice *device)
+{
+    if (device == nullptr || !device->isWritable()) {
+        return false;
+    }
+
+    KDCRMFieldWriter writer(device);
+    for (int i = 0; i < SugarLead::FieldCount; ++i) {
+        const SugarLead::Field field = static_cast<SugarLead::Field>(i);
+        writer.writeField(SugarLead::fieldName(field), lead.value(field));
+    }
+
+    return writer.finish();
+}
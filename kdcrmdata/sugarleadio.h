@@ -35,6 +35,9 @@ public:
     SugarLeadIO();
     bool readSugarLead(QIODevice *device, SugarLead &lead);
     bool writeSugarLead(const SugarLead &lead, QIODevice *device);
+    // Compact binary format (see KDCRMFieldWriter), used for the Akonadi payloads
+    bool readSugarLeadBinary(QIODevice *device, SugarLead &lead);
+    bool writeSugarLeadBinary(const SugarLead &lead, QIODevice *device);
     QString errorString() const;
 
 private:
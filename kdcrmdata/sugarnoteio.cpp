@@ -22,12 +22,23 @@
 
 #include "sugarnoteio.h"
 #include "sugarnote.h"
+#include "kdcrmfieldstream.h"
+#include "kdcrmfields.h"
 
 #include <KLocalizedString>
 #include <QHash>
 #include <QIODevice>
 #include <QXmlStreamWriter>
 
+static void setNoteField(SugarNote &note, const SugarNote::AccessorHash &accessors,
+                         const QString &key, const QString &value)
+{
+    const SugarNote::AccessorHash::const_iterator accessIt = accessors.constFind(key);
+    if (accessIt != accessors.constEnd()) {
+        (note.*(accessIt.value().setter))(value);
+    }
+}
+
 SugarNoteIO::SugarNoteIO()
 {
 }
@@ -66,13 +77,9 @@ void SugarNoteIO::readNote(SugarNote &note)
     Q_ASSERT(xml.isStartElement() && xml.name() == "sugarNote");
 
     while (xml.readNextStartElement()) {
-
-        const SugarNote::AccessorHash::const_iterator accessIt = accessors.constFind(xml.name().toString());
-        if (accessIt != accessors.constEnd()) {
-            (note.*(accessIt.value().setter))(xml.readElementText());
-        } else {
-            xml.skipCurrentElement();
-        }
+        const QString key = xml.name().toString();
+        const QString value = xml.readElementText();
+        setNoteField(note, accessors, key, value);
     }
 }
 
@@ -100,3 +107,54 @@ bool SugarNoteIO::writeSugarNote(const SugarNote &note, QIODevice *device)
 
     return true;
 }
+
+bool SugarNoteIO::readSugarNoteBinary(QIODevice *device, SugarNote &note)
+{
+    if (device == nullptr || !device->isReadable()) {
+        return false;
+    }
+
+    note = SugarNote();
+    const SugarNote::AccessorHash accessors = SugarNote::accessorHash();
+    KDCRMFieldReader reader(device);
+    QString key;
+    QString value;
+    while (reader.readField(key, value)) {
+        setNoteField(note, accessors, key, value);
+    }
+    return !reader.hasError();
+}
+
+bool SugarNoteIO::writeSugarNoteBinary(const SugarNote &note, QIODevice *device)
+{
+    if (device == nullptr || !device->isWritable()) {
+        return false;
+    }
+
+    KDCRMFieldWriter writer(device);
+    const SugarNote::AccessorHash accessors = SugarNote::accessorHash();
+    SugarNote::AccessorHash::const_iterator it = accessors.constBegin();
+    const SugarNote::AccessorHash::const_iterator endIt = accessors.constEnd();
+    for (; it != endIt; ++it) {
+        const SugarNote::valueGetter getter = (*it).getter;
+        writer.writeField(it.key(), (note.*getter)());
+    }
+
+    return writer.finish();
+}
+
+bool SugarNoteIO::writeSugarNoteHeaderBinary(const SugarNote &note, QIODevice *device)
+{
+    if (device == nullptr || !device->isWritable()) {
+        return false;
+    }
+
+    KDCRMFieldWriter writer(device);
+    writer.writeField(KDCRMFields::id(), note.id());
+    writer.writeField(KDCRMFields::name(), note.name());
+    writer.writeField(KDCRMFields::dateModified(), note.dateModified());
+    writer.writeField(KDCRMFields::parentType(), note.parentType());
+    writer.writeField(KDCRMFields::parentId(), note.parentId());
+
+    return writer.finish();
+}
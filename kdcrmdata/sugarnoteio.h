@@ -35,6 +35,11 @@ public:
     SugarNoteIO();
     bool readSugarNote(QIODevice *device, SugarNote &note);
     bool writeSugarNote(const SugarNote &note, QIODevice *device);
+    // Compact binary format (see KDCRMFieldWriter), used for the Akonadi payloads
+    bool readSugarNoteBinary(QIODevice *device, SugarNote &note);
+    bool writeSugarNoteBinary(const SugarNote &note, QIODevice *device);
+    // Only the fields needed to list it (KDCRMHeaderPayloadPart), read it back with readSugarNoteBinary
+    bool writeSugarNoteHeaderBinary(const SugarNote &note, QIODevice *device);
     QString errorString() const;
 
 private:
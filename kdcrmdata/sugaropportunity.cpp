@@ -28,6 +28,7 @@
 
 #include <QDate>
 #include <QDebug>
+#include <QHash>
 #include <QSharedData>
 #include <QString>
 
@@ -41,37 +42,60 @@ public:
 
     bool mEmpty;
 
-    QString mId;
-    QString mName;
-    QString mDateEntered;
+    QString mValues[SugarOpportunity::FieldCount];
     QDateTime mDateModified;
-    QString mModifiedUserId;
-    QString mModifiedByName;
-    QString mCreatedBy;
-    QString mCreatedByName;
-    QString mDescription;
-    QString mDeleted;
-    QString mAssignedUserId;
-    QString mAssignedUserName;
-    QString mOpportunityType;
-    QString mAccountName;
-    QString mAccountId;
-    QString mCampaignId;
-    QString mCampaignName;
-    QString mLeadSource;
-    QString mAmount;
-    QString mAmountUsDollar;
-    QString mCurrencyId;
-    QString mCurrencyName;
-    QString mCurrencySymbol;
-    QString mDateClosed;
-    QString mNextStep;
-    QString mSalesStage;
-    QString mProbability;
     QMap<QString, QString> mCustomFields;
     QString mShownPriority;
 };
 
+typedef QString (*FieldNameFunction)();
+
+// In the order of SugarOpportunity::Field
+static const FieldNameFunction s_fieldNames[] = {
+    &KDCRMFields::id,
+    &KDCRMFields::name,
+    &KDCRMFields::dateEntered,
+    &KDCRMFields::modifiedUserId,
+    &KDCRMFields::modifiedByName,
+    &KDCRMFields::createdBy,
+    &KDCRMFields::createdByName,
+    &KDCRMFields::description,
+    &KDCRMFields::deleted,
+    &KDCRMFields::assignedUserId,
+    &KDCRMFields::assignedUserName,
+    &KDCRMFields::opportunityType,
+    &KDCRMFields::accountName,
+    &KDCRMFields::accountId,
+    &KDCRMFields::campaignId,
+    &KDCRMFields::campaignName,
+    &KDCRMFields::leadSource,
+    &KDCRMFields::amount,
+    &KDCRMFields::amountUsDollar,
+    &KDCRMFields::currencyId,
+    &KDCRMFields::currencyName,
+    &KDCRMFields::currencySymbol,
+    &KDCRMFields::dateClosed,
+    &KDCRMFields::nextStep,
+    &KDCRMFields::salesStage,
+    &KDCRMFields::probability,
+};
+static_assert(sizeof(s_fieldNames) / sizeof(*s_fieldNames) == SugarOpportunity::FieldCount, "one name per field");
+
+struct FieldNames
+{
+    FieldNames()
+    {
+        for (int i = 0; i < SugarOpportunity::FieldCount; ++i) {
+            names[i] = s_fieldNames[i]();
+            indexes.insert(names[i], i);
+        }
+    }
+
+    QString names[SugarOpportunity::FieldCount];
+    QHash<QString, int> indexes;
+};
+Q_GLOBAL_STATIC(FieldNames, s_names)
+
 SugarOpportunity::SugarOpportunity()
     : d(new Private)
 {
@@ -105,37 +129,58 @@ void SugarOpportunity::clear()
     *this = SugarOpportunity();
 }
 
+QString SugarOpportunity::value(Field field) const
+{
+    return d->mValues[field];
+}
+
+void SugarOpportunity::setValue(Field field, const QString &value)
+{
+    d->mEmpty = false;
+    d->mValues[field] = value;
+}
+
+QString SugarOpportunity::fieldName(Field field)
+{
+    return s_names()->names[field];
+}
+
+int SugarOpportunity::fieldIndex(const QString &name)
+{
+    return s_names()->indexes.value(name, -1);
+}
+
 void SugarOpportunity::setId(const QString &id)
 {
     d->mEmpty = false;
-    d->mId = id;
+    d->mValues[Id] = id;
 }
 
 QString SugarOpportunity::id() const
 {
-    return d->mId;
+    return d->mValues[Id];
 }
 
 void SugarOpportunity::setName(const QString &name)
 {
     d->mEmpty = false;
-    d->mName = name;
+    d->mValues[Name] = name;
 }
 
 QString SugarOpportunity::name() const
 {
-    return d->mName;
+    return d->mValues[Name];
 }
 
 void SugarOpportunity::setDateEntered(const QString &value)
 {
     d->mEmpty = false;
-    d->mDateEntered = value;
+    d->mValues[DateEntered] = value;
 }
 
 QString SugarOpportunity::dateEntered() const
 {
-    return d->mDateEntered;
+    return d->mValues[DateEntered];
 }
 
 QDateTime SugarOpportunity::dateModified() const
@@ -157,105 +202,105 @@ QString SugarOpportunity::dateModifiedRaw() const
 void SugarOpportunity::setModifiedUserId(const QString &value)
 {
     d->mEmpty = false;
-    d->mModifiedUserId = value;
+    d->mValues[ModifiedUserId] = value;
 }
 
 QString SugarOpportunity::modifiedUserId() const
 {
-    return d->mModifiedUserId;
+    return d->mValues[ModifiedUserId];
 }
 
 void SugarOpportunity::setModifiedByName(const QString &value)
 {
     d->mEmpty = false;
-    d->mModifiedByName = value;
+    d->mValues[ModifiedByName] = value;
 }
 
 QString SugarOpportunity::modifiedByName() const
 {
-    return d->mModifiedByName;
+    return d->mValues[ModifiedByName];
 }
 
 void SugarOpportunity::setCreatedBy(const QString &value)
 {
     d->mEmpty = false;
-    d->mCreatedBy = value;
+    d->mValues[CreatedBy] = value;
 }
 
 QString SugarOpportunity::createdBy() const
 {
-    return d->mCreatedBy;
+    return d->mValues[CreatedBy];
 }
 
 void SugarOpportunity::setCreatedByName(const QString &value)
 {
     d->mEmpty = false;
-    d->mCreatedByName = value;
+    d->mValues[CreatedByName] = value;
 }
 
 QString SugarOpportunity::createdByName() const
 {
-    return d->mCreatedByName;
+    return d->mValues[CreatedByName];
 }
 
 void SugarOpportunity::setDescription(const QString &value)
 {
     d->mEmpty = false;
-    d->mDescription = value;
+    d->mValues[Description] = value;
 }
 
 QString SugarOpportunity::description() const
 {
-    return d->mDescription;
+    return d->mValues[Description];
 }
 
 QString SugarOpportunity::limitedDescription(int wantedParagraphs) const
 {
-    return KDCRMUtils::limitString(d->mDescription, wantedParagraphs);
+    return KDCRMUtils::limitString(d->mValues[Description], wantedParagraphs);
 }
 
 void SugarOpportunity::setDeleted(const QString &value)
 {
     d->mEmpty = false;
-    d->mDeleted = value;
+    d->mValues[Deleted] = value;
 }
 
 QString SugarOpportunity::deleted() const
 {
-    return d->mDeleted;
+    return d->mValues[Deleted];
 }
 
 void SugarOpportunity::setAssignedUserId(const QString &value)
 {
     d->mEmpty = false;
-    d->mAssignedUserId = value;
+    d->mValues[AssignedUserId] = value;
 }
 
 QString SugarOpportunity::assignedUserId() const
 {
-    return d->mAssignedUserId;
+    return d->mValues[AssignedUserId];
 }
 
 void SugarOpportunity::setAssignedUserName(const QString &value)
 {
     d->mEmpty = false;
-    d->mAssignedUserName = value;
+    d->mValues[AssignedUserName] = value;
 }
 
 QString SugarOpportunity::assignedUserName() const
 {
-    return d->mAssignedUserName;
+    return d->mValues[AssignedUserName];
 }
 
 void SugarOpportunity::setOpportunityType(const QString &value)
 {
     d->mEmpty = false;
-    d->mOpportunityType = value;
+    d->mValues[OpportunityType] = value;
 }
 
 QString SugarOpportunity::opportunityType() const
 {
-    return d->mOpportunityType;
+    return d->mValues[OpportunityType];
 }
 
 QString SugarOpportunity::opportunitySize() const
@@ -271,155 +316,155 @@ QString SugarOpportunity::opportunityPriority() const
 void SugarOpportunity::setTempAccountName(const QString &value)
 {
     d->mEmpty = false;
-    d->mAccountName = value;
+    d->mValues[AccountName] = value;
 }
 
 QString SugarOpportunity::tempAccountName() const
 {
-    return d->mAccountName;
+    return d->mValues[AccountName];
 }
 
 void SugarOpportunity::setAccountId(const QString &value)
 {
     d->mEmpty = false;
-    d->mAccountId = value;
+    d->mValues[AccountId] = value;
 }
 
 QString SugarOpportunity::accountId() const
 {
-    return d->mAccountId;
+    return d->mValues[AccountId];
 }
 
 void SugarOpportunity::setCampaignId(const QString &value)
 {
     d->mEmpty = false;
-    d->mCampaignId = value;
+    d->mValues[CampaignId] = value;
 }
 
 QString SugarOpportunity::campaignId() const
 {
-    return d->mCampaignId;
+    return d->mValues[CampaignId];
 }
 
 void SugarOpportunity::setCampaignName(const QString &value)
 {
     d->mEmpty = false;
-    d->mCampaignName = value;
+    d->mValues[CampaignName] = value;
 }
 
 QString SugarOpportunity::campaignName() const
 {
-    return d->mCampaignName;
+    return d->mValues[CampaignName];
 }
 
 void SugarOpportunity::setLeadSource(const QString &value)
 {
     d->mEmpty = false;
-    d->mLeadSource = value;
+    d->mValues[LeadSource] = value;
 }
 
 QString SugarOpportunity::leadSource() const
 {
-    return d->mLeadSource;
+    return d->mValues[LeadSource];
 }
 
 void SugarOpportunity::setAmount(const QString &value)
 {
     d->mEmpty = false;
-    d->mAmount = value;
+    d->mValues[Amount] = value;
 }
 
 QString SugarOpportunity::amount() const
 {
-    return d->mAmount;
+    return d->mValues[Amount];
 }
 
 void SugarOpportunity::setAmountUsDollar(const QString &value)
 {
     d->mEmpty = false;
-    d->mAmountUsDollar = value;
+    d->mValues[AmountUsDollar] = value;
 }
 
 QString SugarOpportunity::amountUsDollar() const
 {
-    return d->mAmountUsDollar;
+    return d->mValues[AmountUsDollar];
 }
 
 void SugarOpportunity::setCurrencyId(const QString &value)
 {
     d->mEmpty = false;
-    d->mCurrencyId = value;
+    d->mValues[CurrencyId] = value;
 }
 
 QString SugarOpportunity::currencyId() const
 {
-    return d->mCurrencyId;
+    return d->mValues[CurrencyId];
 }
 
 void SugarOpportunity::setCurrencyName(const QString &value)
 {
     d->mEmpty = false;
-    d->mCurrencyName = value;
+    d->mValues[CurrencyName] = value;
 }
 
 QString SugarOpportunity::currencyName() const
 {
-    return d->mCurrencyName;
+    return d->mValues[CurrencyName];
 }
 
 void SugarOpportunity::setCurrencySymbol(const QString &value)
 {
     d->mEmpty = false;
-    d->mCurrencySymbol = value;
+    d->mValues[CurrencySymbol] = value;
 }
 
 QString SugarOpportunity::currencySymbol() const
 {
-    return d->mCurrencySymbol;
+    return d->mValues[CurrencySymbol];
 }
 
 void SugarOpportunity::setDateClosed(const QString &value)
 {
     d->mEmpty = false;
-    d->mDateClosed = value;
+    d->mValues[DateClosed] = value;
 }
 
 QString SugarOpportunity::dateClosed() const
 {
-    return d->mDateClosed;
+    return d->mValues[DateClosed];
 }
 
 void SugarOpportunity::setNextStep(const QString &value)
 {
     d->mEmpty = false;
-    d->mNextStep = value;
+    d->mValues[NextStep] = value;
 }
 
 QString SugarOpportunity::nextStep() const
 {
-    return d->mNextStep;
+    return d->mValues[NextStep];
 }
 
 void SugarOpportunity::setSalesStage(const QString &value)
 {
     d->mEmpty = false;
-    d->mSalesStage = value;
+    d->mValues[SalesStage] = value;
 }
 
 QString SugarOpportunity::salesStage() const
 {
-    return d->mSalesStage;
+    return d->mValues[SalesStage];
 }
 
 void SugarOpportunity::setProbability(const QString &value)
 {
     d->mEmpty = false;
-    d->mProbability = value;
+    d->mValues[Probability] = value;
 }
 
 QString SugarOpportunity::probability() const
 {
-    return d->mProbability;
+    return d->mValues[Probability];
 }
 
 void SugarOpportunity::setNextCallDate(const QDate &date)
@@ -450,6 +495,11 @@ void SugarOpportunity::setData(const QMap<QString, QString>& data)
     const SugarOpportunity::AccessorHash accessors = SugarOpportunity::accessorHash();
     QMap<QString, QString>::const_iterator it = data.constBegin();
     for ( ; it != data.constEnd() ; ++it) {
+        const int index = fieldIndex(it.key());
+        if (index >= 0) {
+            d->mValues[index] = it.value();
+            continue;
+        }
         const SugarOpportunity::AccessorHash::const_iterator accessIt = accessors.constFind(it.key());
         if (accessIt != accessors.constEnd()) {
             (this->*(accessIt.value().setter))(it.value());
@@ -457,29 +507,17 @@ void SugarOpportunity::setData(const QMap<QString, QString>& data)
             d->mCustomFields.insert(it.key(), it.value());
         }
     }
-
-    // equivalent to this, but fully automated:
-    //d->mId = data.value("id");
-    //d->mName = data.value("name");
-    // ...
 }
 
 QMap<QString, QString> SugarOpportunity::data()
 {
     QMap<QString, QString> data;
 
-    const SugarOpportunity::AccessorHash accessors = SugarOpportunity::accessorHash();
-    SugarOpportunity::AccessorHash::const_iterator it    = accessors.constBegin();
-    SugarOpportunity::AccessorHash::const_iterator endIt = accessors.constEnd();
-    for (; it != endIt; ++it) {
-        const SugarOpportunity::valueGetter getter = (*it).getter;
-        data.insert(it.key(), (this->*getter)());
+    const FieldNames *fieldNames = s_names();
+    for (int i = 0; i < FieldCount; ++i) {
+        data.insert(fieldNames->names[i], d->mValues[i]);
     }
-
-    // equivalent to this, but fully automated:
-    //data.insert("id", d->mId);
-    //data.insert("name", d->mName);
-    // ...
+    data.insert(KDCRMFields::dateModified(), dateModifiedRaw());
 
     // plus custom fields
     QMap<QString, QString>::const_iterator cit = d->mCustomFields.constBegin();
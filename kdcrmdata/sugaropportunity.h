@@ -62,6 +62,57 @@ public:
     */
     SugarOpportunity &operator=(const SugarOpportunity &);
 
+    /**
+      The fields stored as plain strings, as indexes for value() and setValue().
+     */
+    enum Field {
+        Id = 0,
+        Name,
+        DateEntered,
+        ModifiedUserId,
+        ModifiedByName,
+        CreatedBy,
+        CreatedByName,
+        Description,
+        Deleted,
+        AssignedUserId,
+        AssignedUserName,
+        OpportunityType,
+        AccountName,
+        AccountId,
+        CampaignId,
+        CampaignName,
+        LeadSource,
+        Amount,
+        AmountUsDollar,
+        CurrencyId,
+        CurrencyName,
+        CurrencySymbol,
+        DateClosed,
+        NextStep,
+        SalesStage,
+        Probability,
+        FieldCount
+    };
+
+    /**
+      Return the value of the given field.
+     */
+    QString value(Field field) const;
+    /**
+      Set the value of the given field.
+     */
+    void setValue(Field field, const QString &value);
+
+    /**
+      Return the name of the given field, as in KDCRMFields.
+     */
+    static QString fieldName(Field field);
+    /**
+      Return the Field for the given name (from KDCRMFields), or -1 if there's none (e.g. custom fields).
+     */
+    static int fieldIndex(const QString &name);
+
     /**
       Return, if the SugarOpportunity entry is empty.
      */
@@ -22,6 +22,7 @@
 
 #include "sugaropportunityio.h"
 #include "sugaropportunity.h"
+#include "kdcrmfieldstream.h"
 #include "kdcrmutils.h"
 #include "kdcrmfields.h"
 
@@ -31,8 +32,24 @@
 #include <QDebug>
 #include <QHash>
 #include <QIODevice>
+#include <QMap>
 #include <QXmlStreamWriter>
 
+static void setOpportunityField(SugarOpportunity &opportunity, const QString &key, const QString &value)
+{
+    const int index = SugarOpportunity::fieldIndex(key);
+    if (index >= 0) {
+        opportunity.setValue(static_cast<SugarOpportunity::Field>(index), value);
+    } else if (key == KDCRMFields::dateModified()) {
+        opportunity.setDateModifiedRaw(value);
+    } else if (key == "nextCallDate") {
+        // compat code, fixing previous mistake
+        opportunity.setCustomField(KDCRMFields::nextCallDate(), value);
+    } else {
+        opportunity.setCustomField(key, value);
+    }
+}
+
 SugarOpportunityIO::SugarOpportunityIO()
 {
 }
@@ -67,23 +84,12 @@ QString SugarOpportunityIO::errorString() const
 
 void SugarOpportunityIO::readOpportunity(SugarOpportunity &opportunity)
 {
-    const SugarOpportunity::AccessorHash accessors = SugarOpportunity::accessorHash();
     Q_ASSERT(xml.isStartElement() && xml.name() == "sugarOpportunity");
 
     while (xml.readNextStartElement()) {
         const QString key = xml.name().toString();
         const QString value = xml.readElementText();
-        const SugarOpportunity::AccessorHash::const_iterator accessIt = accessors.constFind(key);
-        if (accessIt != accessors.constEnd()) {
-            (opportunity.*(accessIt.value().setter))(value);
-        } else {
-            if (key == "nextCallDate") {
-                // compat code, fixing previous mistake
-                opportunity.setCustomField(KDCRMFields::nextCallDate(), value);
-            } else {
-                opportunity.setCustomField(key, value);
-            }
-        }
+        setOpportunityField(opportunity, key, value);
     }
 }
 
@@ -100,13 +106,11 @@ bool SugarOpportunityIO::writeSugarOpportunity(const SugarOpportunity &opportuni
     writer.writeStartElement("sugarOpportunity");
     writer.writeAttribute("version", "1.0");
 
-    const SugarOpportunity::AccessorHash accessors = SugarOpportunity::accessorHash();
-    SugarOpportunity::AccessorHash::const_iterator it    = accessors.constBegin();
-    SugarOpportunity::AccessorHash::const_iterator endIt = accessors.constEnd();
-    for (; it != endIt; ++it) {
-        const SugarOpportunity::valueGetter getter = (*it).getter;
-        writer.writeTextElement(it.key(), (opportunity.*getter)());
+    for (int i = 0; i < SugarOpportunity::FieldCount; ++i) {
+        const SugarOpportunity::Field field = static_cast<SugarOpportunity::Field>(i);
+        writer.writeTextElement(SugarOpportunity::fieldName(field), opportunity.value(field));
     }
+    writer.writeTextElement(KDCRMFields::dateModified(), opportunity.dateModifiedRaw());
 
     // plus custom fields
     QMap<QString, QString> customFields = opportunity.customFields();
@@ -120,3 +124,43 @@ bool SugarOpportunityIO::writeSugarOpportunity(const SugarOpportunity &opportuni
 
     return true;
 }
+
+bool SugarOpportunityIO::readSugarOpportunityBinary(QIODevice *device, SugarOpportunity &opportunity)
+{
+    if (device == nullptr || !device->isReadable()) {
+        return false;
+    }
+
+    opportunity = SugarOpportunity();
+    KDCRMFieldReader reader(device);
+    QString key;
+    QString value;
+    while (reader.readField(key, value)) {
+        setOpportunityField(opportunity, key, value);
+    }
+    return !reader.hasError();
+}
+
+bool SugarOpportunityIO::writeSugarOpportunityBinary(const SugarOpportunity &opportunity, QIODevice *device)
+{
+    if (device == nullptr || !device->isWritable()) {
+        return false;
+    }
+
+    KDCRMFieldWriter writer(device);
+    for (int i = 0; i < SugarOpportunity::FieldCount; ++i) {
+        const SugarOpportunity::Field field = static_cast<SugarOpportunity::Field>(i);
+        writer.writeField(SugarOpportunity::fieldName(field), opportunity.value(field));
+    }
+    writer.writeField(KDCRMFields::dateModified(), opportunity.dateModifiedRaw());
+
+    // plus custom fields
+    const QMap<QString, QString> customFields = opportunity.customFields();
+    QMap<QString, QString>::const_iterator cit = customFields.constBegin();
+    const QMap<QString, QString>::const_iterator end = customFields.constEnd();
+    for ( ; cit != end ; ++cit ) {
+        writer.writeField(cit.key(), cit.value());
+    }
+
+    return writer.finish();
+}
@@ -35,6 +35,9 @@ public:
     SugarOpportunityIO();
     bool readSugarOpportunity(QIODevice *device, SugarOpportunity &opportunity);
     bool writeSugarOpportunity(const SugarOpportunity &opportunity, QIODevice *device);
+    // Compact binary format (see KDCRMFieldWriter), used for the Akonadi payloads
+    bool readSugarOpportunityBinary(QIODevice *device, SugarOpportunity &opportunity);
+    bool writeSugarOpportunityBinary(const SugarOpportunity &opportunity, QIODevice *device);
     QString errorString() const;
 
 private:
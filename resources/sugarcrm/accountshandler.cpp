@@ -147,6 +147,11 @@ int AccountsHandler::expectedContentsVersion() const
     return 3;
 }
 
+int AccountsHandler::crmFieldIndex(const QString &crmFieldName) const
+{
+    return SugarAccount::fieldIndex(crmFieldName);
+}
+
 Akonadi::Item AccountsHandler::itemFromEntry(const KDSoapGenerated::TNS__Entry_value &entry, const Akonadi::Collection &parentCollection)
 {
     Akonadi::Item item;
@@ -163,17 +168,16 @@ Akonadi::Item AccountsHandler::itemFromEntry(const KDSoapGenerated::TNS__Entry_v
 
     SugarAccount account;
     account.setId(entry.id());
-    Q_FOREACH (const KDSoapGenerated::TNS__Name_value &namedValue, valueList) {
-        const QString crmFieldName = sugarFieldToCrmField(namedValue.name());
-        const QString value = KDCRMUtils::decodeXML(namedValue.value());
-        const SugarAccount::AccessorHash::const_iterator accessIt = mAccessors.constFind(crmFieldName);
-        if (accessIt == mAccessors.constEnd()) {
-            const QString crmCustomFieldName = customSugarFieldToCrmField(namedValue.name());
-            account.setCustomField(crmCustomFieldName, value);
+    const FieldColumns &columns = fieldColumns(valueList);
+    for (int i = 0; i < valueList.count(); ++i) {
+        const FieldColumn &column = columns.at(i);
+        const QString value = KDCRMUtils::decodeXML(valueList.at(i).value());
+        if (column.fieldIndex < 0) {
+            account.setCustomField(column.customCrmFieldName, value);
             continue;
         }
 
-        (account.*(accessIt.value().setter))(value);
+        account.setValue(static_cast<SugarAccount::Field>(column.fieldIndex), value);
     }
 
     SugarAccountCache *cache = SugarAccountCache::instance();
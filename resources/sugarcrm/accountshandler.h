@@ -52,6 +52,9 @@ public:
     void compare(Akonadi::AbstractDifferencesReporter *reporter,
                  const Akonadi::Item &leftItem, const Akonadi::Item &rightItem) override;
 
+protected:
+    int crmFieldIndex(const QString &crmFieldName) const override;
+
 private Q_SLOTS:
     void slotItemsReceived(const Akonadi::Item::List &items);
     void slotUpdateJobResult(KJob *job);
@@ -120,8 +120,10 @@ Akonadi::Item CampaignsHandler::itemFromEntry(const KDSoapGenerated::TNS__Entry_
 
     SugarCampaign campaign;
     campaign.setId(entry.id());
-    Q_FOREACH (const KDSoapGenerated::TNS__Name_value &namedValue, valueList) {
-        const QString crmFieldName = sugarFieldToCrmField(namedValue.name());
+    const FieldColumns &columns = fieldColumns(valueList);
+    for (int i = 0; i < valueList.count(); ++i) {
+        const KDSoapGenerated::TNS__Name_value &namedValue = valueList.at(i);
+        const QString &crmFieldName = columns.at(i).crmFieldName;
         const SugarCampaign::AccessorHash::const_iterator accessIt = mAccessors.constFind(crmFieldName);
         if (accessIt == mAccessors.constEnd()) {
             // no accessor for field
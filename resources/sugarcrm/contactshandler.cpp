@@ -846,12 +846,14 @@ Akonadi::Item ContactsHandler::itemFromEntry(const KDSoapGenerated::TNS__Entry_v
     workAddress.setType(KABC::Address::Work | KABC::Address::Pref);
     homeAddress.setType(KABC::Address::Home);
 
-    Q_FOREACH (const KDSoapGenerated::TNS__Name_value &namedValue, valueList) {
-        const QString crmFieldName = sugarFieldToCrmField(namedValue.name());
+    const FieldColumns &columns = fieldColumns(valueList);
+    for (int i = 0; i < valueList.count(); ++i) {
+        const KDSoapGenerated::TNS__Name_value &namedValue = valueList.at(i);
+        const QString &crmFieldName = columns.at(i).crmFieldName;
 
         const ContactAccessorHash::const_iterator accessIt = mAccessors->constFind(crmFieldName);
         if (accessIt == mAccessors->constEnd()) { // no accessor for regular field
-            const QString customCrmFieldName = customSugarFieldToCrmField(namedValue.name());
+            const QString customCrmFieldName = columns.at(i).customCrmFieldName;
             addressee.insertCustom("FATCRM", QString("X-Custom-%1").arg(customCrmFieldName), KDCRMUtils::decodeXML(namedValue.value()));
 
             continue;
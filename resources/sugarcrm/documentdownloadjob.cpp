@@ -0,0 +1,278 @@
+/*
+  This file is part of FatCRM, a desktop application for SugarCRM written by KDAB.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+  Authors: David Faure <david.faure@kdab.com>
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "documentdownloadjob.h"
+
+#include "sugarsession.h"
+#include "sugarsoap.h"
+using namespace KDSoapGenerated;
+
+#include <KDSoapClient/KDSoapMessage.h>
+
+#include <KDebug>
+#include <KGlobal>
+#include <KLocale>
+#include <KStandardDirs>
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QMultiMap>
+#include <QStringList>
+
+// Number of base64 characters decoded per event loop iteration
+static const int s_chunkLength = 1024 * 1024;
+
+static const char s_partialFileName[] = ".part";
+
+static bool isValidRevisionId(const QString &documentRevisionId)
+{
+    // it's used as a directory name
+    return !documentRevisionId.isEmpty()
+           && !documentRevisionId.startsWith(QLatin1Char('.'))
+           && !documentRevisionId.contains(QLatin1Char('/'));
+}
+
+static QString cacheDirectory(const QString &documentRevisionId)
+{
+    return KGlobal::dirs()->saveLocation("cache", QLatin1String("sugarcrm-documents/") + documentRevisionId + QLatin1Char('/'));
+}
+
+static inline bool isBase64Char(ushort c)
+{
+    return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9')
+           || c == '+' || c == '/' || c == '=';
+}
+
+class DocumentDownloadJob::Private
+{
+    DocumentDownloadJob *const q;
+
+public:
+    Private(DocumentDownloadJob *parent, const QString &documentRevisionId)
+        : q(parent),
+          mDocumentRevisionId(documentRevisionId),
+          mSoap(nullptr),
+          mEncodedPos(0)
+    {
+    }
+
+    void fail(const QString &errorText);
+
+public:
+    const QString mDocumentRevisionId;
+    KDSoapGenerated::Sugarsoap *mSoap;
+    QString mFileName;
+    QString mLocalFilePath;
+
+    QString mEncoded; // the file, as sent by the server
+    int mEncodedPos; // position of the next chunk to decode
+    QByteArray mPending; // base64 characters not decoded yet, less than 4 between chunks
+    QFile mFile;
+
+public: // slots
+    void getDocumentRevisionDone(const KDSoapGenerated::TNS__Return_document_revision &callResult);
+    void getDocumentRevisionError(const KDSoapMessage &fault);
+    void decodeNextChunk();
+};
+
+void DocumentDownloadJob::Private::fail(const QString &errorText)
+{
+    kWarning() << errorText;
+    mEncoded.clear();
+    if (mFile.isOpen()) {
+        mFile.close();
+        mFile.remove();
+    }
+
+    q->setError(SugarJob::TaskError);
+    q->setErrorText(errorText);
+    q->emitResult();
+}
+
+void DocumentDownloadJob::Private::getDocumentRevisionDone(const KDSoapGenerated::TNS__Return_document_revision &callResult)
+{
+    if (q->handleError(callResult.error())) {
+        return;
+    }
+
+    const KDSoapGenerated::TNS__Document_revision revision = callResult.document_revision();
+    mFileName = QFileInfo(revision.filename()).fileName();
+    if (mFileName.isEmpty() || mFileName == QLatin1String(s_partialFileName)) {
+        mFileName = mDocumentRevisionId;
+    }
+
+    mFile.setFileName(cacheDirectory(mDocumentRevisionId) + QLatin1String(s_partialFileName));
+    if (!mFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        fail(i18n("Unable to open file %1 for writing: %2", mFile.fileName(), mFile.errorString()));
+        return;
+    }
+
+    mEncoded = revision.file();
+    mEncodedPos = 0;
+    mPending.clear();
+    mPending.reserve(s_chunkLength + 4);
+    q->setTotalAmount(KJob::Bytes, qulonglong(mEncoded.length()) / 4 * 3);
+
+    QMetaObject::invokeMethod(q, "decodeNextChunk", Qt::QueuedConnection);
+}
+
+void DocumentDownloadJob::Private::getDocumentRevisionError(const KDSoapMessage &fault)
+{
+    if (!q->handleLoginError(fault)) {
+        kWarning() << "Get Document Revision Error:" << fault.faultAsString();
+
+        q->setError(SugarJob::SoapError);
+        q->setErrorText(fault.faultAsString());
+        q->emitResult();
+    }
+}
+
+void DocumentDownloadJob::Private::decodeNextChunk()
+{
+    const int end = qMin(mEncodedPos + s_chunkLength, mEncoded.length());
+    const QChar *chars = mEncoded.constData();
+    for (int i = mEncodedPos; i < end; ++i) {
+        const ushort c = chars[i].unicode();
+        if (isBase64Char(c)) {
+            mPending.append(char(c));
+        }
+    }
+    mEncodedPos = end;
+
+    const bool atEnd = mEncodedPos == mEncoded.length();
+    // base64 is decoded in groups of 4 characters, keep the rest for the next chunk
+    const int decodable = atEnd ? mPending.size() : mPending.size() - mPending.size() % 4;
+    const QByteArray decoded = QByteArray::fromBase64(QByteArray::fromRawData(mPending.constData(), decodable));
+    mPending.remove(0, decodable);
+    if (mFile.write(decoded) != decoded.size()) {
+        fail(i18n("Unable to write file %1: %2", mFile.fileName(), mFile.errorString()));
+        return;
+    }
+    q->setProcessedAmount(KJob::Bytes, mFile.pos());
+
+    if (!atEnd) {
+        QMetaObject::invokeMethod(q, "decodeNextChunk", Qt::QueuedConnection);
+        return;
+    }
+
+    mEncoded.clear();
+    mFile.close();
+    const QString localFilePath = QFileInfo(mFile).absolutePath() + QLatin1Char('/') + mFileName;
+    QFile::remove(localFilePath);
+    if (!mFile.rename(localFilePath)) {
+        fail(i18n("Unable to rename %1 to %2: %3", mFile.fileName(), localFilePath, mFile.errorString()));
+        return;
+    }
+    mLocalFilePath = localFilePath;
+    kDebug() << "Downloaded document revision" << mDocumentRevisionId << "to" << mLocalFilePath;
+
+    q->emitResult();
+}
+
+DocumentDownloadJob::DocumentDownloadJob(const QString &documentRevisionId, SugarSession *session, QObject *parent)
+    : SugarJob(session, parent), d(new Private(this, documentRevisionId))
+{
+    // not the session's interface, the transfer can take long and runs next to the resource's tasks
+    d->mSoap = session->createAdditionalSoapInterface(this);
+    connect(d->mSoap, SIGNAL(get_document_revisionDone(KDSoapGenerated::TNS__Return_document_revision)),
+            this,  SLOT(getDocumentRevisionDone(KDSoapGenerated::TNS__Return_document_revision)));
+    connect(d->mSoap, SIGNAL(get_document_revisionError(KDSoapMessage)),
+            this,  SLOT(getDocumentRevisionError(KDSoapMessage)));
+}
+
+DocumentDownloadJob::~DocumentDownloadJob()
+{
+    delete d;
+}
+
+QString DocumentDownloadJob::documentRevisionId() const
+{
+    return d->mDocumentRevisionId;
+}
+
+QString DocumentDownloadJob::localFilePath() const
+{
+    return d->mLocalFilePath;
+}
+
+QString DocumentDownloadJob::cachedFilePath(const QString &documentRevisionId)
+{
+    if (!isValidRevisionId(documentRevisionId)) {
+        return QString();
+    }
+    const QString path = KStandardDirs::locateLocal("cache", QLatin1String("sugarcrm-documents/") + documentRevisionId + QLatin1Char('/'), false);
+    // the partially downloaded file is hidden
+    const QStringList files = QDir(path).entryList(QDir::Files);
+    if (files.isEmpty()) {
+        return QString();
+    }
+    return path + files.first();
+}
+
+void DocumentDownloadJob::pruneCache(qint64 maximumSize, const QString &keptRevisionId)
+{
+    const QString cachePath = KStandardDirs::locateLocal("cache", QLatin1String("sugarcrm-documents/"), false);
+    const QDir cacheDir(cachePath);
+    qint64 totalSize = 0;
+    QMultiMap<QDateTime, QString> removableDirs; // oldest first
+    Q_FOREACH (const QString &revisionId, cacheDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot)) {
+        const QDir revisionDir(cacheDir.filePath(revisionId));
+        const QFileInfoList files = revisionDir.entryInfoList(QDir::Files | QDir::Hidden);
+        bool inProgress = false;
+        QDateTime downloaded;
+        Q_FOREACH (const QFileInfo &file, files) {
+            totalSize += file.size();
+            if (file.fileName() == QLatin1String(s_partialFileName)) {
+                inProgress = true;
+            } else if (!downloaded.isValid() || file.lastModified() > downloaded) {
+                downloaded = file.lastModified();
+            }
+        }
+        if (!inProgress && revisionId != keptRevisionId) {
+            removableDirs.insert(downloaded, revisionId);
+        }
+    }
+
+    QMultiMap<QDateTime, QString>::const_iterator it = removableDirs.constBegin();
+    for (; totalSize > maximumSize && it != removableDirs.constEnd(); ++it) {
+        QDir revisionDir(cacheDir.filePath(it.value()));
+        Q_FOREACH (const QFileInfo &file, revisionDir.entryInfoList(QDir::Files | QDir::Hidden)) {
+            if (revisionDir.remove(file.fileName())) {
+                totalSize -= file.size();
+            }
+        }
+        cacheDir.rmdir(it.value());
+        kDebug() << "Removed document revision" << it.value() << "from the cache";
+    }
+}
+
+void DocumentDownloadJob::startSugarTask()
+{
+    if (!isValidRevisionId(d->mDocumentRevisionId)) {
+        d->fail(i18n("Invalid document revision id: %1", d->mDocumentRevisionId));
+        return;
+    }
+
+    d->mSoap->asyncGet_document_revision(sessionId(), d->mDocumentRevisionId);
+}
+
+#include "documentdownloadjob.moc"
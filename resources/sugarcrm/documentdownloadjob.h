@@ -0,0 +1,72 @@
+/*
+  This file is part of FatCRM, a desktop application for SugarCRM written by KDAB.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+  Authors: David Faure <david.faure@kdab.com>
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef DOCUMENTDOWNLOADJOB_H
+#define DOCUMENTDOWNLOADJOB_H
+
+#include "sugarjob.h"
+
+namespace KDSoapGenerated
+{
+class TNS__Return_document_revision;
+}
+
+/**
+ * Downloads a document revision into the local document cache.
+ *
+ * Revisions never change once uploaded, so the cache is keyed by revision id:
+ * check cachedFilePath() before downloading. The base64 encoded file is decoded
+ * into the cache in fixed-size chunks, one per event loop iteration,
+ * reporting the progress with KJob::percent().
+ */
+class DocumentDownloadJob : public SugarJob
+{
+    Q_OBJECT
+
+public:
+    DocumentDownloadJob(const QString &documentRevisionId, SugarSession *session, QObject *parent = 0);
+
+    ~DocumentDownloadJob() override;
+
+    QString documentRevisionId() const;
+
+    // The downloaded file, once the job succeeded
+    QString localFilePath() const;
+
+    // Returns the path of the file of the given revision if it was downloaded already
+    static QString cachedFilePath(const QString &documentRevisionId);
+
+    // Removes the oldest downloads until the cache is at most maximumSize bytes,
+    // except keptRevisionId and the downloads still in progress
+    static void pruneCache(qint64 maximumSize, const QString &keptRevisionId);
+
+protected:
+    void startSugarTask() override;
+
+private:
+    class Private;
+    Private *const d;
+
+    Q_PRIVATE_SLOT(d, void getDocumentRevisionDone(const KDSoapGenerated::TNS__Return_document_revision &callResult))
+    Q_PRIVATE_SLOT(d, void getDocumentRevisionError(const KDSoapMessage &fault))
+    Q_PRIVATE_SLOT(d, void decodeNextChunk())
+};
+
+#endif
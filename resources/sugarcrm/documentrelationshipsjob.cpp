@@ -0,0 +1,128 @@
+/*
+  This file is part of FatCRM, a desktop application for SugarCRM written by KDAB.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+  Authors: David Faure <david.faure@kdab.com>
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "documentrelationshipsjob.h"
+
+#include "sugarsoap.h"
+using namespace KDSoapGenerated;
+
+#include "kdcrmdata/sugardocument.h"
+
+#include <KDSoapClient/KDSoapMessage.h>
+
+#include <KDebug>
+
+#include <QStringList>
+
+DocumentRelationshipsJob::DocumentRelationshipsJob(const Akonadi::Item::List &items, SugarSession *session,
+                                                   Sugarsoap *soap, QObject *parent)
+    : ExtraInformationJob(items, session, soap, parent),
+      mPosition(0),
+      mRelatedModule(Accounts)
+{
+}
+
+DocumentRelationshipsJob::~DocumentRelationshipsJob()
+{
+}
+
+void DocumentRelationshipsJob::startFetch()
+{
+    connect(soap(), SIGNAL(get_relationshipsDone(KDSoapGenerated::TNS__Get_relationships_result)),
+            this, SLOT(getRelationshipsDone(KDSoapGenerated::TNS__Get_relationships_result)));
+    connect(soap(), SIGNAL(get_relationshipsError(KDSoapMessage)),
+            this, SLOT(getRelationshipsError(KDSoapMessage)));
+    fetchNext();
+}
+
+void DocumentRelationshipsJob::fetchNext()
+{
+    while (mPosition < mItems.count() && !mItems.at(mPosition).hasPayload<SugarDocument>()) {
+        const Akonadi::Item &item = mItems.at(mPosition);
+        kError() << "item (id=" << item.id() << ", remoteId=" << item.remoteId()
+                 << ", mime=" << item.mimeType() << ") is missing Document payload";
+        ++mPosition;
+    }
+    if (mPosition == mItems.count()) {
+        finish();
+        return;
+    }
+
+    const QString documentId = mItems.at(mPosition).payload<SugarDocument>().id();
+    const QString relatedModule = mRelatedModule == Accounts ? QLatin1String("Accounts") : QLatin1String("Opportunities");
+    soap()->asyncGet_relationships(sessionId(), QLatin1String("Documents"), documentId, relatedModule,
+                                   QString() /*relatedModuleQuery*/, 0 /*deleted*/);
+}
+
+void DocumentRelationshipsJob::advance()
+{
+    if (mRelatedModule == Accounts) {
+        mRelatedModule = Opportunities;
+    } else {
+        mRelatedModule = Accounts;
+        ++mPosition;
+    }
+}
+
+void DocumentRelationshipsJob::getRelationshipsDone(const TNS__Get_relationships_result &callResult)
+{
+    const QString errorNumber = callResult.error().number();
+    if (isSessionError(callResult.error())) {
+        fail(callResult.error());
+        return;
+    } else if (errorNumber != QLatin1String("0")) {
+        // only about this document, go on with the others
+        kWarning() << "Could not fetch document relationships of" << mItems.at(mPosition).remoteId()
+                   << ":" << errorNumber << callResult.error().description();
+    } else {
+        QStringList linkedIds;
+        Q_FOREACH (const KDSoapGenerated::TNS__Id_mod &idMod, callResult.ids().items()) {
+            linkedIds.append(idMod.id());
+        }
+        if (!linkedIds.isEmpty()) {
+            Akonadi::Item &item = mItems[mPosition];
+            SugarDocument document = item.payload<SugarDocument>();
+            if (mRelatedModule == Accounts) {
+                document.setLinkedAccountIds(linkedIds);
+            } else {
+                document.setLinkedOpportunityIds(linkedIds);
+            }
+            item.setPayload<SugarDocument>(document);
+        }
+    }
+
+    advance();
+    fetchNext();
+}
+
+void DocumentRelationshipsJob::getRelationshipsError(const KDSoapMessage &fault)
+{
+    kWarning() << "Could not fetch document relationships of" << mItems.at(mPosition).remoteId()
+               << ":" << fault.faultAsString();
+    if (isTransportError(fault)) {
+        fail(fault);
+        return;
+    }
+
+    advance();
+    fetchNext();
+}
+
+#include "documentrelationshipsjob.moc"
@@ -0,0 +1,70 @@
+/*
+  This file is part of FatCRM, a desktop application for SugarCRM written by KDAB.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+  Authors: David Faure <david.faure@kdab.com>
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef DOCUMENTRELATIONSHIPSJOB_H
+#define DOCUMENTRELATIONSHIPSJOB_H
+
+#include "extrainformationjob.h"
+
+class KDSoapMessage;
+namespace KDSoapGenerated
+{
+class TNS__Get_relationships_result;
+}
+
+/**
+ * Fetches the accounts and opportunities linked to the listed documents.
+ *
+ * The SOAP API only returns the relationships of one document at a time,
+ * so the requests are sent one after the other, from the event loop.
+ * Errors follow the ExtraInformationJob policy, per document: an error about
+ * one document only skips that document.
+ */
+class DocumentRelationshipsJob : public ExtraInformationJob
+{
+    Q_OBJECT
+
+public:
+    DocumentRelationshipsJob(const Akonadi::Item::List &items, SugarSession *session,
+                             KDSoapGenerated::Sugarsoap *soap, QObject *parent = 0);
+
+    ~DocumentRelationshipsJob() override;
+
+protected:
+    void startFetch() override;
+
+private Q_SLOTS:
+    void getRelationshipsDone(const KDSoapGenerated::TNS__Get_relationships_result &callResult);
+    void getRelationshipsError(const KDSoapMessage &fault);
+
+private:
+    enum RelatedModule {
+        Accounts,
+        Opportunities
+    };
+
+    void fetchNext();
+    void advance();
+
+    int mPosition; // position of the current document in the item list
+    RelatedModule mRelatedModule;
+};
+
+#endif
@@ -20,6 +20,7 @@
 
 #include "documentshandler.h"
 
+#include "documentrelationshipsjob.h"
 #include "kdcrmutils.h"
 #include "sugarsession.h"
 #include "sugarsoap.h"
@@ -135,46 +136,11 @@ bool DocumentsHandler::needsExtraInformation() const
     return true;
 }
 
-void DocumentsHandler::getExtraInformation(Akonadi::Item::List &items)
+ExtraInformationJob *DocumentsHandler::createExtraInformationJob(const Akonadi::Item::List &items,
+                                                                KDSoapGenerated::Sugarsoap *soap,
+                                                                QObject *parent)
 {
-    for (int pos = 0; pos < items.count(); ++pos) {
-        Akonadi::Item &item = items[pos];
-
-        if (!item.hasPayload<SugarDocument>()) {
-            kError() << "item (id=" << item.id() << ", remoteId=" << item.remoteId()
-                     << ", mime=" << item.mimeType() << ") is missing Document payload";
-            continue;
-        }
-
-        SugarDocument document = item.payload<SugarDocument>();
-        bool update = false;
-
-        KDSoapGenerated::TNS__Get_relationships_result result = soap()->get_relationships(sessionId(), "Documents", document.id(), "Accounts", QString(), 0);
-
-        QStringList linkedAccountIds;
-        Q_FOREACH (const KDSoapGenerated::TNS__Id_mod &idMod, result.ids().items()) {
-            linkedAccountIds.append(idMod.id());
-        }
-
-        if (!linkedAccountIds.isEmpty()) {
-            document.setLinkedAccountIds(linkedAccountIds);
-            update = true;
-        }
-
-        QStringList linkedOpportunityIds;
-        result = soap()->get_relationships(sessionId(), "Documents", document.id(), "Opportunities", QString(), 0);
-        Q_FOREACH (const KDSoapGenerated::TNS__Id_mod &idMod, result.ids().items()) {
-            linkedOpportunityIds.append(idMod.id());
-        }
-
-        if (!linkedOpportunityIds.isEmpty()) {
-            document.setLinkedOpportunityIds(linkedOpportunityIds);
-            update = true;
-        }
-
-        if (update)
-            item.setPayload<SugarDocument>(document);
-    }
+    return new DocumentRelationshipsJob(items, mSession, soap, parent);
 }
 
 Akonadi::Item DocumentsHandler::itemFromEntry(const KDSoapGenerated::TNS__Entry_value &entry, const Akonadi::Collection &parentCollection)
@@ -193,12 +159,14 @@ Akonadi::Item DocumentsHandler::itemFromEntry(const KDSoapGenerated::TNS__Entry_
 
     SugarDocument document;
     document.setId(entry.id());
-    Q_FOREACH (const KDSoapGenerated::TNS__Name_value &namedValue, valueList) {
-        const QString crmFieldName = sugarFieldToCrmField(namedValue.name());
+    const FieldColumns &columns = fieldColumns(valueList);
+    for (int i = 0; i < valueList.count(); ++i) {
+        const KDSoapGenerated::TNS__Name_value &namedValue = valueList.at(i);
+        const QString &crmFieldName = columns.at(i).crmFieldName;
         const QString value = KDCRMUtils::decodeXML(namedValue.value());
         const SugarDocument::AccessorHash::const_iterator accessIt = mAccessors.constFind(crmFieldName);
         if (accessIt == mAccessors.constEnd()) {
-            const QString crmCustomFieldName = customSugarFieldToCrmField(namedValue.name());
+            const QString crmCustomFieldName = columns.at(i).customCrmFieldName;
             document.setCustomField(crmCustomFieldName, value);
             continue;
         }
@@ -46,7 +46,9 @@ public:
     int expectedContentsVersion() const override;
 
     bool needsExtraInformation() const override;
-    void getExtraInformation(Akonadi::Item::List &items) override;
+    ExtraInformationJob *createExtraInformationJob(const Akonadi::Item::List &items,
+                                                   KDSoapGenerated::Sugarsoap *soap,
+                                                   QObject *parent) override;
     Akonadi::Item itemFromEntry(const KDSoapGenerated::TNS__Entry_value &entry, const Akonadi::Collection &parentCollection) override;
 
     void compare(Akonadi::AbstractDifferencesReporter *reporter,
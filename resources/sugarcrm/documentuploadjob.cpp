@@ -0,0 +1,218 @@
+/*
+  This file is part of FatCRM, a desktop application for SugarCRM written by KDAB.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+  Authors: David Faure <david.faure@kdab.com>
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "documentuploadjob.h"
+
+#include "sugarsession.h"
+#include "sugarsoap.h"
+using namespace KDSoapGenerated;
+
+#include <KDSoapClient/KDSoapMessage.h>
+
+#include <KDebug>
+#include <KLocale>
+
+#include <QFile>
+
+// Number of bytes encoded per event loop iteration, a multiple of 3 so that
+// the encoded chunks can simply be appended to each other
+static const int s_chunkSize = 3 * 256 * 1024;
+
+class DocumentUploadJob::Private
+{
+    DocumentUploadJob *const q;
+
+public:
+    Private(DocumentUploadJob *parent, const QString &documentName, const QString &statusId,
+            const QString &description, const QString &localFilePath)
+        : q(parent),
+          mDocumentName(documentName),
+          mStatusId(statusId),
+          mDescription(description),
+          mFile(localFilePath),
+          mSoap(nullptr)
+    {
+    }
+
+    void createDocument();
+    void uploadRevision();
+    void fail(const QString &errorText);
+
+public:
+    const QString mDocumentName;
+    const QString mStatusId;
+    const QString mDescription;
+    QFile mFile;
+    KDSoapGenerated::Sugarsoap *mSoap;
+    QString mDocumentId;
+    QString mEncoded; // the file, as sent to the server
+
+public: // slots
+    void setEntryDone(const KDSoapGenerated::TNS__Set_entry_result &callResult);
+    void setDocumentRevisionDone(const KDSoapGenerated::TNS__Set_entry_result &callResult);
+    void soapError(const KDSoapMessage &fault);
+    void encodeNextChunk();
+};
+
+void DocumentUploadJob::Private::createDocument()
+{
+    KDSoapGenerated::TNS__Name_value documentNameProperty;
+    documentNameProperty.setName("document_name");
+    documentNameProperty.setValue(mDocumentName);
+
+    KDSoapGenerated::TNS__Name_value statusIdProperty;
+    statusIdProperty.setName("status_id");
+    statusIdProperty.setValue(mStatusId);
+
+    KDSoapGenerated::TNS__Name_value descriptionProperty;
+    descriptionProperty.setName("description");
+    descriptionProperty.setValue(mDescription);
+
+    KDSoapGenerated::TNS__Name_value_list documentProperties;
+    documentProperties.setItems(QList<KDSoapGenerated::TNS__Name_value>() << documentNameProperty << statusIdProperty << descriptionProperty);
+
+    mSoap->asyncSet_entry(q->sessionId(), "Documents", documentProperties);
+}
+
+void DocumentUploadJob::Private::uploadRevision()
+{
+    KDSoapGenerated::TNS__Document_revision documentRevision;
+    documentRevision.setId(mDocumentId);
+    documentRevision.setRevision("1");
+    documentRevision.setFilename(mDocumentName);
+    documentRevision.setFile(mEncoded);
+
+    mSoap->asyncSet_document_revision(q->sessionId(), documentRevision);
+}
+
+void DocumentUploadJob::Private::fail(const QString &errorText)
+{
+    kWarning() << errorText;
+    mEncoded.clear();
+    mFile.close();
+
+    q->setError(SugarJob::TaskError);
+    q->setErrorText(errorText);
+    q->emitResult();
+}
+
+void DocumentUploadJob::Private::setEntryDone(const KDSoapGenerated::TNS__Set_entry_result &callResult)
+{
+    if (q->handleError(callResult.error())) {
+        return;
+    }
+
+    mDocumentId = callResult.id();
+    kDebug() << "Created document" << mDocumentId << "uploading" << mFile.fileName();
+
+    const qint64 size = mFile.size();
+    q->setTotalAmount(KJob::Bytes, size);
+    mEncoded.clear();
+    mEncoded.reserve((size + 2) / 3 * 4);
+
+    QMetaObject::invokeMethod(q, "encodeNextChunk", Qt::QueuedConnection);
+}
+
+void DocumentUploadJob::Private::setDocumentRevisionDone(const KDSoapGenerated::TNS__Set_entry_result &callResult)
+{
+    if (q->handleError(callResult.error())) {
+        return;
+    }
+
+    mEncoded.clear();
+    q->emitResult();
+}
+
+void DocumentUploadJob::Private::soapError(const KDSoapMessage &fault)
+{
+    if (!q->handleLoginError(fault)) {
+        kWarning() << "Upload Document Error:" << fault.faultAsString();
+
+        mEncoded.clear();
+        q->setError(SugarJob::SoapError);
+        q->setErrorText(fault.faultAsString());
+        q->emitResult();
+    }
+}
+
+void DocumentUploadJob::Private::encodeNextChunk()
+{
+    const QByteArray chunk = mFile.read(s_chunkSize);
+    if (chunk.isEmpty() && !mFile.atEnd()) {
+        fail(i18n("Unable to read file %1: %2", mFile.fileName(), mFile.errorString()));
+        return;
+    }
+    mEncoded.append(QLatin1String(chunk.toBase64().constData()));
+    q->setProcessedAmount(KJob::Bytes, mFile.pos());
+
+    if (mFile.atEnd()) {
+        mFile.close();
+        uploadRevision();
+    } else {
+        QMetaObject::invokeMethod(q, "encodeNextChunk", Qt::QueuedConnection);
+    }
+}
+
+DocumentUploadJob::DocumentUploadJob(const QString &documentName, const QString &statusId, const QString &description,
+                                     const QString &localFilePath, SugarSession *session, QObject *parent)
+    : SugarJob(session, parent), d(new Private(this, documentName, statusId, description, localFilePath))
+{
+    // not the session's interface, the transfer can take long and runs next to the resource's tasks
+    d->mSoap = session->createAdditionalSoapInterface(this);
+    connect(d->mSoap, SIGNAL(set_entryDone(KDSoapGenerated::TNS__Set_entry_result)),
+            this,  SLOT(setEntryDone(KDSoapGenerated::TNS__Set_entry_result)));
+    connect(d->mSoap, SIGNAL(set_entryError(KDSoapMessage)),
+            this,  SLOT(soapError(KDSoapMessage)));
+    connect(d->mSoap, SIGNAL(set_document_revisionDone(KDSoapGenerated::TNS__Set_entry_result)),
+            this,  SLOT(setDocumentRevisionDone(KDSoapGenerated::TNS__Set_entry_result)));
+    connect(d->mSoap, SIGNAL(set_document_revisionError(KDSoapMessage)),
+            this,  SLOT(soapError(KDSoapMessage)));
+}
+
+DocumentUploadJob::~DocumentUploadJob()
+{
+    delete d;
+}
+
+QString DocumentUploadJob::localFilePath() const
+{
+    return d->mFile.fileName();
+}
+
+QString DocumentUploadJob::documentId() const
+{
+    return d->mDocumentId;
+}
+
+void DocumentUploadJob::startSugarTask()
+{
+    // Also called again after a new login
+    if (d->mDocumentId.isEmpty()) {
+        if (!d->mFile.isOpen() && !d->mFile.open(QIODevice::ReadOnly)) {
+            d->fail(i18n("Unable to open file %1 for reading: %2", d->mFile.fileName(), d->mFile.errorString()));
+            return;
+        }
+        d->createDocument();
+    } else {
+        d->uploadRevision();
+    }
+}
+
+#include "documentuploadjob.moc"
@@ -0,0 +1,65 @@
+/*
+  This file is part of FatCRM, a desktop application for SugarCRM written by KDAB.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+  Authors: David Faure <david.faure@kdab.com>
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef DOCUMENTUPLOADJOB_H
+#define DOCUMENTUPLOADJOB_H
+
+#include "sugarjob.h"
+
+namespace KDSoapGenerated
+{
+class TNS__Set_entry_result;
+}
+
+/**
+ * Creates a document, then uploads a local file as its first revision.
+ *
+ * The file is read and base64 encoded in fixed-size chunks, one per event
+ * loop iteration, reporting the progress with KJob::percent().
+ */
+class DocumentUploadJob : public SugarJob
+{
+    Q_OBJECT
+
+public:
+    DocumentUploadJob(const QString &documentName, const QString &statusId, const QString &description,
+                      const QString &localFilePath, SugarSession *session, QObject *parent = 0);
+
+    ~DocumentUploadJob() override;
+
+    QString localFilePath() const;
+
+    // The id of the created document, once the job succeeded
+    QString documentId() const;
+
+protected:
+    void startSugarTask() override;
+
+private:
+    class Private;
+    Private *const d;
+
+    Q_PRIVATE_SLOT(d, void setEntryDone(const KDSoapGenerated::TNS__Set_entry_result &callResult))
+    Q_PRIVATE_SLOT(d, void setDocumentRevisionDone(const KDSoapGenerated::TNS__Set_entry_result &callResult))
+    Q_PRIVATE_SLOT(d, void soapError(const KDSoapMessage &fault))
+    Q_PRIVATE_SLOT(d, void encodeNextChunk())
+};
+
+#endif
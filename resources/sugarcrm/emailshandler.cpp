@@ -22,6 +22,7 @@
 
 #include "emailshandler.h"
 
+#include "emailtextjob.h"
 #include "kdcrmutils.h"
 #include "sugarsession.h"
 #include "sugarsoap.h"
@@ -85,64 +86,11 @@ int EmailsHandler::expectedContentsVersion() const
     return 3;
 }
 
-void EmailsHandler::getExtraInformation(Akonadi::Item::List &items)
+ExtraInformationJob *EmailsHandler::createExtraInformationJob(const Akonadi::Item::List &items,
+                                                             KDSoapGenerated::Sugarsoap *soap,
+                                                             QObject *parent)
 {
-    /* EmailText contains e.g.
-"email_id" = "286898c4-d48f-cd01-e620-4a1d3ad0428e"
-"from_addr" = "Mirko Boehm &lt;mirko@kdab.net&gt;"
-"reply_to_addr" = ""
-"to_addrs" = "mirko@kdab.net"
-"cc_addrs" = ""
-"bcc_addrs" = ""
-"description" = "Test. So."
-"description_html" = "&lt;em&gt;Test.&lt;u&gt; So.&lt;/u&gt;&lt;br /&gt;&lt;/em&gt;"
-"raw_source" = ""
-"deleted" = "0"
-*/
-
-    QHash<QString, int> itemIndexById; // remoteId --> position in item list
-    QString query;
-    for (int i = 0; i < items.count(); ++i) {
-        const Akonadi::Item &item = items.at(i);
-        if (!query.isEmpty())
-            query += " or ";
-        query += "email_id='" + item.remoteId() + '\'';
-        itemIndexById.insert(item.remoteId(), i);
-    }
-    KDSoapGenerated::TNS__Select_fields selectedFields;
-    selectedFields.setItems(QStringList() << "email_id" << "description" << "description_html");
-    // Blocking call
-    KDSoapGenerated::TNS__Get_entry_list_result result =
-            soap()->get_entry_list(sessionId(), "EmailText", query, QString() /*orderBy*/,
-                                   0 /*offset*/, selectedFields, items.count() /*maxResults*/, 0 /*fetchDeleted*/);
-
-    foreach(const KDSoapGenerated::TNS__Entry_value &entry, result.entry_list().items()) {
-        QString email_id, description, descriptionHtml;
-        foreach(const KDSoapGenerated::TNS__Name_value &val, entry.name_value_list().items()) {
-            if (val.name() == "email_id") {
-                email_id = val.value();
-            } else if (val.name() == "description") {
-                description = KDCRMUtils::decodeXML(val.value().trimmed());
-            } else if (val.name() == "description_html") {
-                descriptionHtml = KDCRMUtils::decodeXML(val.value().trimmed());
-            }
-        }
-        if (email_id.isEmpty()) {
-            kWarning() << "No email_id found in entry";
-        } else {
-            const int pos = itemIndexById.value(email_id, -1);
-            if (pos == -1) {
-                kWarning() << "Email not found:" << email_id;
-            } else {
-                SugarEmail email = items[pos].payload<SugarEmail>();
-                email.setDescription(description);
-                if (description.isEmpty()) {
-                    email.setDescriptionHtml(descriptionHtml);
-                }
-                items[pos].setPayload<SugarEmail>(email);
-            }
-        }
-    }
+    return new EmailTextJob(items, mSession, soap, parent);
 }
 
 bool EmailsHandler::setEntry(const Akonadi::Item &item)
@@ -208,8 +156,10 @@ Akonadi::Item EmailsHandler::itemFromEntry(const KDSoapGenerated::TNS__Entry_val
 
     SugarEmail email;
     email.setId(entry.id());
-    Q_FOREACH (const KDSoapGenerated::TNS__Name_value &namedValue, valueList) {
-        const QString crmFieldName = sugarFieldToCrmField(namedValue.name());
+    const FieldColumns &columns = fieldColumns(valueList);
+    for (int i = 0; i < valueList.count(); ++i) {
+        const KDSoapGenerated::TNS__Name_value &namedValue = valueList.at(i);
+        const QString &crmFieldName = columns.at(i).crmFieldName;
         const SugarEmail::AccessorHash::const_iterator accessIt = mAccessors.constFind(crmFieldName);
         if (accessIt == mAccessors.constEnd()) {
             // no accessor for field
@@ -49,7 +49,9 @@ public:
     int expectedContentsVersion() const override;
 
     virtual bool needsExtraInformation() const override { return true; }
-    virtual void getExtraInformation(Akonadi::Item::List &items) override;
+    ExtraInformationJob *createExtraInformationJob(const Akonadi::Item::List &items,
+                                                   KDSoapGenerated::Sugarsoap *soap,
+                                                   QObject *parent) override;
 
     Akonadi::Item itemFromEntry(const KDSoapGenerated::TNS__Entry_value &entry, const Akonadi::Collection &parentCollection) override;
 
@@ -0,0 +1,136 @@
+/*
+  This file is part of FatCRM, a desktop application for SugarCRM written by KDAB.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+  Authors: David Faure <david.faure@kdab.com>
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "emailtextjob.h"
+
+#include "kdcrmutils.h"
+#include "sugarsoap.h"
+using namespace KDSoapGenerated;
+
+#include "kdcrmdata/sugaremail.h"
+
+#include <KDSoapClient/KDSoapMessage.h>
+
+#include <KDebug>
+
+#include <QStringList>
+
+EmailTextJob::EmailTextJob(const Akonadi::Item::List &items, SugarSession *session,
+                           Sugarsoap *soap, QObject *parent)
+    : ExtraInformationJob(items, session, soap, parent)
+{
+}
+
+EmailTextJob::~EmailTextJob()
+{
+}
+
+void EmailTextJob::startFetch()
+{
+    /* EmailText contains e.g.
+"email_id" = "286898c4-d48f-cd01-e620-4a1d3ad0428e"
+"from_addr" = "Mirko Boehm &lt;mirko@kdab.net&gt;"
+"reply_to_addr" = ""
+"to_addrs" = "mirko@kdab.net"
+"cc_addrs" = ""
+"bcc_addrs" = ""
+"description" = "Test. So."
+"description_html" = "&lt;em&gt;Test.&lt;u&gt; So.&lt;/u&gt;&lt;br /&gt;&lt;/em&gt;"
+"raw_source" = ""
+"deleted" = "0"
+*/
+
+    QStringList quotedIds;
+    quotedIds.reserve(mItems.count());
+    for (int i = 0; i < mItems.count(); ++i) {
+        const QString remoteId = mItems.at(i).remoteId();
+        quotedIds.append(QLatin1Char('\'') + remoteId + QLatin1Char('\''));
+        mItemIndexById.insert(remoteId, i);
+    }
+    const QString query = QLatin1String("email_id in (") + quotedIds.join(QLatin1String(",")) + QLatin1Char(')');
+
+    KDSoapGenerated::TNS__Select_fields selectedFields;
+    selectedFields.setItems(QStringList() << "email_id" << "description" << "description_html");
+
+    connect(soap(), SIGNAL(get_entry_listDone(KDSoapGenerated::TNS__Get_entry_list_result)),
+            this, SLOT(listEntriesDone(KDSoapGenerated::TNS__Get_entry_list_result)));
+    connect(soap(), SIGNAL(get_entry_listError(KDSoapMessage)),
+            this, SLOT(listEntriesError(KDSoapMessage)));
+    soap()->asyncGet_entry_list(sessionId(), "EmailText", query, QString() /*orderBy*/,
+                                0 /*offset*/, selectedFields, mItems.count() /*maxResults*/, 0 /*fetchDeleted*/);
+}
+
+void EmailTextJob::listEntriesDone(const TNS__Get_entry_list_result &callResult)
+{
+    if (callResult.error().number() != QLatin1String("0")) {
+        kWarning() << "Could not fetch email texts:" << callResult.error().number() << callResult.error().description();
+        if (isSessionError(callResult.error())) {
+            fail(callResult.error());
+        } else {
+            // deliver these emails without their text rather than blocking the listing
+            finish();
+        }
+        return;
+    }
+
+    foreach(const KDSoapGenerated::TNS__Entry_value &entry, callResult.entry_list().items()) {
+        QString email_id, description, descriptionHtml;
+        foreach(const KDSoapGenerated::TNS__Name_value &val, entry.name_value_list().items()) {
+            if (val.name() == "email_id") {
+                email_id = val.value();
+            } else if (val.name() == "description") {
+                description = KDCRMUtils::decodeXML(val.value().trimmed());
+            } else if (val.name() == "description_html") {
+                descriptionHtml = KDCRMUtils::decodeXML(val.value().trimmed());
+            }
+        }
+        if (email_id.isEmpty()) {
+            kWarning() << "No email_id found in entry";
+        } else {
+            const int pos = mItemIndexById.value(email_id, -1);
+            if (pos == -1) {
+                kWarning() << "Email not found:" << email_id;
+            } else {
+                SugarEmail email = mItems[pos].payload<SugarEmail>();
+                email.setDescription(description);
+                if (description.isEmpty()) {
+                    email.setDescriptionHtml(descriptionHtml);
+                }
+                mItems[pos].setPayload<SugarEmail>(email);
+            }
+        }
+    }
+
+    finish();
+}
+
+void EmailTextJob::listEntriesError(const KDSoapMessage &fault)
+{
+    kWarning() << "Could not fetch email texts:" << fault.faultAsString();
+    if (isTransportError(fault)) {
+        fail(fault);
+    } else {
+        // deliver these emails without their text rather than blocking the listing
+        finish();
+    }
+}
+
+#include "emailtextjob.moc"
@@ -0,0 +1,62 @@
+/*
+  This file is part of FatCRM, a desktop application for SugarCRM written by KDAB.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+  Authors: David Faure <david.faure@kdab.com>
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef EMAILTEXTJOB_H
+#define EMAILTEXTJOB_H
+
+#include "extrainformationjob.h"
+
+#include <QHash>
+
+class KDSoapMessage;
+namespace KDSoapGenerated
+{
+class TNS__Get_entry_list_result;
+}
+
+/**
+ * Fetches the text of listed emails (description and description_html)
+ * from the EmailText module, with one query for the whole page.
+ *
+ * Errors follow the ExtraInformationJob policy, for the whole page.
+ */
+class EmailTextJob : public ExtraInformationJob
+{
+    Q_OBJECT
+
+public:
+    EmailTextJob(const Akonadi::Item::List &items, SugarSession *session,
+                 KDSoapGenerated::Sugarsoap *soap, QObject *parent = 0);
+
+    ~EmailTextJob() override;
+
+protected:
+    void startFetch() override;
+
+private Q_SLOTS:
+    void listEntriesDone(const KDSoapGenerated::TNS__Get_entry_list_result &callResult);
+    void listEntriesError(const KDSoapMessage &fault);
+
+private:
+    QHash<QString, int> mItemIndexById; // remoteId --> position in item list
+};
+
+#endif
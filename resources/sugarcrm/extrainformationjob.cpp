@@ -0,0 +1,130 @@
+/*
+  This file is part of FatCRM, a desktop application for SugarCRM written by KDAB.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+  Authors: David Faure <david.faure@kdab.com>
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "extrainformationjob.h"
+
+#include "sugarsession.h"
+using namespace KDSoapGenerated;
+
+#include <QNetworkReply>
+
+ExtraInformationJob::ExtraInformationJob(const Akonadi::Item::List &items, SugarSession *session,
+                                         Sugarsoap *soap, QObject *parent)
+    : KJob(parent),
+      mItems(items),
+      mSession(session),
+      mSoap(soap)
+{
+}
+
+ExtraInformationJob::~ExtraInformationJob()
+{
+}
+
+void ExtraInformationJob::start()
+{
+    QMetaObject::invokeMethod(this, "slotStart", Qt::QueuedConnection);
+}
+
+Akonadi::Item::List ExtraInformationJob::items() const
+{
+    return mItems;
+}
+
+Sugarsoap *ExtraInformationJob::soap() const
+{
+    return mSoap;
+}
+
+TNS__Error_value ExtraInformationJob::errorValue() const
+{
+    return mErrorValue;
+}
+
+KDSoapMessage ExtraInformationJob::fault() const
+{
+    return mFault;
+}
+
+bool ExtraInformationJob::doKill()
+{
+    mSoap->disconnect(this);
+    return true;
+}
+
+void ExtraInformationJob::finish()
+{
+    mSoap->disconnect(this);
+    emitResult();
+}
+
+void ExtraInformationJob::fail(const TNS__Error_value &errorValue)
+{
+    mErrorValue = errorValue;
+    setError(ServerError);
+    setErrorText(errorValue.description());
+    finish();
+}
+
+void ExtraInformationJob::fail(const KDSoapMessage &fault)
+{
+    mFault = fault;
+    setError(FaultError);
+    setErrorText(fault.faultAsString());
+    finish();
+}
+
+bool ExtraInformationJob::isSessionError(const TNS__Error_value &errorValue)
+{
+    return errorValue.number() == QLatin1String("10");
+}
+
+bool ExtraInformationJob::isTransportError(const KDSoapMessage &fault)
+{
+    // KDSoap reports a failed request as a fault with the QNetworkReply error as fault code.
+    // A SOAP fault sent by the server is parsed from the response instead, even if the
+    // HTTP status is an error, so its fault code is the server's (e.g. "SOAP-ENV:Server").
+    bool isNumber = false;
+    const int errorCode = fault.childValues().child(QLatin1String("faultcode")).value().toString().toInt(&isNumber);
+    if (!isNumber) {
+        return false;
+    }
+    // Connection and proxy errors, see QNetworkReply::NetworkError. Content and protocol
+    // errors (e.g. 404) mean that the server answered, trying again won't help.
+    return (errorCode >= QNetworkReply::ConnectionRefusedError && errorCode <= QNetworkReply::UnknownNetworkError)
+           || (errorCode >= QNetworkReply::ProxyConnectionRefusedError && errorCode <= QNetworkReply::UnknownProxyError);
+}
+
+QString ExtraInformationJob::sessionId() const
+{
+    return mSession->sessionId();
+}
+
+void ExtraInformationJob::slotStart()
+{
+    if (mItems.isEmpty()) {
+        finish();
+    } else {
+        startFetch();
+    }
+}
+
+#include "extrainformationjob.moc"
@@ -0,0 +1,104 @@
+/*
+  This file is part of FatCRM, a desktop application for SugarCRM written by KDAB.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+  Authors: David Faure <david.faure@kdab.com>
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef EXTRAINFORMATIONJOB_H
+#define EXTRAINFORMATIONJOB_H
+
+#include "sugarsoap.h"
+
+#include <Akonadi/Item>
+
+#include <KDSoapClient/KDSoapMessage.h>
+
+#include <KJob>
+
+class SugarSession;
+
+/**
+ * Base class for fetching extra information on listed items (e.g. email text),
+ * see ModuleHandler::createExtraInformationJob().
+ *
+ * The job gets a SOAP interface of its own, so that it can run while the next
+ * page of entries is being listed.
+ *
+ * Error policy, the same for all subclasses: an expired session (error 10) or a
+ * transport error (see isTransportError()) fails the job, ListEntriesJob then logs
+ * in again and lists the page again. Any other error sent by the server is about
+ * the request itself and wouldn't go away by retrying: it's logged, and the items
+ * concerned are delivered without the extra information.
+ */
+class ExtraInformationJob : public KJob
+{
+    Q_OBJECT
+
+public:
+    enum Errors {
+        ServerError = KJob::UserDefinedError + 1, // see errorValue()
+        FaultError // see fault()
+    };
+
+    ExtraInformationJob(const Akonadi::Item::List &items, SugarSession *session,
+                        KDSoapGenerated::Sugarsoap *soap, QObject *parent = 0);
+
+    ~ExtraInformationJob() override;
+
+    void start() override;
+
+    // The items, completed with the extra information once the job finished
+    Akonadi::Item::List items() const;
+
+    KDSoapGenerated::Sugarsoap *soap() const;
+
+    // What made the job fail
+    KDSoapGenerated::TNS__Error_value errorValue() const;
+    KDSoapMessage fault() const;
+
+protected:
+    bool doKill() override;
+
+    // Called from the event loop. Send the request(s), and call finish() when done.
+    virtual void startFetch() = 0;
+    // Disconnects from the SOAP interface, so that it can be used by another job
+    void finish();
+    // Finish with an error, see the error policy above
+    void fail(const KDSoapGenerated::TNS__Error_value &errorValue);
+    void fail(const KDSoapMessage &fault);
+
+    // Whether the server said that the session expired
+    static bool isSessionError(const KDSoapGenerated::TNS__Error_value &errorValue);
+    // Whether the request didn't make it to the server or back, rather than a fault sent by the server
+    static bool isTransportError(const KDSoapMessage &fault);
+
+    QString sessionId() const;
+
+    Akonadi::Item::List mItems;
+
+private Q_SLOTS:
+    void slotStart();
+
+private:
+    SugarSession *mSession;
+    KDSoapGenerated::Sugarsoap *mSoap;
+    KDSoapGenerated::TNS__Error_value mErrorValue;
+    KDSoapMessage mFault;
+};
+
+#endif
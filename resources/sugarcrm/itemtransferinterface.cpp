@@ -20,102 +20,48 @@
 
 #include "itemtransferinterface.h"
 
+#include "documentdownloadjob.h"
+#include "documentuploadjob.h"
 #include "sugarsession.h"
-#include "sugarsoap.h"
 #include "sugarsoap41.h"
 #include "sugarcrmresource.h"
+#include "settings.h"
 
-#include <KCodecs>
-#include <KTempDir>
+#include <KDebug>
+#include <KUrl>
 
-#include <QFile>
+#include <QDBusConnection>
 
 ItemTransferInterface::ItemTransferInterface(SugarCRMResource *resource)
     : QObject(resource), mResource(resource)
 {
 }
 
-QString ItemTransferInterface::downloadDocumentRevision(const QString &documentRevisionId) const
+QString ItemTransferInterface::downloadDocumentRevision(const QString &documentRevisionId)
 {
-    SugarSession *session = mResource->mSession;
-    KDSoapGenerated::Sugarsoap *soap = session->soap();
-    const QString sessionId = session->sessionId();
-    if (sessionId.isEmpty()) {
-        qWarning() << "No session! Need to login first.";
+    const QString cachedFilePath = DocumentDownloadJob::cachedFilePath(documentRevisionId);
+    if (!cachedFilePath.isEmpty()) {
+        return cachedFilePath;
     }
 
-    const KDSoapGenerated::TNS__Return_document_revision result = soap->get_document_revision(sessionId, documentRevisionId);
-    const KDSoapGenerated::TNS__Document_revision revision = result.document_revision();
-
-    KTempDir tempDir;
-    tempDir.setAutoRemove(false);
-
-    const QString fullPath(tempDir.name() + revision.filename());
-    QFile file(fullPath);
-    if (!file.open(QIODevice::WriteOnly)) {
-        tempDir.setAutoRemove(true);
-        return QString();
+    // Clicking twice on a document mustn't download it twice into the same cache file
+    if (KJob *job = mDownloads.value(documentRevisionId)) {
+        delayReply(mTransfers[job]);
+        return QString(); // not sent, see slotDownloadResult
     }
 
-    file.write(KCodecs::base64Decode(revision.file().toLatin1()));
-
-    return fullPath;
+    // the job logs in first if needed
+    DocumentDownloadJob *job = new DocumentDownloadJob(documentRevisionId, mResource->mSession, this);
+    mDownloads.insert(documentRevisionId, job);
+    startTransfer(job, documentRevisionId, SLOT(slotDownloadResult(KJob*)));
+    return QString(); // not sent, see slotDownloadResult
 }
 
-QString ItemTransferInterface::uploadDocument(const QString &documentName, const QString &statusId, const QString &description, const QString &localFilePath) const
+QString ItemTransferInterface::uploadDocument(const QString &documentName, const QString &statusId, const QString &description, const QString &localFilePath)
 {
-    QFile file(localFilePath);
-    if (!file.open(QIODevice::ReadOnly)) {
-        qWarning() << "Unable to open file" << file.fileName() << "for reading";
-        return QString();
-    }
-
-    SugarSession *session = mResource->mSession;
-    KDSoapGenerated::Sugarsoap *soap = session->soap();
-    const QString sessionId = session->sessionId();
-    if (sessionId.isEmpty()) {
-        qWarning() << "No session! Need to login first.";
-    }
-
-    // first create the document entry
-    KDSoapGenerated::TNS__Name_value documentNameProperty;
-    documentNameProperty.setName("document_name");
-    documentNameProperty.setValue(documentName);
-
-    KDSoapGenerated::TNS__Name_value statusIdProperty;
-    statusIdProperty.setName("status_id");
-    statusIdProperty.setValue(statusId);
-
-    KDSoapGenerated::TNS__Name_value descriptionProperty;
-    descriptionProperty.setName("description");
-    descriptionProperty.setValue(description);
-
-    KDSoapGenerated::TNS__Name_value_list documentProperties;
-    documentProperties.setItems(QList<KDSoapGenerated::TNS__Name_value>() << documentNameProperty << statusIdProperty << descriptionProperty);
-
-    KDSoapGenerated::TNS__Set_entry_result result = soap->set_entry(sessionId, "Documents", documentProperties);
-    if (result.error().number() != QLatin1String("0")) {
-        qWarning() << "Unable to create document:" << result.error().name() << result.error().description();
-        return QString();
-    }
-
-    const QString documentId = result.id();
-
-    // then upload the first document revision
-    KDSoapGenerated::TNS__Document_revision documentRevision;
-    documentRevision.setId(documentId);
-    documentRevision.setRevision("1");
-    documentRevision.setFilename(documentName);
-    documentRevision.setFile(QString::fromLatin1(KCodecs::base64Encode(file.readAll())));
-
-    result = soap->set_document_revision(sessionId, documentRevision);
-
-    if (result.error().number() != QLatin1String("0")) {
-        qWarning() << "Unable to create document revision:" << result.error().name() << result.error().description();
-        return QString();
-    }
-
-    return documentId;
+    DocumentUploadJob *job = new DocumentUploadJob(documentName, statusId, description, localFilePath, mResource->mSession, this);
+    startTransfer(job, localFilePath, SLOT(slotUploadResult(KJob*)));
+    return QString(); // not sent, see slotUploadResult
 }
 
 bool ItemTransferInterface::linkItem(const QString &sourceItemId, const QString &sourceModuleName,
@@ -151,4 +97,58 @@ bool ItemTransferInterface::linkItem(const QString &sourceItemId, const QString
     return true;
 }
 
+void ItemTransferInterface::slotTransferPercent(KJob *job, unsigned long percent)
+{
+    emit transferProgress(mTransfers.value(job).transfer, percent);
+}
+
+void ItemTransferInterface::slotDownloadResult(KJob *job)
+{
+    DocumentDownloadJob *downloadJob = static_cast<DocumentDownloadJob *>(job);
+    mDownloads.remove(downloadJob->documentRevisionId());
+    if (job->error()) {
+        qWarning() << "Unable to download document revision:" << job->errorString();
+    } else {
+        DocumentDownloadJob::pruneCache(qint64(Settings::documentCacheSize()) * 1024 * 1024, downloadJob->documentRevisionId());
+    }
+    finishTransfer(job, downloadJob->localFilePath());
+}
+
+void ItemTransferInterface::slotUploadResult(KJob *job)
+{
+    if (job->error()) {
+        qWarning() << "Unable to upload document:" << job->errorString();
+    }
+    finishTransfer(job, job->error() ? QString() : static_cast<DocumentUploadJob *>(job)->documentId());
+}
+
+// Transfers can take much longer than a D-Bus call may block the resource,
+// so the reply is delayed until the job is done.
+void ItemTransferInterface::startTransfer(KJob *job, const QString &transfer, const char *resultSlot)
+{
+    Transfer &pendingTransfer = mTransfers[job];
+    pendingTransfer.transfer = transfer;
+    delayReply(pendingTransfer);
+
+    connect(job, SIGNAL(percent(KJob*,ulong)), this, SLOT(slotTransferPercent(KJob*,ulong)));
+    connect(job, SIGNAL(result(KJob*)), this, resultSlot);
+    job->start();
+}
+
+void ItemTransferInterface::delayReply(Transfer &transfer)
+{
+    if (calledFromDBus()) {
+        setDelayedReply(true);
+        transfer.messages.append(message());
+    }
+}
+
+void ItemTransferInterface::finishTransfer(KJob *job, const QString &result)
+{
+    const Transfer transfer = mTransfers.take(job);
+    Q_FOREACH (const QDBusMessage &call, transfer.messages) {
+        QDBusConnection::sessionBus().send(call.createReply(result));
+    }
+}
+
 #include "itemtransferinterface.moc"
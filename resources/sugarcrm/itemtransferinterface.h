@@ -21,11 +21,16 @@
 #ifndef ITEMTRANSFERINTERFACE_H
 #define ITEMTRANSFERINTERFACE_H
 
+#include <QDBusContext>
+#include <QDBusMessage>
+#include <QHash>
+#include <QList>
 #include <QObject>
 
+class KJob;
 class SugarCRMResource;
 
-class ItemTransferInterface : public QObject
+class ItemTransferInterface : public QObject, protected QDBusContext
 {
     Q_OBJECT
     Q_CLASSINFO("D-Bus Interface", "com.kdab.SugarCRM.ItemTransfer")
@@ -35,16 +40,22 @@ public:
 
 public Q_SLOTS:
     /**
-     * Downloads the document via SOAP and returns the path to a local temp file.
-     * The caller is responsible to clean up the temp file.
+     * Downloads the document via SOAP and returns the path to a local file, or an empty
+     * string in case of an error.
+     * The file is in the document cache, the caller must neither modify nor delete it.
+     * The reply is sent once the download is done, transferProgress() is emitted meanwhile
+     * with the documentRevisionId. Calls for a revision already being downloaded wait
+     * for that download.
      */
-    Q_SCRIPTABLE QString downloadDocumentRevision(const QString &documentRevisionId) const;
+    Q_SCRIPTABLE QString downloadDocumentRevision(const QString &documentRevisionId);
 
     /**
      * Creates a new document via SOAP and returns the document id or an empty
      * string in case of an error.
+     * The reply is sent once the upload is done, transferProgress() is emitted meanwhile
+     * with the localFilePath.
      */
-    Q_SCRIPTABLE QString uploadDocument(const QString &documentName, const QString &statusId, const QString &description, const QString &localFilePath) const;
+    Q_SCRIPTABLE QString uploadDocument(const QString &documentName, const QString &statusId, const QString &description, const QString &localFilePath);
 
     /**
      * Links the two items together name.
@@ -52,8 +63,30 @@ public Q_SLOTS:
     Q_SCRIPTABLE bool linkItem(const QString &sourceItemId, const QString &sourceModuleName,
                                const QString &targetItemId, const QString &targetModuleName) const;
 
+Q_SIGNALS:
+    /**
+     * Emitted while downloading or uploading a document.
+     */
+    Q_SCRIPTABLE void transferProgress(const QString &transfer, int percent);
+
+private Q_SLOTS:
+    void slotTransferPercent(KJob *job, unsigned long percent);
+    void slotDownloadResult(KJob *job);
+    void slotUploadResult(KJob *job);
+
 private:
+    struct Transfer {
+        QString transfer; // as passed to transferProgress()
+        QList<QDBusMessage> messages; // the calls to reply to
+    };
+
+    void startTransfer(KJob *job, const QString &transfer, const char *resultSlot);
+    void delayReply(Transfer &transfer);
+    void finishTransfer(KJob *job, const QString &result);
+
     SugarCRMResource *const mResource;
+    QHash<KJob *, Transfer> mTransfers;
+    QHash<QString, KJob *> mDownloads; // revision id -> job, a revision is only downloaded once at a time
 };
 
 #endif
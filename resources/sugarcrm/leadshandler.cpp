@@ -104,6 +104,11 @@ bool LeadsHandler::setEntry(const Akonadi::Item &item)
     return true;
 }
 
+int LeadsHandler::crmFieldIndex(const QString &crmFieldName) const
+{
+    return SugarLead::fieldIndex(crmFieldName);
+}
+
 Akonadi::Item LeadsHandler::itemFromEntry(const KDSoapGenerated::TNS__Entry_value &entry, const Akonadi::Collection &parentCollection)
 {
     Akonadi::Item item;
@@ -120,15 +125,15 @@ Akonadi::Item LeadsHandler::itemFromEntry(const KDSoapGenerated::TNS__Entry_valu
 
     SugarLead lead;
     lead.setId(entry.id());
-    Q_FOREACH (const KDSoapGenerated::TNS__Name_value &namedValue, valueList) {
-        const QString crmFieldName = sugarFieldToCrmField(namedValue.name());
-        const SugarLead::AccessorHash::const_iterator accessIt = mAccessors.constFind(crmFieldName);
-        if (accessIt == mAccessors.constEnd()) {
-            // no accessor for field
+    const FieldColumns &columns = fieldColumns(valueList);
+    for (int i = 0; i < valueList.count(); ++i) {
+        const int fieldIndex = columns.at(i).fieldIndex;
+        if (fieldIndex < 0) {
+            // no storage for field
             continue;
         }
 
-        (lead.*(accessIt.value().setter))(KDCRMUtils::decodeXML(namedValue.value()));
+        lead.setValue(static_cast<SugarLead::Field>(fieldIndex), KDCRMUtils::decodeXML(valueList.at(i).value()));
     }
     item.setPayload<SugarLead>(lead);
     item.setRemoteRevision(lead.dateModified());
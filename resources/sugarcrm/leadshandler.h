@@ -43,6 +43,9 @@ public:
     void compare(Akonadi::AbstractDifferencesReporter *reporter,
                  const Akonadi::Item &leftItem, const Akonadi::Item &rightItem) override;
 
+protected:
+    int crmFieldIndex(const QString &crmFieldName) const override;
+
 private:
     inline bool isAddressValue(const QString &value) const
     {
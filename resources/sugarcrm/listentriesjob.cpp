@@ -22,9 +22,13 @@
 
 #include "listentriesjob.h"
 
+#include "extrainformationjob.h"
+#include "listentriespagefetcher.h"
+#include "listentriespageplanner.h"
 #include "modulehandler.h"
 #include "sugarsoap.h"
 #include "listentriesscope.h"
+#include "sugarsession.h"
 using namespace KDSoapGenerated;
 
 #include "kdcrmdata/kdcrmutils.h"
@@ -40,6 +44,7 @@ using namespace Akonadi;
 
 #include <KDebug>
 
+#include <QMap>
 #include <QStringList>
 
 class ListEntriesJob::Private
@@ -56,24 +61,58 @@ public:
         : q(parent),
           mCollection(collection),
           mHandler(nullptr),
+          mCountSoap(nullptr),
           mStage(GetCount),
-          mCollectionAttributesChanged(false)
+          mCollectionAttributesChanged(false),
+          mWindowSize(1)
     {
     }
 
+    struct ReceivedPage {
+        ReceivedPage() : pageSize(0), extraInformationJob(nullptr) {}
+        int pageSize; // how far the page goes, as requested unless the server returned less
+        Item::List items;
+        ExtraInformationJob *extraInformationJob; // set while the extra information is being fetched
+    };
+
+    Item::List itemsFromResult(const KDSoapGenerated::TNS__Get_entry_list_result &callResult);
+    void startExtraInformation(ReceivedPage &page);
+    void extraInformationError(ExtraInformationJob *job);
+    void finishListing();
+
+    void restartPipeline();
+    void abortPipeline();
+    void fillWindow();
+    void pageCompleted();
+    void emitReadyPages();
+    void discardPage(ReceivedPage &page);
+    void abortPageFetchers();
+    int busyPageFetchers() const;
+    ListEntriesPageFetcher *idlePageFetcher();
+    KDSoapGenerated::Sugarsoap *idleSoap();
+
 public:
     Collection mCollection;
     ModuleHandler *mHandler;
+    KDSoapGenerated::Sugarsoap *mCountSoap;
     ListEntriesScope mListScope;
     Stage mStage;
     QString mLatestTimestampFromItems;
     bool mCollectionAttributesChanged;
+    ListEntriesPageSizer mPageSizer;
+    int mWindowSize;
+    ListEntriesPagePlanner mPagePlanner;
+
+    QList<ListEntriesPageFetcher *> mPageFetchers;
+    QList<KDSoapGenerated::Sugarsoap *> mIdleSoaps; // for the extra information jobs
+    QMap<int, ReceivedPage> mReceivedPages; // offset -> page, not emitted yet
 
 public: // slots
     void getEntriesCountDone(const KDSoapGenerated::TNS__Get_entries_count_result &callResult);
     void getEntriesCountError(const KDSoapMessage &fault);
-    void listEntriesDone(const KDSoapGenerated::TNS__Get_entry_list_result &callResult);
-    void listEntriesError(const KDSoapMessage &fault);
+    void pageReceived(ListEntriesPageFetcher *fetcher, const KDSoapGenerated::TNS__Get_entry_list_result &callResult);
+    void pageError(ListEntriesPageFetcher *fetcher, const KDSoapMessage &fault);
+    void extraInformationDone(KJob *job);
 };
 
 void ListEntriesJob::Private::getEntriesCountDone(const TNS__Get_entries_count_result &callResult)
@@ -88,6 +127,7 @@ void ListEntriesJob::Private::getEntriesCountDone(const TNS__Get_entries_count_r
     if (count == 0) {
         q->emitResult();
     } else {
+        mPagePlanner.setTotalCount(count);
         mStage = GetExisting;
         q->startSugarTask(); // proceed to next stage
     }
@@ -107,67 +147,251 @@ void ListEntriesJob::Private::getEntriesCountError(const KDSoapMessage &fault)
 static const char s_timeStampKey[] = "timestamp"; // duplicated in collectionmanager.cpp
 static const char s_supportedFieldsKey[] = "supportedFields"; // duplicated in collectionmanager.cpp
 
+// The page size chosen by ListEntriesPageSizer, to start the next listing with it
+static const char s_pageSizeKey[] = "pageSize";
+
 // When the resource evolves and can store more things (or if e.g. encoding bugs are fixed)
 // then increasing the expected version ensures that old caches are thrown out.
 static const char s_contentsVersionKey[] = "contentsVersion";
 
-void ListEntriesJob::Private::listEntriesDone(const KDSoapGenerated::TNS__Get_entry_list_result &callResult)
+// KDSoap doesn't tell us the size of the response, this is close enough for ListEntriesPageSizer
+static qint64 approximateResponseSize(const KDSoapGenerated::TNS__Get_entry_list_result &callResult)
 {
-    kDebug() << q << "stage" << mStage << "error" << callResult.error().number();
-    if (q->handleError(callResult.error())) {
-        return;
+    qint64 size = 0;
+    Q_FOREACH (const KDSoapGenerated::TNS__Entry_value &entry, callResult.entry_list().items()) {
+        Q_FOREACH (const KDSoapGenerated::TNS__Name_value &nameValue, entry.name_value_list().items()) {
+            size += nameValue.name().size() + nameValue.value().size();
+        }
     }
-    if (callResult.result_count() > 0) { // result_count is the size of entry_list, e.g. 100.
-        mCollectionAttributesChanged = mHandler->parseFieldList(mCollection, callResult.field_list());
+    return size;
+}
+
+Item::List ListEntriesJob::Private::itemsFromResult(const KDSoapGenerated::TNS__Get_entry_list_result &callResult)
+{
+    // Only the first page ever parsed can change the attributes, don't reset the flag on the others
+    if (mHandler->parseFieldList(mCollection, callResult.field_list()))
+        mCollectionAttributesChanged = true;
 
-        Item::List items =
-            mHandler->itemsFromListEntriesResponse(callResult.entry_list(), mCollection, &mLatestTimestampFromItems);
+    const Item::List items =
+        mHandler->itemsFromListEntriesResponse(callResult.entry_list(), mCollection, &mLatestTimestampFromItems);
 
-        if (mHandler->needsExtraInformation())
-            mHandler->getExtraInformation(items);
-        kDebug() << "List Entries for" << mHandler->moduleName()
-                 << "received" << items.count() << "items.";
+    kDebug() << "List Entries for" << mHandler->moduleName()
+             << "received" << items.count() << "items.";
+    return items;
+}
 
-        emit q->itemsReceived(items, mListScope.isUpdateScope());
-        mListScope.setOffset(callResult.next_offset());
-        mHandler->listEntries(mListScope);
+void ListEntriesJob::Private::startExtraInformation(ReceivedPage &page)
+{
+    KDSoapGenerated::Sugarsoap *soap = idleSoap();
+    ExtraInformationJob *job = mHandler->createExtraInformationJob(page.items, soap, q);
+    if (job) {
+        connect(job, SIGNAL(result(KJob*)), q, SLOT(extraInformationDone(KJob*)));
+        page.extraInformationJob = job;
+        job->start();
     } else {
-        kDebug() << q << "List Entries for" << mHandler->moduleName() << "done. Latest timestamp=" << mLatestTimestampFromItems;
-
-        // Store timestamp into DB, to persist it across restarts
-        // Add one second, so we don't get the same stuff all over again every time
-        KDCRMUtils::incrementTimeStamp(mLatestTimestampFromItems);
-        EntityAnnotationsAttribute *annotationsAttribute =
-                mCollection.attribute<EntityAnnotationsAttribute>( Akonadi::Collection::AddIfMissing );
-        Q_ASSERT(annotationsAttribute);
-        bool changed = false;
-        if (!mLatestTimestampFromItems.isEmpty() && annotationsAttribute->value(s_timeStampKey) != mLatestTimestampFromItems) {
-            annotationsAttribute->insert(s_timeStampKey, mLatestTimestampFromItems);
+        mIdleSoaps.append(soap);
+    }
+}
+
+void ListEntriesJob::Private::finishListing()
+{
+    kDebug() << q << "List Entries for" << mHandler->moduleName() << "done. Latest timestamp=" << mLatestTimestampFromItems;
+
+    // Store timestamp into DB, to persist it across restarts
+    // Add one second, so we don't get the same stuff all over again every time
+    KDCRMUtils::incrementTimeStamp(mLatestTimestampFromItems);
+    EntityAnnotationsAttribute *annotationsAttribute =
+            mCollection.attribute<EntityAnnotationsAttribute>( Akonadi::Collection::AddIfMissing );
+    Q_ASSERT(annotationsAttribute);
+    bool changed = false;
+    if (!mLatestTimestampFromItems.isEmpty() && annotationsAttribute->value(s_timeStampKey) != mLatestTimestampFromItems) {
+        annotationsAttribute->insert(s_timeStampKey, mLatestTimestampFromItems);
+        changed = true;
+    }
+    if (!mListScope.isUpdateScope()) {
+        // We just did a full listing (first time, or after a contents version upgrade)
+        // then upgrade the contents version attribute.
+        const int currentVersion = mHandler->expectedContentsVersion();
+        if (annotationsAttribute->value(s_contentsVersionKey).toInt() != currentVersion) {
+            annotationsAttribute->insert(s_contentsVersionKey, QString::number(currentVersion));
             changed = true;
         }
-        if (!mListScope.isUpdateScope()) {
-            // We just did a full listing (first time, or after a contents version upgrade)
-            // then upgrade the contents version attribute.
-            const int currentVersion = mHandler->expectedContentsVersion();
-            if (annotationsAttribute->value(s_contentsVersionKey).toInt() != currentVersion) {
-                annotationsAttribute->insert(s_contentsVersionKey, QString::number(currentVersion));
-                changed = true;
-            }
+    }
+    const QString pageSize = QString::number(mPageSizer.pageSize());
+    if (annotationsAttribute->value(s_pageSizeKey) != pageSize) {
+        kDebug() << mHandler->moduleName() << "page size is now" << pageSize;
+        annotationsAttribute->insert(s_pageSizeKey, pageSize);
+        changed = true;
+    }
+    // Also store the list of supported fields, so that the GUI knows what to expect and set
+    const QString fields = mHandler->supportedCRMFields().join(",");
+    if (annotationsAttribute->value(s_supportedFieldsKey) != fields) {
+        annotationsAttribute->insert(s_supportedFieldsKey, fields);
+        changed = true;
+    }
+
+    mCollectionAttributesChanged = mCollectionAttributesChanged || changed;
+    q->emitResult();
+}
+
+// Up to mWindowSize pages are requested at the same time, each through its own
+// ListEntriesPageFetcher. Pages are parsed as soon as they arrive, then completed with
+// the extra information if the module needs it, while the next pages are being listed.
+// They are emitted in order, though.
+
+// Called initially, and again after a re-login. Pages which weren't emitted yet
+// are thrown away and requested again, together with the ones which were still pending.
+void ListEntriesJob::Private::restartPipeline()
+{
+    abortPipeline();
+    mPagePlanner.restart();
+    fillWindow();
+}
+
+// Called on errors, so that nothing is emitted anymore, whether the job is over
+// or the pipeline will be restarted after a re-login
+void ListEntriesJob::Private::abortPipeline()
+{
+    abortPageFetchers();
+    for (QMap<int, ReceivedPage>::iterator it = mReceivedPages.begin(); it != mReceivedPages.end(); ++it) {
+        discardPage(*it);
+    }
+    mReceivedPages.clear();
+}
+
+void ListEntriesJob::Private::fillWindow()
+{
+    // Don't get too far ahead of the pages waiting for their extra information (or for the previous pages)
+    while (mPagePlanner.mayRequestMorePages() && busyPageFetchers() < mWindowSize && mReceivedPages.count() <= mWindowSize) {
+        ListEntriesScope scope = mListScope;
+        scope.setMaxResults(mPageSizer.pageSize());
+        scope.setOffset(mPagePlanner.requestPage(scope.maxResults()));
+        idlePageFetcher()->fetch(mHandler, scope);
+    }
+}
+
+void ListEntriesJob::Private::pageCompleted()
+{
+    emitReadyPages();
+    fillWindow();
+    if (mPagePlanner.isComplete()) {
+        finishListing();
+    }
+}
+
+void ListEntriesJob::Private::emitReadyPages()
+{
+    QMap<int, ReceivedPage>::iterator it = mReceivedPages.begin();
+    while (it != mReceivedPages.end() && it.key() == mPagePlanner.nextOffsetToEmit() && !it->extraInformationJob) {
+        if (!it->items.isEmpty()) {
+            emit q->itemsReceived(it->items, mListScope.isUpdateScope());
         }
-        // Also store the list of supported fields, so that the GUI knows what to expect and set
-        const QString fields = mHandler->supportedCRMFields().join(",");
-        if (annotationsAttribute->value(s_supportedFieldsKey) != fields) {
-            annotationsAttribute->insert(s_supportedFieldsKey, fields);
-            changed = true;
+        mPagePlanner.pageEmitted(it->pageSize);
+        it = mReceivedPages.erase(it);
+    }
+}
+
+void ListEntriesJob::Private::discardPage(ReceivedPage &page)
+{
+    if (page.extraInformationJob) {
+        // the call is still pending, don't reuse that SOAP interface
+        page.extraInformationJob->soap()->deleteLater();
+        page.extraInformationJob->kill(KJob::Quietly);
+        page.extraInformationJob = nullptr;
+    }
+}
+
+void ListEntriesJob::Private::abortPageFetchers()
+{
+    Q_FOREACH (ListEntriesPageFetcher *fetcher, mPageFetchers) {
+        fetcher->abort();
+    }
+}
+
+int ListEntriesJob::Private::busyPageFetchers() const
+{
+    int count = 0;
+    Q_FOREACH (ListEntriesPageFetcher *fetcher, mPageFetchers) {
+        if (fetcher->isBusy())
+            ++count;
+    }
+    return count;
+}
+
+ListEntriesPageFetcher *ListEntriesJob::Private::idlePageFetcher()
+{
+    Q_FOREACH (ListEntriesPageFetcher *fetcher, mPageFetchers) {
+        if (!fetcher->isBusy())
+            return fetcher;
+    }
+    ListEntriesPageFetcher *fetcher = new ListEntriesPageFetcher(q->session(), q);
+    connect(fetcher, SIGNAL(pageReceived(ListEntriesPageFetcher*,KDSoapGenerated::TNS__Get_entry_list_result)),
+            q, SLOT(pageReceived(ListEntriesPageFetcher*,KDSoapGenerated::TNS__Get_entry_list_result)));
+    connect(fetcher, SIGNAL(pageError(ListEntriesPageFetcher*,KDSoapMessage)),
+            q, SLOT(pageError(ListEntriesPageFetcher*,KDSoapMessage)));
+    mPageFetchers.append(fetcher);
+    return fetcher;
+}
+
+KDSoapGenerated::Sugarsoap *ListEntriesJob::Private::idleSoap()
+{
+    if (!mIdleSoaps.isEmpty())
+        return mIdleSoaps.takeLast();
+    return q->session()->createAdditionalSoapInterface(q);
+}
+
+void ListEntriesJob::Private::pageReceived(ListEntriesPageFetcher *fetcher, const KDSoapGenerated::TNS__Get_entry_list_result &callResult)
+{
+    const int offset = fetcher->scope().offset();
+    const int pageSize = fetcher->scope().maxResults();
+    kDebug() << q << "page at offset" << offset << "error" << callResult.error().number();
+    if (q->handleError(callResult.error())) {
+        // Either the job is over, or we'll login again and restartPipeline() will be called
+        abortPipeline();
+        return;
+    }
+
+    const ListEntriesPagePlanner::ReceivedPage received =
+        mPagePlanner.pageReceived(offset, pageSize, callResult.result_count(), callResult.next_offset());
+    if (received.lastPage) {
+        // Nothing after this page, no need to wait for the pages requested after it
+        Q_FOREACH (ListEntriesPageFetcher *other, mPageFetchers) {
+            if (other->isBusy() && other->scope().offset() >= mPagePlanner.nextOffset())
+                other->abort();
         }
+        while (!mReceivedPages.isEmpty() && mReceivedPages.lastKey() >= mPagePlanner.nextOffset()) {
+            QMap<int, ReceivedPage>::iterator last = --mReceivedPages.end();
+            discardPage(*last);
+            mReceivedPages.erase(last);
+        }
+    } else if (received.missingSize > 0) {
+        // The server returned less than requested, ask for the rest of the page
+        kDebug() << q << "incomplete page at offset" << offset << ", requesting" << received.missingSize
+                 << "entries at offset" << received.missingOffset;
+        ListEntriesScope scope = mListScope;
+        scope.setOffset(received.missingOffset);
+        scope.setMaxResults(received.missingSize);
+        idlePageFetcher()->fetch(mHandler, scope);
+    }
 
-        mCollectionAttributesChanged = mCollectionAttributesChanged || changed;
-        q->emitResult();
+    ReceivedPage &page = mReceivedPages[offset];
+    page.pageSize = received.pageSize;
+    if (callResult.result_count() > 0) {
+        mPageSizer.addSample(pageSize, callResult.result_count(),
+                             approximateResponseSize(callResult), fetcher->responseTime());
+        page.items = itemsFromResult(callResult);
+        if (mHandler->needsExtraInformation()) {
+            startExtraInformation(page);
+        }
     }
+
+    pageCompleted();
 }
 
-void ListEntriesJob::Private::listEntriesError(const KDSoapMessage &fault)
+void ListEntriesJob::Private::pageError(ListEntriesPageFetcher *fetcher, const KDSoapMessage &fault)
 {
+    Q_UNUSED(fetcher);
+    abortPipeline();
     if (!q->handleLoginError(fault)) {
         kWarning() << q << "List Entries Error:" << fault.faultAsString();
 
@@ -177,19 +401,53 @@ void ListEntriesJob::Private::listEntriesError(const KDSoapMessage &fault)
     }
 }
 
+void ListEntriesJob::Private::extraInformationDone(KJob *job)
+{
+    for (QMap<int, ReceivedPage>::iterator it = mReceivedPages.begin(); it != mReceivedPages.end(); ++it) {
+        if (it->extraInformationJob == job) {
+            ExtraInformationJob *extraInformationJob = it->extraInformationJob;
+            it->items = extraInformationJob->items();
+            it->extraInformationJob = nullptr;
+            mIdleSoaps.append(extraInformationJob->soap());
+            if (job->error()) {
+                extraInformationError(extraInformationJob);
+            } else {
+                pageCompleted();
+            }
+            return;
+        }
+    }
+}
+
+// Don't emit the page without its extra information, the timestamp would move past its items.
+// Like for the pages themselves: either the job is over, or we'll login again and
+// restartPipeline() will list the page again.
+void ListEntriesJob::Private::extraInformationError(ExtraInformationJob *job)
+{
+    kWarning() << q << "Extra information error for" << mHandler->moduleName() << ":" << job->errorText();
+    abortPipeline();
+    if (job->error() == ExtraInformationJob::FaultError) {
+        if (!q->handleLoginError(job->fault())) {
+            q->setError(SugarJob::SoapError);
+            q->setErrorText(job->errorText());
+            q->emitResult();
+        }
+    } else {
+        q->handleError(job->errorValue());
+    }
+}
+
 ListEntriesJob::ListEntriesJob(const Akonadi::Collection &collection, SugarSession *session, QObject *parent)
     : SugarJob(session, parent), d(new Private(this, collection))
 {
-    connect(soap(), SIGNAL(get_entries_countDone(KDSoapGenerated::TNS__Get_entries_count_result)),
+    // Not the session's SOAP interface: several listings can run at the same time,
+    // and their responses must not be mixed up
+    d->mCountSoap = session->createAdditionalSoapInterface(this);
+    connect(d->mCountSoap, SIGNAL(get_entries_countDone(KDSoapGenerated::TNS__Get_entries_count_result)),
             this, SLOT(getEntriesCountDone(KDSoapGenerated::TNS__Get_entries_count_result)));
-    connect(soap(), SIGNAL(get_entries_countError(KDSoapMessage)),
+    connect(d->mCountSoap, SIGNAL(get_entries_countError(KDSoapMessage)),
             this, SLOT(getEntriesCountError(KDSoapMessage)));
 
-    connect(soap(), SIGNAL(get_entry_listDone(KDSoapGenerated::TNS__Get_entry_list_result)),
-            this,  SLOT(listEntriesDone(KDSoapGenerated::TNS__Get_entry_list_result)));
-    connect(soap(), SIGNAL(get_entry_listError(KDSoapMessage)),
-            this,  SLOT(listEntriesError(KDSoapMessage)));
-
     d->mStage = Private::GetCount;
     //kDebug() << this;
 }
@@ -225,6 +483,18 @@ QString ListEntriesJob::newTimestamp() const
     return d->mLatestTimestampFromItems;
 }
 
+void ListEntriesJob::setPageSizer(const ListEntriesPageSizer &pageSizer)
+{
+    Q_ASSERT(d->mStage == Private::GetCount);
+    d->mPageSizer = pageSizer;
+}
+
+void ListEntriesJob::setWindowSize(int windowSize)
+{
+    Q_ASSERT(d->mStage == Private::GetCount);
+    d->mWindowSize = qMax(1, windowSize);
+}
+
 bool ListEntriesJob::collectionAttributesChanged() const
 {
     return d->mCollectionAttributesChanged;
@@ -244,6 +514,16 @@ int ListEntriesJob::currentContentsVersion(const Collection &collection)
     return 0;
 }
 
+// static
+int ListEntriesJob::savedPageSize(const Collection &collection)
+{
+    EntityAnnotationsAttribute *annotationsAttribute =
+            collection.attribute<EntityAnnotationsAttribute>();
+    if (annotationsAttribute)
+        return annotationsAttribute->value(s_pageSizeKey).toInt();
+    return 0;
+}
+
 // static
 QString ListEntriesJob::latestTimestamp(const Akonadi::Collection &collection, ModuleHandler *handler)
 {
@@ -278,10 +558,10 @@ void ListEntriesJob::startSugarTask()
 
     switch (d->mStage) {
     case Private::GetCount:
-        d->mHandler->getEntriesCount(d->mListScope);
+        d->mHandler->getEntriesCount(d->mListScope, d->mCountSoap);
         break;
     case Private::GetExisting:
-        d->mHandler->listEntries(d->mListScope);
+        d->restartPipeline();
         break;
     }
 }
@@ -24,6 +24,7 @@
 #define LISTENTRIESJOB_H
 
 #include "sugarjob.h"
+#include "listentriespagesizer.h"
 
 #include <Akonadi/Item>
 
@@ -32,6 +33,7 @@ namespace Akonadi
 class Collection;
 }
 
+class ListEntriesPageFetcher;
 class ModuleHandler;
 namespace KDSoapGenerated
 {
@@ -54,11 +56,18 @@ public:
     void setLatestTimestamp(const QString &timestamp);
     QString newTimestamp() const;
 
+    // Chooses the number of entries requested per get_entry_list call
+    void setPageSizer(const ListEntriesPageSizer &pageSizer);
+    // Number of pages requested in parallel. 1 means one page after the other.
+    void setWindowSize(int windowSize);
+
     bool collectionAttributesChanged() const;
     bool isUpdateJob() const;
 
     static int currentContentsVersion(const Akonadi::Collection &collection);
     static QString latestTimestamp(const Akonadi::Collection &collection, ModuleHandler *handler);
+    // The page size chosen by the last listing, 0 if unknown
+    static int savedPageSize(const Akonadi::Collection &collection);
 
 Q_SIGNALS:
     void totalItems(int count);
@@ -74,8 +83,9 @@ private:
 
     Q_PRIVATE_SLOT(d, void getEntriesCountDone(const KDSoapGenerated::TNS__Get_entries_count_result &callResult))
     Q_PRIVATE_SLOT(d, void getEntriesCountError(const KDSoapMessage &fault))
-    Q_PRIVATE_SLOT(d, void listEntriesDone(const KDSoapGenerated::TNS__Get_entry_list_result &callResult))
-    Q_PRIVATE_SLOT(d, void listEntriesError(const KDSoapMessage &fault))
+    Q_PRIVATE_SLOT(d, void pageReceived(ListEntriesPageFetcher *fetcher, const KDSoapGenerated::TNS__Get_entry_list_result &callResult))
+    Q_PRIVATE_SLOT(d, void pageError(ListEntriesPageFetcher *fetcher, const KDSoapMessage &fault))
+    Q_PRIVATE_SLOT(d, void extraInformationDone(KJob *job))
 };
 
 #endif
@@ -0,0 +1,104 @@
+/*
+  This file is part of FatCRM, a desktop application for SugarCRM written by KDAB.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+  Authors: David Faure <david.faure@kdab.com>
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "listentriespagefetcher.h"
+
+#include "modulehandler.h"
+#include "sugarsession.h"
+#include "sugarsoap.h"
+using namespace KDSoapGenerated;
+
+#include <KDSoapClient/KDSoapMessage.h>
+
+ListEntriesPageFetcher::ListEntriesPageFetcher(SugarSession *session, QObject *parent)
+    : QObject(parent),
+      mSession(session),
+      mSoap(nullptr),
+      mResponseTime(0),
+      mBusy(false)
+{
+    createSoapInterface();
+}
+
+ListEntriesPageFetcher::~ListEntriesPageFetcher()
+{
+}
+
+void ListEntriesPageFetcher::fetch(ModuleHandler *handler, const ListEntriesScope &scope)
+{
+    Q_ASSERT(!mBusy);
+    mScope = scope;
+    mBusy = true;
+    mTimer.start();
+    handler->listEntries(mScope, mSoap);
+}
+
+void ListEntriesPageFetcher::abort()
+{
+    if (mBusy) {
+        // KDSoap has no way to cancel a call, drop the interface with it instead
+        mBusy = false;
+        createSoapInterface();
+    }
+}
+
+bool ListEntriesPageFetcher::isBusy() const
+{
+    return mBusy;
+}
+
+ListEntriesScope ListEntriesPageFetcher::scope() const
+{
+    return mScope;
+}
+
+qint64 ListEntriesPageFetcher::responseTime() const
+{
+    return mResponseTime;
+}
+
+void ListEntriesPageFetcher::listEntriesDone(const TNS__Get_entry_list_result &callResult)
+{
+    mBusy = false;
+    mResponseTime = mTimer.elapsed();
+    emit pageReceived(this, callResult);
+}
+
+void ListEntriesPageFetcher::listEntriesError(const KDSoapMessage &fault)
+{
+    mBusy = false;
+    emit pageError(this, fault);
+}
+
+void ListEntriesPageFetcher::createSoapInterface()
+{
+    if (mSoap) {
+        mSoap->disconnect();
+        mSoap->deleteLater();
+    }
+
+    mSoap = mSession->createAdditionalSoapInterface(this);
+    connect(mSoap, SIGNAL(get_entry_listDone(KDSoapGenerated::TNS__Get_entry_list_result)),
+            this, SLOT(listEntriesDone(KDSoapGenerated::TNS__Get_entry_list_result)));
+    connect(mSoap, SIGNAL(get_entry_listError(KDSoapMessage)),
+            this, SLOT(listEntriesError(KDSoapMessage)));
+}
+
+#include "listentriespagefetcher.moc"
@@ -0,0 +1,86 @@
+/*
+  This file is part of FatCRM, a desktop application for SugarCRM written by KDAB.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+  Authors: David Faure <david.faure@kdab.com>
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef LISTENTRIESPAGEFETCHER_H
+#define LISTENTRIESPAGEFETCHER_H
+
+#include "listentriesscope.h"
+
+#include <QElapsedTimer>
+#include <QObject>
+
+class KDSoapMessage;
+class ModuleHandler;
+class SugarSession;
+namespace KDSoapGenerated
+{
+class Sugarsoap;
+class TNS__Get_entry_list_result;
+}
+
+/**
+ * Requests one page of entries (get_entry_list) through its own SOAP interface.
+ *
+ * ListEntriesJob uses several of these to keep multiple pages in flight at once,
+ * which isn't possible with the session's SOAP interface since its signals
+ * don't say which call they belong to.
+ */
+class ListEntriesPageFetcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ListEntriesPageFetcher(SugarSession *session, QObject *parent = 0);
+
+    ~ListEntriesPageFetcher() override;
+
+    void fetch(ModuleHandler *handler, const ListEntriesScope &scope);
+
+    // Forget about the pending call, if any. Its result won't be reported.
+    void abort();
+
+    bool isBusy() const;
+
+    // The scope of the current (or last) call, including its offset
+    ListEntriesScope scope() const;
+
+    // Time between the request and the response of the last call, in milliseconds
+    qint64 responseTime() const;
+
+Q_SIGNALS:
+    void pageReceived(ListEntriesPageFetcher *fetcher, const KDSoapGenerated::TNS__Get_entry_list_result &callResult);
+    void pageError(ListEntriesPageFetcher *fetcher, const KDSoapMessage &fault);
+
+private Q_SLOTS:
+    void listEntriesDone(const KDSoapGenerated::TNS__Get_entry_list_result &callResult);
+    void listEntriesError(const KDSoapMessage &fault);
+
+private:
+    void createSoapInterface();
+
+    SugarSession *mSession;
+    KDSoapGenerated::Sugarsoap *mSoap;
+    ListEntriesScope mScope;
+    QElapsedTimer mTimer;
+    qint64 mResponseTime;
+    bool mBusy;
+};
+
+#endif
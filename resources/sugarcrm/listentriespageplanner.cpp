@@ -0,0 +1,113 @@
+/*
+  This file is part of FatCRM, a desktop application for SugarCRM written by KDAB.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+  Authors: David Faure <david.faure@kdab.com>
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "listentriespageplanner.h"
+
+#include <QtGlobal>
+
+ListEntriesPagePlanner::ListEntriesPagePlanner()
+    : mTotalCount(0),
+      mNextOffset(0),
+      mNextOffsetToEmit(0),
+      mListingExhausted(false)
+{
+}
+
+void ListEntriesPagePlanner::setTotalCount(int totalCount)
+{
+    mTotalCount = totalCount;
+}
+
+int ListEntriesPagePlanner::totalCount() const
+{
+    return mTotalCount;
+}
+
+bool ListEntriesPagePlanner::mayRequestMorePages() const
+{
+    if (mListingExhausted)
+        return false;
+    if (mNextOffset < mTotalCount)
+        return true;
+    // The server might have more entries than it counted (e.g. created meanwhile).
+    // Go on until the last page comes back, one page at a time.
+    return mNextOffset == mNextOffsetToEmit;
+}
+
+int ListEntriesPagePlanner::requestPage(int pageSize)
+{
+    const int offset = mNextOffset;
+    mNextOffset += pageSize;
+    return offset;
+}
+
+ListEntriesPagePlanner::ReceivedPage ListEntriesPagePlanner::pageReceived(int offset, int requestedEntries, int receivedEntries, int serverNextOffset)
+{
+    ReceivedPage page;
+    page.pageSize = requestedEntries;
+    if (receivedEntries >= requestedEntries) {
+        return page;
+    }
+
+    if (receivedEntries == 0 || offset + receivedEntries >= mTotalCount) {
+        // Nothing after this page
+        page.lastPage = true;
+        mListingExhausted = true;
+        mNextOffset = qMin(mNextOffset, offset + requestedEntries);
+        return page;
+    }
+
+    // The server returned less than asked for (e.g. it caps the number of results),
+    // go on from where it stopped. The pages requested after this one are still fine.
+    int continueOffset = serverNextOffset;
+    if (continueOffset <= offset || continueOffset > offset + requestedEntries) {
+        continueOffset = offset + receivedEntries;
+    }
+    page.pageSize = continueOffset - offset;
+    page.missingOffset = continueOffset;
+    page.missingSize = requestedEntries - page.pageSize;
+    return page;
+}
+
+void ListEntriesPagePlanner::pageEmitted(int pageSize)
+{
+    mNextOffsetToEmit += pageSize;
+}
+
+int ListEntriesPagePlanner::nextOffset() const
+{
+    return mNextOffset;
+}
+
+int ListEntriesPagePlanner::nextOffsetToEmit() const
+{
+    return mNextOffsetToEmit;
+}
+
+bool ListEntriesPagePlanner::isComplete() const
+{
+    return mNextOffsetToEmit == mNextOffset;
+}
+
+void ListEntriesPagePlanner::restart()
+{
+    mNextOffset = mNextOffsetToEmit;
+    mListingExhausted = false;
+}
@@ -0,0 +1,74 @@
+/*
+  This file is part of FatCRM, a desktop application for SugarCRM written by KDAB.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+  Authors: David Faure <david.faure@kdab.com>
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef LISTENTRIESPAGEPLANNER_H
+#define LISTENTRIESPAGEPLANNER_H
+
+/**
+ * Keeps track of the offsets of the pages requested by ListEntriesJob.
+ *
+ * Pages are requested ahead of time, possibly several at once, and emitted in order.
+ * A page which comes back with fewer entries than requested is only the last one
+ * if it's empty or if it reaches the entries count; otherwise the server capped the
+ * number of results, and the rest of that page has to be requested separately.
+ */
+class ListEntriesPagePlanner
+{
+public:
+    ListEntriesPagePlanner();
+
+    void setTotalCount(int totalCount);
+    int totalCount() const;
+
+    // Whether another page can be requested now
+    bool mayRequestMorePages() const;
+    // Returns the offset of the page to request, and moves past it
+    int requestPage(int pageSize);
+
+    struct ReceivedPage {
+        ReceivedPage() : pageSize(0), missingOffset(0), missingSize(0), lastPage(false) {}
+        int pageSize; // how far this page goes, i.e. how much to skip when emitting it
+        int missingOffset; // the part of the page the server didn't return, to be requested now
+        int missingSize; // 0 if nothing is missing
+        bool lastPage; // nothing after this page, pages requested after nextOffset() are useless
+    };
+    // serverNextOffset is the next_offset returned by the server
+    ReceivedPage pageReceived(int offset, int requestedEntries, int receivedEntries, int serverNextOffset);
+
+    void pageEmitted(int pageSize);
+
+    // Offset of the next page to request
+    int nextOffset() const;
+    // Offset of the next page to emit, everything before was emitted already
+    int nextOffsetToEmit() const;
+    // Whether everything requested was emitted
+    bool isComplete() const;
+
+    // Requests everything which wasn't emitted yet again (e.g. after a re-login)
+    void restart();
+
+private:
+    int mTotalCount; // as returned by get_entries_count, the server might have more by now
+    int mNextOffset;
+    int mNextOffsetToEmit;
+    bool mListingExhausted; // the last page was received, there's nothing after it
+};
+
+#endif
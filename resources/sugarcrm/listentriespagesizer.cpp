@@ -0,0 +1,102 @@
+/*
+  This file is part of FatCRM, a desktop application for SugarCRM written by KDAB.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+  Authors: David Faure <david.faure@kdab.com>
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "listentriespagesizer.h"
+
+ListEntriesPageSizer::ListEntriesPageSizer()
+    : mPageSize(100),
+      mMinimumPageSize(100),
+      mMaximumPageSize(100),
+      mTargetResponseTime(2000),
+      mMaximumResponseSize(0)
+{
+}
+
+ListEntriesPageSizer::ListEntriesPageSizer(int minimumPageSize, int maximumPageSize)
+    : mPageSize(0),
+      mMinimumPageSize(qMax(1, minimumPageSize)),
+      mMaximumPageSize(qMax(mMinimumPageSize, maximumPageSize)),
+      mTargetResponseTime(2000),
+      mMaximumResponseSize(0)
+{
+    setPageSize(100);
+}
+
+void ListEntriesPageSizer::setPageSize(int pageSize)
+{
+    mPageSize = qBound(mMinimumPageSize, pageSize, mMaximumPageSize);
+}
+
+int ListEntriesPageSizer::pageSize() const
+{
+    return mPageSize;
+}
+
+int ListEntriesPageSizer::minimumPageSize() const
+{
+    return mMinimumPageSize;
+}
+
+int ListEntriesPageSizer::maximumPageSize() const
+{
+    return mMaximumPageSize;
+}
+
+void ListEntriesPageSizer::setTargetResponseTime(int msecs)
+{
+    mTargetResponseTime = qMax(1, msecs);
+}
+
+int ListEntriesPageSizer::targetResponseTime() const
+{
+    return mTargetResponseTime;
+}
+
+void ListEntriesPageSizer::setMaximumResponseSize(qint64 bytes)
+{
+    mMaximumResponseSize = qMax<qint64>(0, bytes);
+}
+
+qint64 ListEntriesPageSizer::maximumResponseSize() const
+{
+    return mMaximumResponseSize;
+}
+
+void ListEntriesPageSizer::addSample(int requestedEntries, int receivedEntries, qint64 bytes, qint64 msecs)
+{
+    if (requestedEntries <= 0 || receivedEntries < requestedEntries) {
+        return;
+    }
+
+    // Change by at most a factor 2 per page, so that one slow (or fast) response doesn't throw us off,
+    // and not at all when we're close enough, to avoid changing the size for every page.
+    const qreal factor = qBound<qreal>(0.5, qreal(mTargetResponseTime) / qMax<qint64>(1, msecs), 2.0);
+    int newPageSize = mPageSize;
+    if (factor < 0.8 || factor > 1.25) {
+        newPageSize = qRound(requestedEntries * factor);
+    }
+
+    if (mMaximumResponseSize > 0 && bytes > 0) {
+        const qint64 bytesPerEntry = qMax<qint64>(1, bytes / receivedEntries);
+        newPageSize = int(qMin<qint64>(newPageSize, mMaximumResponseSize / bytesPerEntry));
+    }
+
+    setPageSize(newPageSize);
+}
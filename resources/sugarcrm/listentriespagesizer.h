@@ -0,0 +1,65 @@
+/*
+  This file is part of FatCRM, a desktop application for SugarCRM written by KDAB.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+  Authors: David Faure <david.faure@kdab.com>
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef LISTENTRIESPAGESIZER_H
+#define LISTENTRIESPAGESIZER_H
+
+#include <QtGlobal>
+
+/**
+ * Chooses the number of entries to request per get_entry_list call.
+ *
+ * Every complete page is a sample (response time and size); the page size then grows
+ * or shrinks so that a page takes about the target response time, without the
+ * response getting bigger than the maximum response size.
+ */
+class ListEntriesPageSizer
+{
+public:
+    ListEntriesPageSizer();
+    ListEntriesPageSizer(int minimumPageSize, int maximumPageSize);
+
+    void setPageSize(int pageSize);
+    int pageSize() const;
+
+    int minimumPageSize() const;
+    int maximumPageSize() const;
+
+    // in milliseconds
+    void setTargetResponseTime(int msecs);
+    int targetResponseTime() const;
+
+    // in bytes, 0 for no limit
+    void setMaximumResponseSize(qint64 bytes);
+    qint64 maximumResponseSize() const;
+
+    // requestedEntries is the page size used for the request, receivedEntries the result count.
+    // Incomplete pages (the last one) are ignored, they say nothing about the page size.
+    void addSample(int requestedEntries, int receivedEntries, qint64 bytes, qint64 msecs);
+
+private:
+    int mPageSize;
+    int mMinimumPageSize;
+    int mMaximumPageSize;
+    int mTargetResponseTime;
+    qint64 mMaximumResponseSize;
+};
+
+#endif
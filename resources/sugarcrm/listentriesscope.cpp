@@ -24,12 +24,14 @@
 
 ListEntriesScope::ListEntriesScope()
     : mOffset(0),
+      mMaxResults(100),
       mGetDeleted(false)
 {
 }
 
 ListEntriesScope::ListEntriesScope(const QString &timestamp)
     : mOffset(0),
+      mMaxResults(100),
       mUpdateTimestamp(timestamp),
       mGetDeleted(false)
 {
@@ -55,6 +57,16 @@ int ListEntriesScope::offset() const
     return mOffset;
 }
 
+void ListEntriesScope::setMaxResults(int maxResults)
+{
+    mMaxResults = maxResults;
+}
+
+int ListEntriesScope::maxResults() const
+{
+    return mMaxResults;
+}
+
 void ListEntriesScope::fetchDeleted()
 {
     mGetDeleted = true;
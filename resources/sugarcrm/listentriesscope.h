@@ -38,6 +38,10 @@ public:
 
     int offset() const;
 
+    void setMaxResults(int maxResults);
+
+    int maxResults() const;
+
     void fetchDeleted();
 
     int deleted() const;
@@ -46,6 +50,7 @@ public:
 
 private:
     int mOffset;
+    int mMaxResults;
     QString mUpdateTimestamp;
     bool mGetDeleted;
 };
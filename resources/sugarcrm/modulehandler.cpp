@@ -39,8 +39,170 @@ using namespace KDSoapGenerated;
 
 #include <KLocale>
 
+#include <QHash>
 #include <QVector>
 
+namespace {
+// Two-way dictionary between the CRM field names and the Sugar field names
+struct FieldNamesMapping
+{
+    FieldNamesMapping();
+
+    QHash<QString, QString> crmToSugar;
+    QHash<QString, QString> sugarToCrm;
+};
+}
+
+FieldNamesMapping::FieldNamesMapping()
+{
+    //                 CRM field name , Sugar field name
+    crmToSugar.insert(KDCRMFields::accountDescription(), QLatin1String("account_description"));
+    crmToSugar.insert(KDCRMFields::accountId(), QLatin1String("account_id"));
+    crmToSugar.insert(KDCRMFields::accountName(), QLatin1String("account_name"));
+    crmToSugar.insert(KDCRMFields::accountType(), QLatin1String("account_type"));
+    crmToSugar.insert(KDCRMFields::accountPhoneOther(), QLatin1String("phone_alternate"));
+    crmToSugar.insert(KDCRMFields::accountPhoneWork(), QLatin1String("phone_office"));
+    crmToSugar.insert(KDCRMFields::actualCost(), QLatin1String("actual_cost"));
+    crmToSugar.insert(KDCRMFields::altAddressCity(), QLatin1String("alt_address_city"));
+    crmToSugar.insert(KDCRMFields::altAddressCountry(), QLatin1String("alt_address_country"));
+    crmToSugar.insert(KDCRMFields::altAddressPostalcode(), QLatin1String("alt_address_postalcode"));
+    crmToSugar.insert(KDCRMFields::altAddressState(), QLatin1String("alt_address_state"));
+    crmToSugar.insert(KDCRMFields::altAddressStreet(), QLatin1String("alt_address_street"));
+    crmToSugar.insert(KDCRMFields::amount(), QLatin1String("amount"));
+    crmToSugar.insert(KDCRMFields::amountUsDollar(), QLatin1String("amount_usdollar"));
+    crmToSugar.insert(KDCRMFields::annualRevenue(), QLatin1String("annual_revenue"));
+    crmToSugar.insert(KDCRMFields::assignedUserId(), QLatin1String("assigned_user_id"));
+    crmToSugar.insert(KDCRMFields::assignedUserName(), QLatin1String("assigned_user_name"));
+    crmToSugar.insert(KDCRMFields::assistant(), QLatin1String("assistant"));
+    crmToSugar.insert(KDCRMFields::billingAddressCity(), QLatin1String("billing_address_city"));
+    crmToSugar.insert(KDCRMFields::billingAddressCountry(), QLatin1String("billing_address_country"));
+    crmToSugar.insert(KDCRMFields::billingAddressPostalcode(), QLatin1String("billing_address_postalcode"));
+    crmToSugar.insert(KDCRMFields::billingAddressState(), QLatin1String("billing_address_state"));
+    crmToSugar.insert(KDCRMFields::billingAddressStreet(), QLatin1String("billing_address_street"));
+    crmToSugar.insert(KDCRMFields::birthdate(), QLatin1String("birthdate"));
+    crmToSugar.insert(KDCRMFields::budget(), QLatin1String("budget"));
+    crmToSugar.insert(KDCRMFields::cAcceptStatusFields(), QLatin1String("c_accept_status_fields"));
+    crmToSugar.insert(KDCRMFields::campaign(), QLatin1String("campaign"));
+    crmToSugar.insert(KDCRMFields::campaignId(), QLatin1String("campaign_id"));
+    crmToSugar.insert(KDCRMFields::campaignName(), QLatin1String("campaign_name"));
+    crmToSugar.insert(KDCRMFields::campaignType(), QLatin1String("campaign_type"));
+    crmToSugar.insert(KDCRMFields::ccAddrsNames(), QLatin1String("cc_addrs_names"));
+    crmToSugar.insert(KDCRMFields::contactId(), QLatin1String("contact_id"));
+    crmToSugar.insert(KDCRMFields::contactName(), QLatin1String("contact_name"));
+    crmToSugar.insert(KDCRMFields::content(), QLatin1String("content"));
+    crmToSugar.insert(KDCRMFields::converted(), QLatin1String("converted"));
+    crmToSugar.insert(KDCRMFields::createdBy(), QLatin1String("created_by"));
+    crmToSugar.insert(KDCRMFields::createdByName(), QLatin1String("created_by_name"));
+    crmToSugar.insert(KDCRMFields::currencyId(), QLatin1String("currency_id"));
+    crmToSugar.insert(KDCRMFields::currencyName(), QLatin1String("currency_name"));
+    crmToSugar.insert(KDCRMFields::currencySymbol(), QLatin1String("currency_symbol"));
+    crmToSugar.insert(KDCRMFields::dateClosed(), QLatin1String("date_closed"));
+    crmToSugar.insert(KDCRMFields::dateDue(), QLatin1String("date_due"));
+    crmToSugar.insert(KDCRMFields::dateDueFlag(), QLatin1String("date_due_flag"));
+    crmToSugar.insert(KDCRMFields::dateEntered(), QLatin1String("date_entered"));
+    crmToSugar.insert(KDCRMFields::dateModified(), QLatin1String("date_modified"));
+    crmToSugar.insert(KDCRMFields::dateSent(), QLatin1String("date_sent"));
+    crmToSugar.insert(KDCRMFields::dateStart(), QLatin1String("date_start"));
+    crmToSugar.insert(KDCRMFields::dateStartFlag(), QLatin1String("date_start_flag"));
+    crmToSugar.insert(KDCRMFields::deleted(), QLatin1String("deleted"));
+    crmToSugar.insert(KDCRMFields::department(), QLatin1String("department"));
+    crmToSugar.insert(KDCRMFields::description(), QLatin1String("description"));
+    crmToSugar.insert(KDCRMFields::doNotCall(), QLatin1String("do_not_call"));
+    crmToSugar.insert(KDCRMFields::email1(), QLatin1String("email1"));
+    crmToSugar.insert(KDCRMFields::email2(), QLatin1String("email2"));
+    crmToSugar.insert(KDCRMFields::employees(), QLatin1String("employees"));
+    crmToSugar.insert(KDCRMFields::endDate(), QLatin1String("end_date"));
+    crmToSugar.insert(KDCRMFields::expectedCost(), QLatin1String("expected_cost"));
+    crmToSugar.insert(KDCRMFields::expectedRevenue(), QLatin1String("expected_revenue"));
+    crmToSugar.insert(KDCRMFields::fileMimeType(), QLatin1String("file_mime_type"));
+    crmToSugar.insert(KDCRMFields::fileName(), QLatin1String("file_name"));
+    crmToSugar.insert(KDCRMFields::firstName(), QLatin1String("first_name"));
+    crmToSugar.insert(KDCRMFields::frequency(), QLatin1String("frequency"));
+    crmToSugar.insert(KDCRMFields::fromAddrName(), QLatin1String("from_addr_name"));
+    crmToSugar.insert(KDCRMFields::id(), QLatin1String("id"));
+    crmToSugar.insert(KDCRMFields::impressions(), QLatin1String("impressions"));
+    crmToSugar.insert(KDCRMFields::industry(), QLatin1String("industry"));
+    crmToSugar.insert(KDCRMFields::lastName(), QLatin1String("last_name"));
+    crmToSugar.insert(KDCRMFields::leadSource(), QLatin1String("lead_source"));
+    crmToSugar.insert(KDCRMFields::leadSourceDescription(), QLatin1String("lead_source_description"));
+    crmToSugar.insert(KDCRMFields::mAcceptStatusFields(), QLatin1String("m_accept_status_fields"));
+    crmToSugar.insert(KDCRMFields::messageId(), QLatin1String("message_id"));
+    crmToSugar.insert(KDCRMFields::modifiedByName(), QLatin1String("modified_by_name"));
+    crmToSugar.insert(KDCRMFields::modifiedUserId(), QLatin1String("modified_user_id"));
+    crmToSugar.insert(KDCRMFields::name(), QLatin1String("name"));
+    crmToSugar.insert(KDCRMFields::nextStep(), QLatin1String("next_step"));
+    crmToSugar.insert(KDCRMFields::objective(), QLatin1String("objective"));
+    crmToSugar.insert(KDCRMFields::opportunityAmount(), QLatin1String("opportunity_amount"));
+    crmToSugar.insert(KDCRMFields::opportunityId(), QLatin1String("opportunity_id"));
+    crmToSugar.insert(KDCRMFields::opportunityName(), QLatin1String("opportunity_name"));
+    crmToSugar.insert(KDCRMFields::opportunityRoleFields(), QLatin1String("opportunity_role_fields"));
+    crmToSugar.insert(KDCRMFields::opportunityType(), QLatin1String("opportunity_type"));
+    crmToSugar.insert(KDCRMFields::ownership(), QLatin1String("ownership"));
+    crmToSugar.insert(KDCRMFields::parentId(), QLatin1String("parent_id"));
+    crmToSugar.insert(KDCRMFields::parentName(), QLatin1String("parent_name"));
+    crmToSugar.insert(KDCRMFields::parentType(), QLatin1String("parent_type"));
+    crmToSugar.insert(KDCRMFields::phoneAssistant(), QLatin1String("assistant_phone"));
+    crmToSugar.insert(KDCRMFields::phoneFax(), QLatin1String("phone_fax"));
+    crmToSugar.insert(KDCRMFields::phoneHome(), QLatin1String("phone_home"));
+    crmToSugar.insert(KDCRMFields::phoneMobile(), QLatin1String("phone_mobile"));
+    crmToSugar.insert(KDCRMFields::phoneOther(), QLatin1String("phone_other"));
+    crmToSugar.insert(KDCRMFields::phoneWork(), QLatin1String("phone_work"));
+    crmToSugar.insert(KDCRMFields::portalApp(), QLatin1String("portal_app"));
+    crmToSugar.insert(KDCRMFields::portalName(), QLatin1String("portal_name"));
+    crmToSugar.insert(KDCRMFields::primaryAddressCity(), QLatin1String("primary_address_city"));
+    crmToSugar.insert(KDCRMFields::primaryAddressCountry(), QLatin1String("primary_address_country"));
+    crmToSugar.insert(KDCRMFields::primaryAddressPostalcode(), QLatin1String("primary_address_postalcode"));
+    crmToSugar.insert(KDCRMFields::primaryAddressState(), QLatin1String("primary_address_state"));
+    crmToSugar.insert(KDCRMFields::primaryAddressStreet(), QLatin1String("primary_address_street"));
+    crmToSugar.insert(KDCRMFields::priority(), QLatin1String("priority"));
+    crmToSugar.insert(KDCRMFields::probability(), QLatin1String("probability"));
+    crmToSugar.insert(KDCRMFields::rating(), QLatin1String("rating"));
+    crmToSugar.insert(KDCRMFields::referedBy(), QLatin1String("refered_by"));
+    crmToSugar.insert(KDCRMFields::referUrl(), QLatin1String("refer_url"));
+    crmToSugar.insert(KDCRMFields::reportsTo(), QLatin1String("report_to_name"));
+    crmToSugar.insert(KDCRMFields::reportsToId(), QLatin1String("reports_to_id"));
+    crmToSugar.insert(KDCRMFields::salesStage(), QLatin1String("sales_stage"));
+    crmToSugar.insert(KDCRMFields::salutation(), QLatin1String("salutation"));
+    crmToSugar.insert(KDCRMFields::shippingAddressCity(), QLatin1String("shipping_address_city"));
+    crmToSugar.insert(KDCRMFields::shippingAddressCountry(), QLatin1String("shipping_address_country"));
+    crmToSugar.insert(KDCRMFields::shippingAddressPostalcode(), QLatin1String("shipping_address_postalcaode"));
+    crmToSugar.insert(KDCRMFields::shippingAddressState(), QLatin1String("shipping_address_state"));
+    crmToSugar.insert(KDCRMFields::shippingAddressStreet(), QLatin1String("shipping_address_street"));
+    crmToSugar.insert(KDCRMFields::sicCode(), QLatin1String("sic_code"));
+    crmToSugar.insert(KDCRMFields::startDate(), QLatin1String("start_date"));
+    crmToSugar.insert(KDCRMFields::status(), QLatin1String("status"));
+    crmToSugar.insert(KDCRMFields::statusDescription(), QLatin1String("status_description"));
+    crmToSugar.insert(KDCRMFields::tickerSymbol(), QLatin1String("ticker_symbol"));
+    crmToSugar.insert(KDCRMFields::title(), QLatin1String("title"));
+    crmToSugar.insert(KDCRMFields::trackerCount(), QLatin1String("tracker_count"));
+    crmToSugar.insert(KDCRMFields::trackerKey(), QLatin1String("tracker_key"));
+    crmToSugar.insert(KDCRMFields::trackerText(), QLatin1String("tracker_text"));
+    crmToSugar.insert(KDCRMFields::toAddrsNames(), QLatin1String("to_addrs_names"));
+    crmToSugar.insert(KDCRMFields::website(), QLatin1String("website"));
+    crmToSugar.insert(KDCRMFields::documentName(), QLatin1String("document_name"));
+    crmToSugar.insert(KDCRMFields::docId(), QLatin1String("doc_id"));
+    crmToSugar.insert(KDCRMFields::docType(), QLatin1String("doc_type"));
+    crmToSugar.insert(KDCRMFields::docUrl(), QLatin1String("doc_url"));
+    crmToSugar.insert(KDCRMFields::activeDate(), QLatin1String("active_date"));
+    crmToSugar.insert(KDCRMFields::expDate(), QLatin1String("exp_date"));
+    crmToSugar.insert(KDCRMFields::categoryId(), QLatin1String("category_id"));
+    crmToSugar.insert(KDCRMFields::subcategoryId(), QLatin1String("subcategory_id"));
+    crmToSugar.insert(KDCRMFields::statusId(), QLatin1String("status_id"));
+    crmToSugar.insert(KDCRMFields::documentRevisionId(), QLatin1String("document_revision_id"));
+    crmToSugar.insert(KDCRMFields::relatedDocId(), QLatin1String("related_doc_id"));
+    crmToSugar.insert(KDCRMFields::relatedDocName(), QLatin1String("related_doc_name"));
+    crmToSugar.insert(KDCRMFields::relatedDocRevId(), QLatin1String("related_doc_rev_id"));
+    crmToSugar.insert(KDCRMFields::isTemplate(), QLatin1String("is_template"));
+    crmToSugar.insert(KDCRMFields::templateType(), QLatin1String("template_type"));
+
+    QHash<QString, QString>::const_iterator it = crmToSugar.constBegin();
+    for (; it != crmToSugar.constEnd(); ++it) {
+        sugarToCrm.insert(it.value(), it.key());
+    }
+}
+
+Q_GLOBAL_STATIC(FieldNamesMapping, s_fieldNamesMapping)
+
 ModuleHandler::ModuleHandler(const QString &moduleName, SugarSession *session)
     : mSession(session),
       mModuleName(moduleName),
@@ -93,23 +255,33 @@ void ModuleHandler::modifyCollection(const Akonadi::Collection &collection)
 }
 
 void ModuleHandler::getEntriesCount(const ListEntriesScope &scope)
+{
+    getEntriesCount(scope, soap());
+}
+
+void ModuleHandler::getEntriesCount(const ListEntriesScope &scope, KDSoapGenerated::Sugarsoap *soap)
 {
     const QString query = scope.query(queryStringForListing(), mModuleName.toLower());
-    soap()->asyncGet_entries_count(sessionId(), moduleName(), query, scope.deleted());
+    soap->asyncGet_entries_count(sessionId(), moduleName(), query, scope.deleted());
 }
 
 void ModuleHandler::listEntries(const ListEntriesScope &scope)
+{
+    listEntries(scope, soap());
+}
+
+void ModuleHandler::listEntries(const ListEntriesScope &scope, KDSoapGenerated::Sugarsoap *soap)
 {
     const QString query = scope.query(queryStringForListing(), mModuleName.toLower());
     const QString orderBy = orderByForListing();
     const int offset = scope.offset();
-    const int maxResults = 100;
+    const int maxResults = scope.maxResults();
     const int fetchDeleted = scope.deleted();
 
     KDSoapGenerated::TNS__Select_fields selectedFields;
     selectedFields.setItems(supportedSugarFields());
 
-    soap()->asyncGet_entry_list(sessionId(), moduleName(), query, orderBy, offset, selectedFields, maxResults, fetchDeleted);
+    soap->asyncGet_entry_list(sessionId(), moduleName(), query, orderBy, offset, selectedFields, maxResults, fetchDeleted);
 }
 
 QStringList ModuleHandler::availableFields() const
@@ -228,6 +400,16 @@ Akonadi::Item::List ModuleHandler::itemsFromListEntriesResponse(const KDSoapGene
     return items;
 }
 
+ExtraInformationJob *ModuleHandler::createExtraInformationJob(const Akonadi::Item::List &items,
+                                                             KDSoapGenerated::Sugarsoap *soap,
+                                                             QObject *parent)
+{
+    Q_UNUSED(items);
+    Q_UNUSED(soap);
+    Q_UNUSED(parent);
+    return nullptr;
+}
+
 bool ModuleHandler::needBackendChange(const Akonadi::Item &item, const QSet<QByteArray> &modifiedParts) const
 {
     Q_UNUSED(item);
@@ -245,10 +427,47 @@ QByteArray ModuleHandler::partIdFromPayloadPart(const char *part)
     return QByteArray("PLD:") + part;
 }
 
+const ModuleHandler::FieldColumns &ModuleHandler::fieldColumns(const QList<KDSoapGenerated::TNS__Name_value> &valueList) const
+{
+    bool sameColumns = mFieldColumns.count() == valueList.count();
+    for (int i = 0; sameColumns && i < valueList.count(); ++i) {
+        sameColumns = mFieldColumns.at(i).sugarFieldName == valueList.at(i).name();
+    }
+
+    if (!sameColumns) {
+        mFieldColumns.clear();
+        mFieldColumns.reserve(valueList.count());
+        Q_FOREACH (const KDSoapGenerated::TNS__Name_value &namedValue, valueList) {
+            mFieldColumns.append(resolveField(namedValue.name()));
+        }
+    }
+
+    return mFieldColumns;
+}
+
+int ModuleHandler::crmFieldIndex(const QString &crmFieldName) const
+{
+    Q_UNUSED(crmFieldName);
+    return -1;
+}
+
+ModuleHandler::FieldColumn ModuleHandler::resolveField(const QString &sugarFieldName) const
+{
+    QHash<QString, FieldColumn>::const_iterator it = mResolvedFields.constFind(sugarFieldName);
+    if (it == mResolvedFields.constEnd()) {
+        FieldColumn column;
+        column.sugarFieldName = sugarFieldName;
+        column.crmFieldName = sugarFieldToCrmField(sugarFieldName);
+        column.customCrmFieldName = customSugarFieldToCrmField(sugarFieldName);
+        column.fieldIndex = column.crmFieldName.isEmpty() ? -1 : crmFieldIndex(column.crmFieldName);
+        it = mResolvedFields.insert(sugarFieldName, column);
+    }
+    return *it;
+}
+
 QString ModuleHandler::sugarFieldToCrmField(const QString &sugarFieldName) const
 {
-    const QMap<QString, QString> &map = fieldNamesMapping();
-    return map.key(sugarFieldName, QString());
+    return s_fieldNamesMapping()->sugarToCrm.value(sugarFieldName);
 }
 
 QString ModuleHandler::customSugarFieldToCrmField(const QString &sugarFieldName) const
@@ -278,8 +497,7 @@ QStringList ModuleHandler::sugarFieldsToCrmFields(const QStringList &sugarFieldN
 
 QString ModuleHandler::sugarFieldFromCrmField(const QString &crmFieldName) const
 {
-    const QMap<QString, QString> &map = fieldNamesMapping();
-    return map.value(crmFieldName, QString());
+    return s_fieldNamesMapping()->crmToSugar.value(crmFieldName);
 }
 
 QString ModuleHandler::customSugarFieldFromCrmField(const QString &crmFieldName) const
@@ -304,154 +522,6 @@ QStringList ModuleHandler::sugarFieldsFromCrmFields(const QStringList &crmFieldN
     return sugarFieldNames;
 }
 
-const QMap<QString, QString>& ModuleHandler::fieldNamesMapping() const
-{
-    static QMap<QString, QString> mapping;
-    if (mapping.isEmpty()) {
-        //                      CRM field name , Sugar field name
-        mapping.insert(KDCRMFields::accountDescription(), QLatin1String("account_description"));
-        mapping.insert(KDCRMFields::accountId(), QLatin1String("account_id"));
-        mapping.insert(KDCRMFields::accountName(), QLatin1String("account_name"));
-        mapping.insert(KDCRMFields::accountType(), QLatin1String("account_type"));
-        mapping.insert(KDCRMFields::accountPhoneOther(), QLatin1String("phone_alternate"));
-        mapping.insert(KDCRMFields::accountPhoneWork(), QLatin1String("phone_office"));
-        mapping.insert(KDCRMFields::actualCost(), QLatin1String("actual_cost"));
-        mapping.insert(KDCRMFields::altAddressCity(), QLatin1String("alt_address_city"));
-        mapping.insert(KDCRMFields::altAddressCountry(), QLatin1String("alt_address_country"));
-        mapping.insert(KDCRMFields::altAddressPostalcode(), QLatin1String("alt_address_postalcode"));
-        mapping.insert(KDCRMFields::altAddressState(), QLatin1String("alt_address_state"));
-        mapping.insert(KDCRMFields::altAddressStreet(), QLatin1String("alt_address_street"));
-        mapping.insert(KDCRMFields::amount(), QLatin1String("amount"));
-        mapping.insert(KDCRMFields::amountUsDollar(), QLatin1String("amount_usdollar"));
-        mapping.insert(KDCRMFields::annualRevenue(), QLatin1String("annual_revenue"));
-        mapping.insert(KDCRMFields::assignedUserId(), QLatin1String("assigned_user_id"));
-        mapping.insert(KDCRMFields::assignedUserName(), QLatin1String("assigned_user_name"));
-        mapping.insert(KDCRMFields::assistant(), QLatin1String("assistant"));
-        mapping.insert(KDCRMFields::billingAddressCity(), QLatin1String("billing_address_city"));
-        mapping.insert(KDCRMFields::billingAddressCountry(), QLatin1String("billing_address_country"));
-        mapping.insert(KDCRMFields::billingAddressPostalcode(), QLatin1String("billing_address_postalcode"));
-        mapping.insert(KDCRMFields::billingAddressState(), QLatin1String("billing_address_state"));
-        mapping.insert(KDCRMFields::billingAddressStreet(), QLatin1String("billing_address_street"));
-        mapping.insert(KDCRMFields::birthdate(), QLatin1String("birthdate"));
-        mapping.insert(KDCRMFields::budget(), QLatin1String("budget"));
-        mapping.insert(KDCRMFields::cAcceptStatusFields(), QLatin1String("c_accept_status_fields"));
-        mapping.insert(KDCRMFields::campaign(), QLatin1String("campaign"));
-        mapping.insert(KDCRMFields::campaignId(), QLatin1String("campaign_id"));
-        mapping.insert(KDCRMFields::campaignName(), QLatin1String("campaign_name"));
-        mapping.insert(KDCRMFields::campaignType(), QLatin1String("campaign_type"));
-        mapping.insert(KDCRMFields::ccAddrsNames(), QLatin1String("cc_addrs_names"));
-        mapping.insert(KDCRMFields::contactId(), QLatin1String("contact_id"));
-        mapping.insert(KDCRMFields::contactName(), QLatin1String("contact_name"));
-        mapping.insert(KDCRMFields::content(), QLatin1String("content"));
-        mapping.insert(KDCRMFields::converted(), QLatin1String("converted"));
-        mapping.insert(KDCRMFields::createdBy(), QLatin1String("created_by"));
-        mapping.insert(KDCRMFields::createdByName(), QLatin1String("created_by_name"));
-        mapping.insert(KDCRMFields::currencyId(), QLatin1String("currency_id"));
-        mapping.insert(KDCRMFields::currencyName(), QLatin1String("currency_name"));
-        mapping.insert(KDCRMFields::currencySymbol(), QLatin1String("currency_symbol"));
-        mapping.insert(KDCRMFields::dateClosed(), QLatin1String("date_closed"));
-        mapping.insert(KDCRMFields::dateDue(), QLatin1String("date_due"));
-        mapping.insert(KDCRMFields::dateDueFlag(), QLatin1String("date_due_flag"));
-        mapping.insert(KDCRMFields::dateEntered(), QLatin1String("date_entered"));
-        mapping.insert(KDCRMFields::dateModified(), QLatin1String("date_modified"));
-        mapping.insert(KDCRMFields::dateSent(), QLatin1String("date_sent"));
-        mapping.insert(KDCRMFields::dateStart(), QLatin1String("date_start"));
-        mapping.insert(KDCRMFields::dateStartFlag(), QLatin1String("date_start_flag"));
-        mapping.insert(KDCRMFields::deleted(), QLatin1String("deleted"));
-        mapping.insert(KDCRMFields::department(), QLatin1String("department"));
-        mapping.insert(KDCRMFields::description(), QLatin1String("description"));
-        mapping.insert(KDCRMFields::doNotCall(), QLatin1String("do_not_call"));
-        mapping.insert(KDCRMFields::email1(), QLatin1String("email1"));
-        mapping.insert(KDCRMFields::email2(), QLatin1String("email2"));
-        mapping.insert(KDCRMFields::employees(), QLatin1String("employees"));
-        mapping.insert(KDCRMFields::endDate(), QLatin1String("end_date"));
-        mapping.insert(KDCRMFields::expectedCost(), QLatin1String("expected_cost"));
-        mapping.insert(KDCRMFields::expectedRevenue(), QLatin1String("expected_revenue"));
-        mapping.insert(KDCRMFields::fileMimeType(), QLatin1String("file_mime_type"));
-        mapping.insert(KDCRMFields::fileName(), QLatin1String("file_name"));
-        mapping.insert(KDCRMFields::firstName(), QLatin1String("first_name"));
-        mapping.insert(KDCRMFields::frequency(), QLatin1String("frequency"));
-        mapping.insert(KDCRMFields::fromAddrName(), QLatin1String("from_addr_name"));
-        mapping.insert(KDCRMFields::id(), QLatin1String("id"));
-        mapping.insert(KDCRMFields::impressions(), QLatin1String("impressions"));
-        mapping.insert(KDCRMFields::industry(), QLatin1String("industry"));
-        mapping.insert(KDCRMFields::lastName(), QLatin1String("last_name"));
-        mapping.insert(KDCRMFields::leadSource(), QLatin1String("lead_source"));
-        mapping.insert(KDCRMFields::leadSourceDescription(), QLatin1String("lead_source_description"));
-        mapping.insert(KDCRMFields::mAcceptStatusFields(), QLatin1String("m_accept_status_fields"));
-        mapping.insert(KDCRMFields::messageId(), QLatin1String("message_id"));
-        mapping.insert(KDCRMFields::modifiedByName(), QLatin1String("modified_by_name"));
-        mapping.insert(KDCRMFields::modifiedUserId(), QLatin1String("modified_user_id"));
-        mapping.insert(KDCRMFields::name(), QLatin1String("name"));
-        mapping.insert(KDCRMFields::nextStep(), QLatin1String("next_step"));
-        mapping.insert(KDCRMFields::objective(), QLatin1String("objective"));
-        mapping.insert(KDCRMFields::opportunityAmount(), QLatin1String("opportunity_amount"));
-        mapping.insert(KDCRMFields::opportunityId(), QLatin1String("opportunity_id"));
-        mapping.insert(KDCRMFields::opportunityName(), QLatin1String("opportunity_name"));
-        mapping.insert(KDCRMFields::opportunityRoleFields(), QLatin1String("opportunity_role_fields"));
-        mapping.insert(KDCRMFields::opportunityType(), QLatin1String("opportunity_type"));
-        mapping.insert(KDCRMFields::ownership(), QLatin1String("ownership"));
-        mapping.insert(KDCRMFields::parentId(), QLatin1String("parent_id"));
-        mapping.insert(KDCRMFields::parentName(), QLatin1String("parent_name"));
-        mapping.insert(KDCRMFields::parentType(), QLatin1String("parent_type"));
-        mapping.insert(KDCRMFields::phoneAssistant(), QLatin1String("assistant_phone"));
-        mapping.insert(KDCRMFields::phoneFax(), QLatin1String("phone_fax"));
-        mapping.insert(KDCRMFields::phoneHome(), QLatin1String("phone_home"));
-        mapping.insert(KDCRMFields::phoneMobile(), QLatin1String("phone_mobile"));
-        mapping.insert(KDCRMFields::phoneOther(), QLatin1String("phone_other"));
-        mapping.insert(KDCRMFields::phoneWork(), QLatin1String("phone_work"));
-        mapping.insert(KDCRMFields::portalApp(), QLatin1String("portal_app"));
-        mapping.insert(KDCRMFields::portalName(), QLatin1String("portal_name"));
-        mapping.insert(KDCRMFields::primaryAddressCity(), QLatin1String("primary_address_city"));
-        mapping.insert(KDCRMFields::primaryAddressCountry(), QLatin1String("primary_address_country"));
-        mapping.insert(KDCRMFields::primaryAddressPostalcode(), QLatin1String("primary_address_postalcode"));
-        mapping.insert(KDCRMFields::primaryAddressState(), QLatin1String("primary_address_state"));
-        mapping.insert(KDCRMFields::primaryAddressStreet(), QLatin1String("primary_address_street"));
-        mapping.insert(KDCRMFields::priority(), QLatin1String("priority"));
-        mapping.insert(KDCRMFields::probability(), QLatin1String("probability"));
-        mapping.insert(KDCRMFields::rating(), QLatin1String("rating"));
-        mapping.insert(KDCRMFields::referedBy(), QLatin1String("refered_by"));
-        mapping.insert(KDCRMFields::referUrl(), QLatin1String("refer_url"));
-        mapping.insert(KDCRMFields::reportsTo(), QLatin1String("report_to_name"));
-        mapping.insert(KDCRMFields::reportsToId(), QLatin1String("reports_to_id"));
-        mapping.insert(KDCRMFields::salesStage(), QLatin1String("sales_stage"));
-        mapping.insert(KDCRMFields::salutation(), QLatin1String("salutation"));
-        mapping.insert(KDCRMFields::shippingAddressCity(), QLatin1String("shipping_address_city"));
-        mapping.insert(KDCRMFields::shippingAddressCountry(), QLatin1String("shipping_address_country"));
-        mapping.insert(KDCRMFields::shippingAddressPostalcode(), QLatin1String("shipping_address_postalcaode"));
-        mapping.insert(KDCRMFields::shippingAddressState(), QLatin1String("shipping_address_state"));
-        mapping.insert(KDCRMFields::shippingAddressStreet(), QLatin1String("shipping_address_street"));
-        mapping.insert(KDCRMFields::sicCode(), QLatin1String("sic_code"));
-        mapping.insert(KDCRMFields::startDate(), QLatin1String("start_date"));
-        mapping.insert(KDCRMFields::status(), QLatin1String("status"));
-        mapping.insert(KDCRMFields::statusDescription(), QLatin1String("status_description"));
-        mapping.insert(KDCRMFields::tickerSymbol(), QLatin1String("ticker_symbol"));
-        mapping.insert(KDCRMFields::title(), QLatin1String("title"));
-        mapping.insert(KDCRMFields::trackerCount(), QLatin1String("tracker_count"));
-        mapping.insert(KDCRMFields::trackerKey(), QLatin1String("tracker_key"));
-        mapping.insert(KDCRMFields::trackerText(), QLatin1String("tracker_text"));
-        mapping.insert(KDCRMFields::toAddrsNames(), QLatin1String("to_addrs_names"));
-        mapping.insert(KDCRMFields::website(), QLatin1String("website"));
-        mapping.insert(KDCRMFields::documentName(), QLatin1String("document_name"));
-        mapping.insert(KDCRMFields::docId(), QLatin1String("doc_id"));
-        mapping.insert(KDCRMFields::docType(), QLatin1String("doc_type"));
-        mapping.insert(KDCRMFields::docUrl(), QLatin1String("doc_url"));
-        mapping.insert(KDCRMFields::activeDate(), QLatin1String("active_date"));
-        mapping.insert(KDCRMFields::expDate(), QLatin1String("exp_date"));
-        mapping.insert(KDCRMFields::categoryId(), QLatin1String("category_id"));
-        mapping.insert(KDCRMFields::subcategoryId(), QLatin1String("subcategory_id"));
-        mapping.insert(KDCRMFields::statusId(), QLatin1String("status_id"));
-        mapping.insert(KDCRMFields::documentRevisionId(), QLatin1String("document_revision_id"));
-        mapping.insert(KDCRMFields::relatedDocId(), QLatin1String("related_doc_id"));
-        mapping.insert(KDCRMFields::relatedDocName(), QLatin1String("related_doc_name"));
-        mapping.insert(KDCRMFields::relatedDocRevId(), QLatin1String("related_doc_rev_id"));
-        mapping.insert(KDCRMFields::isTemplate(), QLatin1String("is_template"));
-        mapping.insert(KDCRMFields::templateType(), QLatin1String("template_type"));
-    }
-
-    return mapping;
-}
-
 QString ModuleHandler::sessionId() const
 {
     return mSession->sessionId();
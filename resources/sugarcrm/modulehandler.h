@@ -29,8 +29,11 @@
 #include <Akonadi/Item>
 #include <Akonadi/Collection>
 
+#include <QHash>
 #include <QStringList>
+#include <QVector>
 
+class ExtraInformationJob;
 class SugarSession;
 class ListEntriesScope;
 
@@ -40,6 +43,7 @@ class Sugarsoap;
 class TNS__Entry_list;
 class TNS__Entry_value;
 class TNS__Field_list;
+class TNS__Name_value;
 }
 
 class ModuleHandler : public QObject, public Akonadi::DifferencesAlgorithmInterface
@@ -61,7 +65,11 @@ public:
     void modifyCollection(const Akonadi::Collection &collection);
 
     void getEntriesCount(const ListEntriesScope &scope);
+    void getEntriesCount(const ListEntriesScope &scope, KDSoapGenerated::Sugarsoap *soap);
     void listEntries(const ListEntriesScope &scope);
+    // Same, but sends the request through the given SOAP interface,
+    // so that several pages can be requested at the same time
+    void listEntries(const ListEntriesScope &scope, KDSoapGenerated::Sugarsoap *soap);
 
     QStringList availableFields() const;
     static QStringList listAvailableFields(SugarSession *session, const QString &module);
@@ -74,7 +82,11 @@ public:
     // Return true if the handler wants to fetch extra information on listed items
     // (e.g. email text)
     virtual bool needsExtraInformation() const { return false; }
-    virtual void getExtraInformation(Akonadi::Item::List &) {}
+    // Return a job which fetches the extra information without blocking, through
+    // the given SOAP interface. The items are delivered as they are if this returns nullptr.
+    virtual ExtraInformationJob *createExtraInformationJob(const Akonadi::Item::List &items,
+                                                           KDSoapGenerated::Sugarsoap *soap,
+                                                           QObject *parent);
 
     virtual QString queryStringForListing() const { return QString(); }
     virtual QString orderByForListing() const = 0;
@@ -110,6 +122,24 @@ protected:
 
     virtual Akonadi::Collection handlerCollection() const = 0;
 
+    // How the values of a column of a get_entry_list response are stored
+    struct FieldColumn
+    {
+        QString sugarFieldName;
+        QString crmFieldName; // empty if this isn't a known CRM field
+        QString customCrmFieldName; // the name to use when storing it as a custom field
+        int fieldIndex; // see crmFieldIndex()
+    };
+    typedef QVector<FieldColumn> FieldColumns;
+
+    // Returns one FieldColumn per name/value pair of an entry. All the entries of a response
+    // have the same columns, so this is only resolved again when the column names change.
+    const FieldColumns &fieldColumns(const QList<KDSoapGenerated::TNS__Name_value> &valueList) const;
+
+    // Reimplement to return the index of a CRM field in the payload's storage,
+    // e.g. SugarAccount::fieldIndex(). The default implementation returns -1.
+    virtual int crmFieldIndex(const QString &crmFieldName) const;
+
     QString sugarFieldToCrmField(const QString &sugarFieldName) const;
     virtual QString customSugarFieldToCrmField(const QString &sugarFieldName) const;
     QStringList sugarFieldsToCrmFields(const QStringList &sugarFieldNames) const;
@@ -125,9 +155,11 @@ private Q_SLOTS:
     void slotCollectionsReceived(const Akonadi::Collection::List &collections);
 
 private:
-    const QMap<QString, QString>& fieldNamesMapping() const;
+    FieldColumn resolveField(const QString &sugarFieldName) const;
 
     mutable QStringList mAvailableFields;
+    mutable FieldColumns mFieldColumns;
+    mutable QHash<QString, FieldColumn> mResolvedFields;
 
     EnumDefinitions mEnumDefinitions;
     bool mParsedEnumDefinitions;
@@ -0,0 +1,416 @@
+/*
+  This file is part of FatCRM, a desktop application for SugarCRM written by KDAB.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+  Authors: David Faure <david.faure@kdab.com>
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "modulesyncscheduler.h"
+
+#include "listentriesjob.h"
+#include "listentriespagesizer.h"
+#include "modulehandler.h"
+#include "settings.h"
+
+#include <Akonadi/CollectionFetchJob>
+#include <Akonadi/CollectionFetchScope>
+
+using namespace Akonadi;
+
+#include <KDebug>
+
+#include <QElapsedTimer>
+#include <QPair>
+#include <QTimer>
+
+class ModuleSyncScheduler::Private
+{
+    ModuleSyncScheduler *const q;
+
+public:
+    explicit Private(ModuleSyncScheduler *parent, SugarSession *session, const ModuleHandlerHash *moduleHandlers)
+        : q(parent),
+          mSession(session),
+          mModuleHandlers(moduleHandlers),
+          mMaximumConcurrentJobs(1),
+          mUnclaimedTimeout(60),
+          mClaimedJob(nullptr),
+          mReplayPending(false),
+          mFetchingCollections(false)
+    {
+        mUnclaimedTimer.setSingleShot(true);
+        QObject::connect(&mUnclaimedTimer, SIGNAL(timeout()), q, SLOT(dropUnclaimedJobs()));
+    }
+
+    struct Entry {
+        Entry() : job(nullptr), started(false), finished(false), totalItems(-1), progress(-1) {}
+        ListEntriesJob *job;
+        bool started;
+        bool finished;
+        // What the job reported while nobody asked for its collection yet
+        int totalItems;
+        int progress;
+        QList<QPair<Item::List, bool> > pages;
+        QElapsedTimer finishedTimer;
+    };
+
+    ListEntriesJob *createJob(const Collection &collection, ModuleHandler *handler);
+    void addEntry(ListEntriesJob *job);
+    int indexOf(const QString &module) const;
+    int indexOf(KJob *job) const;
+    bool mustWait(const Entry &entry) const;
+    void startJobs();
+    void removeEntry(int index);
+
+public:
+    SugarSession *mSession;
+    const ModuleHandlerHash *mModuleHandlers;
+    int mMaximumConcurrentJobs;
+    int mUnclaimedTimeout; // in seconds
+    QList<Entry> mEntries; // in the order in which the jobs should be started
+    ListEntriesJob *mClaimedJob; // the job for the collection being retrieved
+    bool mReplayPending; // mClaimedJob got claimed, its buffered signals weren't replayed yet
+    bool mFetchingCollections;
+    QTimer mUnclaimedTimer;
+
+public: // slots
+    void collectionsReceived(const Akonadi::Collection::List &collections);
+    void collectionFetchResult(KJob *job);
+    void jobTotalItems(int count);
+    void jobProgress(int count);
+    void jobItemsReceived(const Akonadi::Item::List &items, bool isUpdateJob);
+    void jobResult(KJob *job);
+    void replayClaimedJob();
+    void dropUnclaimedJobs();
+};
+
+// Accounts have to be listed first, OpportunitiesHandler resolves account names using SugarAccountCache
+static bool mustBeListedAfter(const QString &module, const QString &otherModule)
+{
+    return module == QLatin1String("Opportunities") && otherModule == QLatin1String("Accounts");
+}
+
+static int modulePriority(const QString &module)
+{
+    return module == QLatin1String("Accounts") ? 0 : 1;
+}
+
+ListEntriesJob *ModuleSyncScheduler::Private::createJob(const Collection &collection, ModuleHandler *handler)
+{
+    ListEntriesJob *job = new ListEntriesJob(collection, mSession, q);
+    job->setAutoDelete(false); // it might finish long before its collection is retrieved
+    job->setModule(handler);
+    job->setLatestTimestamp(ListEntriesJob::latestTimestamp(collection, handler));
+    ListEntriesPageSizer pageSizer(Settings::listEntriesMinimumPageSize(), Settings::listEntriesMaximumPageSize());
+    pageSizer.setTargetResponseTime(Settings::listEntriesTargetResponseTime());
+    pageSizer.setMaximumResponseSize(qint64(Settings::listEntriesMaximumResponseSize()) * 1024);
+    const int savedPageSize = ListEntriesJob::savedPageSize(collection);
+    pageSizer.setPageSize(savedPageSize > 0 ? savedPageSize : Settings::listEntriesPageSize());
+    job->setPageSizer(pageSizer);
+    job->setWindowSize(Settings::listEntriesWindowSize());
+
+    connect(job, SIGNAL(totalItems(int)), q, SLOT(jobTotalItems(int)));
+    connect(job, SIGNAL(progress(int)), q, SLOT(jobProgress(int)));
+    connect(job, SIGNAL(itemsReceived(Akonadi::Item::List,bool)),
+            q, SLOT(jobItemsReceived(Akonadi::Item::List,bool)));
+    connect(job, SIGNAL(result(KJob*)), q, SLOT(jobResult(KJob*)));
+    return job;
+}
+
+void ModuleSyncScheduler::Private::addEntry(ListEntriesJob *job)
+{
+    Entry entry;
+    entry.job = job;
+    const int priority = modulePriority(job->module()->moduleName());
+    int index = mEntries.count();
+    while (index > 0 && !mEntries.at(index - 1).started
+           && modulePriority(mEntries.at(index - 1).job->module()->moduleName()) > priority) {
+        --index;
+    }
+    mEntries.insert(index, entry);
+}
+
+int ModuleSyncScheduler::Private::indexOf(const QString &module) const
+{
+    for (int i = 0; i < mEntries.count(); ++i) {
+        if (mEntries.at(i).job->module()->moduleName() == module)
+            return i;
+    }
+    return -1;
+}
+
+int ModuleSyncScheduler::Private::indexOf(KJob *job) const
+{
+    for (int i = 0; i < mEntries.count(); ++i) {
+        if (mEntries.at(i).job == job)
+            return i;
+    }
+    return -1;
+}
+
+bool ModuleSyncScheduler::Private::mustWait(const Entry &entry) const
+{
+    const QString module = entry.job->module()->moduleName();
+    Q_FOREACH (const Entry &other, mEntries) {
+        if (!other.finished && mustBeListedAfter(module, other.job->module()->moduleName()))
+            return true;
+    }
+    return false;
+}
+
+void ModuleSyncScheduler::Private::startJobs()
+{
+    if (mFetchingCollections) {
+        return; // wait until we know all the collections, for the order
+    }
+
+    int running = 0;
+    Q_FOREACH (const Entry &entry, mEntries) {
+        if (entry.started && !entry.finished)
+            ++running;
+    }
+
+    for (int i = 0; i < mEntries.count(); ++i) {
+        Entry &entry = mEntries[i];
+        if (entry.started || mustWait(entry))
+            continue;
+        // The resource is waiting for the claimed job, don't let it wait any longer than necessary
+        if (entry.job != mClaimedJob && running >= mMaximumConcurrentJobs)
+            continue;
+        kDebug() << "Starting to list" << entry.job->module()->moduleName()
+                 << (entry.job == mClaimedJob ? "" : "in advance");
+        entry.started = true;
+        ++running;
+        entry.job->start();
+    }
+}
+
+void ModuleSyncScheduler::Private::removeEntry(int index)
+{
+    mEntries.removeAt(index);
+    startJobs(); // if Opportunities were waiting for Accounts
+}
+
+void ModuleSyncScheduler::Private::collectionsReceived(const Akonadi::Collection::List &collections)
+{
+    Q_FOREACH (const Collection &collection, collections) {
+        ModuleHandler *handler = mModuleHandlers->value(collection.remoteId());
+        if (handler && indexOf(handler->moduleName()) == -1) {
+            addEntry(createJob(collection, handler));
+        }
+    }
+}
+
+void ModuleSyncScheduler::Private::collectionFetchResult(KJob *job)
+{
+    if (job->error()) {
+        kWarning() << job->errorString();
+    }
+    mFetchingCollections = false;
+    startJobs();
+}
+
+void ModuleSyncScheduler::Private::jobTotalItems(int count)
+{
+    ListEntriesJob *job = qobject_cast<ListEntriesJob *>(q->sender());
+    if (job == mClaimedJob && !mReplayPending) {
+        emit q->totalItems(count);
+    } else {
+        const int index = indexOf(job);
+        Q_ASSERT(index >= 0);
+        mEntries[index].totalItems = count;
+    }
+}
+
+void ModuleSyncScheduler::Private::jobProgress(int count)
+{
+    ListEntriesJob *job = qobject_cast<ListEntriesJob *>(q->sender());
+    if (job == mClaimedJob && !mReplayPending) {
+        emit q->progress(count);
+    } else {
+        const int index = indexOf(job);
+        Q_ASSERT(index >= 0);
+        mEntries[index].progress = count;
+    }
+}
+
+void ModuleSyncScheduler::Private::jobItemsReceived(const Akonadi::Item::List &items, bool isUpdateJob)
+{
+    ListEntriesJob *job = qobject_cast<ListEntriesJob *>(q->sender());
+    if (job == mClaimedJob && !mReplayPending) {
+        emit q->itemsReceived(items, isUpdateJob);
+    } else {
+        const int index = indexOf(job);
+        Q_ASSERT(index >= 0);
+        mEntries[index].pages.append(qMakePair(items, isUpdateJob));
+    }
+}
+
+void ModuleSyncScheduler::Private::jobResult(KJob *job)
+{
+    const int index = indexOf(job);
+    Q_ASSERT(index >= 0);
+    if (job == mClaimedJob && !mReplayPending) {
+        mClaimedJob = nullptr;
+        removeEntry(index);
+        emit q->result(job);
+        return;
+    }
+
+    Entry &entry = mEntries[index];
+    kDebug() << "Listed" << entry.job->module()->moduleName() << "in advance, error" << job->error();
+    entry.finished = true;
+    entry.finishedTimer.start();
+    if (!mUnclaimedTimer.isActive()) {
+        mUnclaimedTimer.start(mUnclaimedTimeout * 1000);
+    }
+    startJobs();
+}
+
+void ModuleSyncScheduler::Private::replayClaimedJob()
+{
+    mReplayPending = false;
+    const int index = indexOf(mClaimedJob);
+    if (index == -1) {
+        return; // cleared meanwhile
+    }
+
+    Entry &entry = mEntries[index];
+    ListEntriesJob *job = entry.job;
+    if (entry.totalItems >= 0) {
+        emit q->totalItems(entry.totalItems);
+    }
+    if (entry.progress >= 0) {
+        emit q->progress(entry.progress);
+    }
+    const QList<QPair<Item::List, bool> > pages = entry.pages;
+    entry.pages.clear();
+    for (int i = 0; i < pages.count(); ++i) {
+        emit q->itemsReceived(pages.at(i).first, pages.at(i).second);
+    }
+
+    if (entry.finished) {
+        mClaimedJob = nullptr;
+        removeEntry(index);
+        emit q->result(job);
+    }
+}
+
+void ModuleSyncScheduler::Private::dropUnclaimedJobs()
+{
+    qint64 nextExpiry = -1;
+    for (int i = mEntries.count() - 1; i >= 0; --i) {
+        const Entry &entry = mEntries.at(i);
+        if (!entry.finished || entry.job == mClaimedJob)
+            continue;
+        const qint64 remaining = qint64(mUnclaimedTimeout) * 1000 - entry.finishedTimer.elapsed();
+        if (remaining <= 0) {
+            kDebug() << "Nobody wanted the listing of" << entry.job->module()->moduleName() << ", dropping it";
+            entry.job->deleteLater();
+            mEntries.removeAt(i);
+        } else if (nextExpiry == -1 || remaining < nextExpiry) {
+            nextExpiry = remaining;
+        }
+    }
+    if (nextExpiry != -1) {
+        mUnclaimedTimer.start(nextExpiry);
+    }
+}
+
+ModuleSyncScheduler::ModuleSyncScheduler(SugarSession *session, const ModuleHandlerHash *moduleHandlers, QObject *parent)
+    : QObject(parent), d(new Private(this, session, moduleHandlers))
+{
+}
+
+ModuleSyncScheduler::~ModuleSyncScheduler()
+{
+    delete d;
+}
+
+void ModuleSyncScheduler::setMaximumConcurrentJobs(int count)
+{
+    d->mMaximumConcurrentJobs = qMax(1, count);
+}
+
+void ModuleSyncScheduler::setUnclaimedTimeout(int seconds)
+{
+    d->mUnclaimedTimeout = seconds;
+}
+
+void ModuleSyncScheduler::prefetchAll(const QString &resourceIdentifier)
+{
+    if (d->mMaximumConcurrentJobs <= 1 || d->mFetchingCollections) {
+        return;
+    }
+
+    d->mFetchingCollections = true;
+    CollectionFetchJob *job = new CollectionFetchJob(Collection::root(), CollectionFetchJob::Recursive, this);
+    job->fetchScope().setResource(resourceIdentifier);
+    connect(job, SIGNAL(collectionsReceived(Akonadi::Collection::List)),
+            this, SLOT(collectionsReceived(Akonadi::Collection::List)));
+    connect(job, SIGNAL(result(KJob*)), this, SLOT(collectionFetchResult(KJob*)));
+}
+
+ListEntriesJob *ModuleSyncScheduler::retrieve(const Akonadi::Collection &collection, ModuleHandler *handler)
+{
+    Q_ASSERT(!d->mClaimedJob);
+
+    int index = d->indexOf(handler->moduleName());
+    if (index == -1) {
+        d->addEntry(d->createJob(collection, handler));
+        index = d->indexOf(handler->moduleName());
+    }
+
+    ListEntriesJob *job = d->mEntries.at(index).job;
+    d->mClaimedJob = job;
+    // Replay from the event loop, the caller needs to know about the job first
+    d->mReplayPending = true;
+    QTimer::singleShot(0, this, SLOT(replayClaimedJob()));
+    d->startJobs();
+    return job;
+}
+
+void ModuleSyncScheduler::discardListing(ModuleHandler *handler)
+{
+    const QString module = handler->moduleName();
+    for (int i = d->mEntries.count() - 1; i >= 0; --i) {
+        const Private::Entry &entry = d->mEntries.at(i);
+        if (entry.job == d->mClaimedJob)
+            continue;
+        const QString entryModule = entry.job->module()->moduleName();
+        // Modules waiting for this one can't be listed before it, drop them too
+        if (entryModule == module || (!entry.started && mustBeListedAfter(entryModule, module))) {
+            kDebug() << "Dropping the listing of" << entryModule << "done in advance";
+            entry.job->kill(KJob::Quietly);
+            entry.job->deleteLater();
+            d->mEntries.removeAt(i);
+        }
+    }
+    d->startJobs();
+}
+
+void ModuleSyncScheduler::clear()
+{
+    Q_FOREACH (const Private::Entry &entry, d->mEntries) {
+        entry.job->kill(KJob::Quietly);
+        entry.job->deleteLater();
+    }
+    d->mEntries.clear();
+    d->mClaimedJob = nullptr;
+    d->mUnclaimedTimer.stop();
+}
+
+#include "modulesyncscheduler.moc"
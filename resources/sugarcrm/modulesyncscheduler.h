@@ -0,0 +1,99 @@
+/*
+  This file is part of FatCRM, a desktop application for SugarCRM written by KDAB.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+  Authors: David Faure <david.faure@kdab.com>
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef MODULESYNCSCHEDULER_H
+#define MODULESYNCSCHEDULER_H
+
+#include <Akonadi/Collection>
+#include <Akonadi/Item>
+
+#include <QHash>
+#include <QObject>
+
+class KJob;
+class ListEntriesJob;
+class ModuleHandler;
+class SugarSession;
+
+/**
+ * Runs the ListEntriesJobs of several modules at the same time.
+ *
+ * The resource scheduler only asks for one folder at a time (retrieveItems()), so
+ * once a synchronization of all folders started, the other folders are listed in
+ * advance, up to a configurable number of jobs in parallel. What they receive is
+ * kept until the resource asks for their folder, and then delivered through the
+ * signals of this class, like for the folder currently being retrieved.
+ *
+ * Accounts are listed before Opportunities, which look up account ids by name
+ * in SugarAccountCache.
+ */
+class ModuleSyncScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    typedef QHash<QString, ModuleHandler *> ModuleHandlerHash;
+
+    ModuleSyncScheduler(SugarSession *session, const ModuleHandlerHash *moduleHandlers, QObject *parent = 0);
+
+    ~ModuleSyncScheduler() override;
+
+    // Maximum number of jobs running at the same time. 1 disables listing in advance.
+    void setMaximumConcurrentJobs(int count);
+    // Time after which a listing done in advance is dropped, if its folder wasn't retrieved
+    void setUnclaimedTimeout(int seconds);
+
+    // Lists all the folders of the resource in advance, the next retrieve() calls will
+    // (hopefully) find them finished already.
+    void prefetchAll(const QString &resourceIdentifier);
+
+    // Returns the job listing the given collection, which now reports to the signals of
+    // this class, replaying what it received so far. result() is emitted when it's done;
+    // the job isn't deleted automatically, call deleteLater() on it then.
+    ListEntriesJob *retrieve(const Akonadi::Collection &collection, ModuleHandler *handler);
+
+    // Drops what was listed in advance for the folder of this module, e.g. because an item was
+    // modified locally and the listing might be older than what is about to be stored on the server
+    void discardListing(ModuleHandler *handler);
+
+    // Kills all the jobs, e.g. when going offline
+    void clear();
+
+Q_SIGNALS:
+    void totalItems(int count);
+    void progress(int count);
+    void itemsReceived(const Akonadi::Item::List &items, bool isUpdateJob);
+    void result(KJob *job);
+
+private:
+    class Private;
+    Private *const d;
+
+    Q_PRIVATE_SLOT(d, void collectionsReceived(const Akonadi::Collection::List &collections))
+    Q_PRIVATE_SLOT(d, void collectionFetchResult(KJob *job))
+    Q_PRIVATE_SLOT(d, void jobTotalItems(int count))
+    Q_PRIVATE_SLOT(d, void jobProgress(int count))
+    Q_PRIVATE_SLOT(d, void jobItemsReceived(const Akonadi::Item::List &items, bool isUpdateJob))
+    Q_PRIVATE_SLOT(d, void jobResult(KJob *job))
+    Q_PRIVATE_SLOT(d, void replayClaimedJob())
+    Q_PRIVATE_SLOT(d, void dropUnclaimedJobs())
+};
+
+#endif
@@ -140,6 +140,11 @@ QStringList OpportunitiesHandler::supportedCRMFields() const
     return sugarFieldsToCrmFields(availableFields()) << KDCRMFields::accountId();
 }
 
+int OpportunitiesHandler::crmFieldIndex(const QString &crmFieldName) const
+{
+    return SugarOpportunity::fieldIndex(crmFieldName);
+}
+
 Akonadi::Item OpportunitiesHandler::itemFromEntry(const KDSoapGenerated::TNS__Entry_value &entry, const Akonadi::Collection &parentCollection)
 {
     Akonadi::Item item;
@@ -156,13 +161,18 @@ Akonadi::Item OpportunitiesHandler::itemFromEntry(const KDSoapGenerated::TNS__En
 
     SugarOpportunity opportunity;
     opportunity.setId(entry.id());
-    Q_FOREACH (const KDSoapGenerated::TNS__Name_value &namedValue, valueList) {
-        const QString crmFieldName = sugarFieldToCrmField(namedValue.name());
-        const QString value = KDCRMUtils::decodeXML(namedValue.value());
-        const SugarOpportunity::AccessorHash::const_iterator accessIt = mAccessors.constFind(crmFieldName);
+    const FieldColumns &columns = fieldColumns(valueList);
+    for (int i = 0; i < valueList.count(); ++i) {
+        const FieldColumn &column = columns.at(i);
+        const QString value = KDCRMUtils::decodeXML(valueList.at(i).value());
+        if (column.fieldIndex >= 0) {
+            opportunity.setValue(static_cast<SugarOpportunity::Field>(column.fieldIndex), value);
+            continue;
+        }
+        // date_modified isn't stored as a string, go through the accessor
+        const SugarOpportunity::AccessorHash::const_iterator accessIt = mAccessors.constFind(column.crmFieldName);
         if (accessIt == mAccessors.constEnd()) {
-            const QString customCrmFieldName = customSugarFieldToCrmField(namedValue.name());
-            opportunity.setCustomField(customCrmFieldName, value);
+            opportunity.setCustomField(column.customCrmFieldName, value);
             continue;
         }
 
@@ -38,6 +38,7 @@
 #include "listmodulesjob.h"
 #include "loginjob.h"
 #include "moduledebuginterface.h"
+#include "modulesyncscheduler.h"
 #include "noteshandler.h"
 #include "opportunitieshandler.h"
 #include "resourcedebuginterface.h"
@@ -73,6 +74,9 @@ SugarCRMResource::SugarCRMResource(const QString &id)
       mDebugInterface(new ResourceDebugInterface(this)),
       mModuleHandlers(new ModuleHandlerHash),
       mModuleDebugInterfaces(new ModuleDebugInterfaceHash),
+      mSyncScheduler(new ModuleSyncScheduler(mSession, mModuleHandlers, this)),
+      mPrefetchPending(false),
+      mCollectionTreeSyncOnly(false),
       mConflictHandler(new ConflictHandler(ConflictHandler::BackendConflict, this)),
       mOnline(false)
 {
@@ -88,7 +92,7 @@ SugarCRMResource::SugarCRMResource(const QString &id)
     ItemTransferInterface *itemDownloadInterface = new ItemTransferInterface(this);
     QDBusConnection::sessionBus().registerObject(QLatin1String("/ItemTransfer"),
             itemDownloadInterface,
-            QDBusConnection::ExportScriptableSlots);
+            QDBusConnection::ExportScriptableSlots | QDBusConnection::ExportScriptableSignals);
 
     setNeedsNetwork(true);
 #if KDE_IS_VERSION(4, 14, 0)
@@ -105,6 +109,14 @@ SugarCRMResource::SugarCRMResource(const QString &id)
                                    Settings::host());
     mSession->createSoapInterface();
 
+    connect(mSyncScheduler, SIGNAL(totalItems(int)),
+            this, SLOT(slotTotalItems(int)));
+    connect(mSyncScheduler, SIGNAL(progress(int)),
+            this, SLOT(slotProgress(int)));
+    connect(mSyncScheduler, SIGNAL(itemsReceived(Akonadi::Item::List,bool)),
+            this, SLOT(slotItemsReceived(Akonadi::Item::List,bool)));
+    connect(mSyncScheduler, SIGNAL(result(KJob*)), this, SLOT(listEntriesResult(KJob*)));
+
     connect(mConflictHandler, SIGNAL(commitChange(Akonadi::Item)),
             this, SLOT(commitChange(Akonadi::Item)));
     connect(mConflictHandler, SIGNAL(updateOnBackend(Akonadi::Item)),
@@ -200,6 +212,9 @@ void SugarCRMResource::doSetOnline(bool online)
                 mCurrentJob->kill(KJob::Quietly);
                 mCurrentJob = nullptr;
             }
+            mSyncScheduler->clear();
+            mPrefetchPending = false;
+            mCollectionTreeSyncOnly = false;
             if (mLoginJob) {
                 mLoginJob->kill(KJob::Quietly);
                 mLoginJob = nullptr;
@@ -220,6 +235,7 @@ void SugarCRMResource::itemAdded(const Akonadi::Item &item, const Akonadi::Colle
     ModuleHandler *handler = mModuleHandlers->value(collection.remoteId());
     if (handler) {
         status(Running);
+        mSyncScheduler->discardListing(handler);
 
         CreateEntryJob *job = new CreateEntryJob(item, mSession, this);
         Q_ASSERT(!mCurrentJob);
@@ -254,6 +270,7 @@ void SugarCRMResource::itemChanged(const Akonadi::Item &item, const QSet<QByteAr
             return;
         }
         status(Running);
+        mSyncScheduler->discardListing(handler);
 
         updateItem(item, handler);
     } else {
@@ -278,6 +295,9 @@ void SugarCRMResource::itemRemoved(const Akonadi::Item &item)
     }
 
     status(Running);
+    if (ModuleHandler *handler = mModuleHandlers->value(collection.remoteId())) {
+        mSyncScheduler->discardListing(handler);
+    }
 
 #if 0
     const QString message = "disabled for safety reasons";
@@ -297,6 +317,12 @@ void SugarCRMResource::retrieveCollections()
 {
     status(Running, i18nc("@info:status", "Retrieving folders"));
 
+    // Prefetching is only worth it for a full synchronization, the listings would be
+    // kept unused otherwise. There's no API to know about it, but the only collection
+    // tree syncs not followed by the items are the ones we trigger after login.
+    mPrefetchPending = !mCollectionTreeSyncOnly;
+    mCollectionTreeSyncOnly = false;
+
     SugarJob *job = new ListModulesJob(mSession, this);
     Q_ASSERT(!mCurrentJob);
     mCurrentJob = job;
@@ -318,9 +344,16 @@ void SugarCRMResource::retrieveItems(const Akonadi::Collection &collection)
         // getting items in batches
         setItemStreamingEnabled(true);
 
-        ListEntriesJob *job = new ListEntriesJob(collection, mSession, this);
-        job->setModule(handler);
-        job->setLatestTimestamp(ListEntriesJob::latestTimestamp(collection, handler));
+        mSyncScheduler->setMaximumConcurrentJobs(Settings::concurrentModuleSyncs());
+        mSyncScheduler->setUnclaimedTimeout(Settings::unclaimedListingTimeout());
+        if (mPrefetchPending) {
+            // Most likely all folders are going to be synchronized, one after the other.
+            // List the other ones meanwhile.
+            mPrefetchPending = false;
+            mSyncScheduler->prefetchAll(identifier());
+        }
+
+        ListEntriesJob *job = mSyncScheduler->retrieve(collection, handler);
         Q_ASSERT(!mCurrentJob);
         mCurrentJob = job;
 
@@ -329,15 +362,6 @@ void SugarCRMResource::retrieveItems(const Akonadi::Collection &collection)
                 : i18nc("@info:status", "Retrieving contents of folder %1", collection.name());
         kDebug() << message;
         status(Running, message);
-
-        connect(job, SIGNAL(totalItems(int)),
-                this, SLOT(slotTotalItems(int)));
-        connect(job, SIGNAL(progress(int)),
-                this, SLOT(slotProgress(int)));
-        connect(job, SIGNAL(itemsReceived(Akonadi::Item::List,bool)),
-                this, SLOT(slotItemsReceived(Akonadi::Item::List,bool)));
-        connect(job, SIGNAL(result(KJob*)), this, SLOT(listEntriesResult(KJob*)));
-        job->start();
     } else {
         kDebug() << "No module handler for collection" << collection;
         kDebug() << mModuleHandlers->keys();
@@ -412,6 +436,8 @@ void SugarCRMResource::explicitLoginResult(KJob *job)
 
     taskDone();
     status(Idle);
+    // Not a full synchronization, the folder contents won't necessarily follow
+    mCollectionTreeSyncOnly = true;
     synchronizeCollectionTree();
 }
 
@@ -428,6 +454,7 @@ void SugarCRMResource::listModulesResult(KJob *job)
         const QString message = job->errorText();
         kWarning() << "error=" << job->error() << ":" << message;
 
+        mPrefetchPending = false;
         status(Broken, message);
         error(message);
         cancelTask(message);
@@ -500,6 +527,7 @@ void SugarCRMResource::slotItemsReceived(const Item::List &items, bool isUpdateJ
 void SugarCRMResource::listEntriesResult(KJob *job)
 {
     ListEntriesJob *listEntriesJob = static_cast<ListEntriesJob *>(job);
+    listEntriesJob->deleteLater(); // ModuleSyncScheduler disables auto-deletion
 
     Q_ASSERT(mCurrentJob == job);
     mCurrentJob = nullptr;
@@ -32,6 +32,7 @@ class KJob;
 class ResourceDebugInterface;
 class ModuleDebugInterface;
 class ModuleHandler;
+class ModuleSyncScheduler;
 class SugarSession;
 class LoginJob;
 class SugarJob;
@@ -77,6 +78,10 @@ private:
     typedef QHash<QString, ModuleDebugInterface *> ModuleDebugInterfaceHash;
     ModuleDebugInterfaceHash *mModuleDebugInterfaces;
 
+    ModuleSyncScheduler *mSyncScheduler;
+    bool mPrefetchPending; // a full synchronization listed the folders, their contents are going to follow
+    bool mCollectionTreeSyncOnly; // the next folder listing is only a collection tree sync (after login)
+
     ConflictHandler *mConflictHandler;
     int mTotalItems;
     bool mOnline;
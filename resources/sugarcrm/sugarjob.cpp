@@ -218,6 +218,11 @@ QString SugarJob::sessionId() const
     return d->mSession->sessionId();
 }
 
+SugarSession *SugarJob::session() const
+{
+    return d->mSession;
+}
+
 Sugarsoap *SugarJob::soap()
 {
     return d->mSession->soap();
@@ -64,6 +64,7 @@ protected:
     bool handleLoginError(const KDSoapMessage &fault);
 
     QString sessionId() const;
+    SugarSession *session() const;
     KDSoapGenerated::Sugarsoap *soap();
 
 private:
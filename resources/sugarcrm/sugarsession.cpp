@@ -169,6 +169,13 @@ Sugarsoap *SugarSession::soap()
     return d->mSoap;
 }
 
+Sugarsoap *SugarSession::createAdditionalSoapInterface(QObject *parent) const
+{
+    Sugarsoap *soap = new Sugarsoap(parent);
+    soap->setEndPoint(endPointFromHostString(d->mHost));
+    return soap;
+}
+
 void SugarSession::setProtocol(SugarProtocolBase *protocol)
 {
     d->mProtocol = protocol;
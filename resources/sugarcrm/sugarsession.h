@@ -68,6 +68,9 @@ public:
     SugarProtocolBase *protocol() const;
 
     KDSoapGenerated::Sugarsoap *soap();
+    // Creates another SOAP interface for the same server, for jobs which need
+    // to have several calls in flight at the same time
+    KDSoapGenerated::Sugarsoap *createAdditionalSoapInterface(QObject *parent) const;
 
 private:
     class Private;
@@ -405,8 +405,10 @@ Akonadi::Item TasksHandler::itemFromEntry( const TNS__Entry_value &entry, const
     KCalCore::Todo::Ptr todo( new KCalCore::Todo );
     todo->setUid( entry.id() );
 
-    Q_FOREACH( const TNS__Name_value &namedValue, valueList ) {
-        const QString crmFieldName = sugarFieldToCrmField(namedValue.name());
+    const FieldColumns &columns = fieldColumns( valueList );
+    for ( int i = 0; i < valueList.count(); ++i ) {
+        const TNS__Name_value &namedValue = valueList.at( i );
+        const QString &crmFieldName = columns.at( i ).crmFieldName;
         const AccessorHash::const_iterator accessIt = mAccessors->constFind(crmFieldName);
         if ( accessIt == mAccessors->constEnd() ) {
             // no accessor for field
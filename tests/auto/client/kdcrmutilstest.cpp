@@ -24,11 +24,46 @@
 
 #include <QTest>
 #include <QDebug>
+#include <QStringList>
+
+// What decodeXML used to do, as a reference for the fuzz test and the benchmarks
+static QString replaceEntities(const QString &str)
+{
+    QString decoded = str;
+    decoded.replace("&quot;", QChar('"'));
+    decoded.replace("&#039;", QChar('\''));
+    decoded.replace("&gt;", QChar('>'));
+    decoded.replace("&lt;", QChar('<'));
+    decoded.replace("&amp;", QChar('&'));
+    return decoded.trimmed();
+}
 
 class KDCRMUtilsTest : public QObject
 {
     Q_OBJECT
-public:
+private:
+    static QString randomString(const QStringList &tokens, int maxTokens)
+    {
+        QString str;
+        const int count = qrand() % maxTokens;
+        for (int i = 0; i < count; ++i) {
+            str += tokens.at(qrand() % tokens.count());
+        }
+        return str;
+    }
+
+    static QString emailDescription()
+    {
+        QString text;
+        for (int i = 0; i < 400; ++i) {
+            text += QString::fromUtf8("Hi Jörg, the \"quote\" for line %1 is attached &amp; signed.\n").arg(i);
+            if (i % 20 == 0) {
+                text += QLatin1String("&gt; On Monday, Bob &lt;bob@example.com&gt; wrote: don&#039;t forget\n");
+            }
+        }
+        return text;
+    }
+
 private Q_SLOTS:
     void testIncrementTimestamp_data()
     {
@@ -50,6 +85,134 @@ private Q_SLOTS:
         KDCRMUtils::incrementTimeStamp(str);
         QCOMPARE(str, output);
     }
+
+    void testDecodeXML_data()
+    {
+        QTest::addColumn<QString>("input");
+        QTest::addColumn<QString>("output");
+
+        QTest::newRow("empty") << "" << "";
+        QTest::newRow("plain") << "KDAB" << "KDAB";
+        QTest::newRow("trailing_spaces") << " Sweden  " << "Sweden";
+        QTest::newRow("named") << "&lt;a href=&quot;x&quot;&gt; &amp; &apos;" << "<a href=\"x\"> & '";
+        QTest::newRow("decimal") << "don&#039;t &#39;" << "don't '";
+        QTest::newRow("hex") << "&#x27;&#X41;&#xe9;" << QString::fromUtf8("'Aé");
+        QTest::newRow("non_bmp") << "&#128512;" << QString::fromUtf8("\xF0\x9F\x98\x80");
+        QTest::newRow("double_encoded") << "&amp;lt;" << "&lt;";
+        QTest::newRow("lone_ampersand") << "Smith & Sons" << "Smith & Sons";
+        QTest::newRow("unknown_entity") << "a&nbsp;b" << "a&nbsp;b";
+        QTest::newRow("truncated") << "a &am" << "a &am";
+        QTest::newRow("no_semicolon") << "&#39 &lt" << "&#39 &lt";
+        QTest::newRow("no_digits") << "&#; &#x;" << "&#; &#x;";
+        QTest::newRow("zero") << "&#0;" << "&#0;";
+        QTest::newRow("surrogate") << "&#xd800;" << "&#xd800;";
+        QTest::newRow("out_of_range") << "&#1114112;&#99999999999;" << "&#1114112;&#99999999999;";
+        QTest::newRow("encoded_spaces") << "&#32;x&#32;" << "x";
+    }
+
+    void testDecodeXML()
+    {
+        QFETCH(QString, input);
+        QFETCH(QString, output);
+
+        QCOMPARE(KDCRMUtils::decodeXML(input), output);
+    }
+
+    void testEncodeXML_data()
+    {
+        QTest::addColumn<QString>("input");
+        QTest::addColumn<QString>("output");
+
+        QTest::newRow("empty") << "" << "";
+        QTest::newRow("plain") << QString::fromUtf8("Jörg") << QString::fromUtf8("Jörg");
+        QTest::newRow("all") << "<a href=\"x\"> & 'y'" << "&lt;a href=&quot;x&quot;&gt; &amp; &#039;y&#039;";
+        QTest::newRow("entity") << "&lt;" << "&amp;lt;";
+    }
+
+    void testEncodeXML()
+    {
+        QFETCH(QString, input);
+        QFETCH(QString, output);
+
+        QCOMPARE(KDCRMUtils::encodeXML(input), output);
+    }
+
+    void fuzzXML()
+    {
+        qsrand(42);
+        // Only the entities the old implementation knew, it didn't decode numeric references
+        const QStringList namedTokens = QStringList() << "&amp;" << "&lt;" << "&gt;" << "&quot;" << "&#039;"
+                                                      << "&" << ";" << "amp" << "<" << ">"
+                                                      << "'" << "\"" << " " << QString::fromUtf8("é") << "a";
+        for (int i = 0; i < 20000; ++i) {
+            const QString str = randomString(namedTokens, 12);
+            // Same result as the old implementation
+            QCOMPARE(KDCRMUtils::decodeXML(str), replaceEntities(str));
+            // Encoding is reversible
+            QCOMPARE(KDCRMUtils::decodeXML(KDCRMUtils::encodeXML(str)), str.trimmed());
+        }
+
+        // Numeric references (see testDecodeXML for the expected results), encoding is still reversible
+        const QStringList numericTokens = namedTokens + (QStringList() << "#" << "x" << "3" << "9");
+        for (int i = 0; i < 20000; ++i) {
+            const QString str = randomString(numericTokens, 12);
+            QCOMPARE(KDCRMUtils::decodeXML(KDCRMUtils::encodeXML(str)), str.trimmed());
+        }
+    }
+
+    void benchmarkDecodeXML_data()
+    {
+        QTest::addColumn<bool>("reference");
+        QTest::addColumn<QStringList>("values");
+
+        const QString email = emailDescription();
+        const QStringList emails = QStringList() << email << email << email << email;
+        QStringList fields;
+        for (int i = 0; i < 100000; ++i) {
+            fields.append(i % 10 ? QString("Field value %1").arg(i) : QString("Smith &amp; Sons %1").arg(i));
+        }
+
+        QTest::newRow("email_descriptions_replace") << true << emails;
+        QTest::newRow("email_descriptions") << false << emails;
+        QTest::newRow("short_fields_replace") << true << fields;
+        QTest::newRow("short_fields") << false << fields;
+    }
+
+    void benchmarkDecodeXML()
+    {
+        QFETCH(bool, reference);
+        QFETCH(QStringList, values);
+        int length = 0;
+
+        QBENCHMARK {
+            length = 0;
+            Q_FOREACH (const QString &value, values) {
+                length += reference ? replaceEntities(value).length() : KDCRMUtils::decodeXML(value).length();
+            }
+        }
+
+        QVERIFY(length > 0);
+    }
+
+    void benchmarkEncodeXML_data()
+    {
+        benchmarkDecodeXML_data();
+    }
+
+    void benchmarkEncodeXML()
+    {
+        QFETCH(QStringList, values);
+        int length = 0;
+
+        QBENCHMARK {
+            length = 0;
+            Q_FOREACH (const QString &value, values) {
+                length += KDCRMUtils::encodeXML(value).length();
+            }
+        }
+
+        QVERIFY(length > 0);
+    }
 };
 
 QTEST_MAIN(KDCRMUtilsTest)
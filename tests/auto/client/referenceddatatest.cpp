@@ -27,9 +27,36 @@
 #include <QtTest/QtTestGui>
 #include <QComboBox>
 #include <QDebug>
+#include <QMap>
 #include <QAbstractProxyModel>
 #include <QSignalSpy>
 
+// Records the contents of the model after each insertion
+class InsertionRecorder : public QObject
+{
+    Q_OBJECT
+public:
+    explicit InsertionRecorder(QAbstractItemModel *model)
+        : mModel(model)
+    {
+        connect(model, SIGNAL(rowsInserted(QModelIndex,int,int)), this, SLOT(slotRowsInserted()));
+    }
+
+    QStringList texts;
+
+private Q_SLOTS:
+    void slotRowsInserted()
+    {
+        QStringList rowTexts;
+        for (int i = 0 ; i < mModel->rowCount() ; ++i )
+            rowTexts.append(mModel->index(i, 0).data().toString());
+        texts.append(rowTexts.join(","));
+    }
+
+private:
+    QAbstractItemModel *mModel;
+};
+
 class ReferencedDataTest : public QObject
 {
     Q_OBJECT
@@ -90,6 +117,84 @@ private Q_SLOTS:
                  << "Adam Faure" << "Charles Faure" << "David Faure" << "Ernest Faure" << "Sabine Faure");
     }
 
+    void testAddMapMerge()
+    {
+        // GIVEN
+        ReferencedData *data = ReferencedData::instance(AccountRef);
+        data->clear();
+        QMap<QString, QString> initial;
+        initial.insert("b", "Account B");
+        initial.insert("d", "Account D");
+        initial.insert("f", "Account F");
+        data->addMap(initial, true);
+        ReferencedDataModel model(AccountRef);
+        QSignalSpy spyRowsATBI(&model, SIGNAL(rowsAboutToBeInserted(QModelIndex,int,int)));
+        QSignalSpy spyDataChanged(&model, SIGNAL(dataChanged(QModelIndex,QModelIndex)));
+        // check that the model is consistent after each insertion
+        InsertionRecorder recorder(&model);
+
+        // WHEN
+        QMap<QString, QString> batch;
+        batch.insert("a", "Account A");
+        batch.insert("c", "Account C");
+        batch.insert("d", "Account D2"); // renamed
+        batch.insert("e", "Account E");
+        batch.insert("g", "Account G");
+        batch.insert("h", "Account H");
+        data->addMap(batch, true);
+
+        // THEN
+        QCOMPARE(data->count(), 8);
+        QCOMPARE(modelTexts(&model), QStringList() << QString() << "Account A" << "Account B" << "Account C" << "Account D2"
+                 << "Account E" << "Account F" << "Account G" << "Account H");
+        // one insertion per run of new rows: a, c, e, g+h
+        QCOMPARE(spyRowsATBI.count(), 4);
+        QCOMPARE(spyRowsATBI.at(3).at(1).toInt(), 7); // +1 for the empty item at the top
+        QCOMPARE(spyRowsATBI.at(3).at(2).toInt(), 8);
+        QCOMPARE(recorder.texts, QStringList()
+                 << ",Account A,Account B,Account D,Account F"
+                 << ",Account A,Account B,Account C,Account D,Account F"
+                 << ",Account A,Account B,Account C,Account D,Account E,Account F"
+                 << ",Account A,Account B,Account C,Account D,Account E,Account F,Account G,Account H");
+        QCOMPARE(spyDataChanged.count(), 1);
+        QCOMPARE(spyDataChanged.at(0).at(0).value<QModelIndex>().row(), 4);
+        QCOMPARE(data->referencedData("d"), QString("Account D2"));
+        data->clear();
+    }
+
+    void benchmarkAddMap()
+    {
+        // GIVEN 50k accounts, arriving in batches of 100 like in AccountsPage::handleNewRows
+        static const int s_count = 50000;
+        static const int s_batchSize = 100;
+        QVector<QMap<QString, QString> > batches;
+        batches.reserve(s_count / s_batchSize);
+        qsrand(42);
+        for (int i = 0; i < s_count; ++i) {
+            if (i % s_batchSize == 0) {
+                batches.append(QMap<QString, QString>());
+            }
+            // ids are random, so every batch spreads over the whole data
+            const QString id = QString::number(qrand(), 16) + '-' + QString::number(i);
+            batches.last().insert(id, QString("Account %1").arg(i));
+        }
+        ReferencedData *data = ReferencedData::instance(AccountRef);
+        ReferencedDataModel model(AccountRef);
+
+        // WHEN
+        QBENCHMARK {
+            data->clear();
+            foreach (const QMap<QString, QString> &batch, batches) {
+                data->addMap(batch, true);
+            }
+        }
+
+        // THEN
+        QCOMPARE(data->count(), s_count);
+        QCOMPARE(model.rowCount(), s_count + 1);
+        data->clear();
+    }
+
 private:
     static QStringList comboTexts(QComboBox *combo) {
         QStringList items;
@@ -47,6 +47,9 @@ private:
             case AccountRepository::Field::Name:
                 str += "name";
             break;
+            case AccountRepository::Field::Address:
+                str += "address";
+            break;
             }
         }
         return str;
@@ -163,6 +166,67 @@ private Q_SLOTS:
     }
 
 
+    void shouldReindexRenamedAccount()
+    {
+        //GIVEN
+        AccountRepository *repository = AccountRepository::instance();
+        repository->clear();
+        SugarAccount account;
+        account.setId("1");
+        account.setName("KDAB");
+        account.setBillingAddressCountry("FR");
+        repository->addAccount(account, 1);
+        const QString oldKey = account.key();
+        //WHEN
+        account.setName("Klaralvdalens Datakonsult");
+        account.setBillingAddressCountry("SE");
+        repository->modifyAccount(account);
+        //THEN
+        QVERIFY(repository->accountsByKey(oldKey).isEmpty());
+        QCOMPARE(repository->accountsByKey(account.key()).size(), 1);
+        SugarAccount oldNamed;
+        oldNamed.setName("KDAB");
+        QVERIFY(repository->similarAccounts(oldNamed).isEmpty());
+        QCOMPARE(repository->similarAccounts(account).size(), 1);
+        QCOMPARE(repository->countries(), QStringList() << "SE");
+        QCOMPARE(repository->accountById("1").name(), QString("Klaralvdalens Datakonsult"));
+    }
+
+    void shouldRemoveOnlyTheGivenAccountFromIndexes()
+    {
+        //GIVEN two accounts with the same name
+        AccountRepository *repository = AccountRepository::instance();
+        repository->clear();
+        SugarAccount account1;
+        account1.setId("1");
+        account1.setName("KDAB");
+        account1.setBillingAddressCountry("FR");
+        repository->addAccount(account1, 1);
+        SugarAccount account2;
+        account2.setId("2");
+        account2.setName("KDAB");
+        account2.setBillingAddressCountry("DE");
+        repository->addAccount(account2, 2);
+        QCOMPARE(repository->similarAccounts(account1).size(), 2);
+        //WHEN
+        repository->removeAccount(account1);
+        //THEN
+        const QList<SugarAccount> similar = repository->similarAccounts(account1);
+        QCOMPARE(similar.size(), 1);
+        QCOMPARE(similar.at(0).id(), QString("2"));
+        QCOMPARE(repository->countries(), QStringList() << "DE");
+        //WHEN the freed slot is reused
+        SugarAccount account3;
+        account3.setId("3");
+        account3.setName("ACME");
+        repository->addAccount(account3, 3);
+        //THEN
+        QCOMPARE(repository->accountById("3").name(), QString("ACME"));
+        QCOMPARE(repository->accountById("2").name(), QString("KDAB"));
+        QVERIFY(!repository->hasId("1"));
+    }
+
+
     void findCorrectWhatWasChanged_data()
     {
         QTest::addColumn<SugarAccount>("originalAccount");
@@ -204,6 +268,17 @@ private Q_SLOTS:
         QTest::newRow("Name_billing_shipping_modification") << createAccount("KDAB", "D", "D")
                                                             << createAccount("KDAB_france", "FR", "FR")
                                                             << QVector<Field>{Field::Name,Field::Country};
+
+        SugarAccount movedAccount = createAccount("KDAB", "D", "D");
+        movedAccount.setBillingAddressCity("Berlin");
+        QTest::newRow("billing_city_modification") << createAccount("KDAB", "D", "D")
+                                                   << movedAccount
+                                                   << QVector<Field>{Field::Address};
+        movedAccount = createAccount("KDAB", "D", "D");
+        movedAccount.setShippingAddressPostalcode("10115");
+        QTest::newRow("shipping_postalcode_modification") << createAccount("KDAB", "D", "D")
+                                                          << movedAccount
+                                                          << QVector<Field>{Field::Address};
     }
 
     void findCorrectWhatWasChanged()
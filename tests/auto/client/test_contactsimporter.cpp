@@ -23,6 +23,7 @@
 #include "contactsimporter.h"
 #include "accountrepository.h"
 
+#include <QElapsedTimer>
 #include <QTest>
 #include <QTemporaryFile>
 
@@ -125,6 +126,43 @@ private Q_SLOTS:
         QCOMPARE(account.billingAddressState(), QString());
     }
 
+    void testLargeImport()
+    {
+        // A trade-show export: 20000 contacts from 2000 companies, each company in two cities
+        const int companies = 2000;
+        const int rows = 20000;
+        QByteArray csv;
+        for (int row = 0; row < rows; ++row) {
+            const int company = row % companies;
+            const QByteArray city = (row / companies) % 2 ? "Berlin" : "Hagfors";
+            const QByteArray suffix = (row / companies) % 3 ? "" : " Inc.";
+            csv += "First" + QByteArray::number(row) + ",Last,Mr,12345,contact" + QByteArray::number(row) + "@example.com,"
+                    "Company " + QByteArray::number(company) + suffix + ",Street," + city + ",12345,,Germany,\n";
+        }
+        ContactsImporter importer;
+        QTemporaryFile file;
+        writeTempFile(file, csv);
+
+        QElapsedTimer timer;
+        timer.start();
+        QVERIFY(importer.importFile(file.fileName()));
+        const qint64 elapsed = timer.elapsed();
+
+        const QVector<ContactsSet> contacts = importer.contacts();
+        QCOMPARE(contacts.count(), companies * 2);
+        int addressees = 0;
+        foreach (const ContactsSet &contactsSet, contacts) {
+            QCOMPARE(contactsSet.addressees.count(), rows / companies / 2);
+            addressees += contactsSet.addressees.count();
+        }
+        QCOMPARE(addressees, rows);
+        QCOMPARE(contacts.at(0).account.name(), QString("Company 0 Inc."));
+        QCOMPARE(contacts.at(0).addressees.at(1).preferredEmail(), QString("contact4000@example.com"));
+        // Comparing each row with every account found so far took minutes
+        qDebug() << "imported" << rows << "rows in" << elapsed << "ms";
+        QVERIFY2(elapsed < 10000, qPrintable(QString::number(elapsed)));
+    }
+
 private:
     void writeTempFile(QTemporaryFile &file, const QByteArray& data) {
         QVERIFY(file.open());
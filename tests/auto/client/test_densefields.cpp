@@ -0,0 +1,355 @@
+/*
+  This file is part of FatCRM, a desktop application for SugarCRM written by KDAB.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+  Authors: David Faure <david.faure@kdab.com>
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "kdcrmfields.h"
+#include "sugaraccount.h"
+#include "sugaraccountio.h"
+#include "sugarlead.h"
+#include "sugaropportunity.h"
+
+#include <QBuffer>
+#include <QTest>
+#include <QXmlStreamReader>
+#include <QXmlStreamWriter>
+
+// What SugarAccountIO::writeSugarAccount did before the index-based storage,
+// as a reference for the XML tests
+static void writeAccountWithAccessors(const SugarAccount &account, QIODevice *device)
+{
+    QXmlStreamWriter writer(device);
+    writer.setAutoFormatting(true);
+    writer.writeStartDocument();
+    writer.writeDTD("<!DOCTYPE sugarAccount>");
+    writer.writeStartElement("sugarAccount");
+    writer.writeAttribute("version", "1.0");
+
+    const SugarAccount::AccessorHash accessors = SugarAccount::accessorHash();
+    SugarAccount::AccessorHash::const_iterator it    = accessors.constBegin();
+    SugarAccount::AccessorHash::const_iterator endIt = accessors.constEnd();
+    for (; it != endIt; ++it) {
+        const SugarAccount::valueGetter getter = (*it).getter;
+        writer.writeTextElement(it.key(), (account.*getter)());
+    }
+
+    // plus custom fields
+    QMap<QString, QString> customFields = account.customFields();
+    QMap<QString, QString>::const_iterator cit = customFields.constBegin();
+    const QMap<QString, QString>::const_iterator end = customFields.constEnd();
+    for ( ; cit != end ; ++cit ) {
+        writer.writeTextElement(cit.key(), cit.value());
+    }
+
+    writer.writeEndDocument();
+}
+
+// What SugarAccountIO::readSugarAccount did before the index-based storage
+static bool readAccountWithAccessors(QIODevice *device, SugarAccount &account)
+{
+    account = SugarAccount();
+    QXmlStreamReader xml(device);
+    if (!xml.readNextStartElement() || xml.name() != "sugarAccount") {
+        return false;
+    }
+    const SugarAccount::AccessorHash accessors = SugarAccount::accessorHash();
+    while (xml.readNextStartElement()) {
+        const QString key = xml.name().toString();
+        const QString value = xml.readElementText();
+        const SugarAccount::AccessorHash::const_iterator accessIt = accessors.constFind(key);
+        if (accessIt != accessors.constEnd()) {
+            (account.*(accessIt.value().setter))(value);
+        } else {
+            account.setCustomField(key, value);
+        }
+    }
+    return !xml.error();
+}
+
+// Checks the index-based field storage of the Sugar* value classes,
+// and compares it with the name-based accessors
+class TestDenseFields : public QObject
+{
+    Q_OBJECT
+private:
+    // What itemFromEntry receives from SugarCRM
+    static QList<QPair<QString, QString> > createEntry(int number)
+    {
+        QList<QPair<QString, QString> > entry;
+        for (int i = 0; i < SugarAccount::FieldCount; ++i) {
+            const QString name = SugarAccount::fieldName(static_cast<SugarAccount::Field>(i));
+            entry.append(qMakePair(name, name + QString::number(number)));
+        }
+        entry.append(qMakePair(QString("vismaid_c"), QString::number(number)));
+        return entry;
+    }
+
+    static SugarAccount createAccount(int number)
+    {
+        SugarAccount account;
+        for (int i = 0; i < SugarAccount::FieldCount; ++i) {
+            const SugarAccount::Field field = static_cast<SugarAccount::Field>(i);
+            account.setValue(field, SugarAccount::fieldName(field) + QString::number(number));
+        }
+        account.setCustomField("vismaid_c", QString::number(number));
+        return account;
+    }
+
+    static QStringList elementNames(const QByteArray &xmlData)
+    {
+        QStringList names;
+        QXmlStreamReader xml(xmlData);
+        xml.readNextStartElement();
+        while (xml.readNextStartElement()) {
+            names.append(xml.name().toString());
+            xml.skipCurrentElement();
+        }
+        names.sort();
+        return names;
+    }
+
+    static const int s_benchmarkCount = 20000;
+
+private Q_SLOTS:
+
+    void shouldMapEveryAccessorToAField()
+    {
+        const QStringList accountFields = SugarAccount::accessorHash().keys();
+        Q_FOREACH (const QString &name, accountFields) {
+            const int index = SugarAccount::fieldIndex(name);
+            QVERIFY2(index >= 0, qPrintable(name));
+            QCOMPARE(SugarAccount::fieldName(static_cast<SugarAccount::Field>(index)), name);
+        }
+        QCOMPARE(accountFields.count(), int(SugarAccount::FieldCount));
+
+        const QStringList leadFields = SugarLead::accessorHash().keys();
+        Q_FOREACH (const QString &name, leadFields) {
+            QVERIFY2(SugarLead::fieldIndex(name) >= 0, qPrintable(name));
+        }
+        QCOMPARE(leadFields.count(), int(SugarLead::FieldCount));
+
+        // date_modified is stored as a QDateTime in opportunities
+        const QStringList opportunityFields = SugarOpportunity::accessorHash().keys();
+        Q_FOREACH (const QString &name, opportunityFields) {
+            if (name != KDCRMFields::dateModified()) {
+                QVERIFY2(SugarOpportunity::fieldIndex(name) >= 0, qPrintable(name));
+            }
+        }
+        QCOMPARE(SugarOpportunity::fieldIndex(KDCRMFields::dateModified()), -1);
+        QCOMPARE(opportunityFields.count(), int(SugarOpportunity::FieldCount) + 1);
+
+        QCOMPARE(SugarAccount::fieldIndex("vismaid_c"), -1);
+    }
+
+    void shouldShareStorageWithAccessors()
+    {
+        //GIVEN
+        SugarAccount account;
+        SugarOpportunity opportunity;
+
+        //WHEN
+        account.setValue(SugarAccount::Name, "KDAB");
+        account.setBillingAddressCity("Hagfors");
+        opportunity.setValue(SugarOpportunity::AccountName, "KDAB");
+        opportunity.setDateModifiedRaw("2017-03-01 10:00:00");
+
+        //THEN
+        QCOMPARE(account.name(), QString("KDAB"));
+        QCOMPARE(account.value(SugarAccount::BillingAddressCity), QString("Hagfors"));
+        QCOMPARE(opportunity.tempAccountName(), QString("KDAB"));
+        QCOMPARE(opportunity.data().value(KDCRMFields::dateModified()), QString("2017-03-01 10:00:00"));
+        QVERIFY(!account.isEmpty());
+    }
+
+    void shouldSetDataByName()
+    {
+        //GIVEN
+        SugarAccount account;
+        QMap<QString, QString> data;
+        data.insert(KDCRMFields::name(), "KDAB");
+        data.insert(KDCRMFields::industry(), "Software");
+        data.insert("vismaid_c", "42");
+
+        //WHEN
+        account.setData(data);
+
+        //THEN
+        QCOMPARE(account.value(SugarAccount::Name), QString("KDAB"));
+        QCOMPARE(account.industry(), QString("Software"));
+        QCOMPARE(account.customFields().value("vismaid_c"), QString("42"));
+        const QMap<QString, QString> result = account.data();
+        QCOMPARE(result.count(), int(SugarAccount::FieldCount) + 1);
+        QCOMPARE(result.value(KDCRMFields::industry()), QString("Software"));
+    }
+
+    void shouldKeepXmlFormat()
+    {
+        //GIVEN
+        const SugarAccount account = createAccount(1);
+        SugarAccountIO io;
+
+        //WHEN
+        QByteArray before;
+        QBuffer beforeBuffer(&before);
+        beforeBuffer.open(QIODevice::ReadWrite);
+        writeAccountWithAccessors(account, &beforeBuffer);
+        QByteArray after;
+        QBuffer afterBuffer(&after);
+        afterBuffer.open(QIODevice::ReadWrite);
+        QVERIFY(io.writeSugarAccount(account, &afterBuffer));
+
+        //THEN the same elements are written (the order used to be the hash order)
+        QCOMPARE(elementNames(after), elementNames(before));
+
+        //THEN each version reads what the other one wrote
+        beforeBuffer.seek(0);
+        SugarAccount readBefore;
+        QVERIFY(io.readSugarAccount(&beforeBuffer, readBefore));
+        QCOMPARE(readBefore.data(), account.data());
+        QCOMPARE(readBefore.customFields(), account.customFields());
+        afterBuffer.seek(0);
+        SugarAccount readAfter;
+        QVERIFY(readAccountWithAccessors(&afterBuffer, readAfter));
+        QCOMPARE(readAfter.data(), account.data());
+        QCOMPARE(readAfter.customFields(), account.customFields());
+    }
+
+    void benchmarkItemFromEntry_data()
+    {
+        QTest::addColumn<bool>("indexed");
+
+        QTest::newRow("accessors") << false;
+        QTest::newRow("indexed") << true;
+    }
+
+    // The loop in AccountsHandler::itemFromEntry, before and after
+    void benchmarkItemFromEntry()
+    {
+        QFETCH(bool, indexed);
+        QList<QList<QPair<QString, QString> > > entries;
+        for (int i = 0; i < s_benchmarkCount; ++i) {
+            entries.append(createEntry(i));
+        }
+        const SugarAccount::AccessorHash accessors = SugarAccount::accessorHash();
+        QList<SugarAccount> accounts;
+
+        QBENCHMARK_ONCE {
+            Q_FOREACH (const auto &entry, entries) {
+                SugarAccount account;
+                for (int i = 0; i < entry.count(); ++i) {
+                    const QString &name = entry.at(i).first;
+                    const QString &value = entry.at(i).second;
+                    if (indexed) {
+                        const int index = SugarAccount::fieldIndex(name);
+                        if (index >= 0) {
+                            account.setValue(static_cast<SugarAccount::Field>(index), value);
+                        } else {
+                            account.setCustomField(name, value);
+                        }
+                    } else {
+                        const SugarAccount::AccessorHash::const_iterator accessIt = accessors.constFind(name);
+                        if (accessIt != accessors.constEnd()) {
+                            (account.*(accessIt.value().setter))(value);
+                        } else {
+                            account.setCustomField(name, value);
+                        }
+                    }
+                }
+                accounts.append(account);
+            }
+        }
+
+        QCOMPARE(accounts.count(), s_benchmarkCount);
+        QCOMPARE(accounts.last().customFields().value("vismaid_c"), QString::number(s_benchmarkCount - 1));
+    }
+
+    void benchmarkData_data()
+    {
+        benchmarkItemFromEntry_data();
+    }
+
+    // data() is called for every row by the client's models and details widgets
+    void benchmarkData()
+    {
+        QFETCH(bool, indexed);
+        SugarAccount account;
+        for (int i = 0; i < SugarAccount::FieldCount; ++i) {
+            account.setValue(static_cast<SugarAccount::Field>(i), QString::number(i));
+        }
+        const SugarAccount::AccessorHash accessors = SugarAccount::accessorHash();
+        int count = 0;
+
+        QBENCHMARK {
+            QMap<QString, QString> data;
+            if (indexed) {
+                data = account.data();
+            } else {
+                SugarAccount::AccessorHash::const_iterator it = accessors.constBegin();
+                for (; it != accessors.constEnd(); ++it) {
+                    data.insert(it.key(), (account.*(it.value().getter))());
+                }
+            }
+            count = data.count();
+        }
+
+        QCOMPARE(count, int(SugarAccount::FieldCount));
+    }
+
+    void benchmarkXmlRoundTrip_data()
+    {
+        benchmarkItemFromEntry_data();
+    }
+
+    // SugarAccountIO, before (through the accessor hash) and after
+    void benchmarkXmlRoundTrip()
+    {
+        QFETCH(bool, indexed);
+        QList<SugarAccount> accounts;
+        for (int i = 0; i < s_benchmarkCount; ++i) {
+            accounts.append(createAccount(i));
+        }
+        SugarAccountIO io;
+        int decoded = 0;
+
+        QBENCHMARK_ONCE {
+            Q_FOREACH (const SugarAccount &account, accounts) {
+                QByteArray payload;
+                QBuffer buffer(&payload);
+                buffer.open(QIODevice::ReadWrite);
+                SugarAccount result;
+                bool ok;
+                if (indexed) {
+                    io.writeSugarAccount(account, &buffer);
+                    buffer.seek(0);
+                    ok = io.readSugarAccount(&buffer, result);
+                } else {
+                    writeAccountWithAccessors(account, &buffer);
+                    buffer.seek(0);
+                    ok = readAccountWithAccessors(&buffer, result);
+                }
+                if (ok && result.name() == account.name())
+                    ++decoded;
+            }
+        }
+
+        QCOMPARE(decoded, s_benchmarkCount);
+    }
+};
+
+QTEST_MAIN(TestDenseFields)
+#include "test_densefields.moc"
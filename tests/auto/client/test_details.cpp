@@ -0,0 +1,141 @@
+/*
+  This file is part of FatCRM, a desktop application for SugarCRM written by KDAB.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+  Authors: David Faure <david.faure@kdab.com>
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <QTest>
+#include <QCheckBox>
+#include <QLineEdit>
+#include <QSignalSpy>
+#include <QVBoxLayout>
+
+#include "details.h"
+#include "kdcrmfields.h"
+
+class TestDetails : public Details
+{
+public:
+    TestDetails()
+        : Details(Account)
+    {
+        QVBoxLayout *layout = new QVBoxLayout(this);
+        addLineEdit(layout, KDCRMFields::name());
+        addLineEdit(layout, KDCRMFields::billingAddressCity());
+        addLineEdit(layout, "unsupported_field");
+        QCheckBox *checkBox = new QCheckBox(this);
+        checkBox->setObjectName(KDCRMFields::doNotCall());
+        layout->addWidget(checkBox);
+    }
+
+    QMap<QString, QString> data(const Akonadi::Item &) const override { return QMap<QString, QString>(); }
+    void updateItem(Akonadi::Item &, const QMap<QString, QString> &) const override {}
+    ItemDataExtractor *itemDataExtractor() const override { return nullptr; }
+
+private:
+    void addLineEdit(QVBoxLayout *layout, const QString &name)
+    {
+        QLineEdit *lineEdit = new QLineEdit(this);
+        lineEdit->setObjectName(name);
+        layout->addWidget(lineEdit);
+    }
+};
+
+class TestDetailsBindings : public QObject
+{
+    Q_OBJECT
+
+private:
+    static QMap<QString, QString> accountData()
+    {
+        QMap<QString, QString> data;
+        data.insert(KDCRMFields::id(), "42");
+        data.insert(KDCRMFields::name(), "KDAB");
+        data.insert(KDCRMFields::billingAddressCity(), "Hagfors");
+        data.insert(KDCRMFields::doNotCall(), "1");
+        data.insert("unsupported_field", "ignored");
+        return data;
+    }
+
+    static QStringList supportedFields()
+    {
+        return QStringList() << KDCRMFields::id() << KDCRMFields::name() << KDCRMFields::billingAddressCity() << KDCRMFields::doNotCall();
+    }
+
+private Q_SLOTS:
+
+    void shouldRoundTripSupportedFields()
+    {
+        //GIVEN
+        TestDetails details;
+        QWidget createdModifiedContainer;
+        details.setSupportedFields(supportedFields());
+        //WHEN
+        details.setData(accountData(), &createdModifiedContainer);
+        const QMap<QString, QString> data = details.getData();
+        //THEN
+        QCOMPARE(data.value(KDCRMFields::id()), QString("42"));
+        QCOMPARE(data.value(KDCRMFields::name()), QString("KDAB"));
+        QCOMPARE(data.value(KDCRMFields::billingAddressCity()), QString("Hagfors"));
+        QCOMPARE(data.value(KDCRMFields::doNotCall()), QString("1"));
+        QVERIFY(!data.contains("unsupported_field"));
+        QVERIFY(details.findChild<QLineEdit *>("unsupported_field")->isHidden());
+        QCOMPARE(details.name(), QString("KDAB"));
+    }
+
+    void shouldOnlyUpdateChangedWidgets()
+    {
+        //GIVEN
+        TestDetails details;
+        QWidget createdModifiedContainer;
+        details.setSupportedFields(supportedFields());
+        QMap<QString, QString> data = accountData();
+        details.setData(data, &createdModifiedContainer);
+        QCoreApplication::processEvents(); // connects to the widgets
+        QSignalSpy spy(&details, SIGNAL(modified()));
+        //WHEN
+        details.setData(data, &createdModifiedContainer);
+        //THEN
+        QCOMPARE(spy.count(), 0);
+        //WHEN
+        data.insert(KDCRMFields::billingAddressCity(), "Berlin");
+        details.setData(data, &createdModifiedContainer);
+        //THEN
+        QCOMPARE(spy.count(), 1);
+        QCOMPARE(details.getData().value(KDCRMFields::billingAddressCity()), QString("Berlin"));
+    }
+
+    void shouldClearStoredProperties()
+    {
+        //GIVEN
+        TestDetails details;
+        QWidget createdModifiedContainer;
+        details.setSupportedFields(supportedFields());
+        details.setData(accountData(), &createdModifiedContainer);
+        //WHEN
+        details.clear();
+        //THEN
+        const QMap<QString, QString> data = details.getData();
+        QVERIFY(!data.contains(KDCRMFields::id()));
+        QCOMPARE(data.value(KDCRMFields::name()), QString());
+        QCOMPARE(data.value(KDCRMFields::doNotCall()), QString("0"));
+    }
+};
+
+QTEST_MAIN(TestDetailsBindings)
+
+#include "test_details.moc"
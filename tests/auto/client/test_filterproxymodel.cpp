@@ -0,0 +1,212 @@
+/*
+  This file is part of FatCRM, a desktop application for SugarCRM written by KDAB.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+  Authors: David Faure <david.faure@kdab.com>
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <QTest>
+#include <QStandardItemModel>
+
+#include "accountrepository.h"
+#include "filterproxymodel.h"
+#include "opportunityfilterproxymodel.h"
+#include "referenceddata.h"
+#include "sugaraccount.h"
+#include "sugaropportunity.h"
+
+#include <Akonadi/EntityTreeModel>
+#include <Akonadi/Item>
+
+class TestFilterProxyModel : public QObject
+{
+    Q_OBJECT
+
+private:
+    static void setAccount(QStandardItem *standardItem, Akonadi::Item::Id id, const QString &name, const QString &city)
+    {
+        SugarAccount account;
+        account.setId(QString::number(id));
+        account.setName(name);
+        account.setBillingAddressCity(city);
+        Akonadi::Item item(id);
+        item.setMimeType(SugarAccount::mimeType());
+        item.setPayload<SugarAccount>(account);
+        standardItem->setData(name, Qt::DisplayRole);
+        standardItem->setData(id, Akonadi::EntityTreeModel::ItemIdRole);
+        standardItem->setData(QVariant::fromValue(item), Akonadi::EntityTreeModel::ItemRole);
+    }
+
+    static void setOpportunity(QStandardItem *standardItem, Akonadi::Item::Id id, const QString &name, const QString &accountId)
+    {
+        SugarOpportunity opportunity;
+        opportunity.setId(QString::number(id));
+        opportunity.setName(name);
+        opportunity.setAccountId(accountId);
+        Akonadi::Item item(id);
+        item.setMimeType(SugarOpportunity::mimeType());
+        item.setPayload<SugarOpportunity>(opportunity);
+        standardItem->setData(name, Qt::DisplayRole);
+        standardItem->setData(id, Akonadi::EntityTreeModel::ItemIdRole);
+        standardItem->setData(QVariant::fromValue(item), Akonadi::EntityTreeModel::ItemRole);
+    }
+
+    // What AccountsPage does when an account is loaded or renamed
+    static void loadAccount(Akonadi::Item::Id id, const QString &accountId, const QString &name)
+    {
+        SugarAccount account;
+        account.setId(accountId);
+        account.setName(name);
+        if (AccountRepository::instance()->hasId(accountId)) {
+            AccountRepository::instance()->modifyAccount(account);
+        } else {
+            AccountRepository::instance()->addAccount(account, id);
+        }
+        ReferencedData::instance(AccountRef)->setReferencedData(accountId, name);
+    }
+
+    static QStringList shownNames(const QAbstractItemModel &model)
+    {
+        QStringList names;
+        for (int row = 0; row < model.rowCount(); ++row) {
+            names.append(model.index(row, 0).data().toString());
+        }
+        names.sort();
+        return names;
+    }
+
+    QStandardItemModel *createSourceModel()
+    {
+        QStandardItemModel *model = new QStandardItemModel(this);
+        const char *names[] = { "KDAB", "Kdab Deutschland", "ACME", "Brussels Sprouts" };
+        const char *cities[] = { "Hagfors", "Berlin", "Paris", "Brussels" };
+        for (int i = 0; i < 4; ++i) {
+            QStandardItem *standardItem = new QStandardItem;
+            setAccount(standardItem, i + 1, QString::fromLatin1(names[i]), QString::fromLatin1(cities[i]));
+            model->appendRow(standardItem);
+        }
+        return model;
+    }
+
+private Q_SLOTS:
+
+    void shouldFilterCaseInsensitivelyOnAnyField()
+    {
+        //GIVEN
+        FilterProxyModel proxy(Account);
+        proxy.setSourceModel(createSourceModel());
+        //WHEN
+        proxy.setFilterString("kdab");
+        //THEN
+        QCOMPARE(shownNames(proxy), QStringList() << "KDAB" << "Kdab Deutschland");
+        //WHEN
+        proxy.setFilterString("BRUSSELS");
+        //THEN
+        QCOMPARE(shownNames(proxy), QStringList() << "Brussels Sprouts");
+        //WHEN
+        proxy.setFilterString("PARIS");
+        //THEN (matched on the city)
+        QCOMPARE(shownNames(proxy), QStringList() << "ACME");
+    }
+
+    void shouldRefineAndWidenFilter()
+    {
+        //GIVEN
+        FilterProxyModel proxy(Account);
+        proxy.setSourceModel(createSourceModel());
+        proxy.setFilterString("k");
+        QCOMPARE(shownNames(proxy), QStringList() << "KDAB" << "Kdab Deutschland");
+        //WHEN
+        proxy.setFilterString("kdab d");
+        //THEN
+        QCOMPARE(shownNames(proxy), QStringList() << "Kdab Deutschland");
+        //WHEN the filter is shortened again
+        proxy.setFilterString("kdab");
+        //THEN
+        QCOMPARE(shownNames(proxy), QStringList() << "KDAB" << "Kdab Deutschland");
+        //WHEN
+        proxy.setFilterString(QString());
+        //THEN
+        QCOMPARE(proxy.rowCount(), 4);
+    }
+
+    void shouldUpdateIndexWhenItemChanges()
+    {
+        //GIVEN
+        FilterProxyModel proxy(Account);
+        QStandardItemModel *model = createSourceModel();
+        proxy.setSourceModel(model);
+        proxy.setFilterString("kd");
+        QCOMPARE(proxy.rowCount(), 2);
+        //WHEN an item which was filtered out now matches
+        setAccount(model->item(2), 3, "ACME (formerly KDE)", "Paris");
+        //THEN
+        QCOMPARE(shownNames(proxy), QStringList() << "ACME (formerly KDE)" << "KDAB" << "Kdab Deutschland");
+        //WHEN an item which matched doesn't anymore
+        setAccount(model->item(0), 1, "Klaralvdalens Datakonsult", "Hagfors");
+        //THEN
+        QCOMPARE(shownNames(proxy), QStringList() << "ACME (formerly KDE)" << "Kdab Deutschland");
+    }
+
+    void shouldForgetRemovedItems()
+    {
+        //GIVEN
+        FilterProxyModel proxy(Account);
+        QStandardItemModel *model = createSourceModel();
+        proxy.setSourceModel(model);
+        proxy.setFilterString("kdab");
+        QCOMPARE(proxy.rowCount(), 2);
+        //WHEN a removed item's id is reused by another item
+        model->removeRow(0);
+        QStandardItem *standardItem = new QStandardItem;
+        setAccount(standardItem, 1, "Other", "Stockholm");
+        model->appendRow(standardItem);
+        //THEN
+        QCOMPARE(shownNames(proxy), QStringList() << "Kdab Deutschland");
+    }
+
+    void shouldSearchAccountNameLoadedLater()
+    {
+        //GIVEN opportunities indexed before their accounts are loaded
+        OpportunityFilterProxyModel proxy;
+        QStandardItemModel *model = new QStandardItemModel(this);
+        const char *names[] = { "Training", "Consulting" };
+        for (int i = 0; i < 2; ++i) {
+            QStandardItem *standardItem = new QStandardItem;
+            setOpportunity(standardItem, i + 1, QString::fromLatin1(names[i]), QString("account%1").arg(i + 1));
+            model->appendRow(standardItem);
+        }
+        proxy.setSourceModel(model);
+        proxy.setFilterString("kdab");
+        QCOMPARE(proxy.rowCount(), 0);
+        //WHEN
+        loadAccount(101, "account1", "KDAB");
+        QCoreApplication::processEvents();
+        //THEN
+        QCOMPARE(shownNames(proxy), QStringList() << "Training");
+        //WHEN an account is renamed
+        loadAccount(102, "account2", "ACME");
+        loadAccount(101, "account1", "Klaralvdalens Datakonsult");
+        loadAccount(102, "account2", "KDAB");
+        QCoreApplication::processEvents();
+        //THEN
+        QCOMPARE(shownNames(proxy), QStringList() << "Consulting");
+    }
+};
+
+QTEST_MAIN(TestFilterProxyModel)
+
+#include "test_filterproxymodel.moc"
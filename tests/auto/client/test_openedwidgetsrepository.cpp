@@ -0,0 +1,124 @@
+/*
+  This file is part of FatCRM, a desktop application for SugarCRM written by KDAB.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+  Authors: David Faure <david.faure@kdab.com>
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "openedwidgetsrepository.h"
+
+#include <QTest>
+
+#include <Akonadi/Item>
+
+class FakeItemEditWidget : public ItemEditWidgetBase
+{
+public:
+    explicit FakeItemEditWidget(Akonadi::Item::Id id)
+        : mItem(id)
+    {
+    }
+
+    bool isModified() const override { return false; }
+    Akonadi::Item item() const override { return mItem; }
+    QString title() const override { return QString(); }
+    QString detailsName() const override { return QString(); }
+    void updateItem(const Akonadi::Item &item) override { mUpdates.append(item); }
+
+    void setItem(const Akonadi::Item &item) { mItem = item; }
+    QList<Akonadi::Item> updates() const { return mUpdates; }
+
+protected:
+    void accept() override {}
+
+private:
+    Akonadi::Item mItem;
+    QList<Akonadi::Item> mUpdates;
+};
+
+class TestOpenedWidgetsRepository : public QObject
+{
+    Q_OBJECT
+
+private:
+    static Akonadi::Item itemWithRevision(Akonadi::Item::Id id, const QString &revision)
+    {
+        Akonadi::Item item(id);
+        item.setRemoteRevision(revision);
+        return item;
+    }
+
+private Q_SLOTS:
+
+    void shouldDeliverLatestChangeToWidgetShowingItem()
+    {
+        //GIVEN
+        OpenedWidgetsRepository *repo = OpenedWidgetsRepository::instance();
+        FakeItemEditWidget widget1(1);
+        FakeItemEditWidget widget2(2);
+        repo->registerWidget(&widget1);
+        repo->registerWidget(&widget2);
+        //WHEN
+        repo->itemChanged(itemWithRevision(1, "a"));
+        repo->itemChanged(itemWithRevision(3, "a"));
+        repo->itemChanged(itemWithRevision(1, "b"));
+        //THEN nothing is delivered before returning to the event loop
+        QVERIFY(widget1.updates().isEmpty());
+        //WHEN
+        QCoreApplication::processEvents();
+        //THEN
+        QCOMPARE(widget1.updates().count(), 1);
+        QCOMPARE(widget1.updates().at(0).remoteRevision(), QString("b"));
+        QVERIFY(widget2.updates().isEmpty());
+        repo->unregisterWidget(&widget1);
+        repo->unregisterWidget(&widget2);
+    }
+
+    void shouldNotDeliverToUnregisteredWidget()
+    {
+        //GIVEN
+        OpenedWidgetsRepository *repo = OpenedWidgetsRepository::instance();
+        FakeItemEditWidget widget(1);
+        repo->registerWidget(&widget);
+        //WHEN the widget is closed before the change is delivered
+        repo->itemChanged(itemWithRevision(1, "a"));
+        repo->unregisterWidget(&widget);
+        QCoreApplication::processEvents();
+        //THEN
+        QVERIFY(widget.updates().isEmpty());
+    }
+
+    void shouldFindWidgetByCurrentItemId()
+    {
+        //GIVEN a "New <Item>" widget
+        OpenedWidgetsRepository *repo = OpenedWidgetsRepository::instance();
+        FakeItemEditWidget widget(-1);
+        repo->registerWidget(&widget);
+        QVERIFY(!repo->widgetForItem(5));
+        //WHEN the item is saved
+        widget.setItem(Akonadi::Item(5));
+        repo->itemChanged(itemWithRevision(5, "a"));
+        QCoreApplication::processEvents();
+        //THEN
+        QCOMPARE(repo->widgetForItem(5), static_cast<ItemEditWidgetBase *>(&widget));
+        QCOMPARE(widget.updates().count(), 1);
+        repo->unregisterWidget(&widget);
+    }
+};
+
+QTEST_MAIN(TestOpenedWidgetsRepository)
+
+#include "test_openedwidgetsrepository.moc"
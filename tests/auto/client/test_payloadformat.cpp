@@ -0,0 +1,313 @@
+/*
+  This file is part of FatCRM, a desktop application for SugarCRM written by KDAB.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+  Authors: David Faure <david.faure@kdab.com>
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "kdcrmfieldstream.h"
+#include "kdcrmfields.h"
+#include "sugaraccount.h"
+#include "sugaraccountio.h"
+#include "sugardocument.h"
+#include "sugardocumentio.h"
+#include "sugaremail.h"
+#include "sugaremailio.h"
+#include "sugaropportunity.h"
+#include "sugaropportunityio.h"
+
+#include <QBuffer>
+#include <QDebug>
+#include <QTest>
+
+// Checks the binary format of the Akonadi payloads, and compares it with the XML one
+class TestPayloadFormat : public QObject
+{
+    Q_OBJECT
+private:
+    static SugarAccount createAccount(int number)
+    {
+        SugarAccount account;
+        const SugarAccount::AccessorHash accessors = SugarAccount::accessorHash();
+        SugarAccount::AccessorHash::const_iterator it = accessors.constBegin();
+        for (; it != accessors.constEnd(); ++it) {
+            (account.*(it.value().setter))(it.key() + QString::number(number));
+        }
+        account.setName(QString::fromUtf8("Société Générale & Co <%1>").arg(number));
+        account.setDescription(QString::fromUtf8("Première ligne\nSecond line, number %1").arg(number));
+        account.setCustomField("vismaid_c", QString::number(number));
+        return account;
+    }
+
+    static void compareAccounts(const SugarAccount &actual, const SugarAccount &expected)
+    {
+        const SugarAccount::AccessorHash accessors = SugarAccount::accessorHash();
+        SugarAccount::AccessorHash::const_iterator it = accessors.constBegin();
+        for (; it != accessors.constEnd(); ++it) {
+            QCOMPARE((actual.*(it.value().getter))(), (expected.*(it.value().getter))());
+        }
+        QCOMPARE(actual.customFields(), expected.customFields());
+    }
+
+    static QList<SugarAccount> createAccounts()
+    {
+        QList<SugarAccount> accounts;
+        accounts.reserve(s_benchmarkCount);
+        for (int i = 0; i < s_benchmarkCount; ++i) {
+            accounts.append(createAccount(i));
+        }
+        return accounts;
+    }
+
+    static QList<QByteArray> encodeAccounts(const QList<SugarAccount> &accounts, bool binary)
+    {
+        QList<QByteArray> payloads;
+        payloads.reserve(accounts.count());
+        SugarAccountIO io;
+        Q_FOREACH (const SugarAccount &account, accounts) {
+            QByteArray payload;
+            QBuffer buffer(&payload);
+            buffer.open(QIODevice::WriteOnly);
+            if (binary) {
+                io.writeSugarAccountBinary(account, &buffer);
+            } else {
+                io.writeSugarAccount(account, &buffer);
+            }
+            payloads.append(payload);
+        }
+        return payloads;
+    }
+
+    static const int s_benchmarkCount = 100000;
+
+private Q_SLOTS:
+
+    void shouldRoundTripAccounts_data()
+    {
+        QTest::addColumn<bool>("binary");
+
+        QTest::newRow("xml") << false;
+        QTest::newRow("binary") << true;
+    }
+
+    void shouldRoundTripAccounts()
+    {
+        QFETCH(bool, binary);
+
+        //GIVEN
+        const SugarAccount account = createAccount(42);
+        const QByteArray payload = encodeAccounts(QList<SugarAccount>() << account, binary).first();
+
+        //WHEN
+        QBuffer buffer;
+        buffer.setData(payload);
+        buffer.open(QIODevice::ReadOnly);
+        SugarAccount result;
+        SugarAccountIO io;
+        const bool ok = binary ? io.readSugarAccountBinary(&buffer, result) : io.readSugarAccount(&buffer, result);
+
+        //THEN
+        QVERIFY(ok);
+        compareAccounts(result, account);
+    }
+
+    void shouldRoundTripDocumentLinks()
+    {
+        //GIVEN
+        SugarDocument document;
+        document.setId("doc1");
+        document.setDocumentName("Contract.pdf");
+        document.setLinkedAccountIds(QStringList() << "acc1" << "acc2");
+        document.setLinkedOpportunityIds(QStringList() << "opp1");
+        SugarDocumentIO io;
+        QBuffer buffer;
+        buffer.open(QIODevice::ReadWrite);
+        QVERIFY(io.writeSugarDocumentBinary(document, &buffer));
+
+        //WHEN
+        buffer.seek(0);
+        SugarDocument result;
+        QVERIFY(io.readSugarDocumentBinary(&buffer, result));
+
+        //THEN
+        QCOMPARE(result.id(), QString("doc1"));
+        QCOMPARE(result.documentName(), QString("Contract.pdf"));
+        QCOMPARE(result.linkedAccountIds(), QStringList() << "acc1" << "acc2");
+        QCOMPARE(result.linkedOpportunityIds(), QStringList() << "opp1");
+        QVERIFY(result.customFields().isEmpty());
+    }
+
+    void shouldWriteOnlyHeaderFields()
+    {
+        //GIVEN
+        SugarEmail email;
+        email.setId("email1");
+        email.setName("Re: offer");
+        email.setDateSent("2017-03-01 10:00:00");
+        email.setParentType("Accounts");
+        email.setParentId("acc1");
+        email.setDescription(QString(10000, QLatin1Char('x')));
+        email.setFromAddrName("someone@example.com");
+        SugarEmailIO io;
+        QBuffer fullBuffer;
+        fullBuffer.open(QIODevice::WriteOnly);
+        QVERIFY(io.writeSugarEmailBinary(email, &fullBuffer));
+        QBuffer buffer;
+        buffer.open(QIODevice::ReadWrite);
+
+        //WHEN
+        QVERIFY(io.writeSugarEmailHeaderBinary(email, &buffer));
+        buffer.seek(0);
+        SugarEmail result;
+        QVERIFY(io.readSugarEmailBinary(&buffer, result));
+
+        //THEN
+        QCOMPARE(result.id(), QString("email1"));
+        QCOMPARE(result.name(), QString("Re: offer"));
+        QCOMPARE(result.dateSent(), QString("2017-03-01 10:00:00"));
+        QCOMPARE(result.parentType(), QString("Accounts"));
+        QCOMPARE(result.parentId(), QString("acc1"));
+        QVERIFY(result.description().isEmpty());
+        QVERIFY(result.fromAddrName().isEmpty());
+        QVERIFY(buffer.size() < fullBuffer.size() / 100);
+    }
+
+    void shouldKeepDocumentLinksInHeader()
+    {
+        //GIVEN
+        SugarDocument document;
+        document.setId("doc1");
+        document.setDocumentName("Contract.pdf");
+        document.setDescription("Signed version");
+        document.setLinkedAccountIds(QStringList() << "acc1" << "acc2");
+        document.setLinkedOpportunityIds(QStringList() << "opp1");
+        SugarDocumentIO io;
+        QBuffer buffer;
+        buffer.open(QIODevice::ReadWrite);
+
+        //WHEN
+        QVERIFY(io.writeSugarDocumentHeaderBinary(document, &buffer));
+        buffer.seek(0);
+        SugarDocument result;
+        QVERIFY(io.readSugarDocumentBinary(&buffer, result));
+
+        //THEN
+        QCOMPARE(result.id(), QString("doc1"));
+        QCOMPARE(result.documentName(), QString("Contract.pdf"));
+        QCOMPARE(result.linkedAccountIds(), QStringList() << "acc1" << "acc2");
+        QCOMPARE(result.linkedOpportunityIds(), QStringList() << "opp1");
+        QVERIFY(result.description().isEmpty());
+    }
+
+    void shouldKeepOpportunityCustomFields()
+    {
+        //GIVEN
+        SugarOpportunity opportunity;
+        opportunity.setName("Big deal");
+        opportunity.setCustomField(KDCRMFields::nextCallDate(), "2017-03-01");
+        opportunity.setCustomField("some_custom_c", QString::fromUtf8("ünïcödé"));
+        SugarOpportunityIO io;
+        QBuffer buffer;
+        buffer.open(QIODevice::ReadWrite);
+        QVERIFY(io.writeSugarOpportunityBinary(opportunity, &buffer));
+
+        //WHEN
+        buffer.seek(0);
+        SugarOpportunity result;
+        QVERIFY(io.readSugarOpportunityBinary(&buffer, result));
+
+        //THEN
+        QCOMPARE(result.name(), QString("Big deal"));
+        QCOMPARE(result.customFields(), opportunity.customFields());
+    }
+
+    void shouldRejectTruncatedPayload()
+    {
+        //GIVEN
+        QByteArray payload = encodeAccounts(QList<SugarAccount>() << createAccount(1), true).first();
+        payload.chop(10);
+
+        //WHEN
+        QBuffer buffer(&payload);
+        buffer.open(QIODevice::ReadOnly);
+        SugarAccount result;
+        SugarAccountIO io;
+
+        //THEN
+        QVERIFY(!io.readSugarAccountBinary(&buffer, result));
+    }
+
+    void shouldHaveStableFieldIds()
+    {
+        // These ids are stored in payloads, they must never change
+        QCOMPARE(KDCRMFields::fieldId(KDCRMFields::assignedUserName()), quint16(1));
+        QCOMPARE(KDCRMFields::fieldId(KDCRMFields::id()), quint16(4));
+        QCOMPARE(KDCRMFields::fieldName(4), KDCRMFields::id());
+        QCOMPARE(KDCRMFields::fieldId("some_custom_c"), quint16(0));
+        QVERIFY(KDCRMFields::fieldName(0).isEmpty());
+        QVERIFY(KDCRMFields::fieldName(0xfffe).isEmpty());
+    }
+
+    void benchmarkEncode_data()
+    {
+        shouldRoundTripAccounts_data();
+    }
+
+    void benchmarkEncode()
+    {
+        QFETCH(bool, binary);
+        const QList<SugarAccount> accounts = createAccounts();
+        QList<QByteArray> payloads;
+
+        QBENCHMARK_ONCE {
+            payloads = encodeAccounts(accounts, binary);
+        }
+
+        qint64 size = 0;
+        Q_FOREACH (const QByteArray &payload, payloads) {
+            size += payload.size();
+        }
+        qDebug() << (binary ? "binary:" : "xml:") << s_benchmarkCount << "accounts take" << size << "bytes";
+    }
+
+    void benchmarkDecode_data()
+    {
+        shouldRoundTripAccounts_data();
+    }
+
+    void benchmarkDecode()
+    {
+        QFETCH(bool, binary);
+        const QList<QByteArray> payloads = encodeAccounts(createAccounts(), binary);
+        SugarAccountIO io;
+        int decoded = 0;
+
+        QBENCHMARK_ONCE {
+            Q_FOREACH (QByteArray payload, payloads) {
+                QBuffer buffer(&payload);
+                buffer.open(QIODevice::ReadOnly);
+                SugarAccount account;
+                if (binary ? io.readSugarAccountBinary(&buffer, account) : io.readSugarAccount(&buffer, account))
+                    ++decoded;
+            }
+        }
+
+        QCOMPARE(decoded, s_benchmarkCount);
+    }
+};
+
+QTEST_MAIN(TestPayloadFormat)
+#include "test_payloadformat.moc"
@@ -0,0 +1,389 @@
+/*
+  This file is part of FatCRM, a desktop application for SugarCRM written by KDAB.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+  Authors: David Faure <david.faure@kdab.com>
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "qcsvreader.h"
+
+#include <QBuffer>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QTest>
+#include <QTextCodec>
+#include <QTextStream>
+
+Q_DECLARE_METATYPE(QList<QStringList>)
+
+// Counts the fields without converting them to QString
+class CountingBuilder : public QCsvBuilderInterface
+{
+public:
+    CountingBuilder() : fields(0), characters(0) {}
+
+    void begin() override {}
+    void beginLine() override {}
+    void field(const QString &data, uint, uint) override { ++fields; characters += data.size(); }
+    void fieldRef(const QStringRef &data, uint, uint) override { ++fields; characters += data.size(); }
+    void endLine() override {}
+    void end() override {}
+    void error(const QString &) override {}
+
+    int fields;
+    qint64 characters;
+};
+
+// What QCsvReader::read did before reading in blocks (with a start row of 0),
+// as a reference for the tests and the benchmark
+static void readLikeBefore(QIODevice *device, QTextCodec *codec, QChar delimiter, QCsvBuilderInterface *builder)
+{
+    enum State {
+        StartLine,
+        QuotedField,
+        QuotedFieldEnd,
+        NormalField,
+        EmptyField
+    };
+
+    const QChar textQuote = QLatin1Char('"');
+    int row = 1;
+    int column = 1;
+    QString field;
+    QChar input;
+    State currentState = StartLine;
+
+    builder->begin();
+
+    QTextStream inputStream(device);
+    inputStream.setCodec(codec);
+
+    while (!inputStream.atEnd()) {
+        inputStream >> input;
+
+        switch (currentState) {
+        case StartLine:
+            if (input == QLatin1Char('\r') || input == QLatin1Char('\n')) {
+                currentState = StartLine;
+            } else if (input == textQuote) {
+                builder->beginLine();
+                currentState = QuotedField;
+            } else if (input == delimiter) {
+                builder->beginLine();
+                builder->field(field, row - 1, column - 1);
+                column++;
+                currentState = EmptyField;
+            } else {
+                builder->beginLine();
+                field.append(input);
+                currentState = NormalField;
+            }
+            break;
+        case QuotedField:
+            if (input == textQuote) {
+                currentState = QuotedFieldEnd;
+            } else {
+                field.append(input);
+                currentState = QuotedField;
+            }
+            break;
+        case QuotedFieldEnd:
+            if (input == QLatin1Char('\r') || input == QLatin1Char('\n')) {
+                builder->field(field, row - 1, column - 1);
+                field.clear();
+                builder->endLine();
+                column = 1;
+                row++;
+                currentState = StartLine;
+            } else if (input == textQuote) {
+                field.append(input);
+                currentState = QuotedField;
+            } else if (input == delimiter) {
+                builder->field(field, row - 1, column - 1);
+                field.clear();
+                column++;
+                currentState = EmptyField;
+            } else {
+                builder->field(field, row - 1, column - 1);
+                field.clear();
+                column++;
+                field.append(input);
+                currentState = EmptyField;
+            }
+            break;
+        case NormalField:
+            if (input == QLatin1Char('\r') || input == QLatin1Char('\n')) {
+                builder->field(field, row - 1, column - 1);
+                field.clear();
+                builder->endLine();
+                row++;
+                column = 1;
+                currentState = StartLine;
+            } else if (input == delimiter) {
+                builder->field(field, row - 1, column - 1);
+                field.clear();
+                column++;
+                currentState = EmptyField;
+            } else {
+                field.append(input);
+                currentState = NormalField;
+            }
+            break;
+        case EmptyField:
+            if (input == QLatin1Char('\r') || input == QLatin1Char('\n')) {
+                builder->field(QString(), row - 1, column - 1);
+                field.clear();
+                builder->endLine();
+                column = 1;
+                row++;
+                currentState = StartLine;
+            } else if (input == textQuote) {
+                currentState = QuotedField;
+            } else if (input == delimiter) {
+                builder->field(QString(), row - 1, column - 1);
+                column++;
+                currentState = EmptyField;
+            } else {
+                field.append(input);
+                currentState = NormalField;
+            }
+            break;
+        }
+    }
+
+    if (currentState != StartLine) {
+        if (field.length() > 0) {
+            builder->field(field, row - 1, column - 1);
+            ++row;
+            field.clear();
+        }
+        builder->endLine();
+    }
+
+    builder->end();
+}
+
+class TestQCsvReader : public QObject
+{
+    Q_OBJECT
+private:
+    static QList<QStringList> parse(const QByteArray &csv, bool likeBefore = false)
+    {
+        QList<QStringList> rows;
+        QCsvRowBuilder builder([&rows](const QStringList &row) { rows.append(row); });
+        QBuffer buffer;
+        buffer.setData(csv);
+        buffer.open(QIODevice::ReadOnly);
+        QTextCodec *codec = QTextCodec::codecForName("utf-8");
+        if (likeBefore) {
+            readLikeBefore(&buffer, codec, QLatin1Char(','), &builder);
+        } else {
+            QCsvReader reader(&builder);
+            reader.setDelimiter(QLatin1Char(','));
+            reader.setTextCodec(codec);
+            reader.read(&buffer);
+        }
+        return rows;
+    }
+
+    static QString quoted(const QString &field)
+    {
+        QString result = field;
+        result.replace('"', "\"\"");
+        return '"' + result + '"';
+    }
+
+    // Rows with delimiters, quotes and newlines in quoted fields (odd columns), and multi-byte characters
+    static QList<QStringList> generateRows(int count)
+    {
+        QList<QStringList> rows;
+        for (int i = 0; i < count; ++i) {
+            rows.append(QStringList() << QString::number(i)
+                                      << QString("Smith, \"Sons\" %1").arg(i)
+                                      << QString::fromUtf8("Jörg %1").arg(i)
+                                      << QString("line1\nline2 %1").arg(i)
+                                      << QString()
+                                      << QString::fromUtf8("€%1").arg(i * 7));
+        }
+        return rows;
+    }
+
+    static QByteArray toCsv(const QList<QStringList> &rows)
+    {
+        QString csv;
+        Q_FOREACH (const QStringList &row, rows) {
+            QStringList fields;
+            for (int i = 0; i < row.count(); ++i) {
+                fields << (i % 2 ? quoted(row.at(i)) : row.at(i));
+            }
+            csv += fields.join(",") + "\r\n";
+        }
+        return csv.toUtf8();
+    }
+
+private Q_SLOTS:
+    void shouldParseFields_data()
+    {
+        QTest::addColumn<QByteArray>("csv");
+        QTest::addColumn<QList<QStringList> >("expectedRows");
+
+        QTest::newRow("empty") << QByteArray() << QList<QStringList>();
+        QTest::newRow("simple") << QByteArray("a,b\nc,d\n")
+                                << (QList<QStringList>() << (QStringList() << "a" << "b") << (QStringList() << "c" << "d"));
+        QTest::newRow("no_final_newline") << QByteArray("a,b")
+                                          << (QList<QStringList>() << (QStringList() << "a" << "b"));
+        QTest::newRow("crlf_and_blank_lines") << QByteArray("a\r\n\r\nb\r\n")
+                                              << (QList<QStringList>() << (QStringList() << "a") << (QStringList() << "b"));
+        QTest::newRow("empty_fields") << QByteArray(",,c\n")
+                                      << (QList<QStringList>() << (QStringList() << QString() << QString() << "c"));
+        QTest::newRow("quoted") << QByteArray("\"a,b\",\"say \"\"hi\"\"\",\"x\ny\"\n")
+                                << (QList<QStringList>() << (QStringList() << "a,b" << "say \"hi\"" << "x\ny"));
+        QTest::newRow("quote_in_field") << QByteArray("a\"b,c\n")
+                                        << (QList<QStringList>() << (QStringList() << "a\"b" << "c"));
+        QTest::newRow("utf8") << QByteArray("Vedène,€\n")
+                              << (QList<QStringList>() << (QStringList() << QString::fromUtf8("Vedène") << QString::fromUtf8("€")));
+        QTest::newRow("utf8_bom") << QByteArray("\xEF\xBB\xBF" "a,b\n")
+                                  << (QList<QStringList>() << (QStringList() << "a" << "b"));
+        QTest::newRow("utf16le_bom") << QByteArray("\xFF\xFE" "a\0,\0\xE8\0\n\0", 10)
+                                     << (QList<QStringList>() << (QStringList() << "a" << QString::fromUtf8("è")));
+        QTest::newRow("utf16be_bom") << QByteArray("\xFE\xFF\0a\0,\0\xE8\0\n", 10)
+                                     << (QList<QStringList>() << (QStringList() << "a" << QString::fromUtf8("è")));
+    }
+
+    void shouldParseFields()
+    {
+        QFETCH(QByteArray, csv);
+        QFETCH(QList<QStringList>, expectedRows);
+
+        QCOMPARE(parse(csv), expectedRows);
+        QCOMPARE(parse(csv, true), expectedRows);
+    }
+
+    void shouldParseAcrossBlocks()
+    {
+        //GIVEN several blocks of data, with fields and UTF-8 sequences cut at block boundaries
+        const QList<QStringList> rows = generateRows(10000);
+        const QByteArray csv = toCsv(rows);
+        QVERIFY(csv.size() > 4 * 64 * 1024);
+
+        //WHEN
+        const QList<QStringList> result = parse(csv);
+
+        //THEN
+        QCOMPARE(result.count(), rows.count());
+        for (int i = 0; i < rows.count(); ++i) {
+            QCOMPARE(result.at(i), rows.at(i));
+        }
+    }
+
+    void shouldMatchPreviousReader()
+    {
+        //GIVEN
+        const QByteArray csv = toCsv(generateRows(1000)) + "a\"b,,\"c\"d,\"e\"\"\"\n,\n\"unterminated";
+
+        //WHEN
+        const QList<QStringList> result = parse(csv);
+
+        //THEN
+        QCOMPARE(result, parse(csv, true));
+    }
+
+    void shouldMatchStandardBuilder()
+    {
+        //GIVEN
+        const QByteArray csv = toCsv(generateRows(100));
+        QCsvStandardBuilder builder;
+        QCsvReader reader(&builder);
+        reader.setDelimiter(QLatin1Char(','));
+        reader.setTextCodec(QTextCodec::codecForName("utf-8"));
+        QBuffer buffer;
+        buffer.setData(csv);
+        buffer.open(QIODevice::ReadOnly);
+
+        //WHEN
+        QVERIFY(reader.read(&buffer));
+
+        //THEN
+        const QList<QStringList> rows = parse(csv);
+        QCOMPARE(builder.rowCount(), uint(rows.count()));
+        QCOMPARE(builder.columnCount(), 6u);
+        for (int row = 0; row < rows.count(); ++row) {
+            for (int column = 0; column < 6; ++column) {
+                QCOMPARE(builder.data(row, column), rows.at(row).at(column));
+            }
+        }
+    }
+
+    void benchmarkThroughput_data()
+    {
+        QTest::addColumn<QString>("mode");
+
+        QTest::newRow("previous_reader") << "before";
+        QTest::newRow("standard_builder") << "standard";
+        QTest::newRow("row_builder") << "rows";
+        QTest::newRow("field_refs") << "refs";
+    }
+
+    void benchmarkThroughput()
+    {
+        QFETCH(QString, mode);
+        const QByteArray csv = toCsv(generateRows(200000));
+        QBuffer buffer;
+        buffer.setData(csv);
+        QTextCodec *codec = QTextCodec::codecForName("utf-8");
+        qint64 elapsed = 0;
+
+        QBENCHMARK_ONCE {
+            buffer.open(QIODevice::ReadOnly);
+            QElapsedTimer timer;
+            timer.start();
+            if (mode == "before") {
+                CountingBuilder builder;
+                readLikeBefore(&buffer, codec, QLatin1Char(','), &builder);
+                QCOMPARE(builder.fields, 200000 * 6);
+            } else if (mode == "standard") {
+                QCsvStandardBuilder builder;
+                QCsvReader reader(&builder);
+                reader.setDelimiter(QLatin1Char(','));
+                reader.setTextCodec(codec);
+                QVERIFY(reader.read(&buffer));
+                QCOMPARE(builder.rowCount(), 200000u);
+            } else if (mode == "rows") {
+                int rows = 0;
+                QCsvRowBuilder builder([&rows](const QStringList &) { ++rows; });
+                QCsvReader reader(&builder);
+                reader.setDelimiter(QLatin1Char(','));
+                reader.setTextCodec(codec);
+                QVERIFY(reader.read(&buffer));
+                QCOMPARE(rows, 200000);
+            } else {
+                CountingBuilder builder;
+                QCsvReader reader(&builder);
+                reader.setDelimiter(QLatin1Char(','));
+                reader.setTextCodec(codec);
+                QVERIFY(reader.read(&buffer));
+                QCOMPARE(builder.fields, 200000 * 6);
+            }
+            elapsed = timer.elapsed();
+            buffer.close();
+        }
+
+        qDebug() << mode << ":" << (csv.size() / 1024.0 / 1024.0) / qMax<qint64>(elapsed, 1) * 1000 << "MB/s";
+    }
+};
+
+QTEST_MAIN(TestQCsvReader)
+#include "test_qcsvreader.moc"
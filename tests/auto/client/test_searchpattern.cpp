@@ -0,0 +1,198 @@
+/*
+  This file is part of FatCRM, a desktop application for SugarCRM written by KDAB.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+  Authors: David Faure <david.faure@kdab.com>
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "kdcrmsearchpattern.h"
+
+#include <QTest>
+#include <QDebug>
+#include <QStringList>
+
+Q_DECLARE_METATYPE(QList<QStringList>)
+
+class TestSearchPattern : public QObject
+{
+    Q_OBJECT
+private:
+    static QString randomString(const QString &alphabet, int maxLength)
+    {
+        QString str;
+        const int length = qrand() % maxLength;
+        for (int i = 0; i < length; ++i) {
+            str += alphabet.at(qrand() % alphabet.length());
+        }
+        return str;
+    }
+
+    // name, cities, streets, email, country, phone: what FilterProxyModel searches in accounts
+    static QList<QStringList> accountFields(int count)
+    {
+        QList<QStringList> accounts;
+        for (int i = 0; i < count; ++i) {
+            accounts.append(QStringList()
+                            << QString::fromLatin1("Company number %1 GmbH").arg(i)
+                            << QString::fromUtf8("Düsseldorf") << QString::fromLatin1("Hagfors")
+                            << QString::fromLatin1("%1 Main Street").arg(i % 300)
+                            << QString::fromLatin1("Tomtebodavägen %1").arg(i % 40)
+                            << QString::fromLatin1("info%1@example.com").arg(i)
+                            << QString::fromLatin1("Germany")
+                            << QString::fromLatin1("+49 30 %1").arg(521325 + i));
+        }
+        return accounts;
+    }
+
+    // name, organization, email, work phone, mobile phone, first name, country
+    static QList<QStringList> contactFields(int count)
+    {
+        QList<QStringList> contacts;
+        for (int i = 0; i < count; ++i) {
+            contacts.append(QStringList()
+                            << QString::fromLatin1("Jane Doe%1").arg(i)
+                            << QString::fromLatin1("Company number %1 GmbH").arg(i % 500)
+                            << QString::fromLatin1("jane.doe%1@example.com").arg(i)
+                            << QString::fromLatin1("+33 1 %1").arg(40000000 + i)
+                            << QString::fromLatin1("+33 6 %1").arg(50000000 + i)
+                            << QString::fromLatin1("Jane")
+                            << QString::fromLatin1("France"));
+        }
+        return contacts;
+    }
+
+private Q_SLOTS:
+
+    void shouldMatchLikeQStringContains_data()
+    {
+        QTest::addColumn<QString>("text");
+        QTest::addColumn<QString>("pattern");
+
+        QTest::newRow("empty_pattern") << "KDAB" << "";
+        QTest::newRow("empty_text") << "" << "a";
+        QTest::newRow("upper_in_lower") << "klaralvdalens" << "ALV";
+        QTest::newRow("lower_in_upper") << "KLARALVDALENS" << "alv";
+        QTest::newRow("at_end_of_block") << "0123456789abcdefKDAB" << "kdab";
+        QTest::newRow("no_match") << "0123456789abcdefKDAB" << "kdac";
+        QTest::newRow("umlaut") << QString::fromUtf8("Tomtebodavägen 3, Düsseldorf") << QString::fromUtf8("DÜSSEL");
+        QTest::newRow("umlaut_first") << QString::fromUtf8("Übersee, Ölsdorf") << QString::fromUtf8("ölsd");
+        QTest::newRow("non_ascii_text_ascii_pattern") << QString::fromUtf8("Ελλάδα, Athens") << "ATHENS";
+        QTest::newRow("kelvin_sign") << QString::fromUtf8("12 K") << "k";
+        QTest::newRow("punctuation") << "jane.doe@example.com" << "@EXAMPLE.";
+        QTest::newRow("longer_pattern") << "abc" << "abcd";
+    }
+
+    void shouldMatchLikeQStringContains()
+    {
+        QFETCH(QString, text);
+        QFETCH(QString, pattern);
+        const KDCRMSearchPattern searchPattern(pattern);
+        const bool expected = text.contains(pattern, Qt::CaseInsensitive);
+        QCOMPARE(searchPattern.matches(text), expected);
+        QCOMPARE(searchPattern.matchesFolded(text.toCaseFolded()), expected);
+        QCOMPARE(searchPattern.matchesAny(QStringList() << "nothing" << text), expected);
+    }
+
+    void shouldFindPositionInFoldedText()
+    {
+        //GIVEN
+        const QString text = QString::fromLatin1("Company number 12 GmbH, Main Street").toCaseFolded();
+        //WHEN
+        const KDCRMSearchPattern pattern("MAIN");
+        //THEN
+        QCOMPARE(pattern.indexInFolded(text.constData(), text.length()), text.indexOf("main"));
+        QCOMPARE(KDCRMSearchPattern("none").indexInFolded(text.constData(), text.length()), -1);
+    }
+
+    void fuzzAgainstQStringContains()
+    {
+        const QString alphabet = QString::fromUtf8("aAbBkK KäÄß-");
+        qsrand(42);
+        for (int i = 0; i < 50000; ++i) {
+            const QString text = randomString(alphabet, 40);
+            const QString pattern = randomString(alphabet, 4);
+            const KDCRMSearchPattern searchPattern(pattern);
+            const bool expected = text.contains(pattern, Qt::CaseInsensitive);
+            if (searchPattern.matches(text) != expected || searchPattern.matchesFolded(text.toCaseFolded()) != expected) {
+                qDebug() << text << pattern << expected;
+                QFAIL("mismatch");
+            }
+        }
+    }
+
+    void benchmarkSearch_data()
+    {
+        QTest::addColumn<QList<QStringList> >("items");
+        QTest::addColumn<QString>("filter");
+        QTest::addColumn<int>("method"); // 0 = QString::contains, 1 = matchesAny, 2 = matchesFolded
+
+        const QList<QStringList> accounts = accountFields(20000);
+        const QList<QStringList> contacts = contactFields(60000);
+        const char *methods[] = { "contains", "matchesAny", "matchesFolded" };
+        for (int method = 0; method < 3; ++method) {
+            QTest::newRow((QByteArray("accounts_") + methods[method]).constData()) << accounts << "street 29" << method;
+            QTest::newRow((QByteArray("contacts_") + methods[method]).constData()) << contacts << "DOE5999" << method;
+            QTest::newRow((QByteArray("contacts_nomatch_") + methods[method]).constData()) << contacts << "xyz" << method;
+        }
+    }
+
+    void benchmarkSearch()
+    {
+        QFETCH(QList<QStringList>, items);
+        QFETCH(QString, filter);
+        QFETCH(int, method);
+
+        // like the index of FilterProxyModel
+        QStringList foldedItems;
+        Q_FOREACH (const QStringList &fields, items) {
+            foldedItems.append(fields.join("\n").toCaseFolded());
+        }
+        const KDCRMSearchPattern pattern(filter);
+        int found = 0;
+        QBENCHMARK {
+            found = 0;
+            switch (method) {
+            case 0:
+                Q_FOREACH (const QStringList &fields, items) {
+                    Q_FOREACH (const QString &field, fields) {
+                        if (field.contains(filter, Qt::CaseInsensitive)) {
+                            ++found;
+                            break;
+                        }
+                    }
+                }
+                break;
+            case 1:
+                Q_FOREACH (const QStringList &fields, items) {
+                    if (pattern.matchesAny(fields))
+                        ++found;
+                }
+                break;
+            case 2:
+                Q_FOREACH (const QString &text, foldedItems) {
+                    if (pattern.matchesFolded(text))
+                        ++found;
+                }
+                break;
+            }
+        }
+        Q_UNUSED(found);
+    }
+};
+
+QTEST_MAIN(TestSearchPattern)
+
+#include "test_searchpattern.moc"
@@ -0,0 +1,131 @@
+/*
+  This file is part of FatCRM, a desktop application for SugarCRM written by KDAB.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+  Authors: David Faure <david.faure@kdab.com>
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <QTest>
+#include <QDebug>
+#include "leadshandler.h"
+#include "sugarsession.h"
+#include "sugarsoap.h"
+#include "kdcrmdata/sugarlead.h"
+
+#include <algorithm>
+
+using namespace KDSoapGenerated;
+
+class TestFieldColumns : public QObject
+{
+    Q_OBJECT
+
+private:
+    static TNS__Entry_value createEntry(const QString &id, const QList<QPair<QString, QString> > &values)
+    {
+        QList<TNS__Name_value> items;
+        for (int i = 0; i < values.count(); ++i) {
+            TNS__Name_value namedValue;
+            namedValue.setName(values.at(i).first);
+            namedValue.setValue(values.at(i).second);
+            items.append(namedValue);
+        }
+        TNS__Name_value_list valueList;
+        valueList.setItems(items);
+        TNS__Entry_value entry;
+        entry.setId(id);
+        entry.setName_value_list(valueList);
+        return entry;
+    }
+
+    static QList<QPair<QString, QString> > leadValues(int number)
+    {
+        return QList<QPair<QString, QString> >()
+                << qMakePair(QString("first_name"), QString("Jane%1").arg(number))
+                << qMakePair(QString("last_name"), QString("Doe"))
+                << qMakePair(QString("primary_address_city"), QString("Berlin"))
+                << qMakePair(QString("assistant_phone"), QString::number(number))
+                << qMakePair(QString("unknown_field_c"), QString("ignored"))
+                << qMakePair(QString("date_modified"), QString("2017-03-01 10:00:00"));
+    }
+
+private Q_SLOTS:
+
+    void shouldMapColumnsToLeadFields()
+    {
+        //GIVEN
+        SugarSession session(nullptr);
+        LeadsHandler handler(&session);
+        const TNS__Entry_value entry = createEntry("lead1", leadValues(1));
+
+        //WHEN
+        const Akonadi::Item item = handler.itemFromEntry(entry, Akonadi::Collection());
+
+        //THEN
+        QVERIFY(item.hasPayload<SugarLead>());
+        const SugarLead lead = item.payload<SugarLead>();
+        QCOMPARE(lead.id(), QString("lead1"));
+        QCOMPARE(lead.firstName(), QString("Jane1"));
+        QCOMPARE(lead.lastName(), QString("Doe"));
+        QCOMPARE(lead.primaryAddressCity(), QString("Berlin"));
+        QCOMPARE(lead.assistantPhone(), QString("1"));
+        QCOMPARE(item.remoteRevision(), QString("2017-03-01 10:00:00"));
+    }
+
+    void shouldHandleChangingColumns()
+    {
+        //GIVEN
+        SugarSession session(nullptr);
+        LeadsHandler handler(&session);
+        QList<QPair<QString, QString> > values = leadValues(1);
+        handler.itemFromEntry(createEntry("lead1", values), Akonadi::Collection());
+
+        //WHEN
+        std::reverse(values.begin(), values.end());
+        values.removeLast();
+        const Akonadi::Item item = handler.itemFromEntry(createEntry("lead2", values), Akonadi::Collection());
+
+        //THEN
+        const SugarLead lead = item.payload<SugarLead>();
+        QVERIFY(lead.firstName().isEmpty());
+        QCOMPARE(lead.lastName(), QString("Doe"));
+        QCOMPARE(lead.assistantPhone(), QString("1"));
+        QCOMPARE(item.remoteRevision(), QString("2017-03-01 10:00:00"));
+    }
+
+    void benchmarkItemFromEntry()
+    {
+        SugarSession session(nullptr);
+        LeadsHandler handler(&session);
+        QList<TNS__Entry_value> entries;
+        for (int i = 0; i < 25000; ++i) {
+            entries.append(createEntry(QString::number(i), leadValues(i)));
+        }
+        int parsed = 0;
+
+        QBENCHMARK_ONCE {
+            Q_FOREACH (const TNS__Entry_value &entry, entries) {
+                if (!handler.itemFromEntry(entry, Akonadi::Collection()).remoteId().isEmpty())
+                    ++parsed;
+            }
+        }
+
+        QCOMPARE(parsed, entries.count());
+    }
+};
+
+QTEST_MAIN(TestFieldColumns)
+#include "test_fieldcolumns.moc"
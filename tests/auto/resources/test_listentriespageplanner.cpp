@@ -0,0 +1,229 @@
+/*
+  This file is part of FatCRM, a desktop application for SugarCRM written by KDAB.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+  Authors: David Faure <david.faure@kdab.com>
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <QTest>
+#include <QDebug>
+#include "listentriespageplanner.h"
+
+class TestListEntriesPagePlanner : public QObject
+{
+    Q_OBJECT
+
+private:
+    struct Request {
+        int offset;
+        int size;
+    };
+
+    // Simulates a server with totalCount entries, which returns at most maxResults entries
+    // per call, answering the pending requests in reverse order. Returns the emitted offsets.
+    QVector<int> listAll(int totalCount, int maxResults, int pageSize, int windowSize)
+    {
+        ListEntriesPagePlanner planner;
+        planner.setTotalCount(totalCount);
+        QList<Request> pending;
+        QMap<int, int> received; // offset -> page size
+        QVector<int> emitted;
+        for (int loops = 0; loops < 1000; ++loops) {
+            while (planner.mayRequestMorePages() && pending.count() < windowSize) {
+                const Request request = { planner.requestPage(pageSize), pageSize };
+                pending.append(request);
+            }
+            if (pending.isEmpty())
+                break;
+            const Request request = pending.takeLast();
+            const int count = qBound(0, qMin(request.size, maxResults), totalCount - request.offset);
+            const ListEntriesPagePlanner::ReceivedPage page =
+                planner.pageReceived(request.offset, request.size, count, request.offset + count);
+            if (page.lastPage) {
+                for (int i = pending.count() - 1; i >= 0; --i) {
+                    if (pending.at(i).offset >= planner.nextOffset())
+                        pending.removeAt(i);
+                }
+            } else if (page.missingSize > 0) {
+                const Request missing = { page.missingOffset, page.missingSize };
+                pending.append(missing);
+            }
+            for (int i = 0; i < count; ++i) {
+                emitted.append(request.offset + i); // the entries, in the order they arrive
+            }
+            received.insert(request.offset, page.pageSize);
+            while (received.contains(planner.nextOffsetToEmit())) {
+                planner.pageEmitted(received.take(planner.nextOffsetToEmit()));
+            }
+        }
+        if (!planner.isComplete())
+            return QVector<int>();
+        qSort(emitted);
+        return emitted;
+    }
+
+    static QVector<int> range(int count)
+    {
+        QVector<int> result(count);
+        for (int i = 0; i < count; ++i)
+            result[i] = i;
+        return result;
+    }
+
+private Q_SLOTS:
+
+    void shouldRequestConsecutivePages()
+    {
+        //GIVEN
+        ListEntriesPagePlanner planner;
+        planner.setTotalCount(250);
+        //WHEN
+        const int first = planner.requestPage(100);
+        const int second = planner.requestPage(100);
+        const int third = planner.requestPage(100);
+        //THEN
+        QCOMPARE(first, 0);
+        QCOMPARE(second, 100);
+        QCOMPARE(third, 200);
+        QVERIFY(!planner.mayRequestMorePages()); // beyond the count, wait for the previous pages first
+    }
+
+    void shouldRequestRestOfShortMiddlePage()
+    {
+        //GIVEN
+        ListEntriesPagePlanner planner;
+        planner.setTotalCount(250);
+        planner.requestPage(100);
+        planner.requestPage(100);
+        planner.requestPage(100);
+        //WHEN the server returns fewer rows than asked for, in the middle of the listing
+        const ListEntriesPagePlanner::ReceivedPage page = planner.pageReceived(100, 100, 60, 160);
+        //THEN
+        QVERIFY(!page.lastPage);
+        QCOMPARE(page.pageSize, 60);
+        QCOMPARE(page.missingOffset, 160);
+        QCOMPARE(page.missingSize, 40);
+        QCOMPARE(planner.nextOffset(), 300); // the page at offset 200 is still needed
+    }
+
+    void shouldIgnoreBogusNextOffset()
+    {
+        //GIVEN
+        ListEntriesPagePlanner planner;
+        planner.setTotalCount(250);
+        planner.requestPage(100);
+        //WHEN
+        const ListEntriesPagePlanner::ReceivedPage page = planner.pageReceived(0, 100, 60, 0);
+        //THEN
+        QCOMPARE(page.pageSize, 60);
+        QCOMPARE(page.missingOffset, 60);
+        QCOMPARE(page.missingSize, 40);
+    }
+
+    void shouldStopAtLastPage()
+    {
+        //GIVEN
+        ListEntriesPagePlanner planner;
+        planner.setTotalCount(150);
+        planner.requestPage(100);
+        planner.requestPage(100);
+        //WHEN
+        const ListEntriesPagePlanner::ReceivedPage page = planner.pageReceived(100, 100, 50, 150);
+        //THEN
+        QVERIFY(page.lastPage);
+        QCOMPARE(page.pageSize, 100);
+        QCOMPARE(page.missingSize, 0);
+        QVERIFY(!planner.mayRequestMorePages());
+    }
+
+    void shouldStopAtEmptyPage()
+    {
+        //GIVEN
+        ListEntriesPagePlanner planner;
+        planner.setTotalCount(300);
+        planner.requestPage(100);
+        planner.requestPage(100);
+        planner.requestPage(100);
+        //WHEN (entries were deleted meanwhile)
+        const ListEntriesPagePlanner::ReceivedPage page = planner.pageReceived(100, 100, 0, 100);
+        //THEN
+        QVERIFY(page.lastPage);
+        QCOMPARE(planner.nextOffset(), 200); // the page at offset 200 isn't needed anymore
+        QVERIFY(!planner.mayRequestMorePages());
+    }
+
+    void shouldGoOnAfterCount()
+    {
+        //GIVEN
+        ListEntriesPagePlanner planner;
+        planner.setTotalCount(100);
+        planner.requestPage(100);
+        //WHEN (entries were created meanwhile)
+        const ListEntriesPagePlanner::ReceivedPage page = planner.pageReceived(0, 100, 100, 100);
+        planner.pageEmitted(page.pageSize);
+        //THEN
+        QVERIFY(!page.lastPage);
+        QVERIFY(planner.mayRequestMorePages());
+    }
+
+    void shouldRestartFromFirstPageNotEmitted()
+    {
+        //GIVEN
+        ListEntriesPagePlanner planner;
+        planner.setTotalCount(500);
+        planner.requestPage(100);
+        planner.requestPage(100);
+        planner.requestPage(100);
+        planner.pageEmitted(planner.pageReceived(0, 100, 100, 100).pageSize);
+        //WHEN
+        planner.restart();
+        //THEN
+        QCOMPARE(planner.nextOffset(), 100);
+        QCOMPARE(planner.requestPage(100), 100);
+    }
+
+    void shouldListEverything_data()
+    {
+        QTest::addColumn<int>("totalCount");
+        QTest::addColumn<int>("maxResults");
+        QTest::addColumn<int>("pageSize");
+        QTest::addColumn<int>("windowSize");
+
+        QTest::newRow("no_cap") << 1234 << 10000 << 100 << 3;
+        QTest::newRow("capped") << 1234 << 70 << 100 << 3;
+        QTest::newRow("capped_big_pages") << 5000 << 200 << 1000 << 4;
+        QTest::newRow("capped_one_page_at_a_time") << 555 << 30 << 100 << 1;
+        QTest::newRow("exact_pages") << 500 << 10000 << 100 << 2;
+    }
+
+    void shouldListEverything()
+    {
+        QFETCH(int, totalCount);
+        QFETCH(int, maxResults);
+        QFETCH(int, pageSize);
+        QFETCH(int, windowSize);
+
+        //GIVEN
+        //WHEN
+        const QVector<int> emitted = listAll(totalCount, maxResults, pageSize, windowSize);
+        //THEN
+        QCOMPARE(emitted, range(totalCount));
+    }
+};
+
+QTEST_MAIN(TestListEntriesPagePlanner)
+
+#include "test_listentriespageplanner.moc"
@@ -0,0 +1,119 @@
+/*
+  This file is part of FatCRM, a desktop application for SugarCRM written by KDAB.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+  Authors: David Faure <david.faure@kdab.com>
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <QTest>
+#include <QDebug>
+#include "listentriespagesizer.h"
+
+class TestListEntriesPageSizer : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+
+    void shouldStayWithinBounds()
+    {
+        //GIVEN
+        ListEntriesPageSizer sizer(20, 500);
+        //WHEN
+        sizer.setPageSize(5);
+        //THEN
+        QCOMPARE(sizer.pageSize(), 20);
+        //WHEN
+        sizer.setPageSize(1000);
+        //THEN
+        QCOMPARE(sizer.pageSize(), 500);
+    }
+
+    void shouldGrowWhenFast()
+    {
+        //GIVEN
+        ListEntriesPageSizer sizer(20, 500);
+        sizer.setTargetResponseTime(2000);
+        sizer.setPageSize(100);
+        //WHEN
+        sizer.addSample(100, 100, 10000, 1000);
+        //THEN
+        QCOMPARE(sizer.pageSize(), 200);
+        //WHEN (no more than a factor 2 per page, and no more than the maximum)
+        sizer.addSample(200, 200, 20000, 10);
+        sizer.addSample(400, 400, 40000, 10);
+        //THEN
+        QCOMPARE(sizer.pageSize(), 500);
+    }
+
+    void shouldShrinkWhenSlow()
+    {
+        //GIVEN
+        ListEntriesPageSizer sizer(20, 500);
+        sizer.setTargetResponseTime(2000);
+        sizer.setPageSize(100);
+        //WHEN
+        sizer.addSample(100, 100, 10000, 8000);
+        //THEN
+        QCOMPARE(sizer.pageSize(), 50);
+        //WHEN
+        sizer.addSample(50, 50, 5000, 8000);
+        sizer.addSample(25, 25, 2500, 8000);
+        //THEN
+        QCOMPARE(sizer.pageSize(), 20);
+    }
+
+    void shouldKeepSizeWhenCloseToTarget()
+    {
+        //GIVEN
+        ListEntriesPageSizer sizer(20, 500);
+        sizer.setTargetResponseTime(2000);
+        sizer.setPageSize(100);
+        //WHEN
+        sizer.addSample(100, 100, 10000, 1900);
+        sizer.addSample(100, 100, 10000, 2200);
+        //THEN
+        QCOMPARE(sizer.pageSize(), 100);
+    }
+
+    void shouldIgnoreIncompletePages()
+    {
+        //GIVEN
+        ListEntriesPageSizer sizer(20, 500);
+        sizer.setPageSize(100);
+        //WHEN
+        sizer.addSample(100, 3, 300, 100);
+        //THEN
+        QCOMPARE(sizer.pageSize(), 100);
+    }
+
+    void shouldLimitResponseSize()
+    {
+        //GIVEN
+        ListEntriesPageSizer sizer(20, 500);
+        sizer.setTargetResponseTime(2000);
+        sizer.setMaximumResponseSize(1024 * 1024);
+        sizer.setPageSize(100);
+        //WHEN (fast, but 20KB per entry, e.g. emails)
+        sizer.addSample(100, 100, 2048000, 500);
+        //THEN
+        QCOMPARE(sizer.pageSize(), 51);
+    }
+};
+
+QTEST_MAIN(TestListEntriesPageSizer)
+
+#include "test_listentriespagesizer.moc"